@@ -0,0 +1,2 @@
+#!/bin/bash
+export FILES_TO_COMPILE='src/*.cpp'
@@ -0,0 +1,562 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <regex>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "stdarchive.hpp"
+#include "stdasync.hpp"
+#include "stdcompress.hpp"
+#include "stddecompress.hpp"
+#include "stdentropy.hpp"
+#include "stdfilesystem.hpp"
+
+using namespace stdfunc;
+
+namespace {
+
+// Semi-compressible, roughly like logs or snapshots
+auto makeInput( size_t _size ) -> std::vector< std::byte > {
+    std::vector< std::byte > l_returnValue( _size );
+
+    uint64_t l_state = 0x9E3779B97F4A7C15;
+
+    for ( size_t l_index = 0; l_index < _size; l_index++ ) {
+        l_state ^= ( l_state << 13 );
+        l_state ^= ( l_state >> 7 );
+        l_state ^= ( l_state << 17 );
+
+        l_returnValue[ l_index ] = std::byte(
+            static_cast< unsigned char >( ( l_index % 97 ) < 80
+                                              ? ( ( l_index / 16 ) % 251 )
+                                              : ( l_state & 0xFF ) ) );
+    }
+
+    return ( l_returnValue );
+}
+
+const std::vector< std::byte > g_input = makeInput( 64 * 1024 * 1024 );
+
+// 10k records of 200 to 2000 bytes
+auto makeRecords() -> std::vector< std::span< const std::byte > > {
+    std::vector< std::span< const std::byte > > l_returnValue;
+
+    size_t l_offset = 0;
+
+    for ( size_t l_index = 0; l_index < 10'000; l_index++ ) {
+        const size_t l_size = ( 200 + ( ( l_index * 7919 ) % 1800 ) );
+
+        l_returnValue.emplace_back(
+            std::span( g_input ).subspan( l_offset, l_size ) );
+
+        l_offset += l_size;
+    }
+
+    return ( l_returnValue );
+}
+
+const std::vector< std::span< const std::byte > > g_records = makeRecords();
+
+// Gaps of a sorted posting list, mostly small with rare long jumps
+auto makeGaps() -> std::vector< uint32_t > {
+    std::vector< uint32_t > l_returnValue( 1024 * 1024 );
+
+    uint64_t l_state = 0x9E3779B97F4A7C15;
+
+    for ( auto& _gap : l_returnValue ) {
+        l_state ^= ( l_state << 13 );
+        l_state ^= ( l_state >> 7 );
+        l_state ^= ( l_state << 17 );
+
+        _gap = static_cast< uint32_t >( ( ( l_state % 64 ) == 0 )
+                                            ? ( l_state >> 40 )
+                                            : ( l_state % 200 ) );
+    }
+
+    return ( l_returnValue );
+}
+
+const std::vector< uint32_t > g_gaps = makeGaps();
+
+auto recordsSize() -> int64_t {
+    size_t l_returnValue = 0;
+
+    for ( const std::span< const std::byte > _record : g_records ) {
+        l_returnValue += _record.size();
+    }
+
+    return ( static_cast< int64_t >( l_returnValue ) );
+}
+
+} // namespace
+
+// Throughput versus threads, argument is the worker count
+static void compress$data$parallel( benchmark::State& _state ) {
+    const compress::parameters l_parameters{
+        .level = 3, .workers = static_cast< size_t >( _state.range( 0 ) ) };
+
+    for ( auto _ : _state ) {
+        benchmark::DoNotOptimize( compress::data( g_input, l_parameters ) );
+    }
+
+    _state.SetBytesProcessed( static_cast< int64_t >( _state.iterations() *
+                                                      g_input.size() ) );
+}
+
+BENCHMARK( compress$data$parallel )
+    ->Arg( 0 )
+    ->Arg( 1 )
+    ->Arg( 2 )
+    ->Arg( 4 )
+    ->Arg( 8 )
+    ->Arg( 16 )
+    ->UseRealTime()
+    ->Unit( benchmark::kMillisecond );
+
+// Read, compress and write overlapping, argument is the pool size
+static void compress$pipeline( benchmark::State& _state ) {
+    async::pool l_pool( static_cast< size_t >( _state.range( 0 ) ) );
+
+    std::stringstream l_input;
+    std::stringstream l_output;
+
+    l_input.write( reinterpret_cast< const char* >( g_input.data() ),
+                   static_cast< std::streamsize >( g_input.size() ) );
+
+    for ( auto _ : _state ) {
+        l_input.clear();
+        l_input.seekg( 0 );
+        l_output.str( {} );
+
+        benchmark::DoNotOptimize( compress::pipeline(
+            l_input, l_output, 3, compress::g_defaultPipelineChunkSize,
+            l_pool ) );
+    }
+
+    _state.SetBytesProcessed( static_cast< int64_t >( _state.iterations() *
+                                                      g_input.size() ) );
+}
+
+BENCHMARK( compress$pipeline )
+    ->Arg( 1 )
+    ->Arg( 2 )
+    ->Arg( 4 )
+    ->Arg( 8 )
+    ->Arg( 16 )
+    ->UseRealTime()
+    ->Unit( benchmark::kMillisecond );
+
+static void compress$framedText$parallel( benchmark::State& _state ) {
+    const std::string_view l_text(
+        reinterpret_cast< const char* >( g_input.data() ), g_input.size() );
+
+    for ( auto _ : _state ) {
+        benchmark::DoNotOptimize( compress::framedText(
+            l_text, static_cast< size_t >( _state.range( 0 ) ) ) );
+    }
+
+    _state.SetBytesProcessed( static_cast< int64_t >( _state.iterations() *
+                                                      g_input.size() ) );
+}
+
+BENCHMARK( compress$framedText$parallel )
+    ->Arg( 1 )
+    ->Arg( 2 )
+    ->Arg( 4 )
+    ->Arg( 8 )
+    ->Arg( 16 )
+    ->UseRealTime()
+    ->Unit( benchmark::kMillisecond );
+
+// Baseline for compress$batch
+static void compress$data$records( benchmark::State& _state ) {
+    for ( auto _ : _state ) {
+        for ( const std::span< const std::byte > _record : g_records ) {
+            benchmark::DoNotOptimize( compress::data( _record ) );
+        }
+    }
+
+    _state.SetBytesProcessed( _state.iterations() * recordsSize() );
+}
+
+BENCHMARK( compress$data$records )->UseRealTime()->Unit(
+    benchmark::kMillisecond );
+
+// Records sent as a 64 byte header plus the body in 3 pieces, argument 0
+// concatenates them first, 1 passes the fragments
+static void compress$data$fragments( benchmark::State& _state ) {
+    std::vector< std::byte > l_message;
+
+    for ( auto _ : _state ) {
+        for ( const std::span< const std::byte > _record : g_records ) {
+            const size_t l_third = ( ( _record.size() - 64 ) / 3 );
+            const std::array< std::span< const std::byte >, 4 > l_fragments{
+                _record.first( 64 ), _record.subspan( 64, l_third ),
+                _record.subspan( ( 64 + l_third ), l_third ),
+                _record.subspan( 64 + ( 2 * l_third ) ) };
+
+            if ( _state.range( 0 ) ) {
+                benchmark::DoNotOptimize( compress::data( l_fragments ) );
+
+                continue;
+            }
+
+            l_message.clear();
+
+            for ( const std::span< const std::byte > _fragment :
+                  l_fragments ) {
+                l_message.insert( l_message.end(), _fragment.begin(),
+                                  _fragment.end() );
+            }
+
+            benchmark::DoNotOptimize( compress::data( l_message ) );
+        }
+    }
+
+    _state.SetBytesProcessed( _state.iterations() * recordsSize() );
+}
+
+BENCHMARK( compress$data$fragments )->Arg( 0 )->Arg( 1 )->Unit(
+    benchmark::kMillisecond );
+
+static void compress$batch( benchmark::State& _state ) {
+    for ( auto _ : _state ) {
+        benchmark::DoNotOptimize( compress::batch(
+            g_records, 3, static_cast< size_t >( _state.range( 0 ) ) ) );
+    }
+
+    _state.SetBytesProcessed( _state.iterations() * recordsSize() );
+}
+
+BENCHMARK( compress$batch )
+    ->Arg( 1 )
+    ->Arg( 2 )
+    ->Arg( 4 )
+    ->Arg( 8 )
+    ->Arg( 16 )
+    ->UseRealTime()
+    ->Unit( benchmark::kMillisecond );
+
+// Built-in codec against Snappy on one thread, argument is the lz level
+static void compress$lz( benchmark::State& _state ) {
+    const auto l_level = static_cast< size_t >( _state.range( 0 ) );
+
+    std::optional< std::vector< std::byte > > l_compressed;
+
+    for ( auto _ : _state ) {
+        l_compressed = compress::lz( g_input, l_level );
+
+        benchmark::DoNotOptimize( l_compressed );
+    }
+
+    _state.SetBytesProcessed( static_cast< int64_t >( _state.iterations() *
+                                                      g_input.size() ) );
+    _state.counters[ "ratio" ] =
+        ( static_cast< double >( g_input.size() ) /
+          static_cast< double >( l_compressed ? l_compressed->size()
+                                              : g_input.size() ) );
+}
+
+BENCHMARK( compress$lz )->Arg( 1 )->Arg( 5 )->Arg( 9 )->Unit(
+    benchmark::kMillisecond );
+
+static void compress$text( benchmark::State& _state ) {
+    const std::string_view l_text(
+        reinterpret_cast< const char* >( g_input.data() ), g_input.size() );
+
+    std::optional< std::string > l_compressed;
+
+    for ( auto _ : _state ) {
+        l_compressed = compress::text( l_text );
+
+        benchmark::DoNotOptimize( l_compressed );
+    }
+
+    _state.SetBytesProcessed( static_cast< int64_t >( _state.iterations() *
+                                                      g_input.size() ) );
+    _state.counters[ "ratio" ] =
+        ( static_cast< double >( g_input.size() ) /
+          static_cast< double >( l_compressed ? l_compressed->size()
+                                              : g_input.size() ) );
+}
+
+BENCHMARK( compress$text )->Unit( benchmark::kMillisecond );
+
+static void decompress$lz( benchmark::State& _state ) {
+    const std::vector< std::byte > l_compressed = *compress::lz( g_input );
+
+    for ( auto _ : _state ) {
+        benchmark::DoNotOptimize( decompress::lz( l_compressed ) );
+    }
+
+    _state.SetBytesProcessed( static_cast< int64_t >( _state.iterations() *
+                                                      g_input.size() ) );
+}
+
+BENCHMARK( decompress$lz )->Unit( benchmark::kMillisecond );
+
+static void decompress$text( benchmark::State& _state ) {
+    const std::string l_compressed = *compress::text( std::string_view(
+        reinterpret_cast< const char* >( g_input.data() ), g_input.size() ) );
+
+    for ( auto _ : _state ) {
+        benchmark::DoNotOptimize( decompress::text( l_compressed ) );
+    }
+
+    _state.SetBytesProcessed( static_cast< int64_t >( _state.iterations() *
+                                                      g_input.size() ) );
+}
+
+BENCHMARK( decompress$text )->Unit( benchmark::kMillisecond );
+
+static void decompress$packed( benchmark::State& _state ) {
+    std::vector< std::byte > l_compressed(
+        compress::packedBound( g_gaps.size() ) );
+    std::vector< uint32_t > l_output( g_gaps.size() );
+
+    l_compressed.resize( *compress::packed( g_gaps, l_compressed ) );
+
+    for ( auto _ : _state ) {
+        benchmark::DoNotOptimize(
+            decompress::packed( l_compressed, l_output ) );
+        benchmark::ClobberMemory();
+    }
+
+    _state.SetItemsProcessed(
+        static_cast< int64_t >( _state.iterations() * g_gaps.size() ) );
+}
+
+BENCHMARK( decompress$packed );
+
+static void decompress$streamVByte( benchmark::State& _state ) {
+    std::vector< std::byte > l_compressed(
+        compress::streamVByteBound( g_gaps.size() ) );
+    std::vector< uint32_t > l_output( g_gaps.size() );
+
+    l_compressed.resize( *compress::streamVByte( g_gaps, l_compressed ) );
+
+    for ( auto _ : _state ) {
+        benchmark::DoNotOptimize(
+            decompress::streamVByte( l_compressed, l_output ) );
+        benchmark::ClobberMemory();
+    }
+
+    _state.SetItemsProcessed(
+        static_cast< int64_t >( _state.iterations() * g_gaps.size() ) );
+}
+
+BENCHMARK( decompress$streamVByte );
+
+// Prefix sum back from gaps to document numbers
+static void decompress$delta( benchmark::State& _state ) {
+    std::vector< uint32_t > l_values = g_gaps;
+
+    for ( auto _ : _state ) {
+        decompress::delta( l_values );
+        benchmark::ClobberMemory();
+    }
+
+    _state.SetItemsProcessed(
+        static_cast< int64_t >( _state.iterations() * g_gaps.size() ) );
+}
+
+BENCHMARK( decompress$delta );
+
+static void entropy$histogram( benchmark::State& _state ) {
+    for ( auto _ : _state ) {
+        benchmark::DoNotOptimize( entropy::histogram( g_input ) );
+    }
+
+    _state.SetBytesProcessed( static_cast< int64_t >( _state.iterations() *
+                                                      g_input.size() ) );
+}
+
+BENCHMARK( entropy$histogram )->Unit( benchmark::kMillisecond );
+
+static void decompress$ans( benchmark::State& _state ) {
+    const std::vector< std::byte > l_compressed = *compress::ans( g_input );
+
+    for ( auto _ : _state ) {
+        benchmark::DoNotOptimize( decompress::ans( l_compressed ) );
+    }
+
+    _state.SetBytesProcessed( static_cast< int64_t >( _state.iterations() *
+                                                      g_input.size() ) );
+    _state.counters[ "ratio" ] =
+        ( static_cast< double >( g_input.size() ) /
+          static_cast< double >( l_compressed.size() ) );
+}
+
+BENCHMARK( decompress$ans )->Unit( benchmark::kMillisecond );
+
+static void decompress$huffman( benchmark::State& _state ) {
+    const std::vector< std::byte > l_compressed =
+        *compress::huffman( g_input );
+
+    for ( auto _ : _state ) {
+        benchmark::DoNotOptimize( decompress::huffman( l_compressed ) );
+    }
+
+    _state.SetBytesProcessed( static_cast< int64_t >( _state.iterations() *
+                                                      g_input.size() ) );
+    _state.counters[ "ratio" ] =
+        ( static_cast< double >( g_input.size() ) /
+          static_cast< double >( l_compressed.size() ) );
+}
+
+BENCHMARK( decompress$huffman )->Unit( benchmark::kMillisecond );
+
+// Lookup and read of every record by name, argument 0 stores them as views,
+// 1 compresses each one and 2 compresses solid blocks of 64 KiB
+static void archive$read( benchmark::State& _state ) {
+    std::vector< std::string > l_names;
+    std::vector< archive::entry > l_entries;
+
+    l_names.reserve( g_records.size() );
+
+    for ( size_t l_index = 0; l_index < g_records.size(); l_index++ ) {
+        l_names.emplace_back( "records/" + std::to_string( l_index ) );
+        l_entries.emplace_back( l_names.back(), g_records[ l_index ] );
+    }
+
+    const std::vector< std::byte > l_archive = *archive::pack(
+        l_entries,
+        { .method = ( _state.range( 0 ) ? compress::codec::zstd
+                                        : compress::codec::stored ),
+          .solidBlockSize =
+              ( ( _state.range( 0 ) == 2 ) ? ( 64 * 1024 ) : 0 ) } );
+
+    archive::reader l_reader( l_archive );
+    std::vector< std::byte > l_buffer( 2000 );
+
+    for ( auto _ : _state ) {
+        for ( const std::string& _name : l_names ) {
+            if ( _state.range( 0 ) ) {
+                benchmark::DoNotOptimize( l_reader.read( _name, l_buffer ) );
+
+            } else {
+                benchmark::DoNotOptimize( l_reader.view( _name ) );
+            }
+        }
+    }
+
+    _state.SetBytesProcessed( _state.iterations() * recordsSize() );
+}
+
+BENCHMARK( archive$read )->Arg( 0 )->Arg( 1 )->Arg( 2 )->Unit(
+    benchmark::kMillisecond );
+
+namespace {
+
+// 20k files in 100 directories two levels deep, created once
+auto walkTree() -> const std::filesystem::path& {
+    static const std::filesystem::path l_returnValue = []() {
+        const std::filesystem::path l_root =
+            ( std::filesystem::temp_directory_path() / "stdfunc-walk-bench" );
+
+        if ( !std::filesystem::exists( l_root ) ) {
+            for ( size_t l_directory = 0; l_directory < 100; l_directory++ ) {
+                const std::filesystem::path l_path =
+                    ( l_root / std::to_string( l_directory / 10 ) /
+                      std::to_string( l_directory % 10 ) );
+
+                std::filesystem::create_directories( l_path );
+
+                for ( size_t l_file = 0; l_file < 200; l_file++ ) {
+                    std::ofstream( l_path / ( std::to_string( l_file ) +
+                                              ".shader" ) );
+                }
+            }
+        }
+
+        return ( l_root );
+    }();
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+// Argument 0 is std::filesystem::recursive_directory_iterator, others are
+// the worker count of filesystem::getPaths
+static void filesystem$walk( benchmark::State& _state ) {
+    const std::filesystem::path& l_root = walkTree();
+
+    for ( auto _ : _state ) {
+        if ( _state.range( 0 ) ) {
+            benchmark::DoNotOptimize( filesystem::getPaths(
+                l_root.string(),
+                []( std::string_view _name ) -> bool {
+                    return ( _name.ends_with( ".shader" ) );
+                },
+                { .workers = static_cast< size_t >( _state.range( 0 ) ) } ) );
+
+            continue;
+        }
+
+        std::vector< std::filesystem::path > l_paths;
+
+        for ( const auto& _entry :
+              std::filesystem::recursive_directory_iterator( l_root ) ) {
+            if ( _entry.is_regular_file() &&
+                 _entry.path().filename().string().ends_with( ".shader" ) ) {
+                l_paths.emplace_back( _entry.path() );
+            }
+        }
+
+        benchmark::DoNotOptimize( l_paths );
+    }
+}
+
+BENCHMARK( filesystem$walk )
+    ->Arg( 0 )
+    ->Arg( 1 )
+    ->Arg( 4 )
+    ->UseRealTime()
+    ->Unit( benchmark::kMillisecond );
+
+// Argument 0 picks the pattern, suffixes or automaton, argument 1 is
+// std::regex or filesystem::matcher
+static void filesystem$matcher( benchmark::State& _state ) {
+    const std::string l_pattern =
+        ( _state.range( 0 ) ? "texture_[a-z]+_\\d{2,4}\\.(png|dds)"
+                            : ".*\\.(png|jpg|dds)" );
+    std::vector< std::string > l_names;
+
+    for ( size_t l_index = 0; l_index < 4096; l_index++ ) {
+        l_names.emplace_back(
+            "texture_" + std::string( ( 1 + ( l_index % 12 ) ), 'a' ) + "_" +
+            std::to_string( l_index ) +
+            std::array{ ".png", ".dds", ".tga", ".json" }[ l_index % 4 ] );
+    }
+
+    const std::regex l_regexp( l_pattern );
+    const filesystem::matcher l_matcher( l_pattern );
+
+    for ( auto _ : _state ) {
+        size_t l_count = 0;
+
+        for ( const std::string& _name : l_names ) {
+            l_count += ( _state.range( 1 ) ? l_matcher( _name )
+                                           : std::regex_match( _name,
+                                                               l_regexp ) );
+        }
+
+        benchmark::DoNotOptimize( l_count );
+    }
+}
+
+BENCHMARK( filesystem$matcher )
+    ->ArgsProduct( { { 0, 1 }, { 0, 1 } } )
+    ->Unit( benchmark::kMicrosecond );
+
+BENCHMARK_MAIN();
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "stdcompress.hpp"
+#include "stddecompress.hpp"
+
+namespace stdfunc::archive {
+
+// Blocks start at multiples of this, so mapped entries stay page aligned
+constexpr size_t g_defaultAlignment = 4096;
+
+struct parameters {
+    // compress::codec::stored keeps every entry readable without a copy
+    compress::codec method = compress::codec::zstd;
+    size_t level = 3;
+    // Entries smaller than this share solid blocks of up to this size,
+    // compressed as one. 0 compresses every entry on its own
+    size_t solidBlockSize = 0;
+    // Power of two, 1 packs blocks back to back
+    size_t alignment = g_defaultAlignment;
+    // Compression threads, 0 uses every core
+    size_t workers = 0;
+};
+
+struct entry {
+    std::string_view name;
+    std::span< const std::byte > data;
+};
+
+/**
+ * @brief Pack named buffers into one archive.
+ *
+ * Every entry, or every solid block of small entries, is compressed with
+ * `method` and stored as is when that does not shrink it. Blocks start at
+ * multiples of `alignment`, followed by an index of blocks, entries and an
+ * open addressing table of `hash::xxh64` name hashes, checked with CRC-32C.
+ *
+ * @return `std::nullopt` on duplicate names, a codec missing from this build,
+ *         an alignment other than a power of two or a codec failure.
+ */
+[[nodiscard]] auto pack( std::span< const entry > _entries,
+                         const parameters& _parameters = {} )
+    -> std::optional< std::vector< std::byte > >;
+
+// Packs the files ( e.g. from filesystem::getPathsByRegexp ) into an archive
+// at _output. Entries are named by their path relative to _root, by their file
+// name when _root is empty
+[[nodiscard]] auto pack( std::span< const std::filesystem::path > _paths,
+                         const std::filesystem::path& _output,
+                         const parameters& _parameters = {},
+                         const std::filesystem::path& _root = {} ) -> bool;
+
+/**
+ * @brief Read-only archive written by `archive::pack`, looked up by name in
+ *        O(1).
+ *
+ * Opening checks the index once, lookups then probe it in place without
+ * parsing anything per entry. Entries stored uncompressed are views into the
+ * mapping, compressed ones are decompressed on `read`, which keeps the last
+ * solid block for the next entry from it ( so `read` is not thread-safe, the
+ * const members are ). Archives whose compressed blocks would decompress to
+ * more than `_maxSize` are rejected, the index is not trusted to size buffers.
+ *
+ * @example
+ * archive::reader l_shaders( "shaders.pack" );
+ * auto l_source = l_shaders.view( "blur.frag" );
+ */
+struct reader {
+    // Maps the file read-only, reads it into memory where mmap is missing
+    explicit reader( const std::filesystem::path& _path,
+                     size_t _maxSize = decompress::g_defaultMaxDataSize );
+
+    // Archive bytes in memory, they have to outlive the reader
+    explicit reader( std::span< const std::byte > _archive,
+                     size_t _maxSize = decompress::g_defaultMaxDataSize );
+
+    reader( const reader& ) = delete;
+    reader( reader&& _other ) noexcept;
+    ~reader();
+
+    auto operator=( const reader& ) -> reader& = delete;
+    auto operator=( reader&& _other ) noexcept -> reader&;
+
+    // False when the file is missing or the archive is malformed, lookups
+    // find nothing then
+    [[nodiscard]] auto isValid() const -> bool { return ( _isValid ); }
+
+    // Entry count
+    [[nodiscard]] auto size() const -> size_t { return ( _entryCount ); }
+
+    // Name of the entry at _index in packing order
+    [[nodiscard]] auto name( size_t _index ) const -> std::string_view;
+
+    [[nodiscard]] auto contains( std::string_view _name ) const -> bool {
+        return ( _find( _name ).has_value() );
+    }
+
+    // Uncompressed size
+    [[nodiscard]] auto entrySize( std::string_view _name ) const
+        -> std::optional< size_t >;
+
+    // Entry as stored in the archive, std::nullopt when it is missing or
+    // compressed
+    [[nodiscard]] auto view( std::string_view _name ) const
+        -> std::optional< std::span< const std::byte > >;
+
+    [[nodiscard]] auto read( std::string_view _name )
+        -> std::optional< std::vector< std::byte > >;
+
+    // Writes the entry to the front of _buffer, std::nullopt when it is
+    // missing, does not fit or fails to decompress
+    [[nodiscard]] auto read( std::string_view _name,
+                             std::span< std::byte > _buffer )
+        -> std::optional< size_t >;
+
+private:
+    struct block {
+        uint64_t offset;
+        uint64_t storedSize;
+        uint64_t size;
+        compress::codec method;
+    };
+
+    struct location {
+        block container;
+        uint64_t offset;
+        uint64_t size;
+        size_t blockIndex;
+    };
+
+    // Checks the header and the whole index, blocks decompress to at most
+    // _maxSize bytes
+    auto _open( size_t _maxSize ) -> bool;
+
+    [[nodiscard]] auto _find( std::string_view _name ) const
+        -> std::optional< size_t >;
+
+    [[nodiscard]] auto _block( size_t _index ) const -> block;
+
+    [[nodiscard]] auto _locate( std::string_view _name ) const
+        -> std::optional< location >;
+
+    void _close();
+
+    std::span< const std::byte > _data;
+    bool _isMapped = false;
+    // File read into memory where mmap is missing
+    std::vector< std::byte > _contents;
+    std::span< const std::byte > _blocks;
+    std::span< const std::byte > _entries;
+    std::span< const std::byte > _slots;
+    std::span< const std::byte > _names;
+    size_t _entryCount = 0;
+    bool _isValid = false;
+    // Last solid block decompressed by read()
+    size_t _cachedBlock = std::numeric_limits< size_t >::max();
+    std::vector< std::byte > _cache;
+};
+
+} // namespace stdfunc::archive
@@ -1,12 +1,27 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <iosfwd>
 #include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include "stdasync.hpp"
+#include "stdconcepts.hpp"
+#include "stdentropy.hpp"
+#include "stdfunc.hpp"
+
+// Opaque ZSTD_CCtx and ZSTD_CDict, keep zstd.h out of this header
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
+
 namespace stdfunc::compress {
 
 /**
@@ -46,6 +61,44 @@ namespace stdfunc::compress {
 [[nodiscard]] auto text( std::string_view _text, size_t _level = 1 )
     -> std::optional< std::string >;
 
+/**
+ * @brief Compress large text on several threads into the **Snappy** framing
+ *        format, the same output `compress::textStream` writes.
+ *
+ * The input is split into 64KiB blocks that compress independently, so
+ * throughput scales with `_workers` ( 0 uses every core ). Decompress with
+ * `decompress::framedText`, `decompress::textStream` or any framed Snappy
+ * tool; `decompress::text` only reads the raw format.
+ *
+ * @return `std::nullopt` on empty input or failure.
+ */
+[[nodiscard]] auto framedText( std::string_view _text,
+                               size_t _workers = 0,
+                               size_t _level = 1 )
+    -> std::optional< std::string >;
+
+// Worst-case compress::text output size for _size input bytes
+[[nodiscard]] auto textBound( size_t _size ) -> size_t;
+
+/**
+ * @brief Compress text into caller-owned memory without intermediate copies.
+ *
+ * @param _buffer Must hold at least `textBound( _text.size() )` bytes, smaller
+ *                buffers fail.
+ *
+ * @return Compressed size written to the front of `_buffer`, `std::nullopt`
+ *         on failure.
+ */
+[[nodiscard]] auto text( std::string_view _text,
+                         std::span< char > _buffer,
+                         size_t _level = 1 ) -> std::optional< size_t >;
+
+// Appends the compressed frame to _output, returns the appended size. On
+// failure _output keeps its previous contents
+[[nodiscard]] auto text( std::string_view _text,
+                         std::string& _output,
+                         size_t _level = 1 ) -> std::optional< size_t >;
+
 /**
  * @brief Compress arbitrary binary data.
  *
@@ -72,10 +125,9 @@ namespace stdfunc::compress {
  *         - `std::nullopt` on failure (invalid arguments, compression error,
  *           or underlying library failure).
  *
- * @threadsafe Thread-safe to call concurrently unless the implementation uses
- *            a shared mutable compressor context (it typically won't). If you
- *            plan high-concurrency workloads, benchmark and consider per-thread
- *            contexts or streaming APIs.
+ * @threadsafe Thread-safe to call concurrently. Every thread reuses its own
+ *            cached compression context, so repeated calls do not allocate
+ *            compressor state.
  *
  * @complexity Time: roughly linear in `_data.size()` with constants depending
  *             on `_level`. Memory: allocates output buffer of size proportional
@@ -90,4 +142,1016 @@ namespace stdfunc::compress {
 [[nodiscard]] auto data( std::span< const std::byte > _data, size_t _level = 3 )
     -> std::optional< std::vector< std::byte > >;
 
+/**
+ * @brief Advanced binary compression parameters (current implementation:
+ *        **Zstandard (zstd)**).
+ *
+ * Any combination produces a standard frame that `decompress::data` and the
+ * `zstd` tool read.
+ */
+struct parameters {
+    size_t level = 3;
+    // Compression threads besides the caller, 0 compresses on the calling
+    // thread. Ignored when libzstd lacks multithreading
+    size_t workers = 0;
+    // Input bytes per worker job, 0 lets zstd pick ( 4 windows )
+    size_t jobSize = 0;
+    // Finds matches far back in large inputs, best with a large window
+    bool longDistanceMatching = false;
+    // log2 of the match window, 0 keeps the level default. Windows above
+    // 2^27 need the same window limit on the decompressing side
+    size_t windowLog = 0;
+};
+
+// Compress with advanced parameters, e.g. multi-threaded for large buffers
+[[nodiscard]] auto data( std::span< const std::byte > _data,
+                         const parameters& _parameters )
+    -> std::optional< std::vector< std::byte > >;
+
+// Worst-case compress::data output size for _size input bytes
+[[nodiscard]] auto dataBound( size_t _size ) -> size_t;
+
+/**
+ * @brief Compress data into caller-owned memory ( e.g. a pooled network
+ *        buffer ) without intermediate copies.
+ *
+ * @param _buffer Destination, `dataBound( _data.size() )` bytes always
+ *                suffice. Smaller buffers work as long as the frame fits.
+ *
+ * @return Compressed size written to the front of `_buffer`, `std::nullopt`
+ *         on failure ( including a too small buffer ).
+ */
+[[nodiscard]] auto data( std::span< const std::byte > _data,
+                         std::span< std::byte > _buffer,
+                         size_t _level = 3 ) -> std::optional< size_t >;
+
+// Appends the compressed frame to _output, returns the appended size. On
+// failure _output keeps its previous contents
+[[nodiscard]] auto data( std::span< const std::byte > _data,
+                         std::vector< std::byte >& _output,
+                         size_t _level = 3 ) -> std::optional< size_t >;
+
+/**
+ * @brief Compress scattered fragments ( e.g. a header and several body
+ *        pieces ) as one frame, without concatenating them first.
+ *
+ * The frame is byte for byte the one `compress::data` makes from the
+ * concatenation. Up to 512 KiB in total the fragments stream through the
+ * per-thread context with the total pledged up front, larger inputs of more
+ * than one fragment are gathered once, as past the match window zstd only
+ * reproduces its one-shot frames from contiguous input.
+ *
+ * @param _buffer Destination, `dataBound` of the total size always suffices.
+ *
+ * @return Compressed size written to the front of `_buffer`, `std::nullopt`
+ *         on failure ( including a too small buffer or no input at all ).
+ */
+[[nodiscard]] auto data(
+    std::span< const std::span< const std::byte > > _fragments,
+    std::span< std::byte > _buffer,
+    size_t _level = 3 ) -> std::optional< size_t >;
+
+// Appends the frame of the fragments to _output, as the contiguous overload
+[[nodiscard]] auto data(
+    std::span< const std::span< const std::byte > > _fragments,
+    std::vector< std::byte >& _output,
+    size_t _level = 3 ) -> std::optional< size_t >;
+
+[[nodiscard]] auto data(
+    std::span< const std::span< const std::byte > > _fragments,
+    size_t _level = 3 ) -> std::optional< std::vector< std::byte > >;
+
+/**
+ * @brief Compress on a worker pool, so the thread that has the data ( e.g. an
+ *        I/O thread ) is free until the frame is ready.
+ *
+ * `co_await compress::async( l_data )` continues the coroutine on the worker
+ * that compressed it, `async::wait` blocks for it instead. Nothing starts
+ * before either, and `_data` must stay alive until the task completes.
+ *
+ * @return Task producing what `compress::data( _data, _level )` returns.
+ */
+[[nodiscard]] auto async( std::span< const std::byte > _data,
+                          size_t _level = 3,
+                          async::pool& _pool = async::defaultPool() )
+    -> async::task< std::optional< std::vector< std::byte > > >;
+
+// Dictionary size the zstd command line tool trains by default
+constexpr size_t g_defaultDictionaryCapacity = ( 110 * 1024 );
+
+/**
+ * @brief Train a dictionary for small messages (current implementation:
+ *        **Zstandard (zstd)** `ZDICT_trainFromBuffer`).
+ *
+ * Small payloads ( a few hundred bytes to a few KiB, e.g. JSON or protobuf
+ * messages ) share little history within themselves, a dictionary trained on
+ * typical samples supplies it. Training wants roughly a hundred times more
+ * sample bytes than `_capacity`.
+ *
+ * @return Dictionary content for `compress::dictionary` and
+ *         `decompress::dictionary`, `std::nullopt` when training fails ( e.g.
+ *         too few or too uniform samples ).
+ */
+[[nodiscard]] auto trainDictionary(
+    std::span< const std::span< const std::byte > > _samples,
+    size_t _capacity = g_defaultDictionaryCapacity )
+    -> std::optional< std::vector< std::byte > >;
+
+/**
+ * @brief Dictionary digested once for a compression level (current
+ *        implementation: **Zstandard (zstd)** `ZSTD_CDict`), shared by any
+ *        number of calls and threads.
+ *
+ * Frames record the dictionary ID, `decompress::data` with a
+ * `decompress::dictionary` built from the same content verifies it.
+ *
+ * @example
+ * compress::dictionary l_dictionary( *compress::trainDictionary( samples ) );
+ * auto l_compressed = compress::data( message, l_dictionary );
+ */
+struct dictionary {
+    explicit dictionary( std::span< const std::byte > _content,
+                         size_t _level = 3 );
+
+    dictionary( const dictionary& ) = delete;
+    dictionary( dictionary&& _other ) noexcept;
+    ~dictionary();
+
+    auto operator=( const dictionary& ) -> dictionary& = delete;
+    auto operator=( dictionary&& _other ) noexcept -> dictionary&;
+
+    // 0 for raw content without a dictionary header, or when the content
+    // could not be digested
+    [[nodiscard]] auto id() const -> uint32_t;
+
+private:
+    friend struct context;
+
+    friend auto data( std::span< const std::byte > _data,
+                      std::span< std::byte > _buffer,
+                      const dictionary& _dictionary )
+        -> std::optional< size_t >;
+
+    ZSTD_CDict_s* _dictionary = nullptr;
+};
+
+// Compress with a dictionary at the level it was digested for, into
+// caller-owned memory. Same buffer rules as the overload without one
+[[nodiscard]] auto data( std::span< const std::byte > _data,
+                         std::span< std::byte > _buffer,
+                         const dictionary& _dictionary )
+    -> std::optional< size_t >;
+
+// Appends the compressed frame to _output, returns the appended size. On
+// failure _output keeps its previous contents
+[[nodiscard]] auto data( std::span< const std::byte > _data,
+                         std::vector< std::byte >& _output,
+                         const dictionary& _dictionary )
+    -> std::optional< size_t >;
+
+[[nodiscard]] auto data( std::span< const std::byte > _data,
+                         const dictionary& _dictionary )
+    -> std::optional< std::vector< std::byte > >;
+
+/**
+ * @brief Reusable binary compression context (current implementation:
+ *        **Zstandard (zstd)** `ZSTD_CCtx`).
+ *
+ * Parameters are applied once at construction and the compressor state is
+ * kept across calls, which removes the per-call context allocation of
+ * `compress::data` for callers that manage their own contexts.
+ *
+ * @threadsafe Not thread-safe: use one context per thread.
+ *
+ * @example
+ * compress::context l_context( 19 );
+ * for ( const auto& _message : messages ) {
+ *     auto l_compressed = l_context.data( _message );
+ * }
+ */
+struct context {
+    explicit context( size_t _level = 3 );
+    explicit context( const parameters& _parameters );
+
+    context( const context& ) = delete;
+    context( context&& _other ) noexcept;
+    ~context();
+
+    auto operator=( const context& ) -> context& = delete;
+    auto operator=( context&& _other ) noexcept -> context&;
+
+    [[nodiscard]] auto level() const -> size_t { return ( _level ); }
+
+    // Same frame as compress::data at level()
+    [[nodiscard]] auto data( std::span< const std::byte > _data )
+        -> std::optional< std::vector< std::byte > >;
+
+    // Same as the compress::data buffer overload
+    [[nodiscard]] auto data( std::span< const std::byte > _data,
+                             std::span< std::byte > _buffer )
+        -> std::optional< size_t >;
+
+    // Same as the compress::data appending overload
+    [[nodiscard]] auto data( std::span< const std::byte > _data,
+                             std::vector< std::byte >& _output )
+        -> std::optional< size_t >;
+
+    // Same as the compress::data dictionary overloads, the level comes from
+    // the dictionary
+    [[nodiscard]] auto data( std::span< const std::byte > _data,
+                             const dictionary& _dictionary )
+        -> std::optional< std::vector< std::byte > >;
+
+    [[nodiscard]] auto data( std::span< const std::byte > _data,
+                             std::span< std::byte > _buffer,
+                             const dictionary& _dictionary )
+        -> std::optional< size_t >;
+
+    [[nodiscard]] auto data( std::span< const std::byte > _data,
+                             std::vector< std::byte >& _output,
+                             const dictionary& _dictionary )
+        -> std::optional< size_t >;
+
+private:
+    ZSTD_CCtx_s* _context = nullptr;
+    size_t _level;
+};
+
+/**
+ * @brief Buffers stored back to back in a single allocation.
+ */
+struct arena {
+    std::vector< std::byte > data;
+    // Buffer i spans [ offsets[ i ], offsets[ i + 1 ] ) of data
+    std::vector< size_t > offsets{ 0 };
+
+    [[nodiscard]] auto size() const -> size_t {
+        return ( offsets.size() - 1 );
+    }
+
+    [[nodiscard]] auto operator[]( size_t _index ) const
+        -> std::span< const std::byte > {
+        return ( std::span( data ).subspan(
+            offsets[ _index ],
+            ( offsets[ _index + 1 ] - offsets[ _index ] ) ) );
+    }
+};
+
+/**
+ * @brief Compress many small buffers at once into one arena of
+ *        `compress::data` frames.
+ *
+ * Buffers are spread over up to `_workers` threads ( 0 uses every core ),
+ * each reusing its own compression context, and compress straight into a
+ * single preallocated region that is then packed in order. Empty buffers
+ * become empty frames.
+ *
+ * @return Frame i is `arena[ i ]`, `std::nullopt` when any buffer fails.
+ *
+ * @example
+ * auto l_frames = compress::batch( l_records );
+ * store( l_frames->data, l_frames->offsets );
+ */
+[[nodiscard]] auto batch(
+    std::span< const std::span< const std::byte > > _buffers,
+    size_t _level = 3,
+    size_t _workers = 0 ) -> std::optional< arena >;
+
+// Same with a dictionary, the usual companion of small buffers
+[[nodiscard]] auto batch(
+    std::span< const std::span< const std::byte > > _buffers,
+    const dictionary& _dictionary,
+    size_t _workers = 0 ) -> std::optional< arena >;
+
+// Highest compress::lz level, higher ones are clamped
+constexpr size_t g_lzMaxLevel = 9;
+
+// Worst-case compress::lz output size for _size input bytes
+[[nodiscard]] auto lzBound( size_t _size ) -> size_t;
+
+/**
+ * @brief Compress with the built-in LZ77 codec, available without Snappy or
+ *        zstd.
+ *
+ * Output is the LZ4 block format behind a LEB128 size prefix. Level 1 keeps a
+ * single hash table entry per position and skips ahead faster through data
+ * without matches, in the speed class of Snappy. Every further level doubles
+ * the hash chain depth searched for a longer match, up to 256 candidates at
+ * `g_lzMaxLevel`. Decompress with `decompress::lz`.
+ *
+ * @param _buffer Must hold at least `lzBound( _data.size() )` bytes, smaller
+ *                buffers fail.
+ *
+ * @return Compressed size written to the front of `_buffer`, `std::nullopt`
+ *         on failure or input over 2GiB.
+ */
+[[nodiscard]] auto lz( std::span< const std::byte > _data,
+                       std::span< std::byte > _buffer,
+                       size_t _level = 1 ) -> std::optional< size_t >;
+
+// Appends the compressed block to _output, returns the appended size. On
+// failure _output keeps its previous contents
+[[nodiscard]] auto lz( std::span< const std::byte > _data,
+                       std::vector< std::byte >& _output,
+                       size_t _level = 1 ) -> std::optional< size_t >;
+
+[[nodiscard]] auto lz( std::span< const std::byte > _data, size_t _level = 1 )
+    -> std::optional< std::vector< std::byte > >;
+
+namespace {
+
+constexpr size_t g_embedHashLog = 12;
+
+// Compile-time compress::lz encoder, greedy with one hash entry per position.
+// Writes to _output unless it is nullptr, returns the compressed size
+template < typename T, size_t N >
+constexpr auto _lzEncode( const std::array< T, N >& _data, std::byte* _output )
+    -> size_t {
+    size_t l_size = 0;
+
+    auto l_put = [ & ]( size_t _value ) -> void {
+        if ( _output ) {
+            _output[ l_size ] = std::byte( static_cast< uint8_t >( _value ) );
+        }
+
+        l_size++;
+    };
+
+    auto l_putLength = [ & ]( size_t _length ) -> void {
+        for ( ; _length >= 0xFF; _length -= 0xFF ) {
+            l_put( 0xFF );
+        }
+
+        l_put( _length );
+    };
+
+    auto l_at = [ & ]( size_t _index ) -> uint32_t {
+        return ( static_cast< uint8_t >( _data[ _index ] ) );
+    };
+
+    auto l_load = [ & ]( size_t _index ) -> uint32_t {
+        return ( l_at( _index ) | ( l_at( _index + 1 ) << 8 ) |
+                 ( l_at( _index + 2 ) << 16 ) | ( l_at( _index + 3 ) << 24 ) );
+    };
+
+    // Literals [ _anchor, _position ), then a match unless _length is 0
+    auto l_emit = [ & ]( size_t _anchor, size_t _position, size_t _offset,
+                         size_t _length ) -> void {
+        const size_t l_literals = ( _position - _anchor );
+        const size_t l_extra = ( _length ? ( _length - 4 ) : 0 );
+
+        l_put( ( std::min< size_t >( l_literals, 15 ) << 4 ) |
+               std::min< size_t >( l_extra, 15 ) );
+
+        if ( l_literals >= 15 ) {
+            l_putLength( l_literals - 15 );
+        }
+
+        for ( size_t l_index = _anchor; l_index < _position; l_index++ ) {
+            l_put( l_at( l_index ) );
+        }
+
+        if ( _length ) {
+            l_put( _offset );
+            l_put( _offset >> 8 );
+
+            if ( l_extra >= 15 ) {
+                l_putLength( l_extra - 15 );
+            }
+        }
+    };
+
+    size_t l_prefix = N;
+
+    for ( ; l_prefix >= 0x80; l_prefix >>= 7 ) {
+        l_put( ( l_prefix & 0x7F ) | 0x80 );
+    }
+
+    l_put( l_prefix );
+
+    size_t l_anchor = 0;
+
+    // The last match starts 12 bytes and ends 5 bytes before the end
+    if constexpr ( N > 12 ) {
+        std::array< uint32_t, ( size_t{ 1 } << g_embedHashLog ) > l_heads{};
+
+        size_t l_position = 0;
+
+        while ( l_position <= ( N - 12 ) ) {
+            const uint32_t l_bytes = l_load( l_position );
+            uint32_t& l_head =
+                l_heads[ ( l_bytes * 2654435761U ) >> ( 32 - g_embedHashLog ) ];
+            const size_t l_candidate = l_head;
+
+            l_head = static_cast< uint32_t >( l_position );
+
+            if ( ( l_candidate < l_position ) &&
+                 ( ( l_position - l_candidate ) <= 0xFFFF ) &&
+                 ( l_load( l_candidate ) == l_bytes ) ) {
+                size_t l_length = 4;
+
+                while ( ( ( l_position + l_length ) < ( N - 5 ) ) &&
+                        ( l_at( l_candidate + l_length ) ==
+                          l_at( l_position + l_length ) ) ) {
+                    l_length++;
+                }
+
+                l_emit( l_anchor, l_position, ( l_position - l_candidate ),
+                        l_length );
+
+                l_position += l_length;
+                l_anchor = l_position;
+
+            } else {
+                l_position++;
+            }
+        }
+    }
+
+    l_emit( l_anchor, N, 0, 0 );
+
+    return ( l_size );
+}
+
+} // namespace
+
+/**
+ * @brief Compress `_data` at compile time into a `compress::lz` block sized
+ *        exactly, so binaries ship the compressed bytes only.
+ *
+ * Takes any array of byte-sized elements: `"..."_bytes` literals, or files
+ * embedded with `std::to_array< unsigned char >( { #embed "file" } )`.
+ * Decompress with `decompress::lz` or lazily with `decompress::asset`. Large
+ * assets may need a higher `-fconstexpr-loop-limit` ( GCC ) or
+ * `-fconstexpr-steps` ( Clang ).
+ *
+ * @example
+ * constexpr auto g_shader = compress::embed< "void main() {}"_bytes >();
+ */
+template < std::array _data >
+    requires( sizeof( typename decltype( _data )::value_type ) == 1 )
+[[nodiscard]] consteval auto embed() {
+    std::array< std::byte, _lzEncode( _data, nullptr ) > l_returnValue{};
+
+    _lzEncode( _data, l_returnValue.data() );
+
+    return ( l_returnValue );
+}
+
+// Order-0 Shannon entropy in bits per byte: 0 for a single repeated byte up
+// to 8 for random or already compressed data
+[[nodiscard]] auto entropy( std::span< const std::byte > _data ) -> double;
+
+// Codec recorded in the compress::adaptive header
+enum class codec : uint8_t { stored = 0, snappy = 1, zstd = 2, lz = 3 };
+
+// What compress::adaptive optimizes once data is worth compressing
+enum class preference : uint8_t { speed, balanced, ratio };
+
+struct adaptiveParameters {
+    preference target = preference::balanced;
+    // Fraction the trial compression has to save, data saving less is stored
+    double minimumSavings = 0.05;
+};
+
+struct selection {
+    codec method = codec::stored;
+    size_t level = 0;
+};
+
+/**
+ * @brief Pick a codec and level for `_data` from a sample of it.
+ *
+ * Up to four 16KiB blocks spread over the input are probed. Their byte
+ * entropy flags random or already compressed data ( media, archives ), which
+ * then only gets a single block of trial compression to confirm. Otherwise
+ * all blocks are trial compressed with the fastest settings of zstd and of
+ * the fast codec, Snappy or the built-in `compress::lz` without it. Data
+ * saving less than `minimumSavings` is stored, the rest goes to the fast
+ * codec or a zstd level according to `target`. The fast codec wins
+ * `balanced` while its output stays within 10% of zstd. Without zstd,
+ * `ratio` uses `compress::lz` at `g_lzMaxLevel`.
+ */
+[[nodiscard]] auto probe( std::span< const std::byte > _data,
+                          const adaptiveParameters& _parameters = {} )
+    -> selection;
+
+/**
+ * @brief Compress with the codec `compress::probe` picks, recorded in a one
+ *        byte header. Incompressible data costs a sample probe and a copy
+ *        instead of a full compression pass.
+ *
+ * Decompress with `decompress::adaptive`. Empty input is stored.
+ *
+ * @return `std::nullopt` on failure.
+ */
+[[nodiscard]] auto adaptive( std::span< const std::byte > _data,
+                             const adaptiveParameters& _parameters = {} )
+    -> std::optional< std::vector< std::byte > >;
+
+// Plaintext bytes per block of compress::checked
+constexpr size_t g_defaultCheckedBlockSize = ( 256 * 1024 );
+
+struct checkedParameters {
+    codec method = codec::lz;
+    size_t level = 1;
+    // Up to 4GiB, small enough to stay in cache while verified
+    size_t blockSize = g_defaultCheckedBlockSize;
+    // 0 uses every core
+    size_t workers = 0;
+};
+
+/**
+ * @brief Compress into blocks that each carry the CRC-32C of their
+ *        plaintext, so decompression verifies integrity as it goes.
+ *
+ * Blocks compress independently on up to `workers` threads with `method`,
+ * those that do not shrink are stored. Decompress with
+ * `decompress::checked`, which tells corruption apart from other failures.
+ *
+ * @return `std::nullopt` when the codec is not available, the block size is
+ *         out of range or compression fails.
+ */
+[[nodiscard]] auto checked( std::span< const std::byte > _data,
+                            const checkedParameters& _parameters = {} )
+    -> std::optional< std::vector< std::byte > >;
+
+// Transform compress::array applies to the elements before the codec sees
+// them, recorded in its header
+enum class filter : uint8_t {
+    none,
+    // Byte planes: the first byte of every element, then the second ...
+    shuffle,
+    // Bit planes of every byte plane, for values using few of their bits
+    bitShuffle,
+    // Wrapping difference to the previous element, then shuffle. For counters
+    // and timestamps
+    delta,
+    // XOR with the previous element, then shuffle. For slowly changing floats
+    xorDelta,
+    // Gorilla encoding of 4 or 8 byte floats: leading and trailing zeros of
+    // the XOR with the previous value
+    gorilla,
+};
+
+struct arrayParameters {
+    filter transform = filter::shuffle;
+    codec method = codec::zstd;
+    size_t level = 3;
+};
+
+/**
+ * @brief Compress an array of `_elementSize` byte numbers, filtered first so
+ *        their bytes compress like the values they hold instead of like
+ *        interleaved noise.
+ *
+ * Elements are 1, 2, 4, 8 or 16 bytes. Filtered data that `method` does not
+ * shrink is stored. Decompress with `decompress::array`.
+ *
+ * @return `std::nullopt` on an unsupported element size, a partial element,
+ *         `gorilla` on other than 4 or 8 byte elements, an unavailable codec
+ *         or failure.
+ */
+[[nodiscard]] auto array( std::span< const std::byte > _data,
+                          size_t _elementSize,
+                          const arrayParameters& _parameters = {} )
+    -> std::optional< std::vector< std::byte > >;
+
+/**
+ * @brief Typed `compress::array`.
+ *
+ * @example
+ * std::vector< float > l_samples = readSensor();
+ * auto l_compressed = compress::array< float >(
+ *     l_samples, { .transform = compress::filter::xorDelta } );
+ */
+template < typename T >
+    requires( std::is_trivially_copyable_v< T > &&
+              std::has_single_bit( sizeof( T ) ) && ( sizeof( T ) <= 16 ) )
+[[nodiscard]] auto array( std::span< const T > _data,
+                          const arrayParameters& _parameters = {} )
+    -> std::optional< std::vector< std::byte > > {
+    return ( array( std::as_bytes( _data ), sizeof( T ), _parameters ) );
+}
+
+// Integers per full compress::packed block, 32 per 32 bit lane of a 128 bit
+// vector
+constexpr size_t g_packedBlockSize = 128;
+// Bit width and frame of reference ahead of every compress::packed block
+constexpr size_t g_packedHeaderSize = ( 1 + sizeof( uint32_t ) );
+
+// Interleaves signs so small magnitudes stay small: 0, -1, 1, -2 become
+// 0, 1, 2, 3
+[[nodiscard]] constexpr auto zigzag( int32_t _value ) -> uint32_t {
+    return ( ( static_cast< uint32_t >( _value ) << 1 ) ^
+             static_cast< uint32_t >( _value >> 31 ) );
+}
+
+// Replaces every value in place with its wrapping difference to the previous
+// one, the first with its difference to _previous, so sorted sequences
+// become small gaps. Undo with decompress::delta
+void delta( std::span< uint32_t > _values, uint32_t _previous = 0 );
+
+// Worst-case compress::packed output size for _count integers
+[[nodiscard]] constexpr auto packedBound( size_t _count ) -> size_t {
+    const size_t l_tail = ( _count % g_packedBlockSize );
+
+    return ( ( ( _count / g_packedBlockSize ) *
+               ( g_packedHeaderSize +
+                 bitsToBytes( g_packedBlockSize * 32 ) ) ) +
+             ( l_tail ? ( g_packedHeaderSize + bitsToBytes( l_tail * 32 ) )
+                      : 0 ) );
+}
+
+/**
+ * @brief Frame-of-reference bit packing of integers into caller-owned
+ *        memory.
+ *
+ * Every block of 128 integers stores its minimum and the bit width of its
+ * largest difference to it, then the differences at that width. Full blocks
+ * interleave them over four 32 bit lanes so SSE2 packs and unpacks four at a
+ * time, the last partial block is packed in order. The count is not stored,
+ * size the output of `decompress::packed` to it.
+ *
+ * @return Bytes written, `std::nullopt` when `_buffer` is too small.
+ */
+[[nodiscard]] auto packed( std::span< const uint32_t > _values,
+                           std::span< std::byte > _buffer )
+    -> std::optional< size_t >;
+
+// Worst-case compress::streamVByte output size for _count integers
+[[nodiscard]] constexpr auto streamVByteBound( size_t _count ) -> size_t {
+    return ( bitsToBytes( _count * 2 ) + ( _count * sizeof( uint32_t ) ) );
+}
+
+/**
+ * @brief Stream VByte encoding of integers into caller-owned memory.
+ *
+ * The 2 bit byte lengths of all integers come first, four per control byte,
+ * then the 1 to 4 little endian bytes of each, so a decoder expands four
+ * integers with a single shuffle. The count is not stored, size the output
+ * of `decompress::streamVByte` to it.
+ *
+ * @return Bytes written, `std::nullopt` when `_buffer` is too small.
+ */
+[[nodiscard]] auto streamVByte( std::span< const uint32_t > _values,
+                                std::span< std::byte > _buffer )
+    -> std::optional< size_t >;
+
+/**
+ * @brief Encoding tables of an order-0 `entropy::distribution` for
+ *        `compress::ans` and `compress::huffman`, built once and shared by any
+ *        number of calls and threads.
+ *
+ * Inputs coded with a table carry no model, `decompress::entropyTable` built
+ * from the same distribution decodes them. Symbols the distribution gives no
+ * frequency cannot be coded.
+ *
+ * @example
+ * auto l_model = entropy::normalize( entropy::histogram( sample ) );
+ * compress::entropyTable l_table( *l_model );
+ * auto l_compressed = compress::ans( message, l_table );
+ */
+struct entropyTable {
+    explicit entropyTable( const entropy::distribution& _distribution );
+
+    // 0 when the distribution is not valid and nothing can be coded
+    [[nodiscard]] auto tableLog() const -> size_t;
+
+private:
+    friend auto ans( std::span< const std::byte > _data,
+                     const entropyTable& _table )
+        -> std::optional< std::vector< std::byte > >;
+
+    friend auto huffman( std::span< const std::byte > _data,
+                         const entropyTable& _table )
+        -> std::optional< std::vector< std::byte > >;
+
+    size_t _tableLog = 0;
+    std::array< uint16_t, 256 > _frequencies{};
+    // Next state of every symbol's frequency range, in symbol order
+    std::vector< uint16_t > _states;
+    // Per symbol offset into _states and bias for the bits to flush
+    std::array< int32_t, 256 > _deltaFindState{};
+    std::array< uint32_t, 256 > _deltaNbBits{};
+    // Bit reversed canonical Huffman codes and their lengths
+    std::array< uint16_t, 256 > _codes{};
+    std::array< uint8_t, 256 > _lengths{};
+};
+
+/**
+ * @brief Order-0 tANS ( FSE ) coding of bytes with a prebuilt table.
+ *
+ * Two interleaved states halve the dependency chain of the decoder. Output is
+ * the LEB128 size, then the bit stream, decode with `decompress::ans`.
+ *
+ * @return `std::nullopt` for an invalid table or a symbol it cannot code.
+ */
+[[nodiscard]] auto ans( std::span< const std::byte > _data,
+                        const entropyTable& _table )
+    -> std::optional< std::vector< std::byte > >;
+
+// Self-described tANS: the normalized distribution of _data is serialized
+// ahead of the bit stream
+[[nodiscard]] auto ans( std::span< const std::byte > _data,
+                        size_t _tableLog = entropy::g_defaultTableLog )
+    -> std::optional< std::vector< std::byte > >;
+
+/**
+ * @brief Canonical Huffman coding of bytes with a prebuilt table, codes of
+ *        at most `entropy::g_maxCodeLength` bits.
+ *
+ * The input is split into four quarters coded as separate streams, so the
+ * decoder runs four independent lookups per iteration. Output is the LEB128
+ * size, the sizes of the first three streams, then the streams. Decode with
+ * `decompress::huffman`.
+ *
+ * @return `std::nullopt` for an invalid table or a symbol it cannot code.
+ */
+[[nodiscard]] auto huffman( std::span< const std::byte > _data,
+                            const entropyTable& _table )
+    -> std::optional< std::vector< std::byte > >;
+
+// Self-described Huffman: the normalized distribution of _data is serialized
+// ahead of the streams
+[[nodiscard]] auto huffman( std::span< const std::byte > _data,
+                            size_t _tableLog = entropy::g_defaultTableLog )
+    -> std::optional< std::vector< std::byte > >;
+
+namespace {
+
+// Hands the bytes _step wrote into the front of _buffer to _sink
+template < typename Sink >
+auto _flush( std::span< const std::byte > _buffer,
+             std::span< std::byte > _rest,
+             Sink& _sink ) -> bool {
+    const size_t l_size = ( _buffer.size() - _rest.size() );
+
+    return ( !l_size || _sink( _buffer.first( l_size ) ) );
+}
+
+template < typename Stream, typename Sink >
+auto _write( Stream& _stream,
+             std::span< std::byte > _buffer,
+             std::span< const std::byte > _input,
+             Sink& _sink ) -> bool {
+    bool l_returnValue = true;
+
+    while ( l_returnValue && !_input.empty() ) {
+        std::span< std::byte > l_output = _buffer;
+
+        l_returnValue = ( _stream.update( _input, l_output ) &&
+                          _flush( _buffer, l_output, _sink ) );
+    }
+
+    return ( l_returnValue );
+}
+
+template < typename Stream, typename Sink >
+auto _finish( Stream& _stream, std::span< std::byte > _buffer, Sink& _sink )
+    -> bool {
+    std::optional< bool > l_isFinished = false;
+
+    while ( l_isFinished && !*l_isFinished ) {
+        std::span< std::byte > l_output = _buffer;
+
+        l_isFinished = _stream.finish( l_output );
+
+        if ( l_isFinished && !_flush( _buffer, l_output, _sink ) ) {
+            l_isFinished = std::nullopt;
+        }
+    }
+
+    return ( l_isFinished.has_value() );
+}
+
+} // namespace
+
+/**
+ * @brief Streaming binary compressor (current implementation: **Zstandard
+ *        (zstd)** `ZSTD_compressStream2`), one frame of unbounded size in
+ *        constant memory.
+ *
+ * Pull: `update()` and `finish()` move bytes between caller spans and advance
+ * them. Push: `write()` and `finish( sink )` hand every produced chunk to
+ * `_sink( std::span< const std::byte > ) -> bool` from a fixed internal
+ * buffer, a `false` from the sink aborts. The frame decompresses with
+ * `decompress::data` as well as with `decompress::dataStream`.
+ *
+ * @threadsafe Not thread-safe: use one stream per thread.
+ *
+ * @example
+ * compress::dataStream l_stream;
+ * auto l_sink = [ & ]( std::span< const std::byte > _chunk ) -> bool {
+ *     return ( socket.send( _chunk ) );
+ * };
+ * for ( const auto& _block : blocks ) {
+ *     l_stream.write( _block, l_sink );
+ * }
+ * l_stream.finish( l_sink );
+ */
+struct dataStream {
+    explicit dataStream( size_t _level = 3 );
+
+    dataStream( const dataStream& ) = delete;
+    dataStream( dataStream&& _other ) noexcept;
+    ~dataStream();
+
+    auto operator=( const dataStream& ) -> dataStream& = delete;
+    auto operator=( dataStream&& _other ) noexcept -> dataStream&;
+
+    // Consumes _input until it is empty or _output is full. Input may stay
+    // buffered inside until finish(). False on failure
+    [[nodiscard]] auto update( std::span< const std::byte >& _input,
+                               std::span< std::byte >& _output ) -> bool;
+
+    // Ends the frame: true once everything is written, false when _output
+    // filled up first ( call again ), std::nullopt on failure. The stream
+    // starts a new frame afterwards
+    [[nodiscard]] auto finish( std::span< std::byte >& _output )
+        -> std::optional< bool >;
+
+    template < typename Sink >
+        requires is_lambda< Sink, bool, std::span< const std::byte > >
+    [[nodiscard]] auto write( std::span< const std::byte > _input,
+                              Sink&& _sink ) -> bool {
+        return ( _write( *this, _buffer, _input, _sink ) );
+    }
+
+    template < typename Sink >
+        requires is_lambda< Sink, bool, std::span< const std::byte > >
+    [[nodiscard]] auto finish( Sink&& _sink ) -> bool {
+        return ( _finish( *this, _buffer, _sink ) );
+    }
+
+private:
+    ZSTD_CCtx_s* _context = nullptr;
+    std::vector< std::byte > _buffer;
+};
+
+/**
+ * @brief Streaming text compressor producing the **Snappy** framing format
+ *        ( stream identifier, then chunks of up to 64KiB of input with a
+ *        masked CRC-32C each ), compatible with other framed Snappy tools.
+ *
+ * Same pull and push interface as `compress::dataStream`. Memory is bounded
+ * by one 64KiB block and its compressed chunk.
+ *
+ * @threadsafe Not thread-safe: use one stream per thread.
+ */
+struct textStream {
+    explicit textStream( size_t _level = 1 );
+
+    [[nodiscard]] auto update( std::span< const std::byte >& _input,
+                               std::span< std::byte >& _output ) -> bool;
+
+    [[nodiscard]] auto finish( std::span< std::byte >& _output )
+        -> std::optional< bool >;
+
+    template < typename Sink >
+        requires is_lambda< Sink, bool, std::span< const std::byte > >
+    [[nodiscard]] auto write( std::span< const std::byte > _input,
+                              Sink&& _sink ) -> bool {
+        return ( _write( *this, _buffer, _input, _sink ) );
+    }
+
+    template < typename Sink >
+        requires is_lambda< Sink, bool, std::span< const std::byte > >
+    [[nodiscard]] auto finish( Sink&& _sink ) -> bool {
+        return ( _finish( *this, _buffer, _sink ) );
+    }
+
+private:
+    void _compressBlock();
+
+    // Moves pending chunk bytes into _output, true once all are out
+    auto _drain( std::span< std::byte >& _output ) -> bool;
+
+    size_t _level;
+    // Uncompressed input of the current chunk
+    std::vector< std::byte > _block;
+    // Framed output not handed out yet
+    std::vector< std::byte > _pending;
+    size_t _pendingOffset = 0;
+    std::vector< std::byte > _buffer;
+};
+
+// Input bytes per independently compressed chunk of the seekable format
+constexpr size_t g_defaultSeekableChunkSize = ( 1024 * 1024 );
+
+/**
+ * @brief Compress into the **zstd seekable format**: independent zstd frames
+ *        of `_chunkSize` input bytes each, followed by a seek table of their
+ *        compressed and decompressed sizes with XXH64 checksums.
+ *
+ * `decompress::seekable` then reads any range by decompressing only the
+ * chunks covering it. The seek table is a skippable frame, so the output is
+ * a regular zstd stream for `decompress::data` and other zstd tools as well.
+ * Chunks compress in parallel on up to `_workers` threads ( 0 uses every
+ * core ). Smaller chunks make random reads cheaper and the ratio worse.
+ *
+ * @return `std::nullopt` on failure ( e.g. a `_chunkSize` of 0 or above the
+ *         4GiB the seek table can describe ).
+ */
+[[nodiscard]] auto seekable( std::span< const std::byte > _data,
+                             size_t _chunkSize = g_defaultSeekableChunkSize,
+                             size_t _level = 3,
+                             size_t _workers = 0 )
+    -> std::optional< std::vector< std::byte > >;
+
+/**
+ * @brief Streaming writer of the **zstd seekable format**, byte-identical to
+ *        `compress::seekable`.
+ *
+ * Same pull and push interface as `compress::dataStream`. Memory is bounded
+ * by one chunk, its compressed frame and the seek table ( 12 bytes per
+ * chunk ), so inputs far larger than memory can be written.
+ *
+ * @threadsafe Not thread-safe: use one stream per thread.
+ */
+struct seekableStream {
+    explicit seekableStream( size_t _chunkSize = g_defaultSeekableChunkSize,
+                             size_t _level = 3 );
+
+    [[nodiscard]] auto update( std::span< const std::byte >& _input,
+                               std::span< std::byte >& _output ) -> bool;
+
+    // Writes the last chunk and the seek table. The stream starts a new
+    // seekable output afterwards
+    [[nodiscard]] auto finish( std::span< std::byte >& _output )
+        -> std::optional< bool >;
+
+    template < typename Sink >
+        requires is_lambda< Sink, bool, std::span< const std::byte > >
+    [[nodiscard]] auto write( std::span< const std::byte > _input,
+                              Sink&& _sink ) -> bool {
+        return ( _write( *this, _buffer, _input, _sink ) );
+    }
+
+    template < typename Sink >
+        requires is_lambda< Sink, bool, std::span< const std::byte > >
+    [[nodiscard]] auto finish( Sink&& _sink ) -> bool {
+        return ( _finish( *this, _buffer, _sink ) );
+    }
+
+private:
+    auto _compressChunk() -> bool;
+
+    size_t _chunkSize;
+    size_t _level;
+    // Uncompressed input of the current chunk
+    std::vector< std::byte > _chunk;
+    // Seek table entries of the chunks written so far
+    std::vector< std::byte > _entries;
+    // Output not handed out yet
+    std::vector< std::byte > _pending;
+    size_t _pendingOffset = 0;
+    // The seek table is in _pending
+    bool _isFinishing = false;
+    std::vector< std::byte > _buffer;
+};
+
+// Input compress::pipeline reads at a time, each chunk becomes one frame
+constexpr size_t g_defaultPipelineChunkSize = ( 1024 * 1024 );
+
+/**
+ * @brief Compress _input into _output with reading, compression on `_pool`
+ *        and writing overlapping ( `async::pipeline` ).
+ *
+ * Chunks become independent frames written in order, and back to back frames
+ * are one stream for `decompress::data`, `decompress::pipe` and the zstd tool.
+ * Memory stays bounded by a few chunks per worker. File descriptor overloads
+ * retry on EINTR and leave the descriptors open.
+ */
+[[nodiscard]] auto pipeline( std::istream& _input,
+                             std::ostream& _output,
+                             size_t _level = 3,
+                             size_t _chunkSize = g_defaultPipelineChunkSize,
+                             async::pool& _pool = async::defaultPool() )
+    -> bool;
+[[nodiscard]] auto pipeline( int _input,
+                             int _output,
+                             size_t _level = 3,
+                             size_t _chunkSize = g_defaultPipelineChunkSize,
+                             async::pool& _pool = async::defaultPool() )
+    -> bool;
+
+// Compresses _input until end of file into _output with constant memory.
+// File descriptor overloads retry on EINTR and leave the descriptors open
+[[nodiscard]] auto pipe( dataStream& _stream,
+                         std::istream& _input,
+                         std::ostream& _output ) -> bool;
+[[nodiscard]] auto pipe( dataStream& _stream, int _input, int _output )
+    -> bool;
+[[nodiscard]] auto pipe( textStream& _stream,
+                         std::istream& _input,
+                         std::ostream& _output ) -> bool;
+[[nodiscard]] auto pipe( textStream& _stream, int _input, int _output )
+    -> bool;
+[[nodiscard]] auto pipe( seekableStream& _stream,
+                         std::istream& _input,
+                         std::ostream& _output ) -> bool;
+[[nodiscard]] auto pipe( seekableStream& _stream, int _input, int _output )
+    -> bool;
+
 } // namespace stdfunc::compress
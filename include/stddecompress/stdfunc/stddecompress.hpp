@@ -1,12 +1,29 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <iosfwd>
+#include <list>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "stdasync.hpp"
+#include "stdconcepts.hpp"
+#include "stdentropy.hpp"
+
+// Opaque ZSTD_DCtx and ZSTD_DDict, keep zstd.h out of this header
+struct ZSTD_DCtx_s;
+struct ZSTD_DDict_s;
+
 namespace stdfunc::decompress {
 
 /**
@@ -41,40 +58,758 @@ namespace stdfunc::decompress {
 [[nodiscard]] auto text( std::string_view _data )
     -> std::optional< std::string >;
 
+/**
+ * @brief Decompress the **Snappy** framing format written by
+ *        `compress::framedText` or `compress::textStream` on several threads.
+ *
+ * Chunk headers are scanned once to size the output exactly, then chunks
+ * decompress and verify their CRC-32C in parallel on up to `_workers`
+ * threads ( 0 uses every core ).
+ *
+ * @return `std::nullopt` on malformed input or checksum mismatch.
+ */
+[[nodiscard]] auto framedText( std::string_view _data, size_t _workers = 0 )
+    -> std::optional< std::string >;
+
+// Exact decompressed size stored in a compress::text frame
+[[nodiscard]] auto textSize( std::string_view _data )
+    -> std::optional< size_t >;
+
+/**
+ * @brief Decompress a text frame into caller-owned memory.
+ *
+ * @param _buffer Must hold at least `textSize( _data )` bytes.
+ *
+ * @return Decompressed size written to the front of `_buffer`, `std::nullopt`
+ *         on failure.
+ */
+[[nodiscard]] auto text( std::string_view _data, std::span< char > _buffer )
+    -> std::optional< size_t >;
+
+// Appends the decompressed text to _output, returns the appended size. On
+// failure _output keeps its previous contents
+[[nodiscard]] auto text( std::string_view _data, std::string& _output )
+    -> std::optional< size_t >;
+
+// Output limit for frames whose size is detected, guards against
+// decompression bombs
+constexpr size_t g_defaultMaxDataSize = ( size_t{ 1 } << 30 );
+
 /**
  * @brief Decompress binary data produced by `compress::data`.
  *
- * Decompress a binary compressed frame into a `std::vector<std::byte>` of the
- * original size `_originalSize`. Some compressors (like zstd) may store the
- * original size in the frame; however many APIs expect the caller to provide
- * the expected decompressed size. If your compressor stores the original size
- * in the frame, `_originalSize` can be unused — consult your implementation.
+ * Decompress one or more concatenated binary frames into a
+ * `std::vector<std::byte>`. When `_originalSize` is 0 the size is read from
+ * the frame headers and the output is allocated exactly once; frames written
+ * without a size ( e.g. by `compress::dataStream` ) decompress as a stream
+ * into geometrically growing output instead.
  *
  * @param _data         Compressed frame bytes.
- * @param _originalSize Expected size of the decompressed output in bytes.
- *                      The function may use this to allocate the output buffer
- *                      and to validate the decompressed result. Passing an
- *                      incorrect `_originalSize` may cause decompression to
- *                      fail or return truncated/incorrect data.
+ * @param _originalSize Expected size of the decompressed output in bytes, or
+ *                      0 to detect it. An explicit size is used as the output
+ *                      capacity: a too small one makes decompression fail.
+ * @param _maxSize      Upper bound for a detected size. Frames that declare or
+ *                      produce more fail instead of allocating.
  *
  * @return `std::optional<std::vector<std::byte>>`:
  *         - decompressed byte vector on success;
- *         - `std::nullopt` on failure (bad frame, corruption, mismatch with
- *           `_originalSize`, etc.).
+ *         - `std::nullopt` on failure (bad frame, corruption, truncation,
+ *           output larger than `_originalSize` or `_maxSize`, etc.).
  *
- * @threadsafe Safe to call concurrently, subject to underlying library rules.
+ * @threadsafe Safe to call concurrently. Every thread reuses its own cached
+ *            decompression context.
  *
- * @complexity Time: approximately linear in `_originalSize` (or the
- *             decompressed amount).
+ * @complexity Time: approximately linear in the decompressed amount.
  *
  * @example
- * auto outOpt = decompress::data(std::span(compressedBytes),
- * expected_original_size); if (outOpt) { write(outOpt->data(), outOpt->size());
- * }
+ * auto outOpt = decompress::data(std::span(compressedBytes));
+ * if (outOpt) { write(outOpt->data(), outOpt->size()); }
  */
 // TODO: Make constexpr
 [[nodiscard]] auto data( std::span< const std::byte > _data,
-                         size_t _originalSize )
+                         size_t _originalSize = 0,
+                         size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< std::vector< std::byte > >;
+
+// Sum of the sizes stored in the headers of all frames in _data, std::nullopt
+// when a frame does not store it or is malformed
+[[nodiscard]] auto dataSize( std::span< const std::byte > _data )
+    -> std::optional< size_t >;
+
+/**
+ * @brief Decompress a binary frame into caller-owned memory.
+ *
+ * @param _buffer Destination, at least the original size.
+ *
+ * @return Decompressed size written to the front of `_buffer`, `std::nullopt`
+ *         on failure ( including a too small buffer ).
+ */
+[[nodiscard]] auto data( std::span< const std::byte > _data,
+                         std::span< std::byte > _buffer )
+    -> std::optional< size_t >;
+
+// Appends the decompressed bytes to _output, sized as in the overload above,
+// returns the appended size. On failure _output keeps its previous contents
+[[nodiscard]] auto data( std::span< const std::byte > _data,
+                         std::vector< std::byte >& _output,
+                         size_t _originalSize = 0,
+                         size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< size_t >;
+
+// decompress::data on _pool, the counterpart of compress::async. _data must
+// stay alive until the task completes
+[[nodiscard]] auto async( std::span< const std::byte > _data,
+                          size_t _originalSize = 0,
+                          size_t _maxSize = g_defaultMaxDataSize,
+                          async::pool& _pool = async::defaultPool() )
+    -> async::task< std::optional< std::vector< std::byte > > >;
+
+/**
+ * @brief Dictionary digested once for decompression (current implementation:
+ *        **Zstandard (zstd)** `ZSTD_DDict`), shared by any number of calls and
+ *        threads.
+ *
+ * Built from the same content as the `compress::dictionary` that produced the
+ * frames. Frames recording a different dictionary ID fail without being
+ * decoded.
+ */
+struct dictionary {
+    explicit dictionary( std::span< const std::byte > _content );
+
+    dictionary( const dictionary& ) = delete;
+    dictionary( dictionary&& _other ) noexcept;
+    ~dictionary();
+
+    auto operator=( const dictionary& ) -> dictionary& = delete;
+    auto operator=( dictionary&& _other ) noexcept -> dictionary&;
+
+    // 0 for raw content without a dictionary header, or when the content
+    // could not be digested
+    [[nodiscard]] auto id() const -> uint32_t;
+
+private:
+    friend struct context;
+
+    friend auto data( std::span< const std::byte > _data,
+                      const dictionary& _dictionary,
+                      size_t _originalSize,
+                      size_t _maxSize )
+        -> std::optional< std::vector< std::byte > >;
+
+    friend auto data( std::span< const std::byte > _data,
+                      std::span< std::byte > _buffer,
+                      const dictionary& _dictionary )
+        -> std::optional< size_t >;
+
+    friend auto data( std::span< const std::byte > _data,
+                      std::vector< std::byte >& _output,
+                      const dictionary& _dictionary,
+                      size_t _originalSize,
+                      size_t _maxSize ) -> std::optional< size_t >;
+
+    ZSTD_DDict_s* _dictionary = nullptr;
+};
+
+// Decompress frames written by compress::data with a dictionary, sized as
+// without one
+[[nodiscard]] auto data( std::span< const std::byte > _data,
+                         const dictionary& _dictionary,
+                         size_t _originalSize = 0,
+                         size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< std::vector< std::byte > >;
+
+[[nodiscard]] auto data( std::span< const std::byte > _data,
+                         std::span< std::byte > _buffer,
+                         const dictionary& _dictionary )
+    -> std::optional< size_t >;
+
+[[nodiscard]] auto data( std::span< const std::byte > _data,
+                         std::vector< std::byte >& _output,
+                         const dictionary& _dictionary,
+                         size_t _originalSize = 0,
+                         size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< size_t >;
+
+/**
+ * @brief Reusable binary decompression context (current implementation:
+ *        **Zstandard (zstd)** `ZSTD_DCtx`).
+ *
+ * Keeps the decompressor state across calls instead of allocating it for
+ * every frame.
+ *
+ * @threadsafe Not thread-safe: use one context per thread.
+ */
+struct context {
+    context();
+
+    context( const context& ) = delete;
+    context( context&& _other ) noexcept;
+    ~context();
+
+    auto operator=( const context& ) -> context& = delete;
+    auto operator=( context&& _other ) noexcept -> context&;
+
+    // Same semantics as decompress::data
+    [[nodiscard]] auto data( std::span< const std::byte > _data,
+                             size_t _originalSize = 0,
+                             size_t _maxSize = g_defaultMaxDataSize )
+        -> std::optional< std::vector< std::byte > >;
+
+    [[nodiscard]] auto data( std::span< const std::byte > _data,
+                             std::span< std::byte > _buffer )
+        -> std::optional< size_t >;
+
+    [[nodiscard]] auto data( std::span< const std::byte > _data,
+                             std::vector< std::byte >& _output,
+                             size_t _originalSize = 0,
+                             size_t _maxSize = g_defaultMaxDataSize )
+        -> std::optional< size_t >;
+
+    // Same as the decompress::data dictionary overloads
+    [[nodiscard]] auto data( std::span< const std::byte > _data,
+                             const dictionary& _dictionary,
+                             size_t _originalSize = 0,
+                             size_t _maxSize = g_defaultMaxDataSize )
+        -> std::optional< std::vector< std::byte > >;
+
+    [[nodiscard]] auto data( std::span< const std::byte > _data,
+                             std::span< std::byte > _buffer,
+                             const dictionary& _dictionary )
+        -> std::optional< size_t >;
+
+    [[nodiscard]] auto data( std::span< const std::byte > _data,
+                             std::vector< std::byte >& _output,
+                             const dictionary& _dictionary,
+                             size_t _originalSize = 0,
+                             size_t _maxSize = g_defaultMaxDataSize )
+        -> std::optional< size_t >;
+
+private:
+    ZSTD_DCtx_s* _context = nullptr;
+};
+
+/**
+ * @brief Buffers stored back to back in a single allocation.
+ */
+struct arena {
+    std::vector< std::byte > data;
+    // Buffer i spans [ offsets[ i ], offsets[ i + 1 ] ) of data
+    std::vector< size_t > offsets{ 0 };
+
+    [[nodiscard]] auto size() const -> size_t {
+        return ( offsets.size() - 1 );
+    }
+
+    [[nodiscard]] auto operator[]( size_t _index ) const
+        -> std::span< const std::byte > {
+        return ( std::span( data ).subspan(
+            offsets[ _index ],
+            ( offsets[ _index + 1 ] - offsets[ _index ] ) ) );
+    }
+};
+
+/**
+ * @brief Decompress an arena of frames written by `compress::batch`.
+ *
+ * `_offsets` delimits the frames in `_data` like `compress::arena::offsets`.
+ * Sizes are read from the frame headers to allocate the output once, then
+ * frames decompress in parallel on up to `_workers` threads ( 0 uses every
+ * core ), each reusing its own decompression context. Empty frames become
+ * empty buffers.
+ *
+ * @return Buffer i is `arena[ i ]`, `std::nullopt` when any frame fails, has
+ *         no stored size or the total exceeds `_maxSize`.
+ */
+[[nodiscard]] auto batch( std::span< const std::byte > _data,
+                          std::span< const size_t > _offsets,
+                          size_t _workers = 0,
+                          size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< arena >;
+
+[[nodiscard]] auto batch( std::span< const std::byte > _data,
+                          std::span< const size_t > _offsets,
+                          const dictionary& _dictionary,
+                          size_t _workers = 0,
+                          size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< arena >;
+
+// Decompressed size stored in the prefix of a compress::lz block
+[[nodiscard]] auto lzSize( std::span< const std::byte > _data )
+    -> std::optional< size_t >;
+
+/**
+ * @brief Decompress a block of the built-in LZ77 codec written by
+ *        `compress::lz` into caller-owned memory.
+ *
+ * Every length and offset is checked against both buffers, so corrupt or
+ * hostile input fails instead of reading or writing out of bounds.
+ *
+ * @param _buffer Must hold at least `lzSize( _data )` bytes.
+ *
+ * @return Decompressed size written to the front of `_buffer`, `std::nullopt`
+ *         on failure.
+ */
+[[nodiscard]] auto lz( std::span< const std::byte > _data,
+                       std::span< std::byte > _buffer )
+    -> std::optional< size_t >;
+
+// Appends the decompressed bytes to _output, returns the appended size. Blocks
+// declaring more than _maxSize fail. On failure _output keeps its previous
+// contents
+[[nodiscard]] auto lz( std::span< const std::byte > _data,
+                       std::vector< std::byte >& _output,
+                       size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< size_t >;
+
+[[nodiscard]] auto lz( std::span< const std::byte > _data,
+                       size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< std::vector< std::byte > >;
+
+/**
+ * @brief Resource shipped as a `compress::lz` block, e.g. built at compile
+ *        time by `compress::embed`, decompressed on first use.
+ *
+ * Constant-initialized, so assets cost nothing at startup and those never
+ * touched are never decompressed. The first `data()` call decompresses once
+ * for all threads into pages remapped read-only where `mmap` exists, onto
+ * the heap elsewhere.
+ *
+ * @example
+ * constinit decompress::asset g_shader( g_compressedShader );
+ * std::span< const std::byte > l_source = g_shader.data();
+ */
+struct asset {
+    // The compressed bytes have to outlive the asset
+    constexpr explicit asset( std::span< const std::byte > _compressed )
+        : _compressed( _compressed ) {}
+
+    asset( const asset& ) = delete;
+    auto operator=( const asset& ) -> asset& = delete;
+
+    ~asset();
+
+    // Decompressed bytes, empty when the block is malformed
+    [[nodiscard]] auto data() -> std::span< const std::byte >;
+
+private:
+    auto _load() -> void;
+
+    std::span< const std::byte > _compressed;
+    std::once_flag _once;
+    std::span< const std::byte > _data;
+    std::vector< std::byte > _buffer;
+    bool _isMapped = false;
+};
+
+/**
+ * @brief Decompress the output of `compress::adaptive` with the codec its
+ *        header records.
+ *
+ * @return `std::nullopt` when the header is unknown, the codec is not
+ *         available, the payload is corrupt or it exceeds `_maxSize`.
+ */
+[[nodiscard]] auto adaptive( std::span< const std::byte > _data,
+                             size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< std::vector< std::byte > >;
+
+enum class error : uint8_t {
+    // Not a frame, truncated or inconsistent sizes
+    malformed,
+    // Block failed to decode or its checksum does not match the plaintext
+    corrupted,
+    // Decompressed size exceeds the limit
+    tooLarge,
+    // Block codec is not available in this build
+    unsupported,
+};
+
+/**
+ * @brief Decompress the output of `compress::checked` on up to `_workers`
+ *        threads ( 0 uses every core ).
+ *
+ * Each block is checksummed right after it is decoded, while still in cache,
+ * so no separate verification pass over the output is needed.
+ *
+ * @return The plaintext or why it could not be produced.
+ */
+[[nodiscard]] auto checked( std::span< const std::byte > _data,
+                            size_t _workers = 0,
+                            size_t _maxSize = g_defaultMaxDataSize )
+    -> std::expected< std::vector< std::byte >, error >;
+
+// Element count recorded in the compress::array header
+[[nodiscard]] auto arraySize( std::span< const std::byte > _data )
+    -> std::optional< size_t >;
+
+/**
+ * @brief Decompress the output of `compress::array` into caller-owned memory,
+ *        undoing the filter its header records.
+ *
+ * @return Bytes written, `std::nullopt` when `_elementSize` differs from the
+ *         compressed elements, `_buffer` is too small, the codec is not
+ *         available or the data is corrupt.
+ */
+[[nodiscard]] auto array( std::span< const std::byte > _data,
+                          std::span< std::byte > _buffer,
+                          size_t _elementSize ) -> std::optional< size_t >;
+
+// Typed decompress::array, up to _maxSize bytes of elements
+template < typename T >
+    requires( std::is_trivially_copyable_v< T > &&
+              std::has_single_bit( sizeof( T ) ) && ( sizeof( T ) <= 16 ) )
+[[nodiscard]] auto array( std::span< const std::byte > _data,
+                          size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< std::vector< T > > {
+    std::optional< std::vector< T > > l_returnValue = std::nullopt;
+
+    do {
+        const std::optional< size_t > l_count = arraySize( _data );
+
+        if ( !l_count || ( *l_count > ( _maxSize / sizeof( T ) ) ) )
+            [[unlikely]] {
+            break;
+        }
+
+        std::vector< T > l_output( *l_count );
+
+        if ( !array( _data, std::as_writable_bytes( std::span( l_output ) ),
+                     sizeof( T ) ) ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = std::move( l_output );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+// Inverse of compress::zigzag
+[[nodiscard]] constexpr auto zigzag( uint32_t _value ) -> int32_t {
+    return (
+        static_cast< int32_t >( ( _value >> 1 ) ^ ( 0U - ( _value & 1 ) ) ) );
+}
+
+// Running sum of the values in place starting from _previous, the inverse of
+// compress::delta
+void delta( std::span< uint32_t > _values, uint32_t _previous = 0 );
+
+/**
+ * @brief Unpack `_values.size()` integers written by `compress::packed`.
+ *
+ * @return Bytes read, `std::nullopt` on truncated or corrupt input.
+ */
+[[nodiscard]] auto packed( std::span< const std::byte > _data,
+                           std::span< uint32_t > _values )
+    -> std::optional< size_t >;
+
+/**
+ * @brief Decode `_values.size()` integers written by `compress::streamVByte`,
+ *        four per shuffle with SSSE3.
+ *
+ * @return Bytes read, `std::nullopt` on truncated input.
+ */
+[[nodiscard]] auto streamVByte( std::span< const std::byte > _data,
+                                std::span< uint32_t > _values )
+    -> std::optional< size_t >;
+
+/**
+ * @brief Decoding tables of an order-0 `entropy::distribution` for
+ *        `decompress::ans` and `decompress::huffman`, built once and shared by
+ *        any number of calls and threads.
+ */
+struct entropyTable {
+    explicit entropyTable( const entropy::distribution& _distribution );
+
+    // 0 when the distribution is not valid and nothing can be decoded
+    [[nodiscard]] auto tableLog() const -> size_t;
+
+private:
+    friend auto ans( std::span< const std::byte > _data,
+                     const entropyTable& _table,
+                     size_t _maxSize )
+        -> std::optional< std::vector< std::byte > >;
+
+    friend auto huffman( std::span< const std::byte > _data,
+                         const entropyTable& _table,
+                         size_t _maxSize )
+        -> std::optional< std::vector< std::byte > >;
+
+    // tANS state: the symbol, the bits to read and the base they are added to
+    struct ansEntry {
+        uint16_t newState;
+        uint8_t symbol;
+        uint8_t bits;
+    };
+
+    // Indexed by the next _huffmanLog stream bits
+    struct huffmanEntry {
+        uint8_t symbol;
+        uint8_t length;
+    };
+
+    size_t _tableLog = 0;
+    std::vector< ansEntry > _ans;
+    size_t _huffmanLog = 0;
+    std::vector< huffmanEntry > _huffman;
+};
+
+/**
+ * @brief Decode output of `compress::ans` made with a table of the same
+ *        distribution.
+ *
+ * @return `std::nullopt` on truncated or corrupt input, an invalid table or
+ *         more than `_maxSize` bytes.
+ */
+[[nodiscard]] auto ans( std::span< const std::byte > _data,
+                        const entropyTable& _table,
+                        size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< std::vector< std::byte > >;
+
+// Decode self-described compress::ans output
+[[nodiscard]] auto ans( std::span< const std::byte > _data,
+                        size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< std::vector< std::byte > >;
+
+/**
+ * @brief Decode output of `compress::huffman` made with a table of the same
+ *        distribution, its four streams interleaved.
+ *
+ * @return `std::nullopt` on truncated or corrupt input, an invalid table or
+ *         more than `_maxSize` bytes.
+ */
+[[nodiscard]] auto huffman( std::span< const std::byte > _data,
+                            const entropyTable& _table,
+                            size_t _maxSize = g_defaultMaxDataSize )
+    -> std::optional< std::vector< std::byte > >;
+
+// Decode self-described compress::huffman output
+[[nodiscard]] auto huffman( std::span< const std::byte > _data,
+                            size_t _maxSize = g_defaultMaxDataSize )
     -> std::optional< std::vector< std::byte > >;
 
+namespace {
+
+// Decompresses all of _input, handing every filled part of _buffer to _sink
+template < typename Stream, typename Sink >
+auto _write( Stream& _stream,
+             std::span< std::byte > _buffer,
+             std::span< const std::byte > _input,
+             Sink& _sink ) -> bool {
+    bool l_returnValue = true;
+    bool l_isOutputFull = false;
+
+    while ( l_returnValue && ( !_input.empty() || l_isOutputFull ) ) {
+        std::span< std::byte > l_output = _buffer;
+
+        l_returnValue = _stream.update( _input, l_output );
+
+        l_isOutputFull = l_output.empty();
+
+        const size_t l_size = ( _buffer.size() - l_output.size() );
+
+        if ( l_returnValue && l_size ) {
+            l_returnValue = _sink(
+                std::span< const std::byte >( _buffer ).first( l_size ) );
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+/**
+ * @brief Streaming binary decompressor for `compress::data` and
+ *        `compress::dataStream` frames ( current implementation: **Zstandard
+ *        (zstd)** `ZSTD_decompressStream` ), no original size needed and
+ *        constant memory.
+ *
+ * Pull: `update()` moves bytes between caller spans and advances them. Push:
+ * `write()` hands every produced chunk to
+ * `_sink( std::span< const std::byte > ) -> bool`. Concatenated frames
+ * decompress back to back; `finished()` tells whether the input ended on a
+ * frame boundary, so truncated input is detectable.
+ *
+ * @threadsafe Not thread-safe: use one stream per thread.
+ */
+struct dataStream {
+    dataStream();
+
+    dataStream( const dataStream& ) = delete;
+    dataStream( dataStream&& _other ) noexcept;
+    ~dataStream();
+
+    auto operator=( const dataStream& ) -> dataStream& = delete;
+    auto operator=( dataStream&& _other ) noexcept -> dataStream&;
+
+    // Consumes _input until it is empty or _output is full. False on corrupt
+    // input or failure
+    [[nodiscard]] auto update( std::span< const std::byte >& _input,
+                               std::span< std::byte >& _output ) -> bool;
+
+    // Every started frame is complete and all of its output handed out
+    [[nodiscard]] auto finished() const -> bool { return ( _isFinished ); }
+
+    template < typename Sink >
+        requires is_lambda< Sink, bool, std::span< const std::byte > >
+    [[nodiscard]] auto write( std::span< const std::byte > _input,
+                              Sink&& _sink ) -> bool {
+        return ( _write( *this, _buffer, _input, _sink ) );
+    }
+
+private:
+    ZSTD_DCtx_s* _context = nullptr;
+    std::vector< std::byte > _buffer;
+    bool _isFinished = true;
+};
+
+/**
+ * @brief Streaming decompressor for the **Snappy** framing format written by
+ *        `compress::textStream`. Every chunk checksum is verified.
+ *
+ * Same pull and push interface as `decompress::dataStream`. Memory is bounded
+ * by one chunk, skippable chunks are skipped without buffering.
+ *
+ * @threadsafe Not thread-safe: use one stream per thread.
+ */
+struct textStream {
+    textStream();
+
+    [[nodiscard]] auto update( std::span< const std::byte >& _input,
+                               std::span< std::byte >& _output ) -> bool;
+
+    [[nodiscard]] auto finished() const -> bool {
+        return ( _hasStreamIdentifier && _chunk.empty() && !_skipSize &&
+                 ( _pendingOffset == _pending.size() ) );
+    }
+
+    template < typename Sink >
+        requires is_lambda< Sink, bool, std::span< const std::byte > >
+    [[nodiscard]] auto write( std::span< const std::byte > _input,
+                              Sink&& _sink ) -> bool {
+        return ( _write( *this, _buffer, _input, _sink ) );
+    }
+
+private:
+    // Decodes the complete chunk into _pending
+    auto _decodeChunk() -> bool;
+
+    // Header and body of the current chunk
+    std::vector< std::byte > _chunk;
+    size_t _skipSize = 0;
+    std::vector< std::byte > _pending;
+    size_t _pendingOffset = 0;
+    std::vector< std::byte > _buffer;
+    bool _hasStreamIdentifier = false;
+};
+
+// Decompresses _input until end of file into _output with constant memory,
+// fails on truncated input. File descriptor overloads retry on EINTR and
+// leave the descriptors open
+[[nodiscard]] auto pipe( dataStream& _stream,
+                         std::istream& _input,
+                         std::ostream& _output ) -> bool;
+[[nodiscard]] auto pipe( dataStream& _stream, int _input, int _output )
+    -> bool;
+[[nodiscard]] auto pipe( textStream& _stream,
+                         std::istream& _input,
+                         std::ostream& _output ) -> bool;
+[[nodiscard]] auto pipe( textStream& _stream, int _input, int _output )
+    -> bool;
+
+// Decoded chunks a seekable reader keeps by default
+constexpr size_t g_defaultSeekableCacheSize = 8;
+
+/**
+ * @brief Random access reader for the **zstd seekable format** written by
+ *        `compress::seekable`, `compress::seekableStream` or other zstd
+ *        seekable tools.
+ *
+ * The seek table is read once. `read()` then fetches and decompresses only
+ * the chunks covering the requested range, several of them in parallel on up
+ * to `_workers` threads ( 0 uses every core ), and verifies their checksums
+ * when the table has them. The `_cacheSize` most recently used decoded chunks
+ * are kept, so nearby reads decompress nothing. Tables whose chunks or total
+ * decompress to more than `_maxSize` are rejected, as sizes from the table
+ * are not trusted to size buffers.
+ *
+ * @threadsafe Not thread-safe: use one reader per thread.
+ *
+ * @example
+ * decompress::seekable l_reader( l_descriptor, 0, g_defaultSeekableCacheSize,
+ *                                ( size_t{ 1 } << 40 ) );
+ * auto l_bytes = l_reader.read( 5'000'000'000, 4096 );
+ */
+struct seekable {
+    // Compressed bytes in memory ( e.g. a mapped file ), they have to outlive
+    // the reader
+    explicit seekable( std::span< const std::byte > _data,
+                       size_t _workers = 0,
+                       size_t _cacheSize = g_defaultSeekableCacheSize,
+                       size_t _maxSize = g_defaultMaxDataSize );
+
+    // File read with pread(), which leaves its position alone. The
+    // descriptor stays open and has to outlive the reader
+    explicit seekable( int _descriptor,
+                       size_t _workers = 0,
+                       size_t _cacheSize = g_defaultSeekableCacheSize,
+                       size_t _maxSize = g_defaultMaxDataSize );
+
+    // False when the seek table is missing or malformed, reads fail then
+    [[nodiscard]] auto isValid() const -> bool { return ( _isValid ); }
+
+    // Decompressed size
+    [[nodiscard]] auto size() const -> uint64_t;
+
+    [[nodiscard]] auto chunkCount() const -> size_t {
+        return ( _chunks.size() );
+    }
+
+    /**
+     * @brief Decompress the range starting at `_offset` into `_buffer`.
+     *
+     * @return Bytes written, less than `_buffer.size()` only at the end of
+     *         the data. `std::nullopt` when `_offset` is past the end or a
+     *         chunk fails to read, decompress or verify.
+     */
+    [[nodiscard]] auto read( uint64_t _offset, std::span< std::byte > _buffer )
+        -> std::optional< size_t >;
+
+    [[nodiscard]] auto read( uint64_t _offset, size_t _size )
+        -> std::optional< std::vector< std::byte > >;
+
+private:
+    struct chunk {
+        uint64_t compressedOffset;
+        uint64_t offset;
+        uint32_t compressedSize;
+        uint32_t size;
+        uint32_t checksum;
+    };
+
+    // Parses the seek table at the end of _compressedSize bytes, chunks and
+    // their total decompress to at most _maxSize bytes
+    auto _open( uint64_t _compressedSize, size_t _maxSize ) -> bool;
+
+    auto _readCompressed( uint64_t _offset,
+                          std::span< std::byte > _buffer ) const -> bool;
+
+    auto _decode( size_t _index, std::vector< std::byte >& _output ) const
+        -> bool;
+
+    // Moves a cached chunk to the front, nullptr when it is not cached
+    auto _cached( size_t _index ) -> const std::vector< std::byte >*;
+
+    std::span< const std::byte > _data;
+    int _descriptor = -1;
+    size_t _workers;
+    size_t _cacheSize;
+    std::vector< chunk > _chunks;
+    bool _hasChecksums = false;
+    bool _isValid = false;
+    // Most recently used first. Decoded chunks are large, so the cache holds
+    // few of them and a linear search is cheap
+    std::list< std::pair< size_t, std::vector< std::byte > > > _cache;
+};
+
 } // namespace stdfunc::decompress
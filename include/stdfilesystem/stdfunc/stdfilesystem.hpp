@@ -1,15 +1,18 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <regex>
 #include <string>
 #include <string_view>
 #include <vector>
 
-// FIX: Better guard or port
-#if __has_include( "linux/limits.h" )
-
-#include <optional>
+#if __has_include( <linux/limits.h> ) && __has_include( <unistd.h> )
 
 #define HAS_LINUX_LIMITS
 
@@ -35,42 +38,162 @@ namespace stdfunc::filesystem {
 
 #endif
 
+struct walkParameters {
+    // Levels of subdirectories to descend, 0 lists the directory only
+    size_t depth = std::numeric_limits< size_t >::max();
+    // Threads sharing the subdirectories, 0 uses every core
+    size_t workers = 0;
+};
+
+// Accepts a file name, empty accepts every file
+using filter_t = std::function< bool( std::string_view ) >;
+
+// Receives the directory, as walked from the root, and the file name
+using visitor_t = std::function< void( std::string_view, std::string_view ) >;
+
+/**
+ * @brief Walk _directory recursively, calling `_visit( directory, name )` for
+ *        every regular file whose name passes `_filter`.
+ *
+ * Directories are read with raw `getdents64` on Linux and entry types come
+ * from `d_type`, so only symbolic links and file systems without it cost a
+ * `stat`. Names are views into the read buffer, nothing is allocated for
+ * files `_filter` rejects. Each worker takes its newest subdirectory first
+ * and steals the oldest ones of the others when it runs out, so `_filter`
+ * and `_visit` run concurrently and in no particular order. Symbolic links
+ * to files are visited, to directories they are not followed.
+ *
+ * @return false when `_directory` cannot be opened or read to the end,
+ *         subdirectories that fail either way are skipped.
+ */
+auto walk( std::string_view _directory,
+           const filter_t& _filter,
+           const visitor_t& _visit,
+           const walkParameters& _parameters = {} ) -> bool;
+
+// Paths of the files walk visits, in no particular order. std::nullopt when
+// _directory cannot be read
+[[nodiscard]] auto getPaths( std::string_view _directory,
+                             const filter_t& _filter = {},
+                             const walkParameters& _parameters = {} )
+    -> std::optional< std::vector< std::filesystem::path > >;
+
+enum class syntax : uint8_t { regexp, glob };
+
+/**
+ * @brief Pattern compiled once for matching whole file names, safe to share
+ *        between threads.
+ *
+ * ECMAScript regexps made of literals, `.`, classes, `\d`/ `\w`/ `\s`
+ * escapes, groups, alternation and greedy or lazy quantifiers become a DFA
+ * over byte classes, anything else ( back references, lookarounds, ... ) falls
+ * back to `std::regex`. Globs take `*`, `?`, `[...]`/ `[!...]`, `{a,b}` and
+ * `\` escapes, `*` and `?` do not match `/`.
+ *
+ * Patterns that reduce to a set of literals, a literal prefix and a set of
+ * suffixes ( `.*\\.(png|jpg)`, `*.txt` ) or a literal substring never run the
+ * automaton: they are compared in place and the wildcard part is checked with
+ * an SSE2 scan for the bytes it excludes. Other patterns check their literal
+ * prefix and suffix before the DFA runs.
+ */
+struct matcher {
+    explicit matcher( std::string_view _pattern,
+                      syntax _syntax = syntax::regexp );
+
+    // False for malformed patterns, they match nothing
+    [[nodiscard]] auto isValid() const -> bool {
+        return ( _kind != kind::invalid );
+    }
+
+    // Whether all of _name matches
+    [[nodiscard]] auto operator()( std::string_view _name ) const -> bool;
+
+private:
+    enum class kind : uint8_t {
+        invalid,
+        literals,
+        affixes,
+        substring,
+        automaton,
+        fallback
+    };
+
+    [[nodiscard]] auto _isExcluded( std::string_view _part ) const -> bool;
+
+    kind _kind = kind::invalid;
+    // Literal start, or the substring to find
+    std::string _prefix;
+    // Literal ends, or every literal the pattern matches
+    std::vector< std::string > _suffixes;
+    // Bytes the wildcard of affixes and substring does not match
+    std::array< char, 2 > _excluded{};
+    size_t _excludedCount = 0;
+    // DFA over byte classes, state 0 rejects
+    std::array< uint8_t, 256 > _classes{};
+    size_t _classCount = 0;
+    std::vector< uint32_t > _transitions;
+    std::vector< uint8_t > _isAccepting;
+    // State after the literal prefix
+    uint32_t _start = 0;
+    std::optional< std::regex > _fallback;
+};
+
+// Matcher of _pattern, compiled on first use and shared afterwards. Invalid
+// ones are compiled again on every call, they are not cached
+[[nodiscard]] auto cachedMatcher( std::string_view _pattern,
+                                  syntax _syntax = syntax::regexp )
+    -> std::shared_ptr< const matcher >;
+
 namespace {
 
 template < typename Matcher >
-    requires is_lambda< Matcher, bool, const std::string& >
+    requires is_lambda< Matcher, bool, std::string_view >
 [[nodiscard]] auto _getPathsByRegexp( std::string_view _directory,
                                       Matcher _matcher )
     -> std::vector< std::filesystem::path > {
-    std::vector< std::filesystem::path > l_returnValue;
-
-    for ( const auto& _entry :
-          std::filesystem::directory_iterator( _directory ) ) {
-        if ( !_entry.is_regular_file() ) {
-            continue;
-        }
-
-        const std::string l_filename = _entry.path().filename().string();
+    std::optional< std::vector< std::filesystem::path > > l_paths =
+        getPaths( _directory, _matcher, { .depth = 0, .workers = 1 } );
 
-        if ( _matcher( l_filename ) ) {
-            l_returnValue.emplace_back( _entry.path() );
-        }
+    if ( !l_paths ) [[unlikely]] {
+        // Throws std::filesystem::filesystem_error with the reason
+        std::filesystem::directory_iterator{ _directory };
     }
 
-    return ( l_returnValue );
+    return ( std::move( l_paths ).value_or(
+        std::vector< std::filesystem::path >{} ) );
 }
 
 } // namespace
 
-// Runtime regexp
+// Runtime regexp, compiled once per pattern. Malformed ones throw
+// std::regex_error, unreadable directories std::filesystem::filesystem_error
 [[nodiscard]] inline auto getPathsByRegexp( std::string& _regexp,
                                             std::string_view _directory )
     -> std::vector< std::filesystem::path > {
-    std::regex l_matcher( _regexp );
+    const std::shared_ptr< const matcher > l_matcher =
+        cachedMatcher( _regexp );
+
+    if ( !l_matcher->isValid() ) [[unlikely]] {
+        // Throws the std::regex_error std::regex raises for the pattern
+        std::regex{ _regexp };
+    }
+
+    return ( _getPathsByRegexp(
+        _directory, [ & ]( std::string_view _fileName ) -> bool {
+            return ( ( *l_matcher )( _fileName ) );
+        } ) );
+}
+
+// Malformed globs match nothing
+[[nodiscard]] inline auto getPathsByGlob( std::string_view _glob,
+                                          std::string_view _directory )
+    -> std::vector< std::filesystem::path > {
+    const std::shared_ptr< const matcher > l_matcher =
+        cachedMatcher( _glob, syntax::glob );
 
     return ( _getPathsByRegexp(
-        _directory, [ & ]( const std::string& _fileName ) -> bool {
-            return ( std::regex_match( _fileName, l_matcher ) );
+        _directory, [ & ]( std::string_view _fileName ) -> bool {
+            return ( ( *l_matcher )( _fileName ) );
         } ) );
 }
 
@@ -85,7 +208,7 @@ template < size_t N >
     constexpr auto l_matcher = ctre::match< _regexp >;
 
     return ( _getPathsByRegexp( _directory,
-                                [ & ]( const std::string& _fileName ) -> auto {
+                                [ & ]( std::string_view _fileName ) -> bool {
                                     return ( l_matcher( _fileName ) );
                                 } ) );
 }
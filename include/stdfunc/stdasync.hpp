@@ -0,0 +1,526 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <semaphore>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "stdconcepts.hpp"
+#include "stdthread.hpp"
+
+namespace stdfunc::async {
+
+/**
+ * @brief Bounded multi-producer multi-consumer queue.
+ *
+ * Producers block while it is full, which is what pushes back on whoever
+ * submits faster than the consumers keep up.
+ */
+template < typename T >
+struct queue {
+    // _capacity of 0 holds 1 item
+    explicit queue( size_t _capacity )
+        : _capacity( std::max( _capacity, size_t{ 1 } ) ) {}
+
+    queue( const queue& ) = delete;
+    auto operator=( const queue& ) -> queue& = delete;
+
+    // Blocks while full, false once closed
+    [[nodiscard]] auto push( T _value ) -> bool {
+        bool l_returnValue = false;
+
+        std::unique_lock l_lock( _mutex );
+
+        _notFull.wait( l_lock, [ & ]() -> bool {
+            return ( _isClosed || ( _items.size() < _capacity ) );
+        } );
+
+        if ( !_isClosed ) [[likely]] {
+            _items.emplace_back( std::move( _value ) );
+
+            // Under the lock, the queue may be gone as soon as it is released
+            _notEmpty.notify_one();
+
+            l_returnValue = true;
+        }
+
+        return ( l_returnValue );
+    }
+
+    // Blocks while empty, std::nullopt once closed and drained
+    [[nodiscard]] auto pop() -> std::optional< T > {
+        std::optional< T > l_returnValue = std::nullopt;
+
+        std::unique_lock l_lock( _mutex );
+
+        _notEmpty.wait( l_lock, [ & ]() -> bool {
+            return ( _isClosed || !_items.empty() );
+        } );
+
+        if ( !_items.empty() ) [[likely]] {
+            l_returnValue = std::move( _items.front() );
+
+            _items.pop_front();
+
+            _notFull.notify_one();
+        }
+
+        return ( l_returnValue );
+    }
+
+    // Fails further pushes and wakes every waiter, pops drain what is left
+    void close() {
+        std::lock_guard l_lock( _mutex );
+
+        _isClosed = true;
+
+        _notFull.notify_all();
+        _notEmpty.notify_all();
+    }
+
+    [[nodiscard]] auto capacity() const -> size_t { return ( _capacity ); }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _notFull;
+    std::condition_variable _notEmpty;
+    std::deque< T > _items;
+    size_t _capacity;
+    bool _isClosed = false;
+};
+
+template < typename T >
+struct task;
+
+// What every task promise shares: who continues once the coroutine is done
+struct taskPromiseBase {
+    // Lets wait() block a thread that is not a coroutine
+    struct signal {
+        void notify() {
+            std::lock_guard l_lock( _mutex );
+
+            _isDone = true;
+
+            _condition.notify_one();
+        }
+
+        void wait() {
+            std::unique_lock l_lock( _mutex );
+
+            _condition.wait( l_lock, [ & ]() -> bool { return ( _isDone ); } );
+        }
+
+    private:
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _isDone = false;
+    };
+
+    struct finalAwaiter {
+        [[nodiscard]] auto await_ready() const noexcept -> bool {
+            return ( false );
+        }
+
+        // The frame may be gone once the waiter is notified
+        template < typename Promise >
+        auto await_suspend( std::coroutine_handle< Promise > _handle ) noexcept
+            -> std::coroutine_handle<> {
+            std::coroutine_handle<> l_returnValue = std::noop_coroutine();
+
+            taskPromiseBase& l_promise = _handle.promise();
+
+            if ( l_promise.continuation ) {
+                l_returnValue = l_promise.continuation;
+
+            } else if ( l_promise.waiter ) {
+                l_promise.waiter->notify();
+            }
+
+            return ( l_returnValue );
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    [[nodiscard]] auto initial_suspend() noexcept -> std::suspend_always {
+        return ( std::suspend_always{} );
+    }
+
+    [[nodiscard]] auto final_suspend() noexcept -> finalAwaiter {
+        return ( finalAwaiter{} );
+    }
+
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+
+    std::coroutine_handle<> continuation;
+    signal* waiter = nullptr;
+    std::exception_ptr exception;
+};
+
+template < typename T >
+struct taskPromise : taskPromiseBase {
+    [[nodiscard]] auto get_return_object() -> task< T >;
+
+    void return_value( T _value ) { value.emplace( std::move( _value ) ); }
+
+    [[nodiscard]] auto result() -> T {
+        if ( exception ) [[unlikely]] {
+            std::rethrow_exception( exception );
+        }
+
+        return ( std::move( *value ) );
+    }
+
+    std::optional< T > value;
+};
+
+template <>
+struct taskPromise< void > : taskPromiseBase {
+    [[nodiscard]] auto get_return_object() -> task< void >;
+
+    void return_void() {}
+
+    void result() {
+        if ( exception ) [[unlikely]] {
+            std::rethrow_exception( exception );
+        }
+    }
+};
+
+/**
+ * @brief Lazily started coroutine producing a T.
+ *
+ * Nothing runs until the task is awaited or passed to `async::wait`. The
+ * awaiting coroutine continues on whichever thread the task finished on,
+ * exceptions reach it through `co_await`.
+ *
+ * @example
+ * auto l_send = [ & ]() -> async::task<> {
+ *     auto l_frame = co_await compress::async( l_message );
+ *     co_await socket.write( *l_frame );
+ * };
+ */
+template < typename T = void >
+struct task {
+    using promise_type = taskPromise< T >;
+
+    explicit task( std::coroutine_handle< promise_type > _handle )
+        : _handle( _handle ) {}
+
+    task( const task& ) = delete;
+    task( task&& _other ) noexcept
+        : _handle( std::exchange( _other._handle, nullptr ) ) {}
+
+    ~task() {
+        if ( _handle ) {
+            _handle.destroy();
+        }
+    }
+
+    auto operator=( const task& ) -> task& = delete;
+    auto operator=( task&& _other ) noexcept -> task& {
+        if ( this != &_other ) {
+            if ( _handle ) {
+                _handle.destroy();
+            }
+
+            _handle = std::exchange( _other._handle, nullptr );
+        }
+
+        return ( *this );
+    }
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool {
+        return ( false );
+    }
+
+    // Starts the task, which resumes _continuation when it is done
+    auto await_suspend( std::coroutine_handle<> _continuation ) noexcept
+        -> std::coroutine_handle<> {
+        _handle.promise().continuation = _continuation;
+
+        return ( _handle );
+    }
+
+    auto await_resume() -> T { return ( _handle.promise().result() ); }
+
+    template < typename U >
+    friend auto wait( task< U > _task ) -> U;
+
+private:
+    std::coroutine_handle< promise_type > _handle;
+};
+
+template < typename T >
+auto taskPromise< T >::get_return_object() -> task< T > {
+    return ( task< T >(
+        std::coroutine_handle< taskPromise >::from_promise( *this ) ) );
+}
+
+inline auto taskPromise< void >::get_return_object() -> task< void > {
+    return ( task< void >(
+        std::coroutine_handle< taskPromise >::from_promise( *this ) ) );
+}
+
+// Runs _task to completion, blocking the calling thread. Must not be called
+// from a worker the task needs to make progress
+template < typename T >
+auto wait( task< T > _task ) -> T {
+    taskPromiseBase::signal l_signal;
+
+    _task._handle.promise().waiter = &l_signal;
+    _task._handle.resume();
+
+    l_signal.wait();
+
+    return ( _task._handle.promise().result() );
+}
+
+/**
+ * @brief Fixed set of worker threads fed through a bounded queue.
+ *
+ * Submitting blocks while `_capacity` jobs wait to run, so producers slow
+ * down to what the workers sustain instead of queueing without limit. The
+ * destructor runs every queued job, then joins the workers.
+ */
+struct pool {
+    struct scheduleAwaiter {
+        // Workers of this pool continue right away, they would otherwise
+        // wait on their own queue
+        [[nodiscard]] auto await_ready() const noexcept -> bool {
+            return ( _current() == &target );
+        }
+
+        // A pool shutting down leaves the coroutine on the calling thread
+        [[nodiscard]] auto await_suspend( std::coroutine_handle<> _handle )
+            -> bool {
+            return ( target.post(
+                [ _handle ]() -> void { _handle.resume(); } ) );
+        }
+
+        void await_resume() const noexcept {}
+
+        pool& target;
+    };
+
+    // _workers of 0 uses every core, _capacity of 0 queues up to 4 jobs per
+    // worker
+    explicit pool( size_t _workers = 0, size_t _capacity = 0 )
+        : _jobs( _capacity ? _capacity : ( 4 * _workerCount( _workers ) ) ) {
+        _workers = _workerCount( _workers );
+
+        _threads.reserve( _workers );
+
+        for ( size_t l_worker = 0; l_worker < _workers; l_worker++ ) {
+            _threads.emplace_back( [ this ]() -> void {
+                _current() = this;
+
+                while ( std::optional< job_t > l_job = _jobs.pop() ) {
+                    ( *l_job )();
+                }
+            } );
+        }
+    }
+
+    pool( const pool& ) = delete;
+    auto operator=( const pool& ) -> pool& = delete;
+
+    ~pool() { _jobs.close(); }
+
+    [[nodiscard]] auto workers() const -> size_t { return ( _threads.size() ); }
+
+    // Queues _job for a worker, blocking while the queue is full. False once
+    // the pool shuts down. Jobs must not throw
+    template < typename Job >
+        requires is_lambda< Job, void >
+    [[nodiscard]] auto post( Job&& _job ) -> bool {
+        return ( _jobs.push( job_t( std::forward< Job >( _job ) ) ) );
+    }
+
+    // `co_await l_pool.schedule()` continues the coroutine on a worker
+    [[nodiscard]] auto schedule() -> scheduleAwaiter {
+        return ( scheduleAwaiter{ *this } );
+    }
+
+private:
+    using job_t = std::move_only_function< void() >;
+
+    [[nodiscard]] static auto _workerCount( size_t _workers ) -> size_t {
+        return ( _workers ? _workers : thread::hardwareConcurrency() );
+    }
+
+    [[nodiscard]] static auto _current() -> pool*& {
+        thread_local pool* l_current = nullptr;
+
+        return ( l_current );
+    }
+
+    // Declared before the threads, which join before it goes away
+    queue< job_t > _jobs;
+    std::vector< std::jthread > _threads;
+};
+
+// Shared pool on every core, started on first use
+[[nodiscard]] inline auto defaultPool() -> pool& {
+    static pool l_pool;
+
+    return ( l_pool );
+}
+
+struct pipelineParameters {
+    // Items read but not written yet, 0 allows 2 per pool worker
+    size_t depth = 0;
+    // Writes in read order, otherwise each item as soon as it is transformed
+    bool ordered = true;
+};
+
+/**
+ * @brief Overlaps reading, transforming and writing a sequence of items.
+ *
+ * `_read` runs on the calling thread, `_transform` on `_pool` and `_write`
+ * on a thread of its own, so e.g. disk reads, compression and network writes
+ * proceed concurrently. At most `depth` items are in flight, a slow writer
+ * stalls the reader instead of piling up results.
+ *
+ * `_read` returns `std::nullopt` at the end, `_transform` `std::nullopt` and
+ * `_write` false on failure, which stops reading. Must not be called from a
+ * worker of `_pool`.
+ *
+ * @return True once every item read was written.
+ */
+template < typename Read,
+           typename Transform,
+           typename Write,
+           typename Input = typename std::invoke_result_t< Read& >::value_type,
+           typename Output =
+               typename std::invoke_result_t< Transform&, Input >::value_type >
+    requires( is_lambda< Read, std::optional< Input > > &&
+              is_lambda< Transform, std::optional< Output >, Input > &&
+              is_lambda< Write, bool, Output > )
+auto pipeline( Read&& _read,
+               Transform&& _transform,
+               Write&& _write,
+               const pipelineParameters& _parameters = {},
+               pool& _pool = defaultPool() ) -> bool {
+    const size_t l_depth =
+        ( _parameters.depth ? _parameters.depth : ( 2 * _pool.workers() ) );
+
+    // Free places for items in flight, released once written or dropped
+    std::counting_semaphore<> l_slots( static_cast< ptrdiff_t >( l_depth ) );
+    std::atomic< bool > l_isFailed = false;
+
+    // Holds every item in flight, so pushing never blocks
+    queue< std::pair< size_t, std::optional< Output > > > l_finished( l_depth );
+
+    std::jthread l_writer( [ & ]() -> void {
+        // Items that finished ahead of their turn, at sequence % depth
+        std::vector< std::optional< Output > > l_pending( l_depth );
+        size_t l_next = 0;
+
+        while ( auto l_item = l_finished.pop() ) {
+            auto& [ l_sequence, l_output ] = *l_item;
+
+            if ( !l_output ) [[unlikely]] {
+                l_isFailed.store( true, std::memory_order_relaxed );
+            }
+
+            if ( l_isFailed.load( std::memory_order_relaxed ) ) [[unlikely]] {
+                ptrdiff_t l_dropped = 1;
+
+                for ( std::optional< Output >& _pendingOutput : l_pending ) {
+                    l_dropped += _pendingOutput.has_value();
+
+                    _pendingOutput.reset();
+                }
+
+                l_slots.release( l_dropped );
+
+                continue;
+            }
+
+            if ( !_parameters.ordered ) {
+                if ( !_write( std::move( *l_output ) ) ) [[unlikely]] {
+                    l_isFailed.store( true, std::memory_order_relaxed );
+                }
+
+                l_slots.release();
+
+                continue;
+            }
+
+            l_pending[ l_sequence % l_depth ] = std::move( l_output );
+
+            // Past a failed write the rest is only dropped, items after a gap
+            // go once the missing one arrives
+            for ( ; l_pending[ l_next % l_depth ]; l_next++ ) {
+                std::optional< Output >& l_ready =
+                    l_pending[ l_next % l_depth ];
+
+                if ( !l_isFailed.load( std::memory_order_relaxed ) &&
+                     !_write( std::move( *l_ready ) ) ) [[unlikely]] {
+                    l_isFailed.store( true, std::memory_order_relaxed );
+                }
+
+                l_ready.reset();
+                l_slots.release();
+            }
+        }
+    } );
+
+    for ( size_t l_sequence = 0;
+          !l_isFailed.load( std::memory_order_relaxed ); l_sequence++ ) {
+        l_slots.acquire();
+
+        std::optional< Input > l_input = _read();
+
+        if ( !l_input ) {
+            l_slots.release();
+
+            break;
+        }
+
+        const bool l_isPosted = _pool.post(
+            [ &, l_sequence,
+              l_value = std::move( *l_input ) ]() mutable -> void {
+                std::optional< Output > l_output = std::nullopt;
+
+                if ( !l_isFailed.load( std::memory_order_relaxed ) )
+                    [[likely]] {
+                    l_output = _transform( std::move( l_value ) );
+                }
+
+                ( void )l_finished.push(
+                    { l_sequence, std::move( l_output ) } );
+            } );
+
+        if ( !l_isPosted ) [[unlikely]] {
+            l_isFailed.store( true, std::memory_order_relaxed );
+            l_slots.release();
+        }
+    }
+
+    // Every slot back means every item was written or dropped
+    for ( size_t l_slot = 0; l_slot < l_depth; l_slot++ ) {
+        l_slots.acquire();
+    }
+
+    l_finished.close();
+    l_writer.join();
+
+    return ( !l_isFailed.load( std::memory_order_relaxed ) );
+}
+
+} // namespace stdfunc::async
@@ -0,0 +1,424 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace stdfunc::entropy {
+
+using histogram_t = std::array< size_t, 256 >;
+
+// log2 of the tANS state count, frequencies sum to 2^tableLog
+constexpr size_t g_minTableLog = 5;
+constexpr size_t g_maxTableLog = 12;
+constexpr size_t g_defaultTableLog = 11;
+// Longest Huffman code, one 2^11 entry table decodes every code
+constexpr size_t g_maxCodeLength = 11;
+
+/**
+ * @brief Adds the byte counts of `_data` to `_counts`.
+ *
+ * Every 8 byte load feeds four interleaved tables, so runs of one byte value
+ * do not serialize on a single counter and the loop pipelines. 32 bit
+ * counters keep the tables in half the cache, chunks keep them from
+ * overflowing.
+ */
+inline void count( std::span< const std::byte > _data, histogram_t& _counts ) {
+    constexpr size_t l_chunkSize = ( size_t{ 1 } << 32 );
+
+    for ( ; !_data.empty(); ) {
+        const std::span< const std::byte > l_chunk =
+            _data.first( std::min( _data.size(), l_chunkSize ) );
+
+        std::array< std::array< uint32_t, 256 >, 4 > l_tables{};
+
+        const auto* l_bytes =
+            reinterpret_cast< const uint8_t* >( l_chunk.data() );
+        size_t l_index = 0;
+
+        for ( ; ( l_index + sizeof( uint64_t ) ) <= l_chunk.size();
+              l_index += sizeof( uint64_t ) ) {
+            uint64_t l_word = 0;
+
+            std::memcpy( &l_word, ( l_bytes + l_index ), sizeof( l_word ) );
+
+            [ & ]< size_t... Byte >( std::index_sequence< Byte... > ) -> void {
+                ( l_tables[ Byte % 4 ][ ( l_word >> ( Byte * 8 ) ) & 0xFF ]++,
+                  ... );
+            }( std::make_index_sequence< sizeof( l_word ) >{} );
+        }
+
+        for ( ; l_index < l_chunk.size(); l_index++ ) {
+            l_tables[ 0 ][ l_bytes[ l_index ] ]++;
+        }
+
+        for ( size_t l_value = 0; l_value < _counts.size(); l_value++ ) {
+            _counts[ l_value ] +=
+                ( size_t{ l_tables[ 0 ][ l_value ] } +
+                  l_tables[ 1 ][ l_value ] + l_tables[ 2 ][ l_value ] +
+                  l_tables[ 3 ][ l_value ] );
+        }
+
+        _data = _data.subspan( l_chunk.size() );
+    }
+}
+
+[[nodiscard]] inline auto histogram( std::span< const std::byte > _data )
+    -> histogram_t {
+    histogram_t l_returnValue{};
+
+    count( _data, l_returnValue );
+
+    return ( l_returnValue );
+}
+
+// Symbol frequencies scaled to sum to 2^tableLog, the model the tANS and
+// Huffman coders of compress and decompress build their tables from
+struct distribution {
+    size_t tableLog = g_defaultTableLog;
+    std::array< uint16_t, 256 > frequencies{};
+};
+
+// Table log in range and frequencies summing to 2^tableLog
+[[nodiscard]] inline auto isValid( const distribution& _distribution )
+    -> bool {
+    bool l_returnValue = false;
+
+    if ( ( _distribution.tableLog >= g_minTableLog ) &&
+         ( _distribution.tableLog <= g_maxTableLog ) ) {
+        size_t l_sum = 0;
+
+        for ( const uint16_t _frequency : _distribution.frequencies ) {
+            l_sum += _frequency;
+        }
+
+        l_returnValue = ( l_sum == ( size_t{ 1 } << _distribution.tableLog ) );
+    }
+
+    return ( l_returnValue );
+}
+
+/**
+ * @brief Scale `_counts` to 2^`_tableLog`, every present symbol keeping a
+ *        frequency of at least 1.
+ *
+ * @return `std::nullopt` without symbols, for a table log out of range or
+ *         more present symbols than states.
+ */
+[[nodiscard]] inline auto normalize( const histogram_t& _counts,
+                                     size_t _tableLog = g_defaultTableLog )
+    -> std::optional< distribution > {
+    std::optional< distribution > l_returnValue = std::nullopt;
+
+    do {
+        if ( ( _tableLog < g_minTableLog ) || ( _tableLog > g_maxTableLog ) )
+            [[unlikely]] {
+            break;
+        }
+
+        size_t l_total = 0;
+        size_t l_symbolCount = 0;
+
+        for ( const size_t _count : _counts ) {
+            l_total += _count;
+            l_symbolCount += !!_count;
+        }
+
+        const size_t l_states = ( size_t{ 1 } << _tableLog );
+
+        if ( !l_total || ( l_symbolCount > l_states ) ) [[unlikely]] {
+            break;
+        }
+
+        distribution l_distribution{ .tableLog = _tableLog };
+        size_t l_sum = 0;
+
+        for ( size_t l_symbol = 0; l_symbol < _counts.size(); l_symbol++ ) {
+            if ( !_counts[ l_symbol ] ) {
+                continue;
+            }
+
+            const auto l_scaled = static_cast< size_t >( std::llround(
+                ( static_cast< double >( _counts[ l_symbol ] ) *
+                  static_cast< double >( l_states ) ) /
+                static_cast< double >( l_total ) ) );
+
+            l_distribution.frequencies[ l_symbol ] =
+                static_cast< uint16_t >( std::max( l_scaled, size_t{ 1 } ) );
+            l_sum += l_distribution.frequencies[ l_symbol ];
+        }
+
+        // Rounding and the minimum of 1 overshoot, take it from the most
+        // frequent symbols where it costs the least
+        for ( ; l_sum > l_states; l_sum-- ) {
+            ( *std::ranges::max_element( l_distribution.frequencies ) )--;
+        }
+
+        ( *std::ranges::max_element( l_distribution.frequencies ) ) +=
+            static_cast< uint16_t >( l_states - l_sum );
+
+        l_returnValue = l_distribution;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+// Table log, last present symbol, then the LEB128 frequency of every symbol
+// up to it
+[[nodiscard]] inline auto serialize( const distribution& _distribution )
+    -> std::vector< std::byte > {
+    std::vector< std::byte > l_returnValue;
+
+    size_t l_last = _distribution.frequencies.size();
+
+    while ( ( l_last > 1 ) && !_distribution.frequencies[ l_last - 1 ] ) {
+        l_last--;
+    }
+
+    l_returnValue.emplace_back(
+        static_cast< std::byte >( _distribution.tableLog ) );
+    l_returnValue.emplace_back( static_cast< std::byte >( l_last - 1 ) );
+
+    for ( size_t l_symbol = 0; l_symbol < l_last; l_symbol++ ) {
+        size_t l_frequency = _distribution.frequencies[ l_symbol ];
+
+        for ( ; l_frequency >= 0x80; l_frequency >>= 7 ) {
+            l_returnValue.emplace_back(
+                static_cast< std::byte >( ( l_frequency & 0x7F ) | 0x80 ) );
+        }
+
+        l_returnValue.emplace_back( static_cast< std::byte >( l_frequency ) );
+    }
+
+    return ( l_returnValue );
+}
+
+// Consumes a serialized distribution from the front of _data, std::nullopt
+// when it is truncated or not valid
+[[nodiscard]] inline auto deserialize( std::span< const std::byte >& _data )
+    -> std::optional< distribution > {
+    std::optional< distribution > l_returnValue = std::nullopt;
+
+    do {
+        if ( _data.size() < 2 ) [[unlikely]] {
+            break;
+        }
+
+        distribution l_distribution{
+            .tableLog = static_cast< uint8_t >( _data[ 0 ] ) };
+        const size_t l_last = ( static_cast< uint8_t >( _data[ 1 ] ) + 1 );
+
+        std::span< const std::byte > l_rest = _data.subspan( 2 );
+        bool l_isTruncated = false;
+
+        for ( size_t l_symbol = 0; l_symbol < l_last; l_symbol++ ) {
+            size_t l_frequency = 0;
+            size_t l_shift = 0;
+            bool l_hasEnd = false;
+
+            // Frequencies take at most 2 bytes
+            for ( ; !l_rest.empty() && ( l_shift < 14 ); l_shift += 7 ) {
+                const auto l_byte = static_cast< uint8_t >( l_rest.front() );
+
+                l_rest = l_rest.subspan( 1 );
+                l_frequency |= ( static_cast< size_t >( l_byte & 0x7F )
+                                 << l_shift );
+
+                if ( !( l_byte & 0x80 ) ) {
+                    l_hasEnd = true;
+
+                    break;
+                }
+            }
+
+            if ( !l_hasEnd || ( l_frequency > 0xFFFF ) ) [[unlikely]] {
+                l_isTruncated = true;
+
+                break;
+            }
+
+            l_distribution.frequencies[ l_symbol ] =
+                static_cast< uint16_t >( l_frequency );
+        }
+
+        if ( l_isTruncated || !isValid( l_distribution ) ) [[unlikely]] {
+            break;
+        }
+
+        _data = l_rest;
+        l_returnValue = l_distribution;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+/**
+ * @brief Huffman code lengths of up to `g_maxCodeLength` bits, 0 for absent
+ *        symbols. A single symbol gets a 1 bit code.
+ *
+ * Frequencies are halved until the tree fits, which both sides repeat
+ * exactly, so only the distribution has to be shared.
+ */
+[[nodiscard]] inline auto codeLengths( const distribution& _distribution )
+    -> std::array< uint8_t, 256 > {
+    std::array< uint8_t, 256 > l_returnValue{};
+
+    std::array< size_t, 256 > l_weights{};
+
+    std::ranges::copy( _distribution.frequencies, l_weights.begin() );
+
+    // Weight and symbol, lightest first
+    std::vector< std::pair< size_t, size_t > > l_leaves;
+
+    for ( size_t l_symbol = 0; l_symbol < l_weights.size(); l_symbol++ ) {
+        if ( l_weights[ l_symbol ] ) {
+            l_leaves.emplace_back( 0, l_symbol );
+        }
+    }
+
+    if ( l_leaves.size() == 1 ) {
+        l_returnValue[ l_leaves.front().second ] = 1;
+    }
+
+    for ( bool l_fits = ( l_leaves.size() < 2 ); !l_fits; ) {
+        for ( auto& _leaf : l_leaves ) {
+            _leaf.first = l_weights[ _leaf.second ];
+        }
+
+        std::ranges::sort( l_leaves );
+
+        // Two queue construction: leaves, then internal nodes in the order
+        // they are made, both already sorted by weight
+        const size_t l_leafCount = l_leaves.size();
+        std::vector< size_t > l_nodeWeights( ( l_leafCount * 2 ) - 1 );
+        std::vector< size_t > l_parents( l_nodeWeights.size() );
+
+        for ( size_t l_index = 0; l_index < l_leafCount; l_index++ ) {
+            l_nodeWeights[ l_index ] = l_leaves[ l_index ].first;
+        }
+
+        size_t l_nextLeaf = 0;
+        size_t l_nextNode = l_leafCount;
+
+        const auto l_takeLightest = [ & ]( size_t _created ) -> size_t {
+            const bool l_isLeaf =
+                ( ( l_nextLeaf < l_leafCount ) &&
+                  ( ( l_nextNode == _created ) ||
+                    ( l_nodeWeights[ l_nextLeaf ] <=
+                      l_nodeWeights[ l_nextNode ] ) ) );
+
+            return ( l_isLeaf ? l_nextLeaf++ : l_nextNode++ );
+        };
+
+        for ( size_t l_created = l_leafCount;
+              l_created < l_nodeWeights.size(); l_created++ ) {
+            const size_t l_first = l_takeLightest( l_created );
+            const size_t l_second = l_takeLightest( l_created );
+
+            l_nodeWeights[ l_created ] =
+                ( l_nodeWeights[ l_first ] + l_nodeWeights[ l_second ] );
+            l_parents[ l_first ] = l_created;
+            l_parents[ l_second ] = l_created;
+        }
+
+        // Depths from the root down, parents always come later
+        std::vector< size_t > l_depths( l_nodeWeights.size() );
+
+        for ( size_t l_node = ( l_nodeWeights.size() - 1 ); l_node-- > 0; ) {
+            l_depths[ l_node ] = ( l_depths[ l_parents[ l_node ] ] + 1 );
+        }
+
+        l_fits = ( *std::ranges::max_element(
+                       std::span( l_depths ).first( l_leafCount ) ) <=
+                   g_maxCodeLength );
+
+        if ( l_fits ) {
+            for ( size_t l_index = 0; l_index < l_leafCount; l_index++ ) {
+                l_returnValue[ l_leaves[ l_index ].second ] =
+                    static_cast< uint8_t >( l_depths[ l_index ] );
+            }
+        } else {
+            for ( size_t& _weight : l_weights ) {
+                _weight = ( ( _weight + 1 ) / 2 );
+            }
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+// Canonical codes for _lengths, bit reversed for least significant bit first
+// streams
+[[nodiscard]] inline auto canonicalCodes(
+    const std::array< uint8_t, 256 >& _lengths )
+    -> std::array< uint16_t, 256 > {
+    std::array< uint16_t, 256 > l_returnValue{};
+
+    std::array< size_t, ( g_maxCodeLength + 1 ) > l_lengthCounts{};
+
+    for ( const uint8_t _length : _lengths ) {
+        l_lengthCounts[ _length ]++;
+    }
+
+    l_lengthCounts[ 0 ] = 0;
+
+    std::array< size_t, ( g_maxCodeLength + 1 ) > l_nextCodes{};
+    size_t l_code = 0;
+
+    for ( size_t l_length = 1; l_length <= g_maxCodeLength; l_length++ ) {
+        l_code = ( ( l_code + l_lengthCounts[ l_length - 1 ] ) << 1 );
+        l_nextCodes[ l_length ] = l_code;
+    }
+
+    for ( size_t l_symbol = 0; l_symbol < _lengths.size(); l_symbol++ ) {
+        const size_t l_length = _lengths[ l_symbol ];
+
+        if ( !l_length ) {
+            continue;
+        }
+
+        const size_t l_canonical = l_nextCodes[ l_length ]++;
+        size_t l_reversed = 0;
+
+        for ( size_t l_bit = 0; l_bit < l_length; l_bit++ ) {
+            l_reversed |= ( ( ( l_canonical >> l_bit ) & 1 )
+                            << ( l_length - 1 - l_bit ) );
+        }
+
+        l_returnValue[ l_symbol ] = static_cast< uint16_t >( l_reversed );
+    }
+
+    return ( l_returnValue );
+}
+
+// Symbol of every tANS state, each symbol's states spread far apart
+[[nodiscard]] inline auto spread( const distribution& _distribution )
+    -> std::vector< uint8_t > {
+    const size_t l_states = ( size_t{ 1 } << _distribution.tableLog );
+    // Odd, so stepping visits every state once
+    const size_t l_step = ( ( l_states >> 1 ) + ( l_states >> 3 ) + 3 );
+
+    std::vector< uint8_t > l_returnValue( l_states );
+    size_t l_position = 0;
+
+    for ( size_t l_symbol = 0; l_symbol < _distribution.frequencies.size();
+          l_symbol++ ) {
+        for ( size_t l_index = 0;
+              l_index < _distribution.frequencies[ l_symbol ]; l_index++ ) {
+            l_returnValue[ l_position ] = static_cast< uint8_t >( l_symbol );
+            l_position = ( ( l_position + l_step ) & ( l_states - 1 ) );
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+} // namespace stdfunc::entropy
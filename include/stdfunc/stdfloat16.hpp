@@ -1,9 +1,12 @@
 #pragma once
 
 #include <cmath>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <format>
 #include <limits>
+#include <type_traits>
 
 #include "stdfunc.hpp"
 
@@ -23,6 +26,48 @@ using float16x16_t = float16_t __attribute__( (
 using float16x32_t = float16_t __attribute__( (
     vector_size( stdfunc::bitsToBytes( g_float16TypeBitAmount * 32 ) ) ) );
 
+namespace stdfunc {
+
+template < typename T >
+concept is_float16 = std::is_same_v< std::remove_cv_t< T >, float16_t >;
+
+template < typename T >
+concept is_float16_vector =
+    ( std::is_same_v< std::remove_cv_t< T >, float16x2_t > ||
+      std::is_same_v< std::remove_cv_t< T >, float16x4_t > ||
+      std::is_same_v< std::remove_cv_t< T >, float16x8_t > ||
+      std::is_same_v< std::remove_cv_t< T >, float16x16_t > ||
+      std::is_same_v< std::remove_cv_t< T >, float16x32_t > );
+
+// Same-width integer and float lane types for each float16xN_t, spelled out
+// because dependent vector_size is not honoured by every compiler
+template < is_float16_vector T >
+struct float16VectorTraits;
+
+#define STDFUNC_FLOAT16_VECTOR_TRAITS( _lanes )                        \
+    template <>                                                        \
+    struct float16VectorTraits< float16x##_lanes##_t > {               \
+        static constexpr size_t lanes = _lanes;                        \
+        using bits_t = uint16_t                                        \
+            __attribute__( ( vector_size( ( _lanes ) * 2 ) ) );        \
+        using float32_t =                                              \
+            float __attribute__( ( vector_size( ( _lanes ) * 4 ) ) ); \
+    }
+
+STDFUNC_FLOAT16_VECTOR_TRAITS( 2 );
+STDFUNC_FLOAT16_VECTOR_TRAITS( 4 );
+STDFUNC_FLOAT16_VECTOR_TRAITS( 8 );
+STDFUNC_FLOAT16_VECTOR_TRAITS( 16 );
+STDFUNC_FLOAT16_VECTOR_TRAITS( 32 );
+
+#undef STDFUNC_FLOAT16_VECTOR_TRAITS
+
+// std::floating_point does not cover _Float16 on every standard library
+template < typename T >
+concept is_floating_point = ( std::floating_point< T > || is_float16< T > );
+
+} // namespace stdfunc
+
 namespace std {
 
 template <>
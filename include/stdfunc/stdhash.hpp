@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <ranges>
 #include <span>
 #include <type_traits>
@@ -30,6 +33,12 @@
 
 #endif
 
+#if defined( __SSE4_2__ )
+
+#include <nmmintrin.h>
+
+#endif
+
 #include "stddebug.hpp"
 
 namespace stdfunc::hash {
@@ -161,4 +170,173 @@ template < std::integral T, typename ReturnT = std::make_unsigned_t< T > >
     }
 }
 
+namespace {
+
+// Reflected Castagnoli polynomial
+constexpr auto g_crc32cTable = []() -> std::array< uint32_t, 256 > {
+    std::array< uint32_t, 256 > l_returnValue{};
+
+    for ( uint32_t l_index = 0; l_index < l_returnValue.size(); l_index++ ) {
+        uint32_t l_crc = l_index;
+
+        for ( size_t l_bit = 0; l_bit < 8; l_bit++ ) {
+            l_crc = ( ( l_crc & 1 ) ? ( ( l_crc >> 1 ) ^ 0x82F63B78 )
+                                    : ( l_crc >> 1 ) );
+        }
+
+        l_returnValue[ l_index ] = l_crc;
+    }
+
+    return ( l_returnValue );
+}();
+
+} // namespace
+
+// CRC-32C ( Castagnoli ) with the SSE4.2 crc32 instruction when available.
+// Pass the previous result as _crc to continue over split data
+[[nodiscard]] constexpr auto crc32c( std::span< const std::byte > _data,
+                                     uint32_t _crc = 0 ) -> uint32_t {
+    uint32_t l_crc = ~_crc;
+    size_t l_index = 0;
+
+#if defined( __SSE4_2__ )
+
+    if !consteval {
+        uint64_t l_wideCrc = l_crc;
+
+        for ( ; ( l_index + sizeof( uint64_t ) ) <= _data.size();
+              l_index += sizeof( uint64_t ) ) {
+            uint64_t l_word = 0;
+
+            __builtin_memcpy( &l_word, ( _data.data() + l_index ),
+                              sizeof( l_word ) );
+
+            l_wideCrc = _mm_crc32_u64( l_wideCrc, l_word );
+        }
+
+        l_crc = static_cast< uint32_t >( l_wideCrc );
+    }
+
+#endif
+
+    for ( ; l_index < _data.size(); l_index++ ) {
+        l_crc = ( g_crc32cTable[ ( l_crc ^ static_cast< uint32_t >(
+                                               _data[ l_index ] ) ) &
+                                 0xFF ] ^
+                  ( l_crc >> 8 ) );
+    }
+
+    return ( ~l_crc );
+}
+
+namespace {
+
+constexpr uint64_t g_xxh64Prime1 = 0x9E3779B185EBCA87;
+constexpr uint64_t g_xxh64Prime2 = 0xC2B2AE3D27D4EB4F;
+constexpr uint64_t g_xxh64Prime3 = 0x165667B19E3779F9;
+constexpr uint64_t g_xxh64Prime4 = 0x85EBCA77C2B2AE63;
+constexpr uint64_t g_xxh64Prime5 = 0x27D4EB2F165667C5;
+
+// Little endian load, folded into a single load by the compiler
+template < typename T >
+[[nodiscard]] constexpr auto _loadLittleEndian(
+    std::span< const std::byte > _data,
+    size_t _index ) -> T {
+    T l_returnValue = 0;
+
+    for ( size_t l_byte = 0; l_byte < sizeof( T ); l_byte++ ) {
+        l_returnValue |= ( static_cast< T >( _data[ _index + l_byte ] )
+                           << ( l_byte * 8 ) );
+    }
+
+    return ( l_returnValue );
+}
+
+[[nodiscard]] constexpr auto _xxh64Round( uint64_t _accumulator,
+                                          uint64_t _input ) -> uint64_t {
+    return ( std::rotl( ( _accumulator + ( _input * g_xxh64Prime2 ) ), 31 ) *
+             g_xxh64Prime1 );
+}
+
+[[nodiscard]] constexpr auto _xxh64Merge( uint64_t _accumulator,
+                                          uint64_t _lane ) -> uint64_t {
+    return ( ( ( _accumulator ^ _xxh64Round( 0, _lane ) ) * g_xxh64Prime1 ) +
+             g_xxh64Prime4 );
+}
+
+} // namespace
+
+// XXH64, the checksum of zstd frames and the zstd seekable format
+[[nodiscard]] constexpr auto xxh64( std::span< const std::byte > _data,
+                                    uint64_t _seed = 0 ) -> uint64_t {
+#if defined( HAS_XXH3 )
+
+    if !consteval {
+        return ( XXH64( _data.data(), _data.size(), _seed ) );
+    }
+
+#endif
+
+    size_t l_index = 0;
+    uint64_t l_hash = 0;
+
+    if ( _data.size() >= 32 ) {
+        std::array< uint64_t, 4 > l_lanes{
+            ( _seed + g_xxh64Prime1 + g_xxh64Prime2 ),
+            ( _seed + g_xxh64Prime2 ), _seed, ( _seed - g_xxh64Prime1 ) };
+
+        for ( ; ( l_index + 32 ) <= _data.size(); l_index += 32 ) {
+            for ( size_t l_lane = 0; l_lane < l_lanes.size(); l_lane++ ) {
+                l_lanes[ l_lane ] = _xxh64Round(
+                    l_lanes[ l_lane ],
+                    _loadLittleEndian< uint64_t >(
+                        _data, ( l_index + ( l_lane * 8 ) ) ) );
+            }
+        }
+
+        l_hash = ( std::rotl( l_lanes[ 0 ], 1 ) + std::rotl( l_lanes[ 1 ], 7 ) +
+                   std::rotl( l_lanes[ 2 ], 12 ) +
+                   std::rotl( l_lanes[ 3 ], 18 ) );
+
+        for ( const uint64_t _lane : l_lanes ) {
+            l_hash = _xxh64Merge( l_hash, _lane );
+        }
+
+    } else {
+        l_hash = ( _seed + g_xxh64Prime5 );
+    }
+
+    l_hash += _data.size();
+
+    for ( ; ( l_index + 8 ) <= _data.size(); l_index += 8 ) {
+        l_hash ^= _xxh64Round(
+            0, _loadLittleEndian< uint64_t >( _data, l_index ) );
+        l_hash = ( ( std::rotl( l_hash, 27 ) * g_xxh64Prime1 ) +
+                   g_xxh64Prime4 );
+    }
+
+    if ( ( l_index + 4 ) <= _data.size() ) {
+        l_hash ^= ( _loadLittleEndian< uint32_t >( _data, l_index ) *
+                    g_xxh64Prime1 );
+        l_hash =
+            ( ( std::rotl( l_hash, 23 ) * g_xxh64Prime2 ) + g_xxh64Prime3 );
+
+        l_index += 4;
+    }
+
+    for ( ; l_index < _data.size(); l_index++ ) {
+        l_hash ^= ( static_cast< uint64_t >( _data[ l_index ] ) *
+                    g_xxh64Prime5 );
+        l_hash = ( std::rotl( l_hash, 11 ) * g_xxh64Prime1 );
+    }
+
+    l_hash ^= ( l_hash >> 33 );
+    l_hash *= g_xxh64Prime2;
+    l_hash ^= ( l_hash >> 29 );
+    l_hash *= g_xxh64Prime3;
+    l_hash ^= ( l_hash >> 32 );
+
+    return ( l_hash );
+}
+
 } // namespace stdfunc::hash
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "stdconcepts.hpp"
+
+namespace stdfunc::thread {
+
+// Logical cores, at least 1
+[[nodiscard]] inline auto hardwareConcurrency() -> size_t {
+    return ( std::max( std::thread::hardware_concurrency(), 1U ) );
+}
+
+/**
+ * @brief Runs `_function( index )` for every index in [ 0, _count ) on up to
+ *        _workers threads, the calling thread included, and returns once all
+ *        are done.
+ *
+ * Indices are handed out one at a time from a shared counter, so uneven work
+ * balances itself. `_workers` of 0 uses every core, 1 runs inline.
+ */
+template < typename Function >
+    requires is_lambda< Function, void, size_t >
+void parallelFor( size_t _count, Function&& _function, size_t _workers = 0 ) {
+    if ( !_workers ) {
+        _workers = hardwareConcurrency();
+    }
+
+    _workers = std::min( _workers, _count );
+
+    if ( _workers <= 1 ) {
+        for ( size_t l_index = 0; l_index < _count; l_index++ ) {
+            _function( l_index );
+        }
+
+        return;
+    }
+
+    std::atomic< size_t > l_next = 0;
+
+    auto l_work = [ & ]() -> void {
+        for ( size_t l_index = l_next.fetch_add( 1, std::memory_order_relaxed );
+              l_index < _count;
+              l_index = l_next.fetch_add( 1, std::memory_order_relaxed ) ) {
+            _function( l_index );
+        }
+    };
+
+    std::vector< std::jthread > l_threads;
+
+    l_threads.reserve( _workers - 1 );
+
+    for ( size_t l_worker = 1; l_worker < _workers; l_worker++ ) {
+        l_threads.emplace_back( l_work );
+    }
+
+    l_work();
+}
+
+} // namespace stdfunc::thread
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <span>
+
+namespace stdfunc::id {
+
+constexpr size_t g_uuidTextLength = 36;
+constexpr size_t g_ulidTextLength = 26;
+
+// Big-endian, RFC 9562 layout
+struct uuid {
+    std::array< std::byte, 16 > bytes;
+
+    constexpr auto operator<=>( const uuid& ) const = default;
+};
+
+// Big-endian: 48bits of milliseconds then 80bits of randomness
+struct ulid {
+    std::array< std::byte, 16 > bytes;
+
+    constexpr auto operator<=>( const ulid& ) const = default;
+};
+
+/**
+ * @brief Random ( version 4 ) UUID.
+ *
+ * @threadsafe Uses the thread-local balanced engine.
+ */
+[[nodiscard]] auto makeUuid4() -> uuid;
+
+void makeUuid4( std::span< uuid > _result );
+
+/**
+ * @brief Time-ordered ( version 7 ) UUID.
+ *
+ * 48bits of Unix milliseconds followed by a 12bits counter that is reseeded
+ * every millisecond and incremented within it ( RFC 9562 method 1 ). When the
+ * counter overflows or the clock goes backwards the timestamp is advanced
+ * instead, so values generated on one thread are strictly increasing.
+ *
+ * @threadsafe Monotonic per thread; no synchronization between threads.
+ */
+[[nodiscard]] auto makeUuid7() -> uuid;
+
+// Reads the clock once for the whole batch
+void makeUuid7( std::span< uuid > _result );
+
+/**
+ * @brief ULID with monotonic randomness.
+ *
+ * Within the same millisecond the 80bits random part of the previous value is
+ * incremented, on overflow the timestamp is advanced.
+ *
+ * @threadsafe Monotonic per thread; no synchronization between threads.
+ */
+[[nodiscard]] auto makeUlid() -> ulid;
+
+// Reads the clock once for the whole batch
+void makeUlid( std::span< ulid > _result );
+
+// Lowercase 8-4-4-4-12 hex
+void encode( const uuid& _uuid, std::span< char, g_uuidTextLength > _result );
+
+// Crockford base32
+void encode( const ulid& _ulid, std::span< char, g_ulidTextLength > _result );
+
+// Consecutive texts without separators, _result must hold all of them
+void encode( std::span< const uuid > _uuids, std::span< char > _result );
+void encode( std::span< const ulid > _ulids, std::span< char > _result );
+
+[[nodiscard]] auto text( const uuid& _uuid )
+    -> std::array< char, g_uuidTextLength >;
+
+[[nodiscard]] auto text( const ulid& _ulid )
+    -> std::array< char, g_ulidTextLength >;
+
+// Random [0-9A-Za-z] over the whole span, unbiased
+void base62( std::span< char > _result );
+
+// Random Crockford base32 over the whole span
+void base32( std::span< char > _result );
+
+template < size_t N >
+[[nodiscard]] auto base62() -> std::array< char, N > {
+    std::array< char, N > l_returnValue{};
+
+    base62( l_returnValue );
+
+    return ( l_returnValue );
+}
+
+template < size_t N >
+[[nodiscard]] auto base32() -> std::array< char, N > {
+    std::array< char, N > l_returnValue{};
+
+    base32( l_returnValue );
+
+    return ( l_returnValue );
+}
+
+} // namespace stdfunc::id
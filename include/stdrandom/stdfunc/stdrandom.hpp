@@ -1,12 +1,19 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <bit>
+#include <cmath>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <limits>
 #include <random>
+#include <ranges>
+#include <span>
+#include <vector>
 
 #if defined( __x86_64__ )
 
@@ -14,6 +21,13 @@
 
 #endif
 
+#if defined( __F16C__ )
+
+#include <immintrin.h>
+
+#endif
+
+#include "stdfloat16.hpp"
 #include "stdhash.hpp"
 #include "stdtodo.hpp"
 
@@ -124,31 +138,116 @@ using engine_t = std::
 
 extern thread_local engine_t g_engine;
 
+// Raw 64 bits from the balanced engine
+[[nodiscard]] inline auto bits() -> uint64_t {
+    if constexpr ( engine_t::max() >= std::numeric_limits< uint64_t >::max() ) {
+        return ( g_engine() );
+
+    } else {
+        const uint64_t l_high = g_engine();
+
+        return ( ( l_high << 32 ) | g_engine() );
+    }
+}
+
+namespace {
+
+constexpr uint16_t g_float16MantissaMask = 0x03FF;
+constexpr uint16_t g_float16One = 0x3C00;
+
+// Random mantissa under a fixed exponent gives [ 1, 2 ) without any
+// conversion, so a single word is 4 half-precision lanes. Scaling happens in
+// float lanes ( F16C converts ) unless the target has native FP16 arithmetic
+// and the range is representable
+template < is_float16_vector T >
+[[nodiscard]] auto _uniformFloat16( float _min, float _max ) -> T {
+    using bits_t = typename float16VectorTraits< T >::bits_t;
+    using float32_t = typename float16VectorTraits< T >::float32_t;
+
+    std::array< uint64_t, ( ( sizeof( T ) + 7 ) / 8 ) > l_words{};
+
+    for ( auto& _word : l_words ) {
+        _word = bits();
+    }
+
+    bits_t l_bits{};
+
+    std::memcpy( &l_bits, l_words.data(), sizeof( l_bits ) );
+
+    l_bits = ( ( l_bits & g_float16MantissaMask ) | g_float16One );
+
+    const T l_oneToTwo = std::bit_cast< T >( l_bits );
+    const float l_scale = ( _max - _min );
+
+#if defined( __AVX512FP16__ )
+
+    if ( l_scale <= static_cast< float >(
+                        std::numeric_limits< float16_t >::max() ) ) {
+        return ( ( ( l_oneToTwo - static_cast< float16_t >( 1 ) ) *
+                   static_cast< float16_t >( l_scale ) ) +
+                 static_cast< float16_t >( _min ) );
+    }
+
+#endif
+
+    const float32_t l_result =
+        ( ( ( __builtin_convertvector( l_oneToTwo, float32_t ) - 1.0F ) *
+            l_scale ) +
+          _min );
+
+    return ( __builtin_convertvector( l_result, T ) );
+}
+
+} // namespace
+
 template < typename T >
-    requires std::is_arithmetic_v< T >
+    requires( std::is_arithmetic_v< T > || is_float16< T > )
 auto balanced( T _min, T _max ) -> T {
-    using distribution_t =
-        std::conditional_t< std::is_integral_v< T >,
-                            std::uniform_int_distribution< T >,
-                            std::uniform_real_distribution< T > >;
+    if constexpr ( is_float16< T > ) {
+        return ( _uniformFloat16< float16x4_t >( static_cast< float >( _min ),
+                                                 static_cast< float >( _max ) )
+                     [ 0 ] );
 
-    return ( ( distribution_t( _min, _max ) )( g_engine ) );
+    } else {
+        using distribution_t =
+            std::conditional_t< std::is_integral_v< T >,
+                                std::uniform_int_distribution< T >,
+                                std::uniform_real_distribution< T > >;
+
+        return ( ( distribution_t( _min, _max ) )( g_engine ) );
+    }
+}
+
+// Vector of independent lanes in [ _min, _max ]
+template < is_float16_vector T >
+auto balanced( float16_t _min, float16_t _max ) -> T {
+    return ( _uniformFloat16< T >( static_cast< float >( _min ),
+                                   static_cast< float >( _max ) ) );
 }
 
 template < typename T >
-    requires std::is_arithmetic_v< T >
+    requires( std::is_arithmetic_v< T > || is_float16< T > ||
+              is_float16_vector< T > )
 auto balanced() -> T {
-    using numericLimit_t = std::numeric_limits< T >;
+    if constexpr ( is_float16< T > || is_float16_vector< T > ) {
+        using numericLimit_t = std::numeric_limits< float16_t >;
+
+        return ( balanced< T >( numericLimit_t::lowest(),
+                                numericLimit_t::max() ) );
+
+    } else {
+        using numericLimit_t = std::numeric_limits< T >;
 
-    const auto l_max = numericLimit_t::max();
+        const auto l_max = numericLimit_t::max();
 
-    if constexpr ( std::is_integral_v< T > ) {
-        return ( ( std::uniform_int_distribution< T >( numericLimit_t::min(),
-                                                       l_max ) )( g_engine ) );
+        if constexpr ( std::is_integral_v< T > ) {
+            return ( ( std::uniform_int_distribution< T >(
+                numericLimit_t::min(), l_max ) )( g_engine ) );
 
-    } else if constexpr ( std::is_floating_point_v< T > ) {
-        return ( ( std::uniform_real_distribution< T >(
-            numericLimit_t::lowest(), l_max ) )( g_engine ) );
+        } else if constexpr ( std::is_floating_point_v< T > ) {
+            return ( ( std::uniform_real_distribution< T >(
+                numericLimit_t::lowest(), l_max ) )( g_engine ) );
+        }
     }
 }
 
@@ -181,7 +280,7 @@ auto robust() -> T {
 }
 
 template < typename T >
-    requires std::is_arithmetic_v< T >
+    requires( std::is_arithmetic_v< T > || is_float16< T > )
 constexpr auto g_defaultNumberGenerator = []( auto... _arguments ) -> T {
     return ( balanced< T >( _arguments... ) );
 };
@@ -222,11 +321,177 @@ constexpr auto view( const Container& _container ) {
                  [ & ]( auto ) -> auto { return ( value( _container ) ); } ) );
 }
 
+// Bijection over [ 0, size ) without materializing it: balanced Feistel
+// network with hash::weak round functions on the smallest even bit width that
+// covers size, cycle-walking until the result falls back into range
+struct permutation {
+    constexpr explicit permutation(
+        uint64_t _size,
+        uint64_t _seed = g_goldenRatioSeed< uint64_t > )
+        : _size( _size ) {
+        assert( _size );
+
+        const auto l_bits = static_cast< uint32_t >(
+            std::bit_width( std::max( _size, uint64_t{ 2 } ) - 1 ) );
+
+        _halfBits = ( ( l_bits + 1 ) / 2 );
+        _halfMask = ( ( uint64_t{ 1 } << _halfBits ) - 1 );
+
+        for ( uint64_t l_round = 0; l_round < _keys.size(); l_round++ ) {
+            _keys[ l_round ] = hash::weak< uint64_t >(
+                std::bit_cast< std::array< std::byte, 16 > >(
+                    std::array{ _seed, l_round } ) );
+        }
+    }
+
+    [[nodiscard]] constexpr auto size() const -> uint64_t { return ( _size ); }
+
+    [[nodiscard]] constexpr auto map( uint64_t _index ) const -> uint64_t {
+        assert( _index < _size );
+
+        do {
+            _index = _encrypt( _index );
+        } while ( _index >= _size );
+
+        return ( _index );
+    }
+
+    [[nodiscard]] constexpr auto unmap( uint64_t _index ) const -> uint64_t {
+        assert( _index < _size );
+
+        do {
+            _index = _decrypt( _index );
+        } while ( _index >= _size );
+
+        return ( _index );
+    }
+
+    [[nodiscard]] constexpr auto operator()( uint64_t _index ) const
+        -> uint64_t {
+        return ( map( _index ) );
+    }
+
+    // Round-major over fixed blocks so every round is a straight loop the
+    // compiler can vectorize, cycle-walking only the few indices that left
+    // the range
+    void map( std::span< const uint64_t > _indices,
+              std::span< uint64_t > _result ) const {
+        assert( _result.size() >= _indices.size() );
+
+        constexpr size_t l_blockSize = 64;
+
+        std::array< uint64_t, l_blockSize > l_left{};
+        std::array< uint64_t, l_blockSize > l_right{};
+
+        for ( size_t l_offset = 0; l_offset < _indices.size();
+              l_offset += l_blockSize ) {
+            const size_t l_count =
+                std::min( l_blockSize, ( _indices.size() - l_offset ) );
+
+            for ( size_t l_index = 0; l_index < l_count; l_index++ ) {
+                const uint64_t l_value = _indices[ l_offset + l_index ];
+
+                assert( l_value < _size );
+
+                l_left[ l_index ] = ( l_value >> _halfBits );
+                l_right[ l_index ] = ( l_value & _halfMask );
+            }
+
+            for ( const uint64_t _key : _keys ) {
+                for ( size_t l_index = 0; l_index < l_count; l_index++ ) {
+                    const uint64_t l_next =
+                        ( l_left[ l_index ] ^
+                          _round( l_right[ l_index ], _key ) );
+
+                    l_left[ l_index ] = l_right[ l_index ];
+                    l_right[ l_index ] = l_next;
+                }
+            }
+
+            for ( size_t l_index = 0; l_index < l_count; l_index++ ) {
+                uint64_t l_value =
+                    ( ( l_left[ l_index ] << _halfBits ) | l_right[ l_index ] );
+
+                while ( l_value >= _size ) [[unlikely]] {
+                    l_value = _encrypt( l_value );
+                }
+
+                _result[ l_offset + l_index ] = l_value;
+            }
+        }
+    }
+
+    // Every index of [ 0, size ) exactly once, in permuted order
+    [[nodiscard]] constexpr auto view() const {
+        return ( std::views::iota( uint64_t{}, _size ) |
+                 std::views::transform(
+                     [ *this ]( uint64_t _index ) -> uint64_t {
+                         return ( map( _index ) );
+                     } ) );
+    }
+
+private:
+    [[nodiscard]] constexpr auto _round( uint64_t _value, uint64_t _key ) const
+        -> uint64_t {
+        // Top bits of FNV-1A are the well-mixed ones
+        return ( hash::weak< uint64_t >(
+                     std::bit_cast< std::array< std::byte, 8 > >(
+                         _value ^ _key ) ) >>
+                 ( 64 - _halfBits ) );
+    }
+
+    [[nodiscard]] constexpr auto _encrypt( uint64_t _value ) const
+        -> uint64_t {
+        uint64_t l_left = ( _value >> _halfBits );
+        uint64_t l_right = ( _value & _halfMask );
+
+        for ( const uint64_t _key : _keys ) {
+            const uint64_t l_next = ( l_left ^ _round( l_right, _key ) );
+
+            l_left = l_right;
+            l_right = l_next;
+        }
+
+        return ( ( l_left << _halfBits ) | l_right );
+    }
+
+    [[nodiscard]] constexpr auto _decrypt( uint64_t _value ) const
+        -> uint64_t {
+        uint64_t l_left = ( _value >> _halfBits );
+        uint64_t l_right = ( _value & _halfMask );
+
+        for ( const uint64_t _key : _keys | std::views::reverse ) {
+            const uint64_t l_previous = ( l_right ^ _round( l_left, _key ) );
+
+            l_right = l_left;
+            l_left = l_previous;
+        }
+
+        return ( ( l_left << _halfBits ) | l_right );
+    }
+
+    uint64_t _size;
+    uint32_t _halfBits = 0;
+    uint64_t _halfMask = 0;
+    std::array< uint64_t, 6 > _keys{};
+};
+
+// Finite counterpart of view(): every element exactly once, in random order
+template < is_container Container >
+constexpr auto view( Container& _container, const permutation& _permutation ) {
+    assert( _permutation.size() == _container.size() );
+
+    return ( _permutation.view() |
+             std::views::transform( [ & ]( uint64_t _index ) -> auto& {
+                 return ( _container.at( _index ) );
+             } ) );
+}
+
 // NOTE: std::ranges does not have generate() on x32
 #if defined( __x86_64__ )
 
 template < is_container Container, typename T = typename Container::value_type >
-    requires std::is_arithmetic_v< T >
+    requires( std::is_arithmetic_v< T > && !is_float16< T > )
 constexpr void fill( Container& _container, T _min, T _max ) {
     std::ranges::generate( _container, [ & ] constexpr -> auto {
         return ( number::g_defaultNumberGenerator< T >( _min, _max ) );
@@ -243,7 +508,7 @@ constexpr void fill( Container& _container, uint8_t _min, uint8_t _max ) {
 }
 
 template < is_container Container, typename T = typename Container::value_type >
-    requires std::is_arithmetic_v< T >
+    requires( std::is_arithmetic_v< T > && !is_float16< T > )
 constexpr void fill( Container& _container ) {
     std::ranges::generate( _container, [ & ] constexpr -> auto {
         return ( number::g_defaultNumberGenerator< T >() );
@@ -261,4 +526,721 @@ constexpr void fill( Container& _container ) {
 
 #endif
 
+// Bulk half precision: 32 lanes per step straight from raw engine words
+template < is_container Container, typename T = typename Container::value_type >
+    requires is_float16< T >
+void fill( Container& _container, T _min, T _max ) {
+    auto l_iterator = std::ranges::begin( _container );
+    size_t l_left = std::ranges::size( _container );
+
+    for ( ; l_left >= ( sizeof( float16x32_t ) / sizeof( T ) );
+          l_left -= ( sizeof( float16x32_t ) / sizeof( T ) ) ) {
+        const auto l_lanes = std::bit_cast<
+            std::array< T, ( sizeof( float16x32_t ) / sizeof( T ) ) > >(
+            number::balanced< float16x32_t >( _min, _max ) );
+
+        l_iterator = std::ranges::copy( l_lanes, l_iterator ).out;
+    }
+
+    for ( ; l_left; l_left-- ) {
+        *l_iterator = number::balanced< T >( _min, _max );
+
+        ++l_iterator;
+    }
+}
+
+template < is_container Container, typename T = typename Container::value_type >
+    requires is_float16< T >
+void fill( Container& _container ) {
+    using numericLimit_t = std::numeric_limits< T >;
+
+    fill( _container, numericLimit_t::lowest(), numericLimit_t::max() );
+}
+
+template < is_container Container, typename T = typename Container::value_type >
+    requires is_float16_vector< T >
+void fill( Container& _container, float16_t _min, float16_t _max ) {
+    for ( T& _vector : _container ) {
+        _vector = number::balanced< T >( _min, _max );
+    }
+}
+
+template < is_container Container, typename T = typename Container::value_type >
+    requires is_float16_vector< T >
+void fill( Container& _container ) {
+    using numericLimit_t = std::numeric_limits< float16_t >;
+
+    fill( _container, numericLimit_t::lowest(), numericLimit_t::max() );
+}
+
+// Non-uniform distributions over the balanced engine
+namespace distribution {
+
+// Ziggurat with 256 layers: x[ 0 ] is the virtual width of the base strip,
+// x[ 1 ] is the tail start and x[ 256 ] is 0, f[ i ] = pdf( x[ i ] )
+struct zigguratTable {
+    std::array< double, 257 > x;
+    std::array< double, 257 > f;
+    double tailStart;
+};
+
+extern const zigguratTable g_zigguratNormal;
+extern const zigguratTable g_zigguratExponential;
+
+namespace {
+
+constexpr size_t g_zigguratLayerMask = 0xFF;
+constexpr size_t g_zigguratSignBit = 8;
+constexpr size_t g_zigguratMantissaShift = 11;
+constexpr double g_zigguratMantissaScale = 0x1p-53;
+
+// Samples generated per bulk pass, sized to stay in L1
+constexpr size_t g_fillBatchSize = 256;
+
+// [ 0, 1 )
+[[nodiscard]] inline auto _uniform() -> double {
+    return (
+        static_cast< double >( number::bits() >> g_zigguratMantissaShift ) *
+        g_zigguratMantissaScale );
+}
+
+// ( 0, 1 ]
+[[nodiscard]] inline auto _uniformPositive() -> double {
+    return ( static_cast< double >(
+                 ( number::bits() >> g_zigguratMantissaShift ) + 1 ) *
+             g_zigguratMantissaScale );
+}
+
+// Wedge and tail handling for a sample rejected by the fast path. Returns
+// false when the caller has to draw again
+template < bool IsSymmetric >
+[[nodiscard]] auto _zigguratSlow( const zigguratTable& _table,
+                                  size_t _layer,
+                                  double& _value ) -> bool {
+    if ( !_layer ) {
+        if constexpr ( IsSymmetric ) {
+            double l_first = 0;
+            double l_second = 0;
+
+            do {
+                l_first = ( -std::log( _uniformPositive() ) /
+                            _table.tailStart );
+                l_second = -std::log( _uniformPositive() );
+            } while ( ( l_second + l_second ) < ( l_first * l_first ) );
+
+            _value = std::copysign( ( _table.tailStart + l_first ), _value );
+
+        } else {
+            _value = ( _table.tailStart - std::log( _uniformPositive() ) );
+        }
+
+        return ( true );
+    }
+
+    const double l_height =
+        ( _table.f[ _layer + 1 ] +
+          ( _uniform() * ( _table.f[ _layer ] - _table.f[ _layer + 1 ] ) ) );
+
+    if constexpr ( IsSymmetric ) {
+        return ( l_height < std::exp( -0.5 * _value * _value ) );
+
+    } else {
+        return ( l_height < std::exp( -_value ) );
+    }
+}
+
+template < bool IsSymmetric >
+[[nodiscard]] inline auto _zigguratFast( const zigguratTable& _table,
+                                         uint64_t _bits,
+                                         double& _value ) -> bool {
+    const size_t l_layer = ( _bits & g_zigguratLayerMask );
+    const double l_uniform =
+        ( static_cast< double >( _bits >> g_zigguratMantissaShift ) *
+          g_zigguratMantissaScale );
+
+    _value = ( l_uniform * _table.x[ l_layer ] );
+
+    const bool l_isInside = ( _value < _table.x[ l_layer + 1 ] );
+
+    if constexpr ( IsSymmetric ) {
+        _value = ( ( ( _bits >> g_zigguratSignBit ) & 1 ) ? ( -_value )
+                                                          : ( _value ) );
+    }
+
+    return ( l_isInside );
+}
+
+template < bool IsSymmetric >
+[[nodiscard]] auto _ziggurat( const zigguratTable& _table ) -> double {
+    double l_value = 0;
+
+    while ( true ) {
+        const uint64_t l_bits = number::bits();
+
+        if ( _zigguratFast< IsSymmetric >( _table, l_bits, l_value ) )
+            [[likely]] {
+            return ( l_value );
+        }
+
+        if ( _zigguratSlow< IsSymmetric >(
+                 _table, ( l_bits & g_zigguratLayerMask ), l_value ) ) {
+            return ( l_value );
+        }
+    }
+}
+
+// Bulk ziggurat: one branch-free pass over a batch of raw words, so the
+// layer lookup and multiply vectorize, then a scalar pass over the ~1% of
+// rejected samples
+template < bool IsSymmetric, typename Container, typename Transform >
+void _fillZiggurat( Container& _container,
+                    const zigguratTable& _table,
+                    Transform _transform ) {
+    std::array< uint64_t, g_fillBatchSize > l_bits{};
+    std::array< double, g_fillBatchSize > l_values{};
+    std::array< bool, g_fillBatchSize > l_isAccepted{};
+
+    auto l_iterator = std::ranges::begin( _container );
+    size_t l_left = std::ranges::size( _container );
+
+    while ( l_left ) {
+        const size_t l_count = std::min( l_left, g_fillBatchSize );
+
+        for ( size_t l_index = 0; l_index < l_count; l_index++ ) {
+            l_bits[ l_index ] = number::bits();
+        }
+
+        for ( size_t l_index = 0; l_index < l_count; l_index++ ) {
+            l_isAccepted[ l_index ] = _zigguratFast< IsSymmetric >(
+                _table, l_bits[ l_index ], l_values[ l_index ] );
+        }
+
+        for ( size_t l_index = 0; l_index < l_count; l_index++ ) {
+            if ( !l_isAccepted[ l_index ] ) [[unlikely]] {
+                if ( !_zigguratSlow< IsSymmetric >(
+                         _table, ( l_bits[ l_index ] & g_zigguratLayerMask ),
+                         l_values[ l_index ] ) ) {
+                    l_values[ l_index ] = _ziggurat< IsSymmetric >( _table );
+                }
+            }
+
+            *l_iterator = _transform( l_values[ l_index ] );
+
+            ++l_iterator;
+        }
+
+        l_left -= l_count;
+    }
+}
+
+} // namespace
+
+// Ziggurat ( Marsaglia-Tsang, Doornik layout )
+template < is_floating_point T >
+[[nodiscard]] auto normal( T _mean = 0, T _deviation = 1 ) -> T {
+    return ( static_cast< T >(
+        static_cast< double >( _mean ) +
+        ( static_cast< double >( _deviation ) *
+          _ziggurat< true >( g_zigguratNormal ) ) ) );
+}
+
+// Ziggurat
+template < is_floating_point T >
+[[nodiscard]] auto exponential( T _rate = 1 ) -> T {
+    assert( _rate > 0 );
+
+    return ( static_cast< T >( _ziggurat< false >( g_zigguratExponential ) /
+                               static_cast< double >( _rate ) ) );
+}
+
+// Marsaglia-Tsang, shape < 1 is boosted with U^( 1 / shape )
+template < is_floating_point T >
+[[nodiscard]] auto gamma( T _shape, T _scale = 1 ) -> T {
+    assert( _shape > 0 );
+    assert( _scale > 0 );
+
+    double l_shape = static_cast< double >( _shape );
+    double l_boost = 1;
+
+    if ( l_shape < 1 ) {
+        l_boost = std::pow( _uniformPositive(), ( 1 / l_shape ) );
+        l_shape += 1;
+    }
+
+    const double l_d = ( l_shape - ( 1.0 / 3.0 ) );
+    const double l_c = ( 1 / std::sqrt( 9 * l_d ) );
+
+    while ( true ) {
+        const double l_x = _ziggurat< true >( g_zigguratNormal );
+        double l_v = ( 1 + ( l_c * l_x ) );
+
+        if ( l_v <= 0 ) [[unlikely]] {
+            continue;
+        }
+
+        l_v = ( l_v * l_v * l_v );
+
+        const double l_squared = ( l_x * l_x );
+        const double l_uniform = _uniformPositive();
+
+        if ( ( l_uniform < ( 1 - ( 0.0331 * l_squared * l_squared ) ) ) ||
+             ( std::log( l_uniform ) <
+               ( ( 0.5 * l_squared ) +
+                 ( l_d * ( 1 - l_v + std::log( l_v ) ) ) ) ) ) {
+            return ( static_cast< T >( l_d * l_v * l_boost *
+                                       static_cast< double >( _scale ) ) );
+        }
+    }
+}
+
+// Multiplication for small means, PTRS ( Hoermann ) for mean >= 10
+template < std::integral T >
+[[nodiscard]] auto poisson( double _mean ) -> T {
+    assert( _mean >= 0 );
+
+    constexpr double l_rejectionThreshold = 10;
+
+    if ( _mean < l_rejectionThreshold ) {
+        const double l_limit = std::exp( -_mean );
+        double l_product = _uniform();
+        T l_result = 0;
+
+        while ( l_product > l_limit ) {
+            l_product *= _uniform();
+            l_result++;
+        }
+
+        return ( l_result );
+    }
+
+    const double l_meanRoot = std::sqrt( _mean );
+    const double l_b = ( 0.931 + ( 2.53 * l_meanRoot ) );
+    const double l_a = ( -0.059 + ( 0.02483 * l_b ) );
+    const double l_inverseAlpha = ( 1.1239 + ( 1.1328 / ( l_b - 3.4 ) ) );
+    const double l_acceptance = ( 0.9277 - ( 3.6224 / ( l_b - 2 ) ) );
+    const double l_logMean = std::log( _mean );
+
+    while ( true ) {
+        const double l_u = ( _uniform() - 0.5 );
+        const double l_v = _uniformPositive();
+        const double l_us = ( 0.5 - std::abs( l_u ) );
+        const double l_k = std::floor(
+            ( ( ( ( 2 * l_a ) / l_us ) + l_b ) * l_u ) + _mean + 0.43 );
+
+        if ( ( l_us >= 0.07 ) && ( l_v <= l_acceptance ) ) {
+            return ( static_cast< T >( l_k ) );
+        }
+
+        if ( ( l_k < 0 ) || ( ( l_us < 0.013 ) && ( l_v > l_us ) ) ) {
+            continue;
+        }
+
+        if ( ( std::log( l_v ) + std::log( l_inverseAlpha ) -
+               std::log( ( l_a / ( l_us * l_us ) ) + l_b ) ) <=
+             ( -_mean + ( l_k * l_logMean ) - std::lgamma( l_k + 1 ) ) ) {
+            return ( static_cast< T >( l_k ) );
+        }
+    }
+}
+
+// Inversion for small n * p, BTRS ( Hoermann ) otherwise
+template < std::integral T >
+[[nodiscard]] auto binomial( T _trials, double _probability ) -> T {
+    assert( _trials >= 0 );
+    assert( ( _probability >= 0 ) && ( _probability <= 1 ) );
+
+    const bool l_isFlipped = ( _probability > 0.5 );
+    const double l_p =
+        ( ( l_isFlipped ) ? ( 1 - _probability ) : ( _probability ) );
+    const double l_q = ( 1 - l_p );
+    const double l_trials = static_cast< double >( _trials );
+
+    const auto l_flip = [ & ]( T _result ) -> T {
+        return ( ( l_isFlipped ) ? ( _trials - _result ) : ( _result ) );
+    };
+
+    if ( !_trials || ( l_p == 0 ) ) [[unlikely]] {
+        return ( l_flip( 0 ) );
+    }
+
+    constexpr double l_rejectionThreshold = 10;
+
+    if ( ( l_trials * l_p ) < l_rejectionThreshold ) {
+        const double l_ratio = ( l_p / l_q );
+        const double l_a = ( ( l_trials + 1 ) * l_ratio );
+        const double l_start = std::pow( l_q, l_trials );
+
+        while ( true ) {
+            double l_probability = l_start;
+            double l_uniform = _uniform();
+            T l_result = 0;
+
+            while ( l_uniform > l_probability ) {
+                l_uniform -= l_probability;
+                l_result++;
+
+                if ( l_result > _trials ) [[unlikely]] {
+                    break;
+                }
+
+                l_probability *=
+                    ( ( l_a / static_cast< double >( l_result ) ) - l_ratio );
+            }
+
+            if ( l_result <= _trials ) [[likely]] {
+                return ( l_flip( l_result ) );
+            }
+        }
+    }
+
+    const double l_deviation = std::sqrt( l_trials * l_p * l_q );
+    const double l_b = ( 1.15 + ( 2.53 * l_deviation ) );
+    const double l_a = ( -0.0873 + ( 0.0248 * l_b ) + ( 0.01 * l_p ) );
+    const double l_c = ( ( l_trials * l_p ) + 0.5 );
+    const double l_acceptance = ( 0.92 - ( 4.2 / l_b ) );
+    const double l_alpha = ( ( 2.83 + ( 5.1 / l_b ) ) * l_deviation );
+    const double l_logRatio = std::log( l_p / l_q );
+    const double l_mode = std::floor( ( l_trials + 1 ) * l_p );
+    const double l_height = ( std::lgamma( l_mode + 1 ) +
+                              std::lgamma( l_trials - l_mode + 1 ) );
+
+    while ( true ) {
+        const double l_u = ( _uniform() - 0.5 );
+        double l_v = _uniformPositive();
+        const double l_us = ( 0.5 - std::abs( l_u ) );
+        const double l_k =
+            std::floor( ( ( ( ( 2 * l_a ) / l_us ) + l_b ) * l_u ) + l_c );
+
+        if ( ( l_k < 0 ) || ( l_k > l_trials ) ) {
+            continue;
+        }
+
+        if ( ( l_us >= 0.07 ) && ( l_v <= l_acceptance ) ) {
+            return ( l_flip( static_cast< T >( l_k ) ) );
+        }
+
+        l_v = std::log( ( l_v * l_alpha ) /
+                        ( ( l_a / ( l_us * l_us ) ) + l_b ) );
+
+        if ( l_v <= ( l_height - std::lgamma( l_k + 1 ) -
+                      std::lgamma( l_trials - l_k + 1 ) +
+                      ( ( l_k - l_mode ) * l_logRatio ) ) ) {
+            return ( l_flip( static_cast< T >( l_k ) ) );
+        }
+    }
+}
+
+template < is_container Container, typename T = typename Container::value_type >
+    requires( is_floating_point< T > && !is_float16< T > )
+void fillNormal( Container& _container, T _mean = 0, T _deviation = 1 ) {
+    const auto l_mean = static_cast< double >( _mean );
+    const auto l_deviation = static_cast< double >( _deviation );
+
+    _fillZiggurat< true >(
+        _container, g_zigguratNormal, [ & ]( double _value ) -> T {
+            return ( static_cast< T >( l_mean + ( l_deviation * _value ) ) );
+        } );
+}
+
+// Samples are produced as float batches and narrowed 8 lanes at a time
+template < is_container Container, typename T = typename Container::value_type >
+    requires( is_float16< T > || is_float16_vector< T > )
+void fillNormal( Container& _container,
+                 float16_t _mean = 0,
+                 float16_t _deviation = 1 ) {
+    constexpr size_t l_lanes = ( sizeof( T ) / sizeof( float16_t ) );
+
+    std::array< float, g_fillBatchSize > l_batch{};
+    std::array< float16_t, g_fillBatchSize > l_narrowed{};
+
+    auto l_iterator = std::ranges::begin( _container );
+    size_t l_left = ( std::ranges::size( _container ) * l_lanes );
+
+    while ( l_left ) {
+        const size_t l_count = std::min( l_left, g_fillBatchSize );
+
+        fillNormal( l_batch, static_cast< float >( _mean ),
+                    static_cast< float >( _deviation ) );
+
+        size_t l_index = 0;
+
+#if defined( __F16C__ )
+
+        for ( ; ( l_index + 8 ) <= l_batch.size(); l_index += 8 ) {
+            _mm_storeu_si128(
+                reinterpret_cast< __m128i* >( &l_narrowed[ l_index ] ),
+                _mm256_cvtps_ph( _mm256_loadu_ps( &l_batch[ l_index ] ),
+                                 _MM_FROUND_TO_NEAREST_INT ) );
+        }
+
+#endif
+
+        for ( ; l_index < l_batch.size(); l_index++ ) {
+            l_narrowed[ l_index ] =
+                static_cast< float16_t >( l_batch[ l_index ] );
+        }
+
+        for ( size_t l_offset = 0; l_offset < l_count; l_offset += l_lanes ) {
+            std::memcpy( &*l_iterator, &l_narrowed[ l_offset ], sizeof( T ) );
+
+            ++l_iterator;
+        }
+
+        l_left -= l_count;
+    }
+}
+
+template < is_container Container, typename T = typename Container::value_type >
+    requires is_floating_point< T >
+void fillExponential( Container& _container, T _rate = 1 ) {
+    assert( _rate > 0 );
+
+    const double l_scale = ( 1 / static_cast< double >( _rate ) );
+
+    _fillZiggurat< false >( _container, g_zigguratExponential,
+                            [ & ]( double _value ) -> T {
+                                return ( static_cast< T >( _value * l_scale ) );
+                            } );
+}
+
+template < is_container Container, typename T = typename Container::value_type >
+    requires is_floating_point< T >
+void fillGamma( Container& _container, T _shape, T _scale = 1 ) {
+    for ( auto& _item : _container ) {
+        _item = gamma< T >( _shape, _scale );
+    }
+}
+
+template < is_container Container, typename T = typename Container::value_type >
+    requires std::integral< T >
+void fillPoisson( Container& _container, double _mean ) {
+    for ( auto& _item : _container ) {
+        _item = poisson< T >( _mean );
+    }
+}
+
+template < is_container Container, typename T = typename Container::value_type >
+    requires std::integral< T >
+void fillBinomial( Container& _container, T _trials, double _probability ) {
+    for ( auto& _item : _container ) {
+        _item = binomial< T >( _trials, _probability );
+    }
+}
+
+} // namespace distribution
+
+// Low-discrepancy ( quasi-random ) sequences. Points are written row-major,
+// one value per dimension in [ 0, 1 ). seek() jumps to an absolute index so
+// workers can split one sequence into disjoint ranges
+namespace sequence {
+
+namespace {
+
+// Truncates a 64bits fraction to the mantissa of T so that values close to 1
+// never round up to 1
+template < is_floating_point T >
+[[nodiscard]] constexpr auto _fractionToReal( uint64_t _fraction ) -> T {
+    constexpr int l_digits = std::min( std::numeric_limits< T >::digits, 53 );
+
+    return ( static_cast< T >(
+        static_cast< double >( _fraction >> ( 64 - l_digits ) ) *
+        ( 1.0 / static_cast< double >( uint64_t{ 1 } << l_digits ) ) ) );
+}
+
+} // namespace
+
+// Largest dimension count sobol supports: van der Corput and the embedded
+// Joe-Kuo direction numbers
+constexpr size_t g_sobolMaxDimensions = 21;
+
+/**
+ * @brief Sobol sequence with Gray-code stepping.
+ *
+ * Direction numbers are Joe-Kuo's ( new-joe-kuo-6.21201 ), embedded for the
+ * first g_sobolMaxDimensions dimensions only, so their two-dimensional
+ * projection guarantees hold for every supported dimension. With a seed every
+ * dimension gets hash-based nested uniform ( Owen ) scrambling ( Laine-Karras
+ * permutation, Burley 2020 ).
+ *
+ * @complexity next(): O( dimensions ) per point; seek(): O( 32 * dimensions ).
+ */
+struct sobol {
+    explicit sobol( size_t _dimensions );
+    sobol( size_t _dimensions, uint64_t _seed );
+
+    [[nodiscard]] auto dimensions() const -> size_t {
+        return ( _dimensions );
+    }
+
+    [[nodiscard]] auto index() const -> uint64_t { return ( _index ); }
+
+    void seek( uint64_t _index );
+
+    void skip( uint64_t _count ) { seek( _index + _count ); }
+
+    // _points.size() / dimensions() points as raw 32bits fractions
+    void next( std::span< uint32_t > _points );
+
+    template < is_floating_point T >
+    void next( std::span< T > _points ) {
+        assert( !( _points.size() % _dimensions ) );
+
+        constexpr size_t l_batchSize = 1024;
+
+        // Every batch holds at least one point
+        static_assert( g_sobolMaxDimensions <= l_batchSize );
+
+        std::array< uint32_t, l_batchSize > l_raw{};
+
+        const size_t l_step = ( ( l_batchSize / _dimensions ) * _dimensions );
+
+        for ( size_t l_offset = 0; l_offset < _points.size();
+              l_offset += l_step ) {
+            const size_t l_count =
+                std::min( l_step, ( _points.size() - l_offset ) );
+
+            next( std::span( l_raw ).first( l_count ) );
+
+            for ( size_t l_index = 0; l_index < l_count; l_index++ ) {
+                _points[ l_offset + l_index ] = _fractionToReal< T >(
+                    static_cast< uint64_t >( l_raw[ l_index ] ) << 32 );
+            }
+        }
+    }
+
+    template < is_container Container,
+               typename T = typename Container::value_type >
+        requires is_floating_point< T >
+    void fill( Container& _container ) {
+        next( std::span< T >( _container ) );
+    }
+
+private:
+    size_t _dimensions;
+    uint64_t _index = 0;
+    // [ bit * dimensions + dimension ] so one step is a contiguous XOR
+    std::vector< uint32_t > _directions;
+    std::vector< uint32_t > _state;
+    // Empty when not scrambled
+    std::vector< uint32_t > _seeds;
+};
+
+/**
+ * @brief Halton sequence over the first primes.
+ *
+ * With a seed every digit is shifted by a hash of the seed, dimension, digit
+ * position and all less significant digits ( nested random digit shift, an
+ * Owen-style scramble ), which also breaks the correlation between high
+ * prime bases.
+ */
+struct halton {
+    explicit halton( size_t _dimensions );
+    halton( size_t _dimensions, uint64_t _seed );
+
+    [[nodiscard]] auto dimensions() const -> size_t {
+        return ( _bases.size() );
+    }
+
+    [[nodiscard]] auto index() const -> uint64_t { return ( _index ); }
+
+    void seek( uint64_t _index ) { this->_index = _index; }
+
+    void skip( uint64_t _count ) { _index += _count; }
+
+    template < is_floating_point T >
+    void next( std::span< T > _points ) {
+        const size_t l_dimensions = dimensions();
+
+        assert( !( _points.size() % l_dimensions ) );
+
+        for ( size_t l_offset = 0; l_offset < _points.size();
+              l_offset += l_dimensions ) {
+            for ( size_t l_dimension = 0; l_dimension < l_dimensions;
+                  l_dimension++ ) {
+                _points[ l_offset + l_dimension ] = _fractionToReal< T >(
+                    _radicalInverse( _index, l_dimension ) );
+            }
+
+            _index++;
+        }
+    }
+
+    template < is_container Container,
+               typename T = typename Container::value_type >
+        requires is_floating_point< T >
+    void fill( Container& _container ) {
+        next( std::span< T >( _container ) );
+    }
+
+private:
+    // 64bits fraction
+    [[nodiscard]] auto _radicalInverse( uint64_t _index,
+                                        size_t _dimension ) const -> uint64_t;
+
+    uint64_t _index = 0;
+    std::vector< uint32_t > _bases;
+    uint64_t _seed = 0;
+    bool _isScrambled = false;
+};
+
+/**
+ * @brief Roberts' R sequence: x_n = frac( offset + n * alpha ), alpha_j are
+ *        powers of the inverse generalized golden ratio of the dimension.
+ *
+ * Runs in 64bits fixed point, so every step is an exact integer
+ * multiply-add that vectorizes. A seed turns the default 0.5 offset into a
+ * random ( Cranley-Patterson ) rotation per dimension.
+ */
+struct r2 {
+    explicit r2( size_t _dimensions );
+    r2( size_t _dimensions, uint64_t _seed );
+
+    [[nodiscard]] auto dimensions() const -> size_t {
+        return ( _alphas.size() );
+    }
+
+    [[nodiscard]] auto index() const -> uint64_t { return ( _index ); }
+
+    void seek( uint64_t _index ) { this->_index = _index; }
+
+    void skip( uint64_t _count ) { _index += _count; }
+
+    template < is_floating_point T >
+    void next( std::span< T > _points ) {
+        const size_t l_dimensions = dimensions();
+
+        assert( !( _points.size() % l_dimensions ) );
+
+        for ( size_t l_offset = 0; l_offset < _points.size();
+              l_offset += l_dimensions ) {
+            // Point _index is x_( _index + 1 ), Roberts starts at n = 1
+            const uint64_t l_n = ( _index + 1 );
+
+            for ( size_t l_dimension = 0; l_dimension < l_dimensions;
+                  l_dimension++ ) {
+                _points[ l_offset + l_dimension ] =
+                    _fractionToReal< T >( _offsets[ l_dimension ] +
+                                          ( l_n * _alphas[ l_dimension ] ) );
+            }
+
+            _index++;
+        }
+    }
+
+    template < is_container Container,
+               typename T = typename Container::value_type >
+        requires is_floating_point< T >
+    void fill( Container& _container ) {
+        next( std::span< T >( _container ) );
+    }
+
+private:
+    uint64_t _index = 0;
+    // 64bits fractions
+    std::vector< uint64_t > _alphas;
+    std::vector< uint64_t > _offsets;
+};
+
+} // namespace sequence
+
 } // namespace stdfunc::random
@@ -0,0 +1,968 @@
+#include "stdarchive.hpp"
+
+#if __has_include( "snappy.h" )
+
+#define HAS_SNAPPY
+
+#endif
+
+#if __has_include( "zstd.h" )
+
+#define HAS_ZSTD
+
+#endif
+
+#if __has_include( <sys/mman.h> )
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define HAS_MMAN
+
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include "stddecompress.hpp"
+#include "stdfunc.hpp"
+#include "stdhash.hpp"
+#include "stdthread.hpp"
+
+namespace stdfunc::archive {
+
+namespace {
+
+// "SFAR"
+constexpr uint32_t g_magic = 0x52414653;
+constexpr uint16_t g_version = 1;
+
+// Magic, version, entry and block counts, index offset and size, slot count,
+// CRC-32C of the index, then reserved bytes
+constexpr size_t g_headerSize = 64;
+// Offset, stored size, size and codec
+constexpr size_t g_blockRecordSize = 32;
+// Name hash, offset in the block, size, block and name offset
+constexpr size_t g_entryRecordSize = 32;
+// Entry index + 1, 0 for an empty slot
+constexpr size_t g_slotSize = sizeof( uint32_t );
+// Index start, keeps its records naturally aligned
+constexpr size_t g_indexAlignment = 8;
+
+template < typename T >
+auto load( std::span< const std::byte > _data, size_t _offset ) -> T {
+    T l_returnValue;
+
+    std::memcpy( &l_returnValue, ( _data.data() + _offset ),
+                 sizeof( l_returnValue ) );
+
+    if constexpr ( ( sizeof( T ) > 1 ) &&
+                   ( std::endian::native == std::endian::big ) ) {
+        l_returnValue = std::byteswap( l_returnValue );
+    }
+
+    return ( l_returnValue );
+}
+
+template < typename T >
+void store( std::span< std::byte > _data, size_t _offset, T _value ) {
+    if constexpr ( ( sizeof( T ) > 1 ) &&
+                   ( std::endian::native == std::endian::big ) ) {
+        _value = std::byteswap( _value );
+    }
+
+    std::memcpy( ( _data.data() + _offset ), &_value, sizeof( _value ) );
+}
+
+auto alignUp( size_t _offset, size_t _alignment ) -> size_t {
+    return ( ( _offset + ( _alignment - 1 ) ) & ~( _alignment - 1 ) );
+}
+
+auto hashOf( std::string_view _name ) -> uint64_t {
+    return ( hash::xxh64( std::as_bytes( std::span( _name ) ) ) );
+}
+
+auto isAvailable( compress::codec _method ) -> bool {
+    bool l_returnValue = false;
+
+    switch ( _method ) {
+        case compress::codec::stored:
+        case compress::codec::lz: {
+            l_returnValue = true;
+
+            break;
+        }
+
+        case compress::codec::snappy: {
+#if defined( HAS_SNAPPY )
+            l_returnValue = true;
+#endif
+
+            break;
+        }
+
+        case compress::codec::zstd: {
+#if defined( HAS_ZSTD )
+            l_returnValue = true;
+#endif
+
+            break;
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+// Appends _fragments compressed as one with _method to _output, false when the
+// codec fails or is not available
+auto appendCompressed(
+    std::span< const std::span< const std::byte > > _fragments,
+    compress::codec _method,
+    size_t _level,
+    std::vector< std::byte >& _output ) -> bool {
+    bool l_returnValue = false;
+
+#if defined( HAS_ZSTD )
+
+    if ( _method == compress::codec::zstd ) {
+        return ( compress::data( _fragments, _output, _level ).has_value() );
+    }
+
+#endif
+
+    std::vector< std::byte > l_gathered;
+    std::span< const std::byte > l_data = _fragments.front();
+
+    if ( _fragments.size() > 1 ) {
+        for ( const auto _fragment : _fragments ) {
+            l_gathered.insert( l_gathered.end(), _fragment.begin(),
+                               _fragment.end() );
+        }
+
+        l_data = l_gathered;
+    }
+
+    if ( _method == compress::codec::lz ) {
+        l_returnValue = compress::lz( l_data, _output, _level ).has_value();
+
+    } else if ( _method == compress::codec::snappy ) {
+#if defined( HAS_SNAPPY )
+        const size_t l_offset = _output.size();
+
+        _output.resize( l_offset + compress::textBound( l_data.size() ) );
+
+        const std::optional< size_t > l_size = compress::text(
+            std::string_view( reinterpret_cast< const char* >( l_data.data() ),
+                              l_data.size() ),
+            std::span( reinterpret_cast< char* >( _output.data() + l_offset ),
+                       ( _output.size() - l_offset ) ),
+            _level );
+
+        _output.resize( l_offset + l_size.value_or( 0 ) );
+
+        l_returnValue = l_size.has_value();
+#endif
+    }
+
+    return ( l_returnValue );
+}
+
+// Decompresses _data into all of _buffer, false when the codec fails, is not
+// available or the size differs
+auto decompressed( std::span< const std::byte > _data,
+                   compress::codec _method,
+                   std::span< std::byte > _buffer ) -> bool {
+    std::optional< size_t > l_size = std::nullopt;
+
+    switch ( _method ) {
+        case compress::codec::stored: {
+            if ( _data.size() == _buffer.size() ) {
+                std::ranges::copy( _data, _buffer.begin() );
+
+                l_size = _data.size();
+            }
+
+            break;
+        }
+
+        case compress::codec::lz: {
+            l_size = decompress::lz( _data, _buffer );
+
+            break;
+        }
+
+        case compress::codec::snappy: {
+#if defined( HAS_SNAPPY )
+            l_size = decompress::text(
+                std::string_view(
+                    reinterpret_cast< const char* >( _data.data() ),
+                    _data.size() ),
+                std::span( reinterpret_cast< char* >( _buffer.data() ),
+                           _buffer.size() ) );
+#endif
+
+            break;
+        }
+
+        case compress::codec::zstd: {
+#if defined( HAS_ZSTD )
+            l_size = decompress::data( _data, _buffer );
+#endif
+
+            break;
+        }
+    }
+
+    return ( l_size == _buffer.size() );
+}
+
+auto readFile( const std::filesystem::path& _path )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        std::error_code l_error;
+
+        const uintmax_t l_size = std::filesystem::file_size( _path, l_error );
+
+        if ( l_error ) [[unlikely]] {
+            break;
+        }
+
+        std::ifstream l_file( _path, std::ios::binary );
+
+        if ( !l_file ) [[unlikely]] {
+            break;
+        }
+
+        std::vector< std::byte > l_contents( l_size );
+
+        if ( !l_file.read( reinterpret_cast< char* >( l_contents.data() ),
+                           static_cast< std::streamsize >( l_size ) ) )
+            [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = std::move( l_contents );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+auto pack( std::span< const entry > _entries, const parameters& _parameters )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        if ( !std::has_single_bit( _parameters.alignment ) ||
+             !isAvailable( _parameters.method ) ) [[unlikely]] {
+            break;
+        }
+
+        // Slots stay twice the entries and fit 32 bits
+        if ( _entries.size() >
+             ( std::numeric_limits< uint32_t >::max() / 2 ) ) [[unlikely]] {
+            break;
+        }
+
+        std::unordered_set< std::string_view > l_names;
+        size_t l_namesSize = 0;
+
+        l_names.reserve( _entries.size() );
+
+        for ( const entry& _entry : _entries ) {
+            l_names.emplace( _entry.name );
+
+            l_namesSize += _entry.name.size();
+        }
+
+        if ( ( l_names.size() != _entries.size() ) ||
+             ( l_namesSize > std::numeric_limits< uint32_t >::max() ) )
+            [[unlikely]] {
+            break;
+        }
+
+        struct block {
+            std::vector< size_t > members;
+            size_t size = 0;
+            compress::codec method = compress::codec::stored;
+            std::vector< std::byte > compressed;
+        };
+
+        std::vector< block > l_blocks;
+        std::vector< uint32_t > l_blockOf( _entries.size() );
+        std::vector< size_t > l_offsetOf( _entries.size() );
+        // Solid block still taking small entries
+        size_t l_solid = std::numeric_limits< size_t >::max();
+
+        for ( size_t l_index = 0; l_index < _entries.size(); l_index++ ) {
+            const size_t l_size = _entries[ l_index ].data.size();
+
+            size_t l_target = l_blocks.size();
+
+            if ( l_size < _parameters.solidBlockSize ) {
+                if ( ( l_solid != std::numeric_limits< size_t >::max() ) &&
+                     ( ( l_blocks[ l_solid ].size + l_size ) <=
+                       _parameters.solidBlockSize ) ) {
+                    l_target = l_solid;
+
+                } else {
+                    l_solid = l_target;
+                }
+            }
+
+            if ( l_target == l_blocks.size() ) {
+                l_blocks.emplace_back();
+            }
+
+            block& l_block = l_blocks[ l_target ];
+
+            l_blockOf[ l_index ] = static_cast< uint32_t >( l_target );
+            l_offsetOf[ l_index ] = l_block.size;
+
+            l_block.members.emplace_back( l_index );
+            l_block.size += l_size;
+        }
+
+        std::atomic< bool > l_isFailed = false;
+
+        thread::parallelFor(
+            l_blocks.size(),
+            [ & ]( size_t _index ) -> void {
+                block& l_block = l_blocks[ _index ];
+
+                if ( !l_block.size ||
+                     ( _parameters.method == compress::codec::stored ) ) {
+                    return;
+                }
+
+                std::vector< std::span< const std::byte > > l_fragments;
+
+                l_fragments.reserve( l_block.members.size() );
+
+                for ( const size_t _member : l_block.members ) {
+                    l_fragments.emplace_back( _entries[ _member ].data );
+                }
+
+                if ( !appendCompressed( l_fragments, _parameters.method,
+                                        _parameters.level,
+                                        l_block.compressed ) ) [[unlikely]] {
+                    l_isFailed.store( true, std::memory_order_relaxed );
+
+                    return;
+                }
+
+                // Incompressible blocks stay views in the mapping
+                if ( l_block.compressed.size() >= l_block.size ) {
+                    l_block.compressed = {};
+
+                } else {
+                    l_block.method = _parameters.method;
+                }
+            },
+            _parameters.workers );
+
+        if ( l_isFailed ) [[unlikely]] {
+            break;
+        }
+
+        std::vector< size_t > l_blockOffsets( l_blocks.size() );
+        size_t l_end = alignUp( g_headerSize, _parameters.alignment );
+
+        for ( size_t l_index = 0; l_index < l_blocks.size(); l_index++ ) {
+            const block& l_block = l_blocks[ l_index ];
+
+            const size_t l_storedSize =
+                ( ( l_block.method == compress::codec::stored )
+                      ? l_block.size
+                      : l_block.compressed.size() );
+
+            // Empty blocks take no room
+            if ( l_storedSize ) {
+                l_end = alignUp( l_end, _parameters.alignment );
+            }
+
+            l_blockOffsets[ l_index ] = l_end;
+
+            l_end += l_storedSize;
+        }
+
+        const size_t l_slotCount =
+            std::bit_ceil( std::max< size_t >( ( _entries.size() * 2 ), 1 ) );
+        const size_t l_indexOffset = alignUp( l_end, g_indexAlignment );
+        const size_t l_entriesOffset =
+            ( l_blocks.size() * g_blockRecordSize );
+        const size_t l_slotsOffset =
+            ( l_entriesOffset + ( _entries.size() * g_entryRecordSize ) );
+        const size_t l_namesOffset =
+            ( l_slotsOffset + ( l_slotCount * g_slotSize ) );
+        const size_t l_indexSize = ( l_namesOffset + l_namesSize );
+
+        std::vector< std::byte > l_archive( l_indexOffset + l_indexSize );
+
+        const std::span< std::byte > l_table =
+            std::span( l_archive ).subspan( l_indexOffset );
+
+        for ( size_t l_index = 0; l_index < l_blocks.size(); l_index++ ) {
+            const block& l_block = l_blocks[ l_index ];
+            const size_t l_record = ( l_index * g_blockRecordSize );
+
+            std::byte* l_output =
+                ( l_archive.data() + l_blockOffsets[ l_index ] );
+
+            if ( l_block.method == compress::codec::stored ) {
+                for ( const size_t _member : l_block.members ) {
+                    l_output =
+                        std::ranges::copy( _entries[ _member ].data, l_output )
+                            .out;
+                }
+
+            } else {
+                std::ranges::copy( l_block.compressed, l_output );
+            }
+
+            store< uint64_t >( l_table, l_record, l_blockOffsets[ l_index ] );
+            store< uint64_t >( l_table, ( l_record + 8 ),
+                ( ( l_block.method == compress::codec::stored )
+                      ? l_block.size
+                      : l_block.compressed.size() ) );
+            store< uint64_t >( l_table, ( l_record + 16 ), l_block.size );
+            store< uint8_t >( l_table, ( l_record + 24 ),
+                              std::to_underlying( l_block.method ) );
+        }
+
+        const std::span< std::byte > l_slots =
+            l_table.subspan( l_slotsOffset, ( l_slotCount * g_slotSize ) );
+        size_t l_nameOffset = 0;
+
+        for ( size_t l_index = 0; l_index < _entries.size(); l_index++ ) {
+            const entry& l_entry = _entries[ l_index ];
+            const size_t l_record =
+                ( l_entriesOffset + ( l_index * g_entryRecordSize ) );
+            const uint64_t l_hash = hashOf( l_entry.name );
+
+            store< uint64_t >( l_table, l_record, l_hash );
+            store< uint64_t >( l_table, ( l_record + 8 ),
+                               l_offsetOf[ l_index ] );
+            store< uint64_t >( l_table, ( l_record + 16 ),
+                               l_entry.data.size() );
+            store< uint32_t >( l_table, ( l_record + 24 ),
+                               l_blockOf[ l_index ] );
+            store< uint32_t >( l_table, ( l_record + 28 ),
+                               static_cast< uint32_t >( l_nameOffset ) );
+
+            std::ranges::copy(
+                std::as_bytes( std::span( l_entry.name ) ),
+                ( l_table.data() + l_namesOffset + l_nameOffset ) );
+
+            l_nameOffset += l_entry.name.size();
+
+            size_t l_slot = ( l_hash & ( l_slotCount - 1 ) );
+
+            while ( load< uint32_t >( l_slots, ( l_slot * g_slotSize ) ) ) {
+                l_slot = ( ( l_slot + 1 ) & ( l_slotCount - 1 ) );
+            }
+
+            store< uint32_t >( l_slots, ( l_slot * g_slotSize ),
+                               static_cast< uint32_t >( l_index + 1 ) );
+        }
+
+        const std::span< std::byte > l_header =
+            std::span( l_archive ).first( g_headerSize );
+
+        store< uint32_t >( l_header, 0, g_magic );
+        store< uint16_t >( l_header, 4, g_version );
+        store< uint32_t >( l_header, 8,
+                           static_cast< uint32_t >( _entries.size() ) );
+        store< uint32_t >( l_header, 12,
+                           static_cast< uint32_t >( l_blocks.size() ) );
+        store< uint64_t >( l_header, 16, l_indexOffset );
+        store< uint64_t >( l_header, 24, l_indexSize );
+        store< uint32_t >( l_header, 32,
+                           static_cast< uint32_t >( l_slotCount ) );
+        store< uint32_t >( l_header, 36, hash::crc32c( l_table ) );
+
+        l_returnValue = std::move( l_archive );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto pack( std::span< const std::filesystem::path > _paths,
+           const std::filesystem::path& _output,
+           const parameters& _parameters,
+           const std::filesystem::path& _root ) -> bool {
+    bool l_returnValue = false;
+
+    do {
+        std::vector< std::string > l_names;
+        std::vector< std::vector< std::byte > > l_contents;
+
+        l_names.reserve( _paths.size() );
+        l_contents.reserve( _paths.size() );
+
+        for ( const std::filesystem::path& _path : _paths ) {
+            std::string l_name =
+                ( _root.empty() ? _path.filename()
+                                : _path.lexically_relative( _root ) )
+                    .generic_string();
+
+            std::optional< std::vector< std::byte > > l_file =
+                readFile( _path );
+
+            if ( l_name.empty() || !l_file ) [[unlikely]] {
+                break;
+            }
+
+            l_names.emplace_back( std::move( l_name ) );
+            l_contents.emplace_back( std::move( *l_file ) );
+        }
+
+        if ( l_names.size() != _paths.size() ) [[unlikely]] {
+            break;
+        }
+
+        std::vector< entry > l_entries;
+
+        l_entries.reserve( _paths.size() );
+
+        for ( size_t l_index = 0; l_index < _paths.size(); l_index++ ) {
+            l_entries.emplace_back( l_names[ l_index ], l_contents[ l_index ] );
+        }
+
+        const std::optional< std::vector< std::byte > > l_archive =
+            pack( l_entries, _parameters );
+
+        if ( !l_archive ) [[unlikely]] {
+            break;
+        }
+
+        std::ofstream l_file( _output, ( std::ios::binary | std::ios::trunc ) );
+
+        l_file.write( reinterpret_cast< const char* >( l_archive->data() ),
+                      static_cast< std::streamsize >( l_archive->size() ) );
+
+        l_returnValue = static_cast< bool >( l_file.flush() );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+reader::reader( const std::filesystem::path& _path, size_t _maxSize ) {
+#if defined( HAS_MMAN )
+
+    const int l_descriptor = ::open( _path.c_str(), ( O_RDONLY | O_CLOEXEC ) );
+
+    if ( l_descriptor != -1 ) [[likely]] {
+        struct stat l_status{};
+
+        if ( !::fstat( l_descriptor, &l_status ) && ( l_status.st_size > 0 ) )
+            [[likely]] {
+            const auto l_size = static_cast< size_t >( l_status.st_size );
+
+            void* const l_pages = ::mmap( nullptr, l_size, PROT_READ,
+                                          MAP_PRIVATE, l_descriptor, 0 );
+
+            if ( l_pages != MAP_FAILED ) [[likely]] {
+                _data = std::span( static_cast< const std::byte* >( l_pages ),
+                                   l_size );
+                _isMapped = true;
+            }
+        }
+
+        ::close( l_descriptor );
+    }
+
+#endif
+
+    if ( !_isMapped ) {
+        if ( auto l_contents = readFile( _path ) ) {
+            _contents = std::move( *l_contents );
+            _data = _contents;
+        }
+    }
+
+    _isValid = _open( _maxSize );
+}
+
+reader::reader( std::span< const std::byte > _archive, size_t _maxSize )
+    : _data( _archive ) {
+    _isValid = _open( _maxSize );
+}
+
+reader::reader( reader&& _other ) noexcept {
+    *this = std::move( _other );
+}
+
+reader::~reader() {
+    _close();
+}
+
+auto reader::operator=( reader&& _other ) noexcept -> reader& {
+    if ( this != &_other ) {
+        _close();
+
+        // Views into a moved buffer keep pointing at the same heap block
+        _data = std::exchange( _other._data, {} );
+        _isMapped = std::exchange( _other._isMapped, false );
+        _contents = std::move( _other._contents );
+        _blocks = std::exchange( _other._blocks, {} );
+        _entries = std::exchange( _other._entries, {} );
+        _slots = std::exchange( _other._slots, {} );
+        _names = std::exchange( _other._names, {} );
+        _entryCount = std::exchange( _other._entryCount, 0 );
+        _isValid = std::exchange( _other._isValid, false );
+        _cachedBlock = std::exchange( _other._cachedBlock,
+                                      std::numeric_limits< size_t >::max() );
+        _cache = std::move( _other._cache );
+    }
+
+    return ( *this );
+}
+
+auto reader::name( size_t _index ) const -> std::string_view {
+    std::string_view l_returnValue;
+
+    if ( _index < _entryCount ) [[likely]] {
+        const size_t l_record = ( _index * g_entryRecordSize );
+        const size_t l_begin = load< uint32_t >( _entries, ( l_record + 28 ) );
+        const size_t l_end =
+            ( ( ( _index + 1 ) < _entryCount )
+                  ? load< uint32_t >( _entries,
+                                      ( l_record + g_entryRecordSize + 28 ) )
+                  : _names.size() );
+
+        l_returnValue = std::string_view(
+            reinterpret_cast< const char* >( _names.data() + l_begin ),
+            ( l_end - l_begin ) );
+    }
+
+    return ( l_returnValue );
+}
+
+auto reader::entrySize( std::string_view _name ) const
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    if ( const auto l_entry = _find( _name ) ) [[likely]] {
+        l_returnValue = load< uint64_t >(
+            _entries, ( ( *l_entry * g_entryRecordSize ) + 16 ) );
+    }
+
+    return ( l_returnValue );
+}
+
+auto reader::view( std::string_view _name ) const
+    -> std::optional< std::span< const std::byte > > {
+    std::optional< std::span< const std::byte > > l_returnValue = std::nullopt;
+
+    const std::optional< location > l_location = _locate( _name );
+
+    if ( l_location &&
+         ( l_location->container.method == compress::codec::stored ) )
+        [[likely]] {
+        l_returnValue = _data.subspan(
+            ( l_location->container.offset + l_location->offset ),
+            l_location->size );
+    }
+
+    return ( l_returnValue );
+}
+
+auto reader::read( std::string_view _name )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        const std::optional< size_t > l_size = entrySize( _name );
+
+        if ( !l_size ) [[unlikely]] {
+            break;
+        }
+
+        std::vector< std::byte > l_contents( *l_size );
+
+        if ( !read( _name, l_contents ) ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = std::move( l_contents );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto reader::read( std::string_view _name, std::span< std::byte > _buffer )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        const std::optional< location > l_location = _locate( _name );
+
+        if ( !l_location || ( _buffer.size() < l_location->size ) )
+            [[unlikely]] {
+            break;
+        }
+
+        const block& l_block = l_location->container;
+        const std::span< std::byte > l_output =
+            _buffer.first( l_location->size );
+        const std::span< const std::byte > l_stored =
+            _data.subspan( l_block.offset, l_block.storedSize );
+
+        if ( l_block.method == compress::codec::stored ) {
+            std::ranges::copy( l_stored.subspan( l_location->offset,
+                                                 l_location->size ),
+                               l_output.begin() );
+
+        } else if ( l_location->size == l_block.size ) {
+            if ( !decompressed( l_stored, l_block.method, l_output ) )
+                [[unlikely]] {
+                break;
+            }
+
+        } else {
+            if ( _cachedBlock != l_location->blockIndex ) {
+                _cachedBlock = std::numeric_limits< size_t >::max();
+                _cache.resize( l_block.size );
+
+                if ( !decompressed( l_stored, l_block.method, _cache ) )
+                    [[unlikely]] {
+                    break;
+                }
+
+                _cachedBlock = l_location->blockIndex;
+            }
+
+            std::ranges::copy( std::span( _cache ).subspan(
+                                   l_location->offset, l_location->size ),
+                               l_output.begin() );
+        }
+
+        l_returnValue = l_location->size;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto reader::_open( size_t _maxSize ) -> bool {
+    bool l_returnValue = false;
+
+    do {
+        if ( _data.size() < g_headerSize ) [[unlikely]] {
+            break;
+        }
+
+        const std::span< const std::byte > l_header =
+            _data.first( g_headerSize );
+
+        if ( ( load< uint32_t >( l_header, 0 ) != g_magic ) ||
+             ( load< uint16_t >( l_header, 4 ) != g_version ) ) [[unlikely]] {
+            break;
+        }
+
+        const size_t l_entryCount = load< uint32_t >( l_header, 8 );
+        const size_t l_blockCount = load< uint32_t >( l_header, 12 );
+        const uint64_t l_indexOffset = load< uint64_t >( l_header, 16 );
+        const uint64_t l_indexSize = load< uint64_t >( l_header, 24 );
+        const size_t l_slotCount = load< uint32_t >( l_header, 32 );
+
+        if ( ( l_indexOffset > _data.size() ) ||
+             ( l_indexSize > ( _data.size() - l_indexOffset ) ) ) [[unlikely]] {
+            break;
+        }
+
+        const size_t l_blocksSize = ( l_blockCount * g_blockRecordSize );
+        const size_t l_entriesSize = ( l_entryCount * g_entryRecordSize );
+        const size_t l_slotsSize = ( l_slotCount * g_slotSize );
+
+        // A free slot always ends probing
+        if ( !std::has_single_bit( l_slotCount ) ||
+             ( l_slotCount <= l_entryCount ) ||
+             ( ( l_blocksSize + l_entriesSize + l_slotsSize ) > l_indexSize ) )
+            [[unlikely]] {
+            break;
+        }
+
+        const std::span< const std::byte > l_table =
+            _data.subspan( l_indexOffset, l_indexSize );
+
+        if ( hash::crc32c( l_table ) != load< uint32_t >( l_header, 36 ) )
+            [[unlikely]] {
+            break;
+        }
+
+        _blocks = l_table.first( l_blocksSize );
+        _entries = l_table.subspan( l_blocksSize, l_entriesSize );
+        _slots = l_table.subspan( ( l_blocksSize + l_entriesSize ),
+                                  l_slotsSize );
+        _names = l_table.subspan( l_blocksSize + l_entriesSize + l_slotsSize );
+
+        bool l_isMalformed = false;
+
+        for ( size_t l_index = 0; l_index < l_blockCount; l_index++ ) {
+            const size_t l_record = ( l_index * g_blockRecordSize );
+            const uint8_t l_method =
+                load< uint8_t >( _blocks, ( l_record + 24 ) );
+
+            if ( l_method > std::to_underlying( compress::codec::lz ) ) {
+                l_isMalformed = true;
+
+                break;
+            }
+
+            const block l_block = _block( l_index );
+
+            // Blocks end before the index, stored ones are as large as they
+            // decompress to and compressed ones within _maxSize
+            if ( ( l_block.offset > l_indexOffset ) ||
+                 ( l_block.storedSize > ( l_indexOffset - l_block.offset ) ) ||
+                 ( ( l_block.method == compress::codec::stored )
+                       ? ( l_block.storedSize != l_block.size )
+                       : ( l_block.size > _maxSize ) ) ) {
+                l_isMalformed = true;
+
+                break;
+            }
+        }
+
+        size_t l_nameOffset = 0;
+
+        for ( size_t l_index = 0;
+              !l_isMalformed && ( l_index < l_entryCount ); l_index++ ) {
+            const size_t l_record = ( l_index * g_entryRecordSize );
+            const uint64_t l_offset =
+                load< uint64_t >( _entries, ( l_record + 8 ) );
+            const uint64_t l_size =
+                load< uint64_t >( _entries, ( l_record + 16 ) );
+            const size_t l_block =
+                load< uint32_t >( _entries, ( l_record + 24 ) );
+            const size_t l_name =
+                load< uint32_t >( _entries, ( l_record + 28 ) );
+
+            if ( l_block >= l_blockCount ) {
+                l_isMalformed = true;
+
+                break;
+            }
+
+            const uint64_t l_blockSize = _block( l_block ).size;
+
+            l_isMalformed =
+                ( ( l_offset > l_blockSize ) ||
+                  ( l_size > ( l_blockSize - l_offset ) ) ||
+                  ( l_name < l_nameOffset ) || ( l_name > _names.size() ) );
+
+            l_nameOffset = l_name;
+        }
+
+        for ( size_t l_slot = 0; !l_isMalformed && ( l_slot < l_slotCount );
+              l_slot++ ) {
+            l_isMalformed =
+                ( load< uint32_t >( _slots, ( l_slot * g_slotSize ) ) >
+                  l_entryCount );
+        }
+
+        if ( l_isMalformed ) [[unlikely]] {
+            break;
+        }
+
+        _entryCount = l_entryCount;
+
+        l_returnValue = true;
+    } while ( false );
+
+    if ( !l_returnValue ) {
+        _blocks = {};
+        _entries = {};
+        _slots = {};
+        _names = {};
+        _entryCount = 0;
+    }
+
+    return ( l_returnValue );
+}
+
+auto reader::_find( std::string_view _name ) const -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    const size_t l_slotCount = ( _slots.size() / g_slotSize );
+    const uint64_t l_hash = hashOf( _name );
+
+    for ( size_t l_probe = 0; l_probe < l_slotCount; l_probe++ ) {
+        const size_t l_slot = ( ( l_hash + l_probe ) & ( l_slotCount - 1 ) );
+        const size_t l_entry =
+            load< uint32_t >( _slots, ( l_slot * g_slotSize ) );
+
+        if ( !l_entry ) {
+            break;
+        }
+
+        if ( ( load< uint64_t >( _entries, ( ( l_entry - 1 ) *
+                                             g_entryRecordSize ) ) ==
+               l_hash ) &&
+             ( name( l_entry - 1 ) == _name ) ) [[likely]] {
+            l_returnValue = ( l_entry - 1 );
+
+            break;
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+auto reader::_block( size_t _index ) const -> block {
+    const size_t l_record = ( _index * g_blockRecordSize );
+
+    return ( block{
+        .offset = load< uint64_t >( _blocks, l_record ),
+        .storedSize = load< uint64_t >( _blocks, ( l_record + 8 ) ),
+        .size = load< uint64_t >( _blocks, ( l_record + 16 ) ),
+        .method = static_cast< compress::codec >(
+            load< uint8_t >( _blocks, ( l_record + 24 ) ) ),
+    } );
+}
+
+auto reader::_locate( std::string_view _name ) const
+    -> std::optional< location > {
+    std::optional< location > l_returnValue = std::nullopt;
+
+    if ( const auto l_entry = _find( _name ) ) [[likely]] {
+        const size_t l_record = ( *l_entry * g_entryRecordSize );
+        const size_t l_block = load< uint32_t >( _entries, ( l_record + 24 ) );
+
+        l_returnValue = location{
+            .container = _block( l_block ),
+            .offset = load< uint64_t >( _entries, ( l_record + 8 ) ),
+            .size = load< uint64_t >( _entries, ( l_record + 16 ) ),
+            .blockIndex = l_block,
+        };
+    }
+
+    return ( l_returnValue );
+}
+
+void reader::_close() {
+#if defined( HAS_MMAN )
+
+    if ( _isMapped ) {
+        ::munmap( const_cast< std::byte* >( _data.data() ), _data.size() );
+    }
+
+#endif
+
+    _data = {};
+    _isMapped = false;
+}
+
+} // namespace stdfunc::archive
@@ -10,64 +10,573 @@
 
 #if __has_include( "zstd.h" )
 
+#include "zdict.h"
 #include "zstd.h"
 
 #define HAS_ZSTD
 
 #endif
 
-#if ( defined( HAS_SNAPPY ) || defined( HAS_ZSTD ) )
+#if __has_include( <unistd.h> )
+
+#include <unistd.h>
+
+#define HAS_UNISTD
+
+#endif
+
+#if defined( __SSE2__ )
+
+#include <emmintrin.h>
+
+#endif
+
+#if defined( __x86_64__ )
+
+#include "std128.hpp"
+
+#endif
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <ostream>
 #include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
-#endif
+#include "stdhash.hpp"
+#include "stdthread.hpp"
 
 namespace stdfunc::compress {
 
-#if defined( HAS_SNAPPY )
+#if ( defined( HAS_SNAPPY ) || defined( HAS_ZSTD ) )
 
-auto text( std::string_view _text, size_t _level )
-    -> std::optional< std::string > {
-    std::optional< std::string > l_returnValue = std::nullopt;
+namespace {
+
+constexpr size_t g_pipeBufferSize = ( 128 * 1024 );
+
+// _read( buffer ) returns the bytes read, 0 at end of input or std::nullopt
+// on failure, _write( bytes ) returns false on failure
+template < typename Stream, typename Read, typename Write >
+auto pipeWith( Stream& _stream, Read&& _read, Write&& _write ) -> bool {
+    bool l_returnValue = false;
+
+    std::vector< std::byte > l_buffer( g_pipeBufferSize );
 
     do {
-        if ( _text.empty() ) [[unlikely]] {
+        std::optional< size_t > l_readSize = std::nullopt;
+
+        while ( ( l_readSize = _read( std::span( l_buffer ) ) ) &&
+                *l_readSize ) {
+            if ( !_stream.write( std::span( l_buffer ).first( *l_readSize ),
+                                 _write ) ) [[unlikely]] {
+                break;
+            }
+        }
+
+        if ( !l_readSize || *l_readSize ) [[unlikely]] {
             break;
         }
 
+        l_returnValue = _stream.finish( _write );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto readStream( std::istream& _input, std::span< std::byte > _buffer )
+    -> std::optional< size_t > {
+    _input.read( reinterpret_cast< char* >( _buffer.data() ),
+                 static_cast< std::streamsize >( _buffer.size() ) );
+
+    if ( _input.bad() ) [[unlikely]] {
+        return ( std::nullopt );
+    }
+
+    return ( static_cast< size_t >( _input.gcount() ) );
+}
+
+auto writeStream( std::ostream& _output, std::span< const std::byte > _chunk )
+    -> bool {
+    _output.write( reinterpret_cast< const char* >( _chunk.data() ),
+                   static_cast< std::streamsize >( _chunk.size() ) );
+
+    return ( _output.good() );
+}
+
+template < typename Stream >
+auto pipeStreams( Stream& _stream, std::istream& _input, std::ostream& _output )
+    -> bool {
+    return ( pipeWith(
+        _stream,
+        [ & ]( std::span< std::byte > _buffer ) -> std::optional< size_t > {
+            return ( readStream( _input, _buffer ) );
+        },
+        [ & ]( std::span< const std::byte > _chunk ) -> bool {
+            return ( writeStream( _output, _chunk ) );
+        } ) );
+}
+
+#if defined( HAS_UNISTD )
+
+auto readDescriptor( int _input, std::span< std::byte > _buffer )
+    -> std::optional< size_t > {
+    ssize_t l_readSize = 0;
+
+    do {
+        l_readSize = ::read( _input, _buffer.data(), _buffer.size() );
+    } while ( ( l_readSize < 0 ) && ( errno == EINTR ) );
+
+    if ( l_readSize < 0 ) [[unlikely]] {
+        return ( std::nullopt );
+    }
+
+    return ( static_cast< size_t >( l_readSize ) );
+}
+
+auto writeDescriptor( int _output, std::span< const std::byte > _chunk )
+    -> bool {
+    while ( !_chunk.empty() ) {
+        const ssize_t l_writtenSize =
+            ::write( _output, _chunk.data(), _chunk.size() );
+
+        if ( l_writtenSize < 0 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+
+            return ( false );
+        }
+
+        _chunk = _chunk.subspan( static_cast< size_t >( l_writtenSize ) );
+    }
+
+    return ( true );
+}
+
+template < typename Stream >
+auto pipeDescriptors( Stream& _stream, int _input, int _output ) -> bool {
+    return ( pipeWith(
+        _stream,
+        [ & ]( std::span< std::byte > _buffer ) -> std::optional< size_t > {
+            return ( readDescriptor( _input, _buffer ) );
+        },
+        [ & ]( std::span< const std::byte > _chunk ) -> bool {
+            return ( writeDescriptor( _output, _chunk ) );
+        } ) );
+}
+
+#endif
+
+// Moves bytes of _pending from _offset on into _output, true once all are
+// out
+auto drain( std::vector< std::byte >& _pending,
+            size_t& _offset,
+            std::span< std::byte >& _output ) -> bool {
+    const size_t l_size =
+        std::min( ( _pending.size() - _offset ), _output.size() );
+
+    std::copy_n( ( _pending.begin() + static_cast< ptrdiff_t >( _offset ) ),
+                 l_size, _output.begin() );
+
+    _offset += l_size;
+    _output = _output.subspan( l_size );
+
+    if ( _offset != _pending.size() ) {
+        return ( false );
+    }
+
+    _pending.clear();
+    _offset = 0;
+
+    return ( true );
+}
+
+} // namespace
+
+#endif
+
+namespace {
+
+// Grows _output by the bound, then trims it to what _compress( span ) wrote
+template < typename Compress >
+auto appendInto( std::vector< std::byte >& _output,
+                 size_t _bound,
+                 Compress&& _compress ) -> std::optional< size_t > {
+    const size_t l_offset = _output.size();
+
+    _output.resize( l_offset + _bound );
+
+    const std::optional< size_t > l_returnValue =
+        _compress( std::span( _output ).subspan( l_offset ) );
+
+    _output.resize( l_offset + l_returnValue.value_or( 0 ) );
+
+    return ( l_returnValue );
+}
+
+void appendLittleEndian( std::vector< std::byte >& _output, uint32_t _value ) {
+    for ( size_t l_index = 0; l_index < sizeof( _value ); l_index++ ) {
+        _output.emplace_back(
+            static_cast< std::byte >( _value >> ( l_index * 8 ) ) );
+    }
+}
+
+constexpr size_t g_lzMinMatch = 4;
+// The LZ4 block format ends with literals and starts no match closer than
+// this to the end, so decoders may copy in whole words
+constexpr size_t g_lzLastLiterals = 5;
+constexpr size_t g_lzMatchStartLimit = 12;
+constexpr size_t g_lzMaxOffset = 0xFFFF;
+// Positions are stored in 32 bits, as in LZ4
+constexpr size_t g_lzMaxInputSize = 0x7E000000;
+// Level 1 keeps its table in L1 cache, the chained levels favor ratio
+constexpr size_t g_lzFastHashLog = 12;
+constexpr size_t g_lzMaxHashLog = 16;
+// Level 1 skips ahead faster the longer no match turns up
+constexpr size_t g_lzSkipStrength = 6;
+// LEB128 bytes of a 64 bit size
+constexpr size_t g_maxSizePrefix = 10;
+
+template < typename T >
+auto load( const std::byte* _source ) -> T {
+    T l_returnValue;
+
+    std::memcpy( &l_returnValue, _source, sizeof( T ) );
+
+    return ( l_returnValue );
+}
+
+// Five bytes separate more positions than the four a match needs
+auto lzHash( const std::byte* _position, size_t _hashLog ) -> size_t {
+    uint64_t l_sequence = load< uint64_t >( _position );
+
+    if constexpr ( std::endian::native == std::endian::little ) {
+        l_sequence <<= 24;
+
+    } else {
+        l_sequence >>= 24;
+    }
+
+    return ( static_cast< size_t >( ( l_sequence * 889523592379ULL ) >>
+                                    ( 64 - _hashLog ) ) );
+}
+
+// Common prefix of _position and the earlier _match, compared a word at a
+// time up to _limit
+auto matchLength( const std::byte* _position,
+                  const std::byte* _match,
+                  const std::byte* _limit ) -> size_t {
+    const std::byte* const l_start = _position;
+
+    bool l_isDifferent = false;
+
+    while ( !l_isDifferent &&
+            ( ( _position + sizeof( uint64_t ) ) <= _limit ) ) {
+        const uint64_t l_difference =
+            ( load< uint64_t >( _position ) ^ load< uint64_t >( _match ) );
+
+        if ( l_difference ) {
+            if constexpr ( std::endian::native == std::endian::little ) {
+                _position += ( std::countr_zero( l_difference ) / 8 );
+
+            } else {
+                _position += ( std::countl_zero( l_difference ) / 8 );
+            }
+
+            l_isDifferent = true;
+
+        } else {
+            _position += sizeof( uint64_t );
+            _match += sizeof( uint64_t );
+        }
+    }
+
+    while ( !l_isDifferent && ( _position < _limit ) &&
+            ( *_position == *_match ) ) {
+        _position++;
+        _match++;
+    }
+
+    return ( static_cast< size_t >( _position - l_start ) );
+}
+
+// Length above the token nibble as a run of 255 bytes plus a remainder
+auto writeLength( std::byte* _output, size_t _length ) -> std::byte* {
+    for ( ; _length >= 0xFF; _length -= 0xFF ) {
+        *( _output++ ) = std::byte{ 0xFF };
+    }
+
+    *( _output++ ) = std::byte( static_cast< uint8_t >( _length ) );
+
+    return ( _output );
+}
+
+// Token, _literals and unless _length is 0 a match, returns the end of what
+// was written
+auto writeSequence( std::byte* _output,
+                    std::span< const std::byte > _literals,
+                    size_t _offset,
+                    size_t _length ) -> std::byte* {
+    std::byte* const l_token = _output++;
+    auto l_tokenValue = static_cast< uint8_t >(
+        std::min< size_t >( _literals.size(), 15 ) << 4 );
+
+    if ( _literals.size() >= 15 ) {
+        _output = writeLength( _output, ( _literals.size() - 15 ) );
+    }
+
+    if ( !_literals.empty() ) {
+        std::memcpy( _output, _literals.data(), _literals.size() );
+
+        _output += _literals.size();
+    }
+
+    if ( _length ) {
+        *( _output++ ) = std::byte( static_cast< uint8_t >( _offset ) );
+        *( _output++ ) = std::byte( static_cast< uint8_t >( _offset >> 8 ) );
+
+        const size_t l_extra = ( _length - g_lzMinMatch );
+
+        l_tokenValue |=
+            static_cast< uint8_t >( std::min< size_t >( l_extra, 15 ) );
+
+        if ( l_extra >= 15 ) {
+            _output = writeLength( _output, ( l_extra - 15 ) );
+        }
+    }
+
+    *l_token = std::byte{ l_tokenValue };
+
+    return ( _output );
+}
+
+// Greedy LZ4 block encoder, _output holds lzBound( _data.size() ) bytes
+auto encodeLz( std::span< const std::byte > _data,
+               std::byte* _output,
+               size_t _level ) -> size_t {
+    std::byte* l_output = _output;
+
+    size_t l_size = _data.size();
+
+    for ( ; l_size >= 0x80; l_size >>= 7 ) {
+        *( l_output++ ) =
+            std::byte( static_cast< uint8_t >( ( l_size & 0x7F ) | 0x80 ) );
+    }
+
+    *( l_output++ ) = std::byte( static_cast< uint8_t >( l_size ) );
+
+    const std::byte* const l_begin = _data.data();
+    const std::byte* const l_end = ( l_begin + _data.size() );
+    const std::byte* l_anchor = l_begin;
+
+    if ( _data.size() > g_lzMatchStartLimit ) {
+        const size_t l_depth = ( size_t{ 1 } << ( _level - 1 ) );
+        const size_t l_hashLog = std::clamp< size_t >(
+            std::bit_width( _data.size() ), 10,
+            ( ( l_depth > 1 ) ? g_lzMaxHashLog : g_lzFastHashLog ) );
+
+        // Most recent position per hash and, from level 2 on, the distance
+        // from every position in the window to the previous one
+        std::vector< uint32_t > l_heads( size_t{ 1 } << l_hashLog );
+        std::vector< uint16_t > l_chain( ( l_depth > 1 ) ? ( g_lzMaxOffset + 1 )
+                                                         : 0 );
+
+        const std::byte* const l_matchLimit = ( l_end - g_lzLastLiterals );
+        const std::byte* const l_startLimit = ( l_end - g_lzMatchStartLimit );
+
+        const bool l_isChained = !l_chain.empty();
+
+        // Returns the previous position with the same hash
+        auto l_insert = [ & ]( const std::byte* _position ) -> size_t {
+            const auto l_position =
+                static_cast< uint32_t >( _position - l_begin );
+
+            uint32_t& l_head = l_heads[ lzHash( _position, l_hashLog ) ];
+
+            const uint32_t l_previous = l_head;
+
+            if ( l_isChained ) {
+                l_chain[ l_position & g_lzMaxOffset ] =
+                    static_cast< uint16_t >( std::min< size_t >(
+                        ( l_position - l_previous ), g_lzMaxOffset ) );
+            }
+
+            l_head = l_position;
+
+            return ( l_previous );
+        };
+
+        const std::byte* l_position = l_begin;
+
+        while ( l_position <= l_startLimit ) {
+            const auto l_current =
+                static_cast< size_t >( l_position - l_begin );
+
+            const std::byte* l_best = nullptr;
+            size_t l_bestLength = 0;
+            size_t l_candidate = l_insert( l_position );
+
+            for ( size_t l_attempt = 0;
+                  ( l_attempt < l_depth ) && ( l_candidate < l_current ) &&
+                  ( ( l_current - l_candidate ) <= g_lzMaxOffset );
+                  l_attempt++ ) {
+                const std::byte* const l_match = ( l_begin + l_candidate );
+
+                if ( load< uint32_t >( l_match ) ==
+                     load< uint32_t >( l_position ) ) {
+                    const size_t l_length =
+                        ( g_lzMinMatch +
+                          matchLength( ( l_position + g_lzMinMatch ),
+                                       ( l_match + g_lzMinMatch ),
+                                       l_matchLimit ) );
+
+                    if ( l_length > l_bestLength ) {
+                        l_best = l_match;
+                        l_bestLength = l_length;
+                    }
+                }
+
+                const size_t l_distance =
+                    ( l_isChained ? l_chain[ l_candidate & g_lzMaxOffset ]
+                                  : 0 );
+
+                l_candidate = ( l_distance ? ( l_candidate - l_distance )
+                                           : l_current );
+            }
+
+            if ( !l_bestLength ) {
+                l_position +=
+                    ( ( l_depth > 1 )
+                          ? 1
+                          : ( 1 + ( static_cast< size_t >( l_position -
+                                                           l_anchor ) >>
+                                    g_lzSkipStrength ) ) );
+
+                continue;
+            }
+
+            const std::byte* const l_searched = l_position;
+
+            // The match often starts in the literals before it
+            while ( ( l_position > l_anchor ) && ( l_best > l_begin ) &&
+                    ( l_position[ -1 ] == l_best[ -1 ] ) ) {
+                l_position--;
+                l_best--;
+                l_bestLength++;
+            }
+
+            l_output = writeSequence(
+                l_output,
+                std::span( l_anchor, static_cast< size_t >( l_position -
+                                                            l_anchor ) ),
+                static_cast< size_t >( l_position - l_best ), l_bestLength );
+
+            l_position += l_bestLength;
+            l_anchor = l_position;
+
+            // Positions the match covers feed later searches, level 1 only
+            // takes the one before its end
+            const std::byte* const l_insertEnd =
+                std::min( l_position, ( l_startLimit + 1 ) );
+
+            for ( const std::byte* l_covered =
+                      ( ( l_depth > 1 ) ? ( l_searched + 1 )
+                                        : ( l_position - 2 ) );
+                  l_covered < l_insertEnd; l_covered++ ) {
+                l_insert( l_covered );
+            }
+        }
+    }
+
+    l_output = writeSequence(
+        l_output,
+        std::span( l_anchor, static_cast< size_t >( l_end - l_anchor ) ), 0,
+        0 );
+
+    return ( static_cast< size_t >( l_output - _output ) );
+}
+
+} // namespace
+
+auto lzBound( size_t _size ) -> size_t {
+    return ( _size + ( _size / 0xFF ) + 16 + g_maxSizePrefix );
+}
+
+auto lz( std::span< const std::byte > _data,
+         std::span< std::byte > _buffer,
+         size_t _level ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
         if ( !_level ) [[unlikely]] {
             break;
         }
 
-        std::string l_compressed;
+        if ( _data.size() > g_lzMaxInputSize ) [[unlikely]] {
+            break;
+        }
 
-        if ( !snappy::Compress( _text.data(), _text.size(), &l_compressed,
-                                snappy::CompressionOptions( _level ) ) )
-            [[unlikely]] {
+        // The encoder writes up to the bound unchecked
+        if ( _buffer.size() < lzBound( _data.size() ) ) [[unlikely]] {
             break;
         }
 
-        l_returnValue = l_compressed;
+        l_returnValue = encodeLz( _data, _buffer.data(),
+                                  std::min( _level, g_lzMaxLevel ) );
     } while ( false );
 
     return ( l_returnValue );
 }
 
-#endif
-
-#if defined( HAS_ZSTD )
+auto lz( std::span< const std::byte > _data,
+         std::vector< std::byte >& _output,
+         size_t _level ) -> std::optional< size_t > {
+    return ( appendInto( _output, lzBound( _data.size() ),
+                         [ & ]( std::span< std::byte > _buffer )
+                             -> std::optional< size_t > {
+                             return ( lz( _data, _buffer, _level ) );
+                         } ) );
+}
 
-auto data( std::span< const std::byte > _data, size_t _level )
+auto lz( std::span< const std::byte > _data, size_t _level )
     -> std::optional< std::vector< std::byte > > {
     std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
 
+    std::vector< std::byte > l_compressed;
+
+    if ( lz( _data, l_compressed, _level ) ) [[likely]] {
+        l_returnValue = std::move( l_compressed );
+    }
+
+    return ( l_returnValue );
+}
+
+#if defined( HAS_SNAPPY )
+
+auto textBound( size_t _size ) -> size_t {
+    return ( snappy::MaxCompressedLength( _size ) );
+}
+
+auto text( std::string_view _text, std::span< char > _buffer, size_t _level )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
     do {
-        if ( _data.empty() ) [[unlikely]] {
+        if ( _text.empty() ) [[unlikely]] {
             break;
         }
 
@@ -75,26 +584,2822 @@ auto data( std::span< const std::byte > _data, size_t _level )
             break;
         }
 
-        const size_t l_maxCompressedSize = ZSTD_compressBound( _data.size() );
+        // RawCompress() writes up to the bound unchecked
+        if ( _buffer.size() < textBound( _text.size() ) ) [[unlikely]] {
+            break;
+        }
 
-        std::vector< std::byte > l_compressed( l_maxCompressedSize );
+        size_t l_compressedSize = 0;
 
-        const size_t l_compressedSize =
-            ZSTD_compress( l_compressed.data(), l_compressed.size(),
-                           _data.data(), _data.size(), _level );
+        snappy::RawCompress(
+            _text.data(), _text.size(), _buffer.data(), &l_compressedSize,
+            snappy::CompressionOptions( static_cast< int >( _level ) ) );
 
-        if ( ZSTD_isError( l_compressedSize ) ) [[unlikely]] {
+        l_returnValue = l_compressedSize;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto text( std::string_view _text, std::string& _output, size_t _level )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    const size_t l_offset = _output.size();
+
+    _output.resize_and_overwrite(
+        ( l_offset + textBound( _text.size() ) ),
+        [ & ]( char* _buffer, size_t _size ) -> size_t {
+            l_returnValue =
+                text( _text,
+                      std::span( ( _buffer + l_offset ), ( _size - l_offset ) ),
+                      _level );
+
+            return ( l_offset + l_returnValue.value_or( 0 ) );
+        } );
+
+    return ( l_returnValue );
+}
+
+auto text( std::string_view _text, size_t _level )
+    -> std::optional< std::string > {
+    std::optional< std::string > l_returnValue = std::nullopt;
+
+    std::string l_compressed;
+
+    if ( text( _text, l_compressed, _level ) ) [[likely]] {
+        l_returnValue = std::move( l_compressed );
+    }
+
+    return ( l_returnValue );
+}
+
+namespace {
+
+// Snappy framing format
+constexpr size_t g_framingBlockSize = ( 64 * 1024 );
+constexpr size_t g_framingHeaderSize = 4;
+constexpr size_t g_framingChecksumSize = 4;
+constexpr std::byte g_framingCompressedChunk{ 0x00 };
+constexpr std::byte g_framingUncompressedChunk{ 0x01 };
+constexpr std::array< std::byte, 10 > g_framingStreamIdentifier{
+    std::byte{ 0xFF }, std::byte{ 0x06 }, std::byte{ 0x00 },
+    std::byte{ 0x00 }, std::byte{ 's' },  std::byte{ 'N' },
+    std::byte{ 'a' },  std::byte{ 'P' },  std::byte{ 'p' },
+    std::byte{ 'Y' } };
+
+auto maskedCrc32c( std::span< const std::byte > _data ) -> uint32_t {
+    const uint32_t l_crc = hash::crc32c( _data );
+
+    return ( ( ( l_crc >> 15 ) | ( l_crc << 17 ) ) + 0xA282EAD8 );
+}
+
+void storeLittleEndian( std::byte* _destination,
+                        uint32_t _value,
+                        size_t _size ) {
+    for ( size_t l_index = 0; l_index < _size; l_index++ ) {
+        _destination[ l_index ] =
+            static_cast< std::byte >( _value >> ( l_index * 8 ) );
+    }
+}
+
+[[nodiscard]] auto chunkBound( size_t _blockSize ) -> size_t {
+    return ( g_framingHeaderSize + g_framingChecksumSize +
+             textBound( _blockSize ) );
+}
+
+// Writes one framing format chunk of _block, _destination holds at least
+// chunkBound( _block.size() ) bytes. Returns the chunk size
+auto writeChunk( std::span< const std::byte > _block,
+                 std::byte* _destination,
+                 size_t _level ) -> size_t {
+    std::byte* l_data =
+        ( _destination + g_framingHeaderSize + g_framingChecksumSize );
+
+    size_t l_compressedSize = 0;
+
+    snappy::RawCompress(
+        reinterpret_cast< const char* >( _block.data() ), _block.size(),
+        reinterpret_cast< char* >( l_data ), &l_compressedSize,
+        snappy::CompressionOptions( static_cast< int >( _level ) ) );
+
+    std::byte l_type = g_framingCompressedChunk;
+
+    // Incompressible input is stored as is
+    if ( l_compressedSize >= _block.size() ) {
+        l_type = g_framingUncompressedChunk;
+        l_compressedSize = _block.size();
+
+        std::ranges::copy( _block, l_data );
+    }
+
+    _destination[ 0 ] = l_type;
+
+    storeLittleEndian( ( _destination + 1 ),
+                       static_cast< uint32_t >( g_framingChecksumSize +
+                                                l_compressedSize ),
+                       3 );
+    storeLittleEndian( ( _destination + g_framingHeaderSize ),
+                       maskedCrc32c( _block ), g_framingChecksumSize );
+
+    return ( g_framingHeaderSize + g_framingChecksumSize + l_compressedSize );
+}
+
+} // namespace
+
+auto framedText( std::string_view _text, size_t _workers, size_t _level )
+    -> std::optional< std::string > {
+    std::optional< std::string > l_returnValue = std::nullopt;
+
+    do {
+        if ( _text.empty() ) [[unlikely]] {
+            break;
+        }
+
+        if ( !_level ) [[unlikely]] {
             break;
         }
 
-        l_compressed.resize( l_compressedSize );
+        const auto l_input = std::as_bytes( std::span( _text ) );
+        const size_t l_blockCount =
+            ( ( l_input.size() + g_framingBlockSize - 1 ) /
+              g_framingBlockSize );
+        const size_t l_chunkBound = chunkBound( g_framingBlockSize );
+
+        std::vector< size_t > l_chunkSizes( l_blockCount );
+
+        std::string l_compressed;
+
+        // Every block compresses into its own slot, then the chunks are
+        // packed in order
+        l_compressed.resize_and_overwrite(
+            ( g_framingStreamIdentifier.size() +
+              ( l_blockCount * l_chunkBound ) ),
+            [ & ]( char* _buffer, size_t ) -> size_t {
+                auto* l_output = reinterpret_cast< std::byte* >( _buffer );
+                std::byte* l_chunks =
+                    ( l_output + g_framingStreamIdentifier.size() );
+
+                std::ranges::copy( g_framingStreamIdentifier, l_output );
+
+                thread::parallelFor(
+                    l_blockCount,
+                    [ & ]( size_t _block ) -> void {
+                        const size_t l_offset = ( _block * g_framingBlockSize );
+
+                        l_chunkSizes[ _block ] = writeChunk(
+                            l_input.subspan(
+                                l_offset,
+                                std::min( g_framingBlockSize,
+                                          ( l_input.size() - l_offset ) ) ),
+                            ( l_chunks + ( _block * l_chunkBound ) ), _level );
+                    },
+                    _workers );
+
+                size_t l_size = g_framingStreamIdentifier.size();
+
+                for ( size_t l_block = 0; l_block < l_blockCount; l_block++ ) {
+                    std::memmove( ( l_output + l_size ),
+                                  ( l_chunks + ( l_block * l_chunkBound ) ),
+                                  l_chunkSizes[ l_block ] );
 
-        l_returnValue = l_compressed;
+                    l_size += l_chunkSizes[ l_block ];
+                }
+
+                return ( l_size );
+            } );
+
+        l_returnValue = std::move( l_compressed );
     } while ( false );
 
     return ( l_returnValue );
 }
 
-#endif
+textStream::textStream( size_t _level )
+    : _level( _level ),
+      _pending( g_framingStreamIdentifier.begin(),
+                g_framingStreamIdentifier.end() ),
+      _buffer( g_framingBlockSize ) {
+    _block.reserve( g_framingBlockSize );
+}
+
+void textStream::_compressBlock() {
+    const size_t l_offset = _pending.size();
+
+    _pending.resize( l_offset + chunkBound( _block.size() ) );
+
+    const size_t l_chunkSize =
+        writeChunk( _block, ( _pending.data() + l_offset ), _level );
+
+    _pending.resize( l_offset + l_chunkSize );
+
+    _block.clear();
+}
+
+auto textStream::_drain( std::span< std::byte >& _output ) -> bool {
+    return ( drain( _pending, _pendingOffset, _output ) );
+}
+
+auto textStream::update( std::span< const std::byte >& _input,
+                         std::span< std::byte >& _output ) -> bool {
+    bool l_returnValue = false;
+
+    do {
+        if ( !_level ) [[unlikely]] {
+            break;
+        }
+
+        while ( _drain( _output ) && !_input.empty() ) {
+            const size_t l_size = std::min(
+                ( g_framingBlockSize - _block.size() ), _input.size() );
+
+            _block.insert( _block.end(), _input.begin(),
+                           ( _input.begin() +
+                             static_cast< ptrdiff_t >( l_size ) ) );
+
+            _input = _input.subspan( l_size );
+
+            if ( _block.size() == g_framingBlockSize ) {
+                _compressBlock();
+            }
+        }
+
+        l_returnValue = true;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto textStream::finish( std::span< std::byte >& _output )
+    -> std::optional< bool > {
+    std::optional< bool > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_level ) [[unlikely]] {
+            break;
+        }
+
+        if ( !_block.empty() ) {
+            _compressBlock();
+        }
+
+        l_returnValue = _drain( _output );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto pipe( textStream& _stream, std::istream& _input, std::ostream& _output )
+    -> bool {
+    return ( pipeStreams( _stream, _input, _output ) );
+}
+
+#if defined( HAS_UNISTD )
+
+auto pipe( textStream& _stream, int _input, int _output ) -> bool {
+    return ( pipeDescriptors( _stream, _input, _output ) );
+}
+
+#endif
+
+#endif
+
+#if defined( HAS_ZSTD )
+
+namespace {
+
+struct contextDeleter {
+    void operator()( ZSTD_CCtx* _context ) const { ZSTD_freeCCtx( _context ); }
+};
+
+// Reused across calls, ZSTD_compressCCtx() only re-applies the level
+auto threadContext() -> ZSTD_CCtx* {
+    thread_local const std::unique_ptr< ZSTD_CCtx, contextDeleter > l_context{
+        ZSTD_createCCtx() };
+
+    return ( l_context.get() );
+}
+
+// _compress( destination, capacity ) returns a ZSTD size or error code
+template < typename Compress >
+auto compressInto( std::span< const std::byte > _data,
+                   std::span< std::byte > _buffer,
+                   Compress&& _compress ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        if ( _data.empty() ) [[unlikely]] {
+            break;
+        }
+
+        const size_t l_compressedSize =
+            _compress( _buffer.data(), _buffer.size() );
+
+        if ( ZSTD_isError( l_compressedSize ) ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = l_compressedSize;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+// Smallest window any level picks for inputs past it, so below this zstd
+// never wraps its streaming buffer and streamed frames match one-shot ones
+constexpr size_t g_streamedFragmentsLimit = ( 512 * 1024 );
+
+auto fragmentsSize( std::span< const std::span< const std::byte > > _fragments )
+    -> size_t {
+    size_t l_returnValue = 0;
+
+    for ( const std::span< const std::byte > _fragment : _fragments ) {
+        l_returnValue += _fragment.size();
+    }
+
+    return ( l_returnValue );
+}
+
+auto applyParameters( ZSTD_CCtx* _context, const parameters& _parameters )
+    -> bool {
+    bool l_returnValue = false;
+
+    auto l_set = [ & ]( ZSTD_cParameter _parameter, size_t _value ) -> bool {
+        return ( !ZSTD_isError( ZSTD_CCtx_setParameter(
+            _context, _parameter, static_cast< int >( _value ) ) ) );
+    };
+
+    do {
+        if ( !l_set( ZSTD_c_compressionLevel, _parameters.level ) )
+            [[unlikely]] {
+            break;
+        }
+
+        // Both fail when libzstd is built without ZSTD_MULTITHREAD, the
+        // frame is then compressed on the calling thread
+        if ( _parameters.workers &&
+             l_set( ZSTD_c_nbWorkers, _parameters.workers ) &&
+             _parameters.jobSize ) {
+            l_set( ZSTD_c_jobSize, _parameters.jobSize );
+        }
+
+        if ( _parameters.windowLog &&
+             !l_set( ZSTD_c_windowLog, _parameters.windowLog ) ) [[unlikely]] {
+            break;
+        }
+
+        if ( _parameters.longDistanceMatching &&
+             !l_set( ZSTD_c_enableLongDistanceMatching, 1 ) ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = true;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto compressWithDictionary( ZSTD_CCtx* _context,
+                             std::span< const std::byte > _data,
+                             std::span< std::byte > _buffer,
+                             const ZSTD_CDict* _dictionary )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_context || !_dictionary ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = compressInto(
+            _data, _buffer,
+            [ & ]( void* _destination, size_t _capacity ) -> size_t {
+                return ( ZSTD_compress_usingCDict(
+                    _context, _destination, _capacity, _data.data(),
+                    _data.size(), _dictionary ) );
+            } );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+// zstd seekable format
+constexpr uint32_t g_seekTableMagic = 0x184D2A5E;
+constexpr uint32_t g_seekableMagic = 0x8F92EAB1;
+constexpr std::byte g_seekTableChecksumFlag{ 0x80 };
+constexpr size_t g_seekTableEntrySize = ( 3 * sizeof( uint32_t ) );
+constexpr size_t g_seekTableFooterSize = ( ( 2 * sizeof( uint32_t ) ) + 1 );
+
+// Compressed size, decompressed size and the low 32 bits of XXH64
+void appendSeekEntry( std::vector< std::byte >& _entries,
+                      size_t _compressedSize,
+                      std::span< const std::byte > _chunk ) {
+    appendLittleEndian( _entries, static_cast< uint32_t >( _compressedSize ) );
+    appendLittleEndian( _entries, static_cast< uint32_t >( _chunk.size() ) );
+    appendLittleEndian( _entries,
+                        static_cast< uint32_t >( hash::xxh64( _chunk ) ) );
+}
+
+// Skippable frame holding _entries, closed by the seekable footer
+void appendSeekTable( std::vector< std::byte >& _output,
+                      std::span< const std::byte > _entries ) {
+    appendLittleEndian( _output, g_seekTableMagic );
+    appendLittleEndian( _output,
+                        static_cast< uint32_t >( _entries.size() +
+                                                 g_seekTableFooterSize ) );
+
+    _output.insert( _output.end(), _entries.begin(), _entries.end() );
+
+    appendLittleEndian( _output,
+                        static_cast< uint32_t >( _entries.size() /
+                                                 g_seekTableEntrySize ) );
+    _output.emplace_back( g_seekTableChecksumFlag );
+    appendLittleEndian( _output, g_seekableMagic );
+}
+
+// Sizes and the chunk count have to fit the 32 bit seek table fields
+[[nodiscard]] auto isSeekableChunkSize( size_t _chunkSize ) -> bool {
+    return ( _chunkSize && ( ZSTD_compressBound( _chunkSize ) <=
+                             std::numeric_limits< uint32_t >::max() ) );
+}
+
+// _compress( buffer, slot ) compresses one non-empty buffer into its slot
+template < typename Compress >
+auto compressBatch( std::span< const std::span< const std::byte > > _buffers,
+                    size_t _workers,
+                    Compress&& _compress ) -> std::optional< arena > {
+    std::optional< arena > l_returnValue = std::nullopt;
+
+    do {
+        // Every buffer compresses into a slot of its bound, then the frames
+        // are packed in order
+        std::vector< size_t > l_slots( _buffers.size() + 1 );
+
+        for ( size_t l_index = 0; l_index < _buffers.size(); l_index++ ) {
+            l_slots[ l_index + 1 ] =
+                ( l_slots[ l_index ] +
+                  ( _buffers[ l_index ].empty()
+                        ? 0
+                        : dataBound( _buffers[ l_index ].size() ) ) );
+        }
+
+        arena l_arena;
+
+        l_arena.data.resize( l_slots.back() );
+
+        std::vector< size_t > l_sizes( _buffers.size() );
+        std::atomic< bool > l_isFailed = false;
+
+        thread::parallelFor(
+            _buffers.size(),
+            [ & ]( size_t _index ) -> void {
+                if ( _buffers[ _index ].empty() ) {
+                    return;
+                }
+
+                const std::optional< size_t > l_size = _compress(
+                    _buffers[ _index ],
+                    std::span( l_arena.data )
+                        .subspan( l_slots[ _index ],
+                                  ( l_slots[ _index + 1 ] -
+                                    l_slots[ _index ] ) ) );
+
+                if ( !l_size ) [[unlikely]] {
+                    l_isFailed.store( true, std::memory_order_relaxed );
+
+                    return;
+                }
+
+                l_sizes[ _index ] = *l_size;
+            },
+            _workers );
+
+        if ( l_isFailed.load( std::memory_order_relaxed ) ) [[unlikely]] {
+            break;
+        }
+
+        l_arena.offsets.resize( _buffers.size() + 1 );
+
+        for ( size_t l_index = 0; l_index < _buffers.size(); l_index++ ) {
+            const size_t l_offset = l_arena.offsets[ l_index ];
+
+            std::memmove( ( l_arena.data.data() + l_offset ),
+                          ( l_arena.data.data() + l_slots[ l_index ] ),
+                          l_sizes[ l_index ] );
+
+            l_arena.offsets[ l_index + 1 ] = ( l_offset + l_sizes[ l_index ] );
+        }
+
+        l_arena.data.resize( l_arena.offsets.back() );
+
+        l_returnValue = std::move( l_arena );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+auto dataBound( size_t _size ) -> size_t {
+    return ( ZSTD_compressBound( _size ) );
+}
+
+auto data( std::span< const std::byte > _data,
+           std::span< std::byte > _buffer,
+           size_t _level ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_level ) [[unlikely]] {
+            break;
+        }
+
+        ZSTD_CCtx* l_context = threadContext();
+
+        if ( !l_context ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = compressInto(
+            _data, _buffer,
+            [ & ]( void* _destination, size_t _capacity ) -> size_t {
+                return ( ZSTD_compressCCtx(
+                    l_context, _destination, _capacity, _data.data(),
+                    _data.size(), static_cast< int >( _level ) ) );
+            } );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto data( std::span< const std::byte > _data,
+           std::vector< std::byte >& _output,
+           size_t _level ) -> std::optional< size_t > {
+    return ( appendInto( _output, dataBound( _data.size() ),
+                         [ & ]( std::span< std::byte > _buffer )
+                             -> std::optional< size_t > {
+                             return ( data( _data, _buffer, _level ) );
+                         } ) );
+}
+
+auto data( std::span< const std::byte > _data, size_t _level )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    std::vector< std::byte > l_compressed;
+
+    if ( data( _data, l_compressed, _level ) ) [[likely]] {
+        l_returnValue = std::move( l_compressed );
+    }
+
+    return ( l_returnValue );
+}
+
+auto data( std::span< const std::byte > _data,
+           const parameters& _parameters )
+    -> std::optional< std::vector< std::byte > > {
+    // Worker threads belong to the context, so large parallel jobs do not
+    // keep them alive in the cached per-thread one
+    context l_context( _parameters );
+
+    return ( l_context.data( _data ) );
+}
+
+auto data( std::span< const std::span< const std::byte > > _fragments,
+           std::span< std::byte > _buffer,
+           size_t _level ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_level ) [[unlikely]] {
+            break;
+        }
+
+        const size_t l_size = fragmentsSize( _fragments );
+
+        if ( !l_size ) [[unlikely]] {
+            break;
+        }
+
+        // The last fragment ends the frame, a separate empty end call would
+        // add an empty last block
+        const std::span< const std::byte >* l_last = nullptr;
+
+        for ( const std::span< const std::byte >& _fragment : _fragments ) {
+            if ( !_fragment.empty() ) {
+                l_last = &_fragment;
+            }
+        }
+
+        // A single fragment is contiguous already
+        if ( l_last->size() == l_size ) {
+            l_returnValue = data( *l_last, _buffer, _level );
+
+            break;
+        }
+
+        if ( l_size > g_streamedFragmentsLimit ) {
+            std::vector< std::byte > l_gathered;
+
+            l_gathered.reserve( l_size );
+
+            for ( const std::span< const std::byte > _fragment : _fragments ) {
+                l_gathered.insert( l_gathered.end(), _fragment.begin(),
+                                   _fragment.end() );
+            }
+
+            l_returnValue = data( l_gathered, _buffer, _level );
+
+            break;
+        }
+
+        ZSTD_CCtx* l_context = threadContext();
+
+        if ( !l_context ) [[unlikely]] {
+            break;
+        }
+
+        // The pledged size picks the same parameters as the one-shot call
+        // and is recorded in the frame header
+        if ( ZSTD_isError( ZSTD_CCtx_reset(
+                 l_context, ZSTD_reset_session_and_parameters ) ) ||
+             ZSTD_isError( ZSTD_CCtx_setParameter(
+                 l_context, ZSTD_c_compressionLevel,
+                 static_cast< int >( _level ) ) ) ||
+             ZSTD_isError( ZSTD_CCtx_setPledgedSrcSize( l_context, l_size ) ) )
+            [[unlikely]] {
+            break;
+        }
+
+        ZSTD_outBuffer l_output{ _buffer.data(), _buffer.size(), 0 };
+        bool l_isFinished = false;
+
+        for ( const std::span< const std::byte >& _fragment : _fragments ) {
+            if ( _fragment.empty() ) {
+                continue;
+            }
+
+            const ZSTD_EndDirective l_directive =
+                ( ( &_fragment == l_last ) ? ZSTD_e_end : ZSTD_e_continue );
+
+            ZSTD_inBuffer l_input{ _fragment.data(), _fragment.size(), 0 };
+
+            const size_t l_result = ZSTD_compressStream2(
+                l_context, &l_output, &l_input, l_directive );
+
+            // Input left over means the output is full
+            if ( ZSTD_isError( l_result ) || ( l_input.pos < l_input.size ) )
+                [[unlikely]] {
+                break;
+            }
+
+            l_isFinished = ( ( l_directive == ZSTD_e_end ) && !l_result );
+        }
+
+        if ( !l_isFinished ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = l_output.pos;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto data( std::span< const std::span< const std::byte > > _fragments,
+           std::vector< std::byte >& _output,
+           size_t _level ) -> std::optional< size_t > {
+    return ( appendInto( _output, dataBound( fragmentsSize( _fragments ) ),
+                         [ & ]( std::span< std::byte > _buffer )
+                             -> std::optional< size_t > {
+                             return ( data( _fragments, _buffer, _level ) );
+                         } ) );
+}
+
+auto data( std::span< const std::span< const std::byte > > _fragments,
+           size_t _level ) -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    std::vector< std::byte > l_compressed;
+
+    if ( data( _fragments, l_compressed, _level ) ) [[likely]] {
+        l_returnValue = std::move( l_compressed );
+    }
+
+    return ( l_returnValue );
+}
+
+auto async( std::span< const std::byte > _data,
+            size_t _level,
+            async::pool& _pool )
+    -> async::task< std::optional< std::vector< std::byte > > > {
+    co_await _pool.schedule();
+
+    co_return ( data( _data, _level ) );
+}
+
+context::context( size_t _level ) : context( parameters{ .level = _level } ) {}
+
+context::context( const parameters& _parameters )
+    : _context( ZSTD_createCCtx() ), _level( _parameters.level ) {
+    if ( _context && !applyParameters( _context, _parameters ) )
+        [[unlikely]] {
+        ZSTD_freeCCtx( std::exchange( _context, nullptr ) );
+    }
+}
+
+context::context( context&& _other ) noexcept
+    : _context( std::exchange( _other._context, nullptr ) ),
+      _level( _other._level ) {}
+
+context::~context() {
+    ZSTD_freeCCtx( _context );
+}
+
+auto context::operator=( context&& _other ) noexcept -> context& {
+    if ( this != &_other ) {
+        ZSTD_freeCCtx( _context );
+
+        _context = std::exchange( _other._context, nullptr );
+        _level = _other._level;
+    }
+
+    return ( *this );
+}
+
+auto context::data( std::span< const std::byte > _data,
+                    std::span< std::byte > _buffer )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_level ) [[unlikely]] {
+            break;
+        }
+
+        if ( !_context ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = compressInto(
+            _data, _buffer,
+            [ & ]( void* _destination, size_t _capacity ) -> size_t {
+                return ( ZSTD_compress2( _context, _destination, _capacity,
+                                         _data.data(), _data.size() ) );
+            } );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto context::data( std::span< const std::byte > _data,
+                    std::vector< std::byte >& _output )
+    -> std::optional< size_t > {
+    return ( appendInto( _output, dataBound( _data.size() ),
+                         [ & ]( std::span< std::byte > _buffer )
+                             -> std::optional< size_t > {
+                             return ( data( _data, _buffer ) );
+                         } ) );
+}
+
+auto context::data( std::span< const std::byte > _data )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    std::vector< std::byte > l_compressed;
+
+    if ( data( _data, l_compressed ) ) [[likely]] {
+        l_returnValue = std::move( l_compressed );
+    }
+
+    return ( l_returnValue );
+}
+
+auto context::data( std::span< const std::byte > _data,
+                    std::span< std::byte > _buffer,
+                    const dictionary& _dictionary )
+    -> std::optional< size_t > {
+    return ( compressWithDictionary( _context, _data, _buffer,
+                                     _dictionary._dictionary ) );
+}
+
+auto context::data( std::span< const std::byte > _data,
+                    std::vector< std::byte >& _output,
+                    const dictionary& _dictionary )
+    -> std::optional< size_t > {
+    return ( appendInto( _output, dataBound( _data.size() ),
+                         [ & ]( std::span< std::byte > _buffer )
+                             -> std::optional< size_t > {
+                             return ( data( _data, _buffer, _dictionary ) );
+                         } ) );
+}
+
+auto context::data( std::span< const std::byte > _data,
+                    const dictionary& _dictionary )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    std::vector< std::byte > l_compressed;
+
+    if ( data( _data, l_compressed, _dictionary ) ) [[likely]] {
+        l_returnValue = std::move( l_compressed );
+    }
+
+    return ( l_returnValue );
+}
+
+auto trainDictionary( std::span< const std::span< const std::byte > > _samples,
+                      size_t _capacity )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        if ( _samples.empty() || !_capacity ) [[unlikely]] {
+            break;
+        }
+
+        // ZDICT takes the samples back to back, with their sizes
+        std::vector< std::byte > l_samples;
+        std::vector< size_t > l_sizes;
+
+        l_sizes.reserve( _samples.size() );
+
+        for ( const std::span< const std::byte > _sample : _samples ) {
+            l_samples.insert( l_samples.end(), _sample.begin(),
+                              _sample.end() );
+            l_sizes.emplace_back( _sample.size() );
+        }
+
+        std::vector< std::byte > l_dictionary( _capacity );
+
+        const size_t l_size = ZDICT_trainFromBuffer(
+            l_dictionary.data(), l_dictionary.size(), l_samples.data(),
+            l_sizes.data(), static_cast< unsigned >( l_sizes.size() ) );
+
+        if ( ZDICT_isError( l_size ) ) [[unlikely]] {
+            break;
+        }
+
+        l_dictionary.resize( l_size );
+
+        l_returnValue = std::move( l_dictionary );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+dictionary::dictionary( std::span< const std::byte > _content, size_t _level )
+    : _dictionary( ZSTD_createCDict( _content.data(), _content.size(),
+                                     static_cast< int >( _level ) ) ) {}
+
+dictionary::dictionary( dictionary&& _other ) noexcept
+    : _dictionary( std::exchange( _other._dictionary, nullptr ) ) {}
+
+dictionary::~dictionary() {
+    ZSTD_freeCDict( _dictionary );
+}
+
+auto dictionary::operator=( dictionary&& _other ) noexcept -> dictionary& {
+    if ( this != &_other ) {
+        ZSTD_freeCDict( _dictionary );
+
+        _dictionary = std::exchange( _other._dictionary, nullptr );
+    }
+
+    return ( *this );
+}
+
+auto dictionary::id() const -> uint32_t {
+    return ( _dictionary ? ZSTD_getDictID_fromCDict( _dictionary ) : 0 );
+}
+
+auto data( std::span< const std::byte > _data,
+           std::span< std::byte > _buffer,
+           const dictionary& _dictionary ) -> std::optional< size_t > {
+    return ( compressWithDictionary( threadContext(), _data, _buffer,
+                                     _dictionary._dictionary ) );
+}
+
+auto data( std::span< const std::byte > _data,
+           std::vector< std::byte >& _output,
+           const dictionary& _dictionary ) -> std::optional< size_t > {
+    return ( appendInto( _output, dataBound( _data.size() ),
+                         [ & ]( std::span< std::byte > _buffer )
+                             -> std::optional< size_t > {
+                             return ( data( _data, _buffer, _dictionary ) );
+                         } ) );
+}
+
+auto data( std::span< const std::byte > _data, const dictionary& _dictionary )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    std::vector< std::byte > l_compressed;
+
+    if ( data( _data, l_compressed, _dictionary ) ) [[likely]] {
+        l_returnValue = std::move( l_compressed );
+    }
+
+    return ( l_returnValue );
+}
+
+auto batch( std::span< const std::span< const std::byte > > _buffers,
+            size_t _level,
+            size_t _workers ) -> std::optional< arena > {
+    return ( compressBatch(
+        _buffers, _workers,
+        [ & ]( std::span< const std::byte > _buffer,
+               std::span< std::byte > _slot ) -> std::optional< size_t > {
+            return ( data( _buffer, _slot, _level ) );
+        } ) );
+}
+
+auto batch( std::span< const std::span< const std::byte > > _buffers,
+            const dictionary& _dictionary,
+            size_t _workers ) -> std::optional< arena > {
+    return ( compressBatch(
+        _buffers, _workers,
+        [ & ]( std::span< const std::byte > _buffer,
+               std::span< std::byte > _slot ) -> std::optional< size_t > {
+            return ( data( _buffer, _slot, _dictionary ) );
+        } ) );
+}
+
+dataStream::dataStream( size_t _level )
+    : _context( _level ? ZSTD_createCCtx() : nullptr ),
+      _buffer( ZSTD_CStreamOutSize() ) {
+    if ( _context ) [[likely]] {
+        ZSTD_CCtx_setParameter( _context, ZSTD_c_compressionLevel,
+                                static_cast< int >( _level ) );
+    }
+}
+
+dataStream::dataStream( dataStream&& _other ) noexcept
+    : _context( std::exchange( _other._context, nullptr ) ),
+      _buffer( std::move( _other._buffer ) ) {}
+
+dataStream::~dataStream() {
+    ZSTD_freeCCtx( _context );
+}
+
+auto dataStream::operator=( dataStream&& _other ) noexcept -> dataStream& {
+    if ( this != &_other ) {
+        ZSTD_freeCCtx( _context );
+
+        _context = std::exchange( _other._context, nullptr );
+        _buffer = std::move( _other._buffer );
+    }
+
+    return ( *this );
+}
+
+auto dataStream::update( std::span< const std::byte >& _input,
+                         std::span< std::byte >& _output ) -> bool {
+    bool l_returnValue = false;
+
+    do {
+        if ( !_context ) [[unlikely]] {
+            break;
+        }
+
+        ZSTD_inBuffer l_input{ _input.data(), _input.size(), 0 };
+        ZSTD_outBuffer l_output{ _output.data(), _output.size(), 0 };
+
+        size_t l_result = 0;
+
+        while ( ( l_input.pos < l_input.size ) &&
+                ( l_output.pos < l_output.size ) ) {
+            l_result = ZSTD_compressStream2( _context, &l_output, &l_input,
+                                             ZSTD_e_continue );
+
+            if ( ZSTD_isError( l_result ) ) [[unlikely]] {
+                break;
+            }
+        }
+
+        _input = _input.subspan( l_input.pos );
+        _output = _output.subspan( l_output.pos );
+
+        if ( ZSTD_isError( l_result ) ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = true;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto dataStream::finish( std::span< std::byte >& _output )
+    -> std::optional< bool > {
+    std::optional< bool > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_context ) [[unlikely]] {
+            break;
+        }
+
+        ZSTD_inBuffer l_input{ nullptr, 0, 0 };
+        ZSTD_outBuffer l_output{ _output.data(), _output.size(), 0 };
+
+        const size_t l_remaining =
+            ZSTD_compressStream2( _context, &l_output, &l_input, ZSTD_e_end );
+
+        _output = _output.subspan( l_output.pos );
+
+        if ( ZSTD_isError( l_remaining ) ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = !l_remaining;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto pipe( dataStream& _stream, std::istream& _input, std::ostream& _output )
+    -> bool {
+    return ( pipeStreams( _stream, _input, _output ) );
+}
+
+#if defined( HAS_UNISTD )
+
+auto pipe( dataStream& _stream, int _input, int _output ) -> bool {
+    return ( pipeDescriptors( _stream, _input, _output ) );
+}
+
+#endif
+
+namespace {
+
+// _read and _write as for pipeWith, chunks are read whole unless the input
+// ends first
+template < typename Read, typename Write >
+auto pipelineWith( Read&& _read,
+                   Write&& _write,
+                   size_t _level,
+                   size_t _chunkSize,
+                   async::pool& _pool ) -> bool {
+    bool l_returnValue = false;
+
+    do {
+        if ( !_chunkSize ) [[unlikely]] {
+            break;
+        }
+
+        bool l_isReadFailed = false;
+
+        const bool l_isWritten = async::pipeline(
+            [ & ]() -> std::optional< std::vector< std::byte > > {
+                std::vector< std::byte > l_chunk( _chunkSize );
+                size_t l_size = 0;
+
+                while ( l_size < l_chunk.size() ) {
+                    const std::optional< size_t > l_readSize =
+                        _read( std::span( l_chunk ).subspan( l_size ) );
+
+                    if ( !l_readSize ) [[unlikely]] {
+                        l_isReadFailed = true;
+
+                        break;
+                    }
+
+                    if ( !*l_readSize ) {
+                        break;
+                    }
+
+                    l_size += *l_readSize;
+                }
+
+                if ( !l_size || l_isReadFailed ) {
+                    return ( std::nullopt );
+                }
+
+                l_chunk.resize( l_size );
+
+                return ( l_chunk );
+            },
+            [ & ]( std::vector< std::byte > _chunk )
+                -> std::optional< std::vector< std::byte > > {
+                return ( data( _chunk, _level ) );
+            },
+            [ & ]( std::vector< std::byte > _frame ) -> bool {
+                return ( _write( std::span< const std::byte >( _frame ) ) );
+            },
+            {}, _pool );
+
+        l_returnValue = ( l_isWritten && !l_isReadFailed );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+auto pipeline( std::istream& _input,
+               std::ostream& _output,
+               size_t _level,
+               size_t _chunkSize,
+               async::pool& _pool ) -> bool {
+    return ( pipelineWith(
+        [ & ]( std::span< std::byte > _buffer ) -> std::optional< size_t > {
+            return ( readStream( _input, _buffer ) );
+        },
+        [ & ]( std::span< const std::byte > _chunk ) -> bool {
+            return ( writeStream( _output, _chunk ) );
+        },
+        _level, _chunkSize, _pool ) );
+}
+
+#if defined( HAS_UNISTD )
+
+auto pipeline( int _input,
+               int _output,
+               size_t _level,
+               size_t _chunkSize,
+               async::pool& _pool ) -> bool {
+    return ( pipelineWith(
+        [ & ]( std::span< std::byte > _buffer ) -> std::optional< size_t > {
+            return ( readDescriptor( _input, _buffer ) );
+        },
+        [ & ]( std::span< const std::byte > _chunk ) -> bool {
+            return ( writeDescriptor( _output, _chunk ) );
+        },
+        _level, _chunkSize, _pool ) );
+}
+
+#endif
+
+auto seekable( std::span< const std::byte > _data,
+               size_t _chunkSize,
+               size_t _level,
+               size_t _workers ) -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        if ( !isSeekableChunkSize( _chunkSize ) ) [[unlikely]] {
+            break;
+        }
+
+        if ( !_level ) [[unlikely]] {
+            break;
+        }
+
+        const size_t l_chunkCount =
+            ( ( _data.size() + _chunkSize - 1 ) / _chunkSize );
+
+        if ( l_chunkCount > std::numeric_limits< uint32_t >::max() )
+            [[unlikely]] {
+            break;
+        }
+
+        auto l_chunk = [ & ]( size_t _index ) -> std::span< const std::byte > {
+            const size_t l_offset = ( _index * _chunkSize );
+
+            return ( _data.subspan(
+                l_offset,
+                std::min( _chunkSize, ( _data.size() - l_offset ) ) ) );
+        };
+
+        const size_t l_frameBound = dataBound( _chunkSize );
+
+        std::vector< std::byte > l_compressed( l_chunkCount * l_frameBound );
+        std::vector< std::optional< size_t > > l_frameSizes( l_chunkCount );
+
+        // Every chunk compresses into its own slot, then the frames are
+        // packed in order
+        thread::parallelFor(
+            l_chunkCount,
+            [ & ]( size_t _index ) -> void {
+                l_frameSizes[ _index ] =
+                    data( l_chunk( _index ),
+                          std::span( l_compressed )
+                              .subspan( ( _index * l_frameBound ),
+                                        l_frameBound ),
+                          _level );
+            },
+            _workers );
+
+        if ( !std::ranges::all_of(
+                 l_frameSizes, []( const std::optional< size_t >& _size ) {
+                     return ( _size.has_value() );
+                 } ) ) [[unlikely]] {
+            break;
+        }
+
+        std::vector< std::byte > l_entries;
+
+        l_entries.reserve( l_chunkCount * g_seekTableEntrySize );
+
+        size_t l_size = 0;
+
+        for ( size_t l_index = 0; l_index < l_chunkCount; l_index++ ) {
+            std::memmove( ( l_compressed.data() + l_size ),
+                          ( l_compressed.data() + ( l_index * l_frameBound ) ),
+                          *l_frameSizes[ l_index ] );
+
+            appendSeekEntry( l_entries, *l_frameSizes[ l_index ],
+                             l_chunk( l_index ) );
+
+            l_size += *l_frameSizes[ l_index ];
+        }
+
+        l_compressed.resize( l_size );
+
+        appendSeekTable( l_compressed, l_entries );
+
+        l_returnValue = std::move( l_compressed );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+seekableStream::seekableStream( size_t _chunkSize, size_t _level )
+    : _chunkSize( isSeekableChunkSize( _chunkSize ) ? _chunkSize : 0 ),
+      _level( _level ),
+      _buffer( ZSTD_CStreamOutSize() ) {
+    _chunk.reserve( _chunkSize );
+}
+
+auto seekableStream::_compressChunk() -> bool {
+    bool l_returnValue = false;
+
+    do {
+        if ( ( _entries.size() / g_seekTableEntrySize ) ==
+             std::numeric_limits< uint32_t >::max() ) [[unlikely]] {
+            break;
+        }
+
+        const std::optional< size_t > l_frameSize =
+            data( _chunk, _pending, _level );
+
+        if ( !l_frameSize ) [[unlikely]] {
+            break;
+        }
+
+        appendSeekEntry( _entries, *l_frameSize, _chunk );
+
+        _chunk.clear();
+
+        l_returnValue = true;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto seekableStream::update( std::span< const std::byte >& _input,
+                             std::span< std::byte >& _output ) -> bool {
+    bool l_returnValue = false;
+
+    do {
+        if ( !_chunkSize || !_level ) [[unlikely]] {
+            break;
+        }
+
+        bool l_isFailed = false;
+
+        while ( !l_isFailed && drain( _pending, _pendingOffset, _output ) &&
+                !_input.empty() ) {
+            const size_t l_size =
+                std::min( ( _chunkSize - _chunk.size() ), _input.size() );
+
+            _chunk.insert( _chunk.end(), _input.begin(),
+                           ( _input.begin() +
+                             static_cast< ptrdiff_t >( l_size ) ) );
+
+            _input = _input.subspan( l_size );
+
+            if ( _chunk.size() == _chunkSize ) {
+                l_isFailed = !_compressChunk();
+            }
+        }
+
+        if ( l_isFailed ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = true;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto seekableStream::finish( std::span< std::byte >& _output )
+    -> std::optional< bool > {
+    std::optional< bool > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_chunkSize || !_level ) [[unlikely]] {
+            break;
+        }
+
+        if ( !_isFinishing ) {
+            if ( !_chunk.empty() && !_compressChunk() ) [[unlikely]] {
+                break;
+            }
+
+            appendSeekTable( _pending, _entries );
+
+            _entries.clear();
+            _isFinishing = true;
+        }
+
+        l_returnValue = drain( _pending, _pendingOffset, _output );
+
+        if ( *l_returnValue ) {
+            _isFinishing = false;
+        }
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto pipe( seekableStream& _stream,
+           std::istream& _input,
+           std::ostream& _output ) -> bool {
+    return ( pipeStreams( _stream, _input, _output ) );
+}
+
+#if defined( HAS_UNISTD )
+
+auto pipe( seekableStream& _stream, int _input, int _output ) -> bool {
+    return ( pipeDescriptors( _stream, _input, _output ) );
+}
+
+#endif
+
+#endif
+
+namespace {
+
+// Below this the header and frame overhead eat any savings
+constexpr size_t g_adaptiveMinimumSize = 64;
+constexpr size_t g_sampleBlockSize = ( 16 * 1024 );
+constexpr size_t g_sampleBlockCount = 4;
+// Order-0 entropy above which data is most likely random or compressed
+constexpr double g_incompressibleEntropy = 7.9;
+constexpr uint8_t g_adaptiveMagic = 0xA0;
+
+// "SFC1", followed by the 64 bit decompressed size
+constexpr uint32_t g_checkedMagic = 0x31434653;
+// Codec, stored size, decompressed size and CRC-32C of the plaintext
+constexpr size_t g_checkedBlockHeaderSize = ( 1 + ( 3 * sizeof( uint32_t ) ) );
+
+#if defined( HAS_SNAPPY )
+
+constexpr codec g_fastCodec = codec::snappy;
+
+#else
+
+constexpr codec g_fastCodec = codec::lz;
+
+#endif
+
+using entropy::histogram_t;
+
+auto entropyOf( const histogram_t& _counts, size_t _total ) -> double {
+    double l_returnValue = 0;
+
+    for ( const size_t _count : _counts ) {
+        if ( _count ) {
+            const double l_probability =
+                ( static_cast< double >( _count ) /
+                  static_cast< double >( _total ) );
+
+            l_returnValue -= ( l_probability * std::log2( l_probability ) );
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+// Evenly spaced blocks, the whole input when it is small
+auto sampleBlocks( std::span< const std::byte > _data )
+    -> std::vector< std::span< const std::byte > > {
+    std::vector< std::span< const std::byte > > l_returnValue;
+
+    if ( _data.size() <= ( g_sampleBlockSize * g_sampleBlockCount ) ) {
+        l_returnValue.emplace_back( _data );
+
+    } else {
+        const size_t l_step = ( ( _data.size() - g_sampleBlockSize ) /
+                                ( g_sampleBlockCount - 1 ) );
+
+        for ( size_t l_block = 0; l_block < g_sampleBlockCount; l_block++ ) {
+            l_returnValue.emplace_back(
+                _data.subspan( ( l_block * l_step ), g_sampleBlockSize ) );
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+// Total compressed size of _samples at the fastest setting of _codec, the
+// maximum when the codec is not available or fails
+auto trialSize( std::span< const std::span< const std::byte > > _samples,
+                codec _codec ) -> size_t {
+    size_t l_returnValue = 0;
+
+    std::vector< std::byte > l_scratch;
+
+    for ( const auto _sample : _samples ) {
+        std::optional< size_t > l_size = std::nullopt;
+
+        l_scratch.clear();
+
+        if ( _codec == codec::zstd ) {
+#if defined( HAS_ZSTD )
+            l_size = data( _sample, l_scratch, 1 );
+#endif
+
+        } else if ( _codec == codec::lz ) {
+            l_size = lz( _sample, l_scratch, 1 );
+
+        } else {
+#if defined( HAS_SNAPPY )
+            l_scratch.resize( textBound( _sample.size() ) );
+
+            l_size = text(
+                std::string_view(
+                    reinterpret_cast< const char* >( _sample.data() ),
+                    _sample.size() ),
+                std::span( reinterpret_cast< char* >( l_scratch.data() ),
+                           l_scratch.size() ),
+                1 );
+#endif
+        }
+
+        if ( !l_size ) [[unlikely]] {
+            l_returnValue = std::numeric_limits< size_t >::max();
+
+            break;
+        }
+
+        l_returnValue += *l_size;
+    }
+
+    return ( l_returnValue );
+}
+
+// Appends _data in the format of _selection to _output, false when the codec
+// fails or is not available
+auto appendCompressed( std::span< const std::byte > _data,
+                       selection _selection,
+                       std::vector< std::byte >& _output ) -> bool {
+    bool l_returnValue = false;
+
+    switch ( _selection.method ) {
+        case codec::stored: {
+            _output.insert( _output.end(), _data.begin(), _data.end() );
+
+            l_returnValue = true;
+
+            break;
+        }
+
+        case codec::lz: {
+            l_returnValue =
+                lz( _data, _output, _selection.level ).has_value();
+
+            break;
+        }
+
+        case codec::snappy: {
+#if defined( HAS_SNAPPY )
+            const size_t l_offset = _output.size();
+
+            _output.resize( l_offset + textBound( _data.size() ) );
+
+            const std::optional< size_t > l_size = text(
+                std::string_view(
+                    reinterpret_cast< const char* >( _data.data() ),
+                    _data.size() ),
+                std::span( reinterpret_cast< char* >( _output.data() +
+                                                      l_offset ),
+                           ( _output.size() - l_offset ) ),
+                _selection.level );
+
+            _output.resize( l_offset + l_size.value_or( 0 ) );
+
+            l_returnValue = l_size.has_value();
+#endif
+
+            break;
+        }
+
+        case codec::zstd: {
+#if defined( HAS_ZSTD )
+            l_returnValue =
+                data( _data, _output, _selection.level ).has_value();
+#endif
+
+            break;
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+auto entropy( std::span< const std::byte > _data ) -> double {
+    double l_returnValue = 0;
+
+    if ( !_data.empty() ) {
+        histogram_t l_counts{};
+
+        entropy::count( _data, l_counts );
+
+        l_returnValue = entropyOf( l_counts, _data.size() );
+    }
+
+    return ( l_returnValue );
+}
+
+auto probe( std::span< const std::byte > _data,
+            const adaptiveParameters& _parameters ) -> selection {
+    selection l_returnValue;
+
+    do {
+        if ( _data.size() < g_adaptiveMinimumSize ) {
+            break;
+        }
+
+        const auto l_samples = sampleBlocks( _data );
+
+        histogram_t l_counts{};
+        size_t l_sampleSize = 0;
+
+        for ( const auto _sample : l_samples ) {
+            entropy::count( _sample, l_counts );
+
+            l_sampleSize += _sample.size();
+        }
+
+        // A flat histogram alone does not rule out structure ( counters,
+        // tables ), so one block still gets a trial
+        const std::span< const std::span< const std::byte > > l_trialSamples =
+            ( ( entropyOf( l_counts, l_sampleSize ) > g_incompressibleEntropy )
+                  ? std::span( l_samples ).first( 1 )
+                  : std::span( l_samples ) );
+
+        l_sampleSize = 0;
+
+        for ( const auto _sample : l_trialSamples ) {
+            l_sampleSize += _sample.size();
+        }
+
+        const auto l_limit = static_cast< size_t >(
+            static_cast< double >( l_sampleSize ) *
+            ( 1.0 - _parameters.minimumSavings ) );
+
+        const size_t l_zstdSize = trialSize( l_trialSamples, codec::zstd );
+        const size_t l_fastSize = trialSize( l_trialSamples, g_fastCodec );
+
+        const bool l_isZstdWorth = ( l_zstdSize <= l_limit );
+        const bool l_isFastWorth = ( l_fastSize <= l_limit );
+
+        if ( !l_isZstdWorth && !l_isFastWorth ) {
+            break;
+        }
+
+        // The fast codec runs several times faster, worth it while its output
+        // stays close to zstd
+        const bool l_isFastClose =
+            ( l_isFastWorth &&
+              ( !l_isZstdWorth ||
+                ( ( l_fastSize * 10 ) <= ( l_zstdSize * 11 ) ) ) );
+
+        const selection l_fast{ g_fastCodec, 1 };
+        const selection l_fastZstd{ codec::zstd, 1 };
+        const selection l_zstd{ codec::zstd, 3 };
+
+        switch ( _parameters.target ) {
+            case preference::speed: {
+                l_returnValue = ( l_isFastWorth ? l_fast : l_fastZstd );
+
+                break;
+            }
+
+            case preference::balanced: {
+                l_returnValue = ( l_isFastClose ? l_fast : l_zstd );
+
+                break;
+            }
+
+            case preference::ratio: {
+                l_returnValue = ( l_isZstdWorth
+                                      ? selection{ codec::zstd, 9 }
+                                      : selection{ codec::lz, g_lzMaxLevel } );
+
+                break;
+            }
+        }
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto adaptive( std::span< const std::byte > _data,
+               const adaptiveParameters& _parameters )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        const selection l_selection = probe( _data, _parameters );
+
+        std::vector< std::byte > l_output;
+
+        auto l_start = [ & ]( codec _codec ) -> void {
+            l_output.assign(
+                1, std::byte{ static_cast< uint8_t >(
+                       g_adaptiveMagic | static_cast< uint8_t >( _codec ) ) } );
+        };
+
+        l_start( l_selection.method );
+
+        if ( !appendCompressed( _data, l_selection, l_output ) ) [[unlikely]] {
+            break;
+        }
+
+        // The sample can misjudge the whole input
+        if ( ( l_selection.method != codec::stored ) &&
+             ( ( l_output.size() - 1 ) >= _data.size() ) ) {
+            l_start( codec::stored );
+
+            l_output.insert( l_output.end(), _data.begin(), _data.end() );
+        }
+
+        l_returnValue = std::move( l_output );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto checked( std::span< const std::byte > _data,
+              const checkedParameters& _parameters )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        const size_t l_blockSize = _parameters.blockSize;
+
+        if ( !l_blockSize ||
+             ( l_blockSize > std::numeric_limits< uint32_t >::max() ) )
+            [[unlikely]] {
+            break;
+        }
+
+        const size_t l_blockCount =
+            ( ( _data.size() + l_blockSize - 1 ) / l_blockSize );
+
+        std::vector< std::vector< std::byte > > l_blocks( l_blockCount );
+        std::atomic< bool > l_isFailed = false;
+
+        thread::parallelFor(
+            l_blockCount,
+            [ & ]( size_t _index ) -> void {
+                const std::span< const std::byte > l_block = _data.subspan(
+                    ( _index * l_blockSize ),
+                    std::min( l_blockSize,
+                              ( _data.size() - ( _index * l_blockSize ) ) ) );
+
+                std::vector< std::byte >& l_output = l_blocks[ _index ];
+                selection l_selection{ _parameters.method, _parameters.level };
+
+                // Header is filled in once the codec is final
+                l_output.resize( g_checkedBlockHeaderSize );
+
+                if ( !appendCompressed( l_block, l_selection, l_output ) )
+                    [[unlikely]] {
+                    l_isFailed.store( true, std::memory_order_relaxed );
+
+                    return;
+                }
+
+                if ( ( l_output.size() - g_checkedBlockHeaderSize ) >=
+                     l_block.size() ) {
+                    l_selection = { codec::stored, 0 };
+
+                    l_output.resize( g_checkedBlockHeaderSize );
+                    l_output.insert( l_output.end(), l_block.begin(),
+                                     l_block.end() );
+                }
+
+                std::vector< std::byte > l_header;
+
+                l_header.reserve( g_checkedBlockHeaderSize );
+                l_header.emplace_back( std::byte{
+                    static_cast< uint8_t >( l_selection.method ) } );
+
+                appendLittleEndian( l_header,
+                                    static_cast< uint32_t >(
+                                        l_output.size() -
+                                        g_checkedBlockHeaderSize ) );
+                appendLittleEndian( l_header,
+                                    static_cast< uint32_t >( l_block.size() ) );
+                appendLittleEndian( l_header, hash::crc32c( l_block ) );
+
+                std::ranges::copy( l_header, l_output.begin() );
+            },
+            _parameters.workers );
+
+        if ( l_isFailed ) [[unlikely]] {
+            break;
+        }
+
+        std::vector< std::byte > l_output;
+
+        appendLittleEndian( l_output, g_checkedMagic );
+        appendLittleEndian( l_output, static_cast< uint32_t >( _data.size() ) );
+        appendLittleEndian( l_output,
+                            static_cast< uint32_t >(
+                                static_cast< uint64_t >( _data.size() ) >>
+                                32 ) );
+
+        for ( const std::vector< std::byte >& _block : l_blocks ) {
+            l_output.insert( l_output.end(), _block.begin(), _block.end() );
+        }
+
+        l_returnValue = std::move( l_output );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+namespace {
+
+constexpr uint8_t g_arrayMagic = 0xB0;
+// Elements of every vector shuffle step, one 16 byte vector per byte plane
+constexpr size_t g_shuffleBlock = 16;
+// Gorilla leading zero count and meaningful bit count fields
+constexpr size_t g_gorillaFieldBits = 6;
+
+// Calls _function.template operator()< Word >() with the unsigned integer of
+// _elementSize bytes, false when there is none
+template < typename Function >
+auto withWord( size_t _elementSize, Function&& _function ) -> bool {
+    switch ( _elementSize ) {
+        case 1: {
+            _function.template operator()< uint8_t >();
+
+            return ( true );
+        }
+
+        case 2: {
+            _function.template operator()< uint16_t >();
+
+            return ( true );
+        }
+
+        case 4: {
+            _function.template operator()< uint32_t >();
+
+            return ( true );
+        }
+
+        case 8: {
+            _function.template operator()< uint64_t >();
+
+            return ( true );
+        }
+
+#if defined( __x86_64__ )
+
+        case 16: {
+            _function.template operator()< uint128_t >();
+
+            return ( true );
+        }
+
+#endif
+
+        default: {
+            return ( false );
+        }
+    }
+}
+
+#if defined( __SSE2__ )
+
+// Transposes 16 elements into Size vectors of one byte plane each by
+// splitting even and odd bytes log2( Size ) times
+template < size_t Size >
+auto shuffleVectors( const std::byte* _input, std::byte* _output,
+                     size_t _count ) -> size_t {
+    const size_t l_blockCount = ( _count / g_shuffleBlock );
+    const __m128i l_lowBytes = _mm_set1_epi16( 0x00FF );
+
+    for ( size_t l_block = 0; l_block < l_blockCount; l_block++ ) {
+        __m128i l_vectors[ Size ];
+
+        for ( size_t l_index = 0; l_index < Size; l_index++ ) {
+            l_vectors[ l_index ] =
+                _mm_loadu_si128( reinterpret_cast< const __m128i* >(
+                    _input + ( ( ( l_block * Size ) + l_index ) *
+                               g_shuffleBlock ) ) );
+        }
+
+        for ( size_t l_width = 1; l_width < Size; l_width *= 2 ) {
+            __m128i l_split[ Size ];
+
+            for ( size_t l_pair = 0; l_pair < ( Size / 2 ); l_pair++ ) {
+                const __m128i l_first = l_vectors[ l_pair * 2 ];
+                const __m128i l_second = l_vectors[ ( l_pair * 2 ) + 1 ];
+
+                l_split[ l_pair ] =
+                    _mm_packus_epi16( _mm_and_si128( l_first, l_lowBytes ),
+                                      _mm_and_si128( l_second, l_lowBytes ) );
+                l_split[ l_pair + ( Size / 2 ) ] =
+                    _mm_packus_epi16( _mm_srli_epi16( l_first, 8 ),
+                                      _mm_srli_epi16( l_second, 8 ) );
+            }
+
+            std::ranges::copy( l_split, l_vectors );
+        }
+
+        for ( size_t l_plane = 0; l_plane < Size; l_plane++ ) {
+            _mm_storeu_si128(
+                reinterpret_cast< __m128i* >( _output + ( l_plane * _count ) +
+                                              ( l_block * g_shuffleBlock ) ),
+                l_vectors[ l_plane ] );
+        }
+    }
+
+    return ( l_blockCount * g_shuffleBlock );
+}
+
+#endif
+
+// Writes byte b of element i to _output[ b * count + i ]
+void shuffle( std::span< const std::byte > _data,
+              size_t _elementSize,
+              std::byte* _output ) {
+    const size_t l_count = ( _data.size() / _elementSize );
+    size_t l_element = 0;
+
+#if defined( __SSE2__ )
+
+    switch ( _elementSize ) {
+        case 2: {
+            l_element = shuffleVectors< 2 >( _data.data(), _output, l_count );
+
+            break;
+        }
+
+        case 4: {
+            l_element = shuffleVectors< 4 >( _data.data(), _output, l_count );
+
+            break;
+        }
+
+        case 8: {
+            l_element = shuffleVectors< 8 >( _data.data(), _output, l_count );
+
+            break;
+        }
+
+        case 16: {
+            l_element = shuffleVectors< 16 >( _data.data(), _output, l_count );
+
+            break;
+        }
+
+        default: {
+            break;
+        }
+    }
+
+#endif
+
+    for ( ; l_element < l_count; l_element++ ) {
+        for ( size_t l_byte = 0; l_byte < _elementSize; l_byte++ ) {
+            _output[ ( l_byte * l_count ) + l_element ] =
+                _data[ ( l_element * _elementSize ) + l_byte ];
+        }
+    }
+}
+
+// Splits the first multiple of 8 bytes of _plane into 8 bit planes, bit i
+// of byte g of bit plane j being bit j of byte 8g + i. The rest is copied
+void bitShuffle( std::span< const std::byte > _plane, std::byte* _output ) {
+    const size_t l_groupCount = ( _plane.size() / 8 );
+    size_t l_group = 0;
+
+#if defined( __SSE2__ )
+
+    for ( ; ( l_group + 2 ) <= l_groupCount; l_group += 2 ) {
+        __m128i l_bytes = _mm_loadu_si128(
+            reinterpret_cast< const __m128i* >( _plane.data() +
+                                                ( l_group * 8 ) ) );
+
+        // Top bits first, shifting the next one up each round
+        for ( size_t l_bit = 8; l_bit-- > 0; ) {
+            const auto l_mask =
+                static_cast< uint16_t >( _mm_movemask_epi8( l_bytes ) );
+
+            std::memcpy( ( _output + ( l_bit * l_groupCount ) + l_group ),
+                         &l_mask, sizeof( l_mask ) );
+
+            l_bytes = _mm_add_epi8( l_bytes, l_bytes );
+        }
+    }
+
+#endif
+
+    for ( ; l_group < l_groupCount; l_group++ ) {
+        for ( size_t l_bit = 0; l_bit < 8; l_bit++ ) {
+            uint8_t l_byte = 0;
+
+            for ( size_t l_index = 0; l_index < 8; l_index++ ) {
+                l_byte |= static_cast< uint8_t >(
+                    ( ( static_cast< uint8_t >(
+                            _plane[ ( l_group * 8 ) + l_index ] ) >>
+                        l_bit ) &
+                      1 )
+                    << l_index );
+            }
+
+            _output[ ( l_bit * l_groupCount ) + l_group ] = std::byte{ l_byte };
+        }
+    }
+
+    std::copy( ( _plane.begin() + static_cast< ptrdiff_t >(
+                                      l_groupCount * 8 ) ),
+               _plane.end(), ( _output + ( l_groupCount * 8 ) ) );
+}
+
+// Replaces every element but the first with its difference to, or with
+// _isXor its XOR with, the previous one
+void deltaEncode( std::span< const std::byte > _data,
+                  size_t _elementSize,
+                  bool _isXor,
+                  std::byte* _output ) {
+    withWord( _elementSize, [ & ]< typename Word >() -> void {
+        Word l_previous = 0;
+
+        for ( size_t l_offset = 0; l_offset < _data.size();
+              l_offset += sizeof( Word ) ) {
+            const auto l_value = load< Word >( _data.data() + l_offset );
+            const auto l_encoded = static_cast< Word >(
+                _isXor ? ( l_value ^ l_previous ) : ( l_value - l_previous ) );
+
+            std::memcpy( ( _output + l_offset ), &l_encoded,
+                         sizeof( l_encoded ) );
+
+            l_previous = l_value;
+        }
+    } );
+}
+
+// Little endian bit stream, least significant bit first
+struct bitWriter {
+    std::vector< std::byte >& output;
+    uint64_t bits = 0;
+    size_t count = 0;
+
+    void write( uint64_t _value, size_t _count ) {
+        // Keeps at most 7 + 32 bits pending
+        if ( _count > 32 ) {
+            write( _value, 32 );
+            write( ( _value >> 32 ), ( _count - 32 ) );
+
+            return;
+        }
+
+        bits |= ( ( _value & ( ( uint64_t{ 1 } << _count ) - 1 ) ) << count );
+        count += _count;
+
+        for ( ; count >= 8; count -= 8 ) {
+            output.emplace_back( static_cast< std::byte >( bits ) );
+
+            bits >>= 8;
+        }
+    }
+
+    void flush() {
+        if ( count ) {
+            output.emplace_back( static_cast< std::byte >( bits ) );
+        }
+
+        bits = 0;
+        count = 0;
+    }
+};
+
+// First value whole, then per value: 0 when unchanged, 10 and the meaningful
+// bits when they fit the previous window, or 11, the leading zero count, the
+// meaningful bit count minus one and the meaningful bits
+void gorillaEncode( std::span< const std::byte > _data,
+                    size_t _elementSize,
+                    std::vector< std::byte >& _output ) {
+    const size_t l_bits = ( _elementSize * 8 );
+
+    bitWriter l_writer{ _output };
+    uint64_t l_previous = 0;
+    size_t l_leading = ( l_bits + 1 );
+    size_t l_trailing = 0;
+
+    for ( size_t l_offset = 0; l_offset < _data.size();
+          l_offset += _elementSize ) {
+        const uint64_t l_value =
+            ( ( _elementSize == sizeof( uint64_t ) )
+                  ? load< uint64_t >( _data.data() + l_offset )
+                  : load< uint32_t >( _data.data() + l_offset ) );
+
+        if ( !l_offset ) {
+            l_writer.write( l_value, l_bits );
+        } else if ( const uint64_t l_xor = ( l_value ^ l_previous ); !l_xor ) {
+            l_writer.write( 0b0, 1 );
+        } else {
+            const auto l_valueLeading = static_cast< size_t >(
+                std::countl_zero( l_xor ) - ( 64 - l_bits ) );
+            const auto l_valueTrailing =
+                static_cast< size_t >( std::countr_zero( l_xor ) );
+
+            if ( ( l_valueLeading >= l_leading ) &&
+                 ( l_valueTrailing >= l_trailing ) ) {
+                l_writer.write( 0b01, 2 );
+                l_writer.write( ( l_xor >> l_trailing ),
+                                ( l_bits - l_leading - l_trailing ) );
+            } else {
+                l_leading = l_valueLeading;
+                l_trailing = l_valueTrailing;
+
+                const size_t l_meaningful = ( l_bits - l_leading - l_trailing );
+
+                l_writer.write( 0b11, 2 );
+                l_writer.write( l_leading, g_gorillaFieldBits );
+                l_writer.write( ( l_meaningful - 1 ), g_gorillaFieldBits );
+                l_writer.write( ( l_xor >> l_trailing ), l_meaningful );
+            }
+        }
+
+        l_previous = l_value;
+    }
+
+    l_writer.flush();
+}
+
+// Filtered _data, empty for filter::none, which compresses _data itself
+auto applyFilter( std::span< const std::byte > _data,
+                  size_t _elementSize,
+                  filter _transform ) -> std::vector< std::byte > {
+    std::vector< std::byte > l_returnValue;
+
+    switch ( _transform ) {
+        case filter::none: {
+            break;
+        }
+
+        case filter::shuffle: {
+            l_returnValue.resize( _data.size() );
+
+            shuffle( _data, _elementSize, l_returnValue.data() );
+
+            break;
+        }
+
+        case filter::bitShuffle: {
+            const size_t l_count = ( _data.size() / _elementSize );
+            std::vector< std::byte > l_planes( _data.size() );
+
+            shuffle( _data, _elementSize, l_planes.data() );
+
+            l_returnValue.resize( _data.size() );
+
+            for ( size_t l_offset = 0; l_offset < l_planes.size();
+                  l_offset += l_count ) {
+                bitShuffle( std::span( l_planes ).subspan( l_offset, l_count ),
+                            ( l_returnValue.data() + l_offset ) );
+            }
+
+            break;
+        }
+
+        case filter::delta:
+        case filter::xorDelta: {
+            std::vector< std::byte > l_deltas( _data.size() );
+
+            deltaEncode( _data, _elementSize,
+                         ( _transform == filter::xorDelta ), l_deltas.data() );
+
+            l_returnValue.resize( _data.size() );
+
+            shuffle( l_deltas, _elementSize, l_returnValue.data() );
+
+            break;
+        }
+
+        case filter::gorilla: {
+            gorillaEncode( _data, _elementSize, l_returnValue );
+
+            break;
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+auto array( std::span< const std::byte > _data,
+            size_t _elementSize,
+            const arrayParameters& _parameters )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        // Sizes of a word type only
+        if ( !withWord( _elementSize, []< typename >() -> void {} ) ||
+             ( _data.size() % _elementSize ) ) [[unlikely]] {
+            break;
+        }
+
+        if ( static_cast< uint8_t >( _parameters.transform ) >
+             static_cast< uint8_t >( filter::gorilla ) ) [[unlikely]] {
+            break;
+        }
+
+        if ( ( _parameters.transform == filter::gorilla ) &&
+             ( _elementSize != sizeof( uint32_t ) ) &&
+             ( _elementSize != sizeof( uint64_t ) ) ) [[unlikely]] {
+            break;
+        }
+
+        const std::vector< std::byte > l_filtered =
+            applyFilter( _data, _elementSize, _parameters.transform );
+        const std::span< const std::byte > l_input =
+            ( ( _parameters.transform == filter::none )
+                  ? _data
+                  : std::span< const std::byte >( l_filtered ) );
+
+        std::vector< std::byte > l_output{
+            std::byte{ static_cast< uint8_t >(
+                g_arrayMagic |
+                static_cast< uint8_t >( _parameters.transform ) ) },
+            std::byte{ static_cast< uint8_t >( _elementSize ) } };
+        selection l_selection{ _parameters.method, _parameters.level };
+
+        // Codec, element count and filtered size
+        constexpr size_t l_headerSize = ( 3 + ( 4 * sizeof( uint32_t ) ) );
+
+        l_output.resize( l_headerSize );
+
+        if ( !l_input.empty() &&
+             !appendCompressed( l_input, l_selection, l_output ) )
+            [[unlikely]] {
+            break;
+        }
+
+        if ( ( l_output.size() - l_headerSize ) >= l_input.size() ) {
+            l_selection = { codec::stored, 0 };
+
+            l_output.resize( l_headerSize );
+            l_output.insert( l_output.end(), l_input.begin(), l_input.end() );
+        }
+
+        std::vector< std::byte > l_sizes;
+
+        for ( const uint64_t _size :
+              { static_cast< uint64_t >( _data.size() / _elementSize ),
+                static_cast< uint64_t >( l_input.size() ) } ) {
+            appendLittleEndian( l_sizes, static_cast< uint32_t >( _size ) );
+            appendLittleEndian( l_sizes,
+                                static_cast< uint32_t >( _size >> 32 ) );
+        }
+
+        l_output[ 2 ] =
+            std::byte{ static_cast< uint8_t >( l_selection.method ) };
+
+        std::ranges::copy( l_sizes, ( l_output.begin() + 3 ) );
+
+        l_returnValue = std::move( l_output );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+namespace {
+
+// 32 bit lanes per 128 bit vector, and the integers each lane packs
+constexpr size_t g_packedLanes = 4;
+constexpr size_t g_packedLaneSize = ( g_packedBlockSize / g_packedLanes );
+
+using packBlockFunction = void ( * )( const uint32_t*, uint32_t, std::byte* );
+
+// Packs value 4k + lane at bit k * Bits of the lane, lane words interleaved
+// as consecutive 128 bit vectors
+template < size_t Bits >
+void packBlock( const uint32_t* _values, uint32_t _base, std::byte* _output ) {
+    if constexpr ( Bits ) {
+#if defined( __SSE2__ )
+
+        const __m128i l_base = _mm_set1_epi32( static_cast< int >( _base ) );
+        __m128i l_word = _mm_setzero_si128();
+
+        auto l_step = [ & ]( auto _index ) -> void {
+            constexpr size_t l_offset = ( decltype( _index )::value * Bits );
+            constexpr size_t l_shift = ( l_offset % 32 );
+
+            const __m128i l_value = _mm_sub_epi32(
+                _mm_loadu_si128( reinterpret_cast< const __m128i* >(
+                    _values + ( decltype( _index )::value * g_packedLanes ) ) ),
+                l_base );
+
+            l_word = _mm_or_si128( l_word, _mm_slli_epi32( l_value, l_shift ) );
+
+            if constexpr ( ( l_shift + Bits ) >= 32 ) {
+                _mm_storeu_si128( reinterpret_cast< __m128i* >(
+                                      _output + ( ( l_offset / 32 ) * 16 ) ),
+                                  l_word );
+
+                // Bits that did not fit start the next word
+                if constexpr ( ( l_shift + Bits ) > 32 ) {
+                    l_word = _mm_srli_epi32( l_value, ( 32 - l_shift ) );
+                } else {
+                    l_word = _mm_setzero_si128();
+                }
+            }
+        };
+
+        [ & ]< size_t... Index >( std::index_sequence< Index... > ) -> void {
+            ( l_step( std::integral_constant< size_t, Index >{} ), ... );
+        }( std::make_index_sequence< g_packedLaneSize >{} );
+
+#else
+
+        for ( size_t l_lane = 0; l_lane < g_packedLanes; l_lane++ ) {
+            uint64_t l_bits = 0;
+            size_t l_count = 0;
+            size_t l_word = 0;
+
+            for ( size_t l_index = 0; l_index < g_packedLaneSize; l_index++ ) {
+                l_bits |= ( static_cast< uint64_t >(
+                                _values[ ( l_index * g_packedLanes ) +
+                                         l_lane ] -
+                                _base )
+                            << l_count );
+                l_count += Bits;
+
+                for ( ; l_count >= 32; l_count -= 32, l_bits >>= 32 ) {
+                    const auto l_value = static_cast< uint32_t >( l_bits );
+
+                    std::memcpy( ( _output + ( ( ( l_word++ * g_packedLanes ) +
+                                                 l_lane ) *
+                                               sizeof( uint32_t ) ) ),
+                                 &l_value, sizeof( l_value ) );
+                }
+            }
+        }
+
+#endif
+    }
+}
+
+constexpr auto g_packBlocks =
+    []< size_t... Bits >( std::index_sequence< Bits... > )
+    -> std::array< packBlockFunction, sizeof...( Bits ) > {
+    return ( std::array< packBlockFunction, sizeof...( Bits ) >{
+        &packBlock< Bits >... } );
+}( std::make_index_sequence< 33 >{} );
+
+// Bits needed for the largest difference to the minimum, and the minimum
+auto frameOfReference( std::span< const uint32_t > _values )
+    -> std::pair< size_t, uint32_t > {
+    const auto [ l_minimum, l_maximum ] = std::ranges::minmax( _values );
+
+    return ( std::pair(
+        static_cast< size_t >( std::bit_width( l_maximum - l_minimum ) ),
+        l_minimum ) );
+}
+
+} // namespace
+
+void delta( std::span< uint32_t > _values, uint32_t _previous ) {
+    size_t l_index = 0;
+
+#if defined( __SSE2__ )
+
+    __m128i l_previous = _mm_set1_epi32( static_cast< int >( _previous ) );
+
+    for ( ; ( l_index + 4 ) <= _values.size(); l_index += 4 ) {
+        auto* l_address = reinterpret_cast< __m128i* >( &_values[ l_index ] );
+        const __m128i l_values = _mm_loadu_si128( l_address );
+
+        // Each lane's predecessor, the first from the previous vector
+        const __m128i l_predecessors =
+            _mm_or_si128( _mm_slli_si128( l_values, 4 ),
+                          _mm_srli_si128( l_previous, 12 ) );
+
+        _mm_storeu_si128( l_address,
+                          _mm_sub_epi32( l_values, l_predecessors ) );
+
+        l_previous = l_values;
+    }
+
+    if ( l_index ) {
+        _previous = static_cast< uint32_t >(
+            _mm_cvtsi128_si32( _mm_srli_si128( l_previous, 12 ) ) );
+    }
+
+#endif
+
+    for ( ; l_index < _values.size(); l_index++ ) {
+        const uint32_t l_value = _values[ l_index ];
+
+        _values[ l_index ] = ( l_value - _previous );
+        _previous = l_value;
+    }
+}
+
+auto packed( std::span< const uint32_t > _values,
+             std::span< std::byte > _buffer ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        if ( _buffer.size() < packedBound( _values.size() ) ) [[unlikely]] {
+            break;
+        }
+
+        std::byte* l_output = _buffer.data();
+
+        const auto l_writeHeader = [ & ]( size_t _bits,
+                                          uint32_t _base ) -> void {
+            *( l_output++ ) = std::byte{ static_cast< uint8_t >( _bits ) };
+
+            for ( size_t l_byte = 0; l_byte < sizeof( _base ); l_byte++ ) {
+                *( l_output++ ) =
+                    static_cast< std::byte >( _base >> ( l_byte * 8 ) );
+            }
+        };
+
+        size_t l_offset = 0;
+
+        for ( ; ( l_offset + g_packedBlockSize ) <= _values.size();
+              l_offset += g_packedBlockSize ) {
+            const std::span< const uint32_t > l_block =
+                _values.subspan( l_offset, g_packedBlockSize );
+            const auto [ l_bits, l_base ] = frameOfReference( l_block );
+
+            l_writeHeader( l_bits, l_base );
+
+            g_packBlocks[ l_bits ]( l_block.data(), l_base, l_output );
+
+            l_output += bitsToBytes( g_packedBlockSize * l_bits );
+        }
+
+        // Partial block in order, least significant bit first
+        if ( l_offset < _values.size() ) {
+            const std::span< const uint32_t > l_tail =
+                _values.subspan( l_offset );
+            const auto [ l_bits, l_base ] = frameOfReference( l_tail );
+
+            l_writeHeader( l_bits, l_base );
+
+            uint64_t l_pending = 0;
+            size_t l_count = 0;
+
+            for ( const uint32_t _value : l_tail ) {
+                l_pending |= ( static_cast< uint64_t >( _value - l_base )
+                               << l_count );
+                l_count += l_bits;
+
+                for ( ; l_count >= 8; l_count -= 8, l_pending >>= 8 ) {
+                    *( l_output++ ) = static_cast< std::byte >( l_pending );
+                }
+            }
+
+            if ( l_count ) {
+                *( l_output++ ) = static_cast< std::byte >( l_pending );
+            }
+        }
+
+        l_returnValue = static_cast< size_t >( l_output - _buffer.data() );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto streamVByte( std::span< const uint32_t > _values,
+                  std::span< std::byte > _buffer ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        if ( _buffer.size() < streamVByteBound( _values.size() ) )
+            [[unlikely]] {
+            break;
+        }
+
+        const size_t l_controlSize = bitsToBytes( _values.size() * 2 );
+
+        std::byte* l_control = _buffer.data();
+        std::byte* l_output = ( l_control + l_controlSize );
+
+        std::fill_n( l_control, l_controlSize, std::byte{} );
+
+        for ( size_t l_index = 0; l_index < _values.size(); l_index++ ) {
+            const uint32_t l_value = _values[ l_index ];
+            const size_t l_length =
+                ( ( l_value > 0xFFFFFF ) ? 4
+                  : ( l_value > 0xFFFF ) ? 3
+                  : ( l_value > 0xFF )   ? 2
+                                         : 1 );
+
+            l_control[ l_index / 4 ] |= static_cast< std::byte >(
+                ( l_length - 1 ) << ( ( l_index % 4 ) * 2 ) );
+
+            for ( size_t l_byte = 0; l_byte < l_length; l_byte++ ) {
+                *( l_output++ ) =
+                    static_cast< std::byte >( l_value >> ( l_byte * 8 ) );
+            }
+        }
+
+        l_returnValue = static_cast< size_t >( l_output - _buffer.data() );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+namespace {
+
+// Sizes ahead of entropy coded output, LEB128 as for compress::lz
+void appendSize( std::vector< std::byte >& _output, size_t _size ) {
+    for ( ; _size >= 0x80; _size >>= 7 ) {
+        _output.emplace_back(
+            std::byte( static_cast< uint8_t >( ( _size & 0x7F ) | 0x80 ) ) );
+    }
+
+    _output.emplace_back( std::byte( static_cast< uint8_t >( _size ) ) );
+}
+
+// bitWriter into memory sized up front: whole bytes are stored a word at a
+// time, so the output needs 8 bytes of room past the last one
+struct bufferedBitWriter {
+    std::byte* output;
+    uint64_t bits = 0;
+    size_t count = 0;
+
+    // _value below 2^_count, at most 56 bits between drains
+    void write( uint64_t _value, size_t _count ) {
+        bits |= ( _value << count );
+        count += _count;
+    }
+
+    void drain() {
+        uint64_t l_word = bits;
+
+        if constexpr ( std::endian::native == std::endian::big ) {
+            l_word = std::byteswap( l_word );
+        }
+
+        std::memcpy( output, &l_word, sizeof( l_word ) );
+
+        output += ( count / 8 );
+        bits >>= ( count & ~size_t{ 7 } );
+        count %= 8;
+    }
+
+    // Drains and pads to a whole byte, returns the end of the output
+    auto finish() -> std::byte* {
+        drain();
+
+        if ( count ) {
+            *( output++ ) = static_cast< std::byte >( bits );
+        }
+
+        bits = 0;
+        count = 0;
+
+        return ( output );
+    }
+};
+
+// Serialized distribution of _data followed by what _encode( _data, table )
+// produces, nothing at all for empty input
+template < typename Encode >
+auto selfDescribed( std::span< const std::byte > _data,
+                    size_t _tableLog,
+                    Encode&& _encode )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        if ( _data.empty() ) {
+            l_returnValue.emplace();
+
+            break;
+        }
+
+        const std::optional< entropy::distribution > l_distribution =
+            entropy::normalize( entropy::histogram( _data ), _tableLog );
+
+        if ( !l_distribution ) [[unlikely]] {
+            break;
+        }
+
+        const std::optional< std::vector< std::byte > > l_encoded =
+            _encode( _data, entropyTable( *l_distribution ) );
+
+        if ( !l_encoded ) [[unlikely]] {
+            break;
+        }
+
+        std::vector< std::byte > l_output =
+            entropy::serialize( *l_distribution );
+
+        l_output.insert( l_output.end(), l_encoded->begin(),
+                         l_encoded->end() );
+
+        l_returnValue = std::move( l_output );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+entropyTable::entropyTable( const entropy::distribution& _distribution ) {
+    if ( !entropy::isValid( _distribution ) ) [[unlikely]] {
+        return;
+    }
+
+    const size_t l_tableLog = _distribution.tableLog;
+    const size_t l_states = ( size_t{ 1 } << l_tableLog );
+
+    _tableLog = l_tableLog;
+    _frequencies = _distribution.frequencies;
+
+    // Every symbol owns the range of _states its frequency spans, filled with
+    // its spread states in increasing order
+    std::array< size_t, 256 > l_starts{};
+    size_t l_total = 0;
+
+    for ( size_t l_symbol = 0; l_symbol < _frequencies.size(); l_symbol++ ) {
+        const size_t l_frequency = _frequencies[ l_symbol ];
+
+        l_starts[ l_symbol ] = l_total;
+
+        if ( l_frequency == 1 ) {
+            _deltaNbBits[ l_symbol ] =
+                static_cast< uint32_t >( ( l_tableLog << 16 ) - l_states );
+            _deltaFindState[ l_symbol ] =
+                static_cast< int32_t >( l_total ) - 1;
+
+        } else if ( l_frequency ) {
+            // States below frequency << maxBits flush one bit less
+            const size_t l_maxBits =
+                ( l_tableLog - ( std::bit_width( l_frequency - 1 ) - 1 ) );
+
+            _deltaNbBits[ l_symbol ] = static_cast< uint32_t >(
+                ( l_maxBits << 16 ) - ( l_frequency << l_maxBits ) );
+            _deltaFindState[ l_symbol ] = static_cast< int32_t >( l_total ) -
+                                          static_cast< int32_t >( l_frequency );
+        }
+
+        l_total += l_frequency;
+    }
+
+    const std::vector< uint8_t > l_spread = entropy::spread( _distribution );
+
+    _states.resize( l_states );
+
+    for ( size_t l_state = 0; l_state < l_states; l_state++ ) {
+        _states[ l_starts[ l_spread[ l_state ] ]++ ] =
+            static_cast< uint16_t >( l_states + l_state );
+    }
+
+    _lengths = entropy::codeLengths( _distribution );
+    _codes = entropy::canonicalCodes( _lengths );
+}
+
+auto entropyTable::tableLog() const -> size_t {
+    return ( _tableLog );
+}
+
+auto ans( std::span< const std::byte > _data, const entropyTable& _table )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_table._tableLog ) [[unlikely]] {
+            break;
+        }
+
+        std::vector< std::byte > l_output;
+
+        appendSize( l_output, _data.size() );
+
+        if ( _data.empty() ) {
+            l_returnValue = std::move( l_output );
+
+            break;
+        }
+
+        const size_t l_tableLog = _table._tableLog;
+        const auto l_states = static_cast< uint32_t >( 1 << l_tableLog );
+        const size_t l_offset = l_output.size();
+
+        // At most tableLog bits per symbol and per state, the end mark and
+        // room for the last word store
+        l_output.resize(
+            l_offset +
+            bitsToBytes( ( ( _data.size() + 2 ) * l_tableLog ) + 1 ) +
+            sizeof( uint64_t ) );
+
+        bufferedBitWriter l_writer{ .output = ( l_output.data() + l_offset ) };
+
+        // Encoder states live in [ states, 2 * states ), both start at the
+        // bottom so the decoder ends on 0
+        std::array< uint32_t, 2 > l_state{ l_states, l_states };
+
+        const uint16_t* const l_next = _table._states.data();
+        const auto& l_frequencies = _table._frequencies;
+        const auto& l_deltaNbBits = _table._deltaNbBits;
+        const auto& l_deltaFindState = _table._deltaFindState;
+
+        const auto l_encode = [ & ]( uint32_t& _state,
+                                     std::byte _byte ) -> bool {
+            const auto l_symbol = static_cast< uint8_t >( _byte );
+
+            if ( !l_frequencies[ l_symbol ] ) [[unlikely]] {
+                return ( false );
+            }
+
+            const uint32_t l_bits =
+                ( ( _state + l_deltaNbBits[ l_symbol ] ) >> 16 );
+
+            l_writer.write( ( _state & ( ( 1U << l_bits ) - 1 ) ), l_bits );
+
+            _state = l_next[ static_cast< size_t >(
+                static_cast< int32_t >( _state >> l_bits ) +
+                l_deltaFindState[ l_symbol ] ) ];
+
+            return ( true );
+        };
+
+        // Last to first, so the decoder reading the stream backwards yields
+        // the symbols in order, even ones on the first state
+        size_t l_index = _data.size();
+        bool l_isCodable = true;
+
+        if ( l_index & 1 ) {
+            l_isCodable = l_encode( l_state[ 0 ], _data[ --l_index ] );
+            l_writer.drain();
+        }
+
+        for ( ; l_isCodable && l_index; l_index -= 2 ) {
+            l_isCodable = ( l_encode( l_state[ 1 ], _data[ l_index - 1 ] ) &&
+                            l_encode( l_state[ 0 ], _data[ l_index - 2 ] ) );
+            l_writer.drain();
+        }
+
+        if ( !l_isCodable ) [[unlikely]] {
+            break;
+        }
+
+        l_writer.write( ( l_state[ 1 ] - l_states ), l_tableLog );
+        l_writer.drain();
+        l_writer.write( ( l_state[ 0 ] - l_states ), l_tableLog );
+
+        // Marks where the decoder starts reading backwards
+        l_writer.write( 1, 1 );
+
+        l_output.resize(
+            static_cast< size_t >( l_writer.finish() - l_output.data() ) );
+
+        l_returnValue = std::move( l_output );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto ans( std::span< const std::byte > _data, size_t _tableLog )
+    -> std::optional< std::vector< std::byte > > {
+    return ( selfDescribed(
+        _data, _tableLog,
+        []( std::span< const std::byte > _input, const entropyTable& _table )
+            -> std::optional< std::vector< std::byte > > {
+            return ( ans( _input, _table ) );
+        } ) );
+}
+
+auto huffman( std::span< const std::byte > _data, const entropyTable& _table )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_table._tableLog ) [[unlikely]] {
+            break;
+        }
+
+        std::vector< std::byte > l_output;
+
+        appendSize( l_output, _data.size() );
+
+        if ( _data.empty() ) {
+            l_returnValue = std::move( l_output );
+
+            break;
+        }
+
+        constexpr size_t l_streamCount = 4;
+        // Codes written between drains, 4 of at most 11 bits
+        constexpr size_t l_codesPerDrain = 4;
+
+        // Sizes of all streams but the last, filled in once they are written
+        const size_t l_sizesOffset = l_output.size();
+        const size_t l_streamsOffset =
+            ( l_sizesOffset + ( ( l_streamCount - 1 ) * sizeof( uint32_t ) ) );
+
+        l_output.resize(
+            l_streamsOffset +
+            bitsToBytes( _data.size() * entropy::g_maxCodeLength ) +
+            l_streamCount + sizeof( uint64_t ) );
+
+        const size_t l_quarter = ( ( _data.size() + 3 ) / l_streamCount );
+        std::byte* l_stream = ( l_output.data() + l_streamsOffset );
+        bool l_isEncoded = true;
+
+        const auto& l_codes = _table._codes;
+        const auto& l_lengths = _table._lengths;
+
+        for ( size_t l_index = 0; l_index < l_streamCount; l_index++ ) {
+            const size_t l_begin =
+                std::min( ( l_index * l_quarter ), _data.size() );
+            const std::span< const std::byte > l_symbols = _data.subspan(
+                l_begin, ( std::min( ( l_begin + l_quarter ), _data.size() ) -
+                           l_begin ) );
+
+            bufferedBitWriter l_writer{ .output = l_stream };
+
+            for ( size_t l_symbol = 0; l_symbol < l_symbols.size();
+                  l_symbol++ ) {
+                const auto l_value =
+                    static_cast< uint8_t >( l_symbols[ l_symbol ] );
+
+                if ( !l_lengths[ l_value ] ) [[unlikely]] {
+                    l_isEncoded = false;
+
+                    break;
+                }
+
+                l_writer.write( l_codes[ l_value ], l_lengths[ l_value ] );
+
+                if ( ( l_symbol % l_codesPerDrain ) ==
+                     ( l_codesPerDrain - 1 ) ) {
+                    l_writer.drain();
+                }
+            }
+
+            if ( !l_isEncoded ) [[unlikely]] {
+                break;
+            }
+
+            std::byte* const l_end = l_writer.finish();
+            const auto l_streamSize = static_cast< size_t >( l_end - l_stream );
+
+            if ( l_streamSize > std::numeric_limits< uint32_t >::max() )
+                [[unlikely]] {
+                l_isEncoded = false;
+
+                break;
+            }
+
+            if ( l_index < ( l_streamCount - 1 ) ) {
+                for ( size_t l_byte = 0; l_byte < sizeof( uint32_t );
+                      l_byte++ ) {
+                    l_output[ l_sizesOffset +
+                              ( l_index * sizeof( uint32_t ) ) + l_byte ] =
+                        static_cast< std::byte >( l_streamSize >>
+                                                  ( l_byte * 8 ) );
+                }
+            }
+
+            l_stream = l_end;
+        }
+
+        if ( !l_isEncoded ) [[unlikely]] {
+            break;
+        }
+
+        l_output.resize(
+            static_cast< size_t >( l_stream - l_output.data() ) );
+
+        l_returnValue = std::move( l_output );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto huffman( std::span< const std::byte > _data, size_t _tableLog )
+    -> std::optional< std::vector< std::byte > > {
+    return ( selfDescribed(
+        _data, _tableLog,
+        []( std::span< const std::byte > _input, const entropyTable& _table )
+            -> std::optional< std::vector< std::byte > > {
+            return ( huffman( _input, _table ) );
+        } ) );
+}
 
 } // namespace stdfunc::compress
@@ -16,66 +16,3562 @@
 
 #endif
 
+#if __has_include( <unistd.h> )
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define HAS_UNISTD
+
+#endif
+
+#if __has_include( <sys/mman.h> )
+
+#include <sys/mman.h>
+
+#define HAS_MMAN
+
+#endif
+
+#if defined( __SSE2__ ) || defined( __SSSE3__ )
+
+#include <immintrin.h>
+
+#endif
+
+#if defined( __x86_64__ )
+
+#include "std128.hpp"
+
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "stdfunc.hpp"
+#include "stdhash.hpp"
+#include "stdthread.hpp"
+
 namespace stdfunc::decompress {
 
-#if defined( HAS_SNAPPY )
+#if ( defined( HAS_SNAPPY ) || defined( HAS_ZSTD ) )
 
-auto text( std::string_view _data ) -> std::optional< std::string > {
-    std::optional< std::string > l_returnValue = std::nullopt;
+namespace {
+
+constexpr size_t g_pipeBufferSize = ( 128 * 1024 );
+
+// _read( buffer ) returns the bytes read, 0 at end of input or std::nullopt
+// on failure, _write( bytes ) returns false on failure
+template < typename Stream, typename Read, typename Write >
+auto pipeWith( Stream& _stream, Read&& _read, Write&& _write ) -> bool {
+    bool l_returnValue = false;
+
+    std::vector< std::byte > l_buffer( g_pipeBufferSize );
 
     do {
-        if ( _data.empty() ) [[unlikely]] {
+        std::optional< size_t > l_readSize = std::nullopt;
+
+        while ( ( l_readSize = _read( std::span( l_buffer ) ) ) &&
+                *l_readSize ) {
+            if ( !_stream.write( std::span( l_buffer ).first( *l_readSize ),
+                                 _write ) ) [[unlikely]] {
+                break;
+            }
+        }
+
+        if ( !l_readSize || *l_readSize ) [[unlikely]] {
             break;
         }
 
-        std::string l_decompressed;
+        // Truncated input
+        l_returnValue = _stream.finished();
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+template < typename Stream >
+auto pipeStreams( Stream& _stream, std::istream& _input, std::ostream& _output )
+    -> bool {
+    return ( pipeWith(
+        _stream,
+        [ & ]( std::span< std::byte > _buffer ) -> std::optional< size_t > {
+            _input.read( reinterpret_cast< char* >( _buffer.data() ),
+                         static_cast< std::streamsize >( _buffer.size() ) );
+
+            if ( _input.bad() ) [[unlikely]] {
+                return ( std::nullopt );
+            }
+
+            return ( static_cast< size_t >( _input.gcount() ) );
+        },
+        [ & ]( std::span< const std::byte > _chunk ) -> bool {
+            _output.write( reinterpret_cast< const char* >( _chunk.data() ),
+                           static_cast< std::streamsize >( _chunk.size() ) );
+
+            return ( _output.good() );
+        } ) );
+}
+
+#if defined( HAS_UNISTD )
+
+template < typename Stream >
+auto pipeDescriptors( Stream& _stream, int _input, int _output ) -> bool {
+    return ( pipeWith(
+        _stream,
+        [ & ]( std::span< std::byte > _buffer ) -> std::optional< size_t > {
+            ssize_t l_readSize = 0;
+
+            do {
+                l_readSize = ::read( _input, _buffer.data(), _buffer.size() );
+            } while ( ( l_readSize < 0 ) && ( errno == EINTR ) );
+
+            if ( l_readSize < 0 ) [[unlikely]] {
+                return ( std::nullopt );
+            }
+
+            return ( static_cast< size_t >( l_readSize ) );
+        },
+        [ & ]( std::span< const std::byte > _chunk ) -> bool {
+            while ( !_chunk.empty() ) {
+                const ssize_t l_writtenSize =
+                    ::write( _output, _chunk.data(), _chunk.size() );
+
+                if ( l_writtenSize < 0 ) {
+                    if ( errno == EINTR ) {
+                        continue;
+                    }
+
+                    return ( false );
+                }
+
+                _chunk =
+                    _chunk.subspan( static_cast< size_t >( l_writtenSize ) );
+            }
+
+            return ( true );
+        } ) );
+}
+
+#endif
+
+} // namespace
+
+#endif
+
+namespace {
+
+constexpr size_t g_lzMinMatch = 4;
+// Every input byte expands to at most 255 output bytes
+constexpr size_t g_lzMaxRatio = 0xFF;
+// Short literal runs move as one copy of this size when both sides have room
+constexpr size_t g_lzLiteralCopySize = 16;
+
+auto loadLittleEndian( const std::byte* _source, size_t _size ) -> uint32_t {
+    uint32_t l_returnValue = 0;
+
+    for ( size_t l_index = 0; l_index < _size; l_index++ ) {
+        l_returnValue |= ( static_cast< uint32_t >( _source[ l_index ] )
+                           << ( l_index * 8 ) );
+    }
+
+    return ( l_returnValue );
+}
+
+// Consumes the LEB128 size prefix of _data
+auto readSizePrefix( std::span< const std::byte >& _data )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    size_t l_size = 0;
+
+    for ( size_t l_shift = 0; !_data.empty() && ( l_shift < 64 );
+          l_shift += 7 ) {
+        const auto l_byte = static_cast< uint8_t >( _data.front() );
+
+        _data = _data.subspan( 1 );
+
+        // Bits past 64
+        if ( ( l_shift == 63 ) && ( l_byte > 1 ) ) [[unlikely]] {
+            break;
+        }
+
+        l_size |= ( static_cast< size_t >( l_byte & 0x7F ) << l_shift );
+
+        if ( !( l_byte & 0x80 ) ) {
+            l_returnValue = l_size;
+
+            break;
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+// Adds the run of 255 bytes plus remainder following a full token nibble,
+// false when the input ends inside it
+auto readLength( const std::byte*& _input,
+                 const std::byte* _end,
+                 size_t& _length ) -> bool {
+    bool l_returnValue = false;
+
+    while ( _input < _end ) {
+        const auto l_byte = static_cast< uint8_t >( *( _input++ ) );
+
+        _length += l_byte;
+
+        if ( l_byte != 0xFF ) {
+            l_returnValue = true;
+
+            break;
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+// LZ4 block decoder, true when _block fills exactly all of _output
+auto decodeLz( std::span< const std::byte > _block,
+               std::span< std::byte > _output ) -> bool {
+    bool l_returnValue = false;
+
+    const std::byte* l_input = _block.data();
+    const std::byte* const l_inputEnd = ( l_input + _block.size() );
+    std::byte* l_output = _output.data();
+    std::byte* const l_outputEnd = ( l_output + _output.size() );
+
+    while ( l_input < l_inputEnd ) {
+        const auto l_token = static_cast< uint8_t >( *( l_input++ ) );
+
+        size_t l_literals = ( l_token >> 4 );
+
+        if ( ( l_literals == 15 ) &&
+             !readLength( l_input, l_inputEnd, l_literals ) ) [[unlikely]] {
+            break;
+        }
+
+        const auto l_inputLeft = static_cast< size_t >( l_inputEnd - l_input );
+        const auto l_outputLeft =
+            static_cast< size_t >( l_outputEnd - l_output );
+
+        if ( ( l_literals > l_inputLeft ) || ( l_literals > l_outputLeft ) )
+            [[unlikely]] {
+            break;
+        }
+
+        // Bytes past the run are overwritten by what follows
+        if ( ( l_literals <= g_lzLiteralCopySize ) &&
+             ( l_inputLeft >= g_lzLiteralCopySize ) &&
+             ( l_outputLeft >= g_lzLiteralCopySize ) ) [[likely]] {
+            std::memcpy( l_output, l_input, g_lzLiteralCopySize );
+
+        } else if ( l_literals ) {
+            std::memcpy( l_output, l_input, l_literals );
+        }
+
+        l_input += l_literals;
+        l_output += l_literals;
+
+        // The block ends with literals
+        if ( l_input == l_inputEnd ) {
+            l_returnValue = ( l_output == l_outputEnd );
+
+            break;
+        }
+
+        if ( ( l_inputEnd - l_input ) < 2 ) [[unlikely]] {
+            break;
+        }
+
+        const size_t l_offset =
+            ( static_cast< size_t >( l_input[ 0 ] ) |
+              ( static_cast< size_t >( l_input[ 1 ] ) << 8 ) );
+
+        l_input += 2;
+
+        if ( !l_offset ||
+             ( l_offset > static_cast< size_t >( l_output - _output.data() ) ) )
+            [[unlikely]] {
+            break;
+        }
+
+        size_t l_length = ( l_token & 0x0F );
+
+        if ( ( l_length == 15 ) &&
+             !readLength( l_input, l_inputEnd, l_length ) ) [[unlikely]] {
+            break;
+        }
+
+        l_length += g_lzMinMatch;
+
+        const auto l_room = static_cast< size_t >( l_outputEnd - l_output );
+
+        if ( l_length > l_room ) [[unlikely]] {
+            break;
+        }
+
+        const std::byte* const l_match = ( l_output - l_offset );
+
+        // Whole words, spilling up to 7 bytes past the match. A period
+        // shorter than a word is first written out bytewise up to a multiple
+        // of it that is, so words never overlap their source
+        if ( l_room >= ( l_length + sizeof( uint64_t ) ) ) [[likely]] {
+            const bool l_isShortPeriod = ( l_offset < sizeof( uint64_t ) );
+            const size_t l_distance =
+                ( l_isShortPeriod
+                      ? ( l_offset * ( ( sizeof( uint64_t ) + l_offset - 1 ) /
+                                       l_offset ) )
+                      : l_offset );
+            const size_t l_head =
+                ( l_isShortPeriod ? std::min( l_distance, l_length ) : 0 );
+
+            for ( size_t l_index = 0; l_index < l_head; l_index++ ) {
+                l_output[ l_index ] = l_match[ l_index ];
+            }
+
+            for ( size_t l_index = l_head; l_index < l_length;
+                  l_index += sizeof( uint64_t ) ) {
+                std::memcpy( ( l_output + l_index ),
+                             ( l_output + l_index - l_distance ),
+                             sizeof( uint64_t ) );
+            }
+
+        } else {
+            for ( size_t l_index = 0; l_index < l_length; l_index++ ) {
+                l_output[ l_index ] = l_match[ l_index ];
+            }
+        }
+
+        l_output += l_length;
+    }
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+auto lzSize( std::span< const std::byte > _data ) -> std::optional< size_t > {
+    return ( readSizePrefix( _data ) );
+}
 
-        if ( !snappy::Uncompress( _data.data(), _data.size(),
-                                  &l_decompressed ) ) [[unlikely]] {
+auto lz( std::span< const std::byte > _data, std::span< std::byte > _buffer )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        const std::optional< size_t > l_size = readSizePrefix( _data );
+
+        if ( !l_size || ( *l_size > _buffer.size() ) ) [[unlikely]] {
+            break;
+        }
+
+        if ( !decodeLz( _data, _buffer.first( *l_size ) ) ) [[unlikely]] {
             break;
         }
 
-        l_returnValue = l_decompressed;
+        l_returnValue = l_size;
     } while ( false );
 
     return ( l_returnValue );
 }
 
-#endif
+auto lz( std::span< const std::byte > _data,
+         std::vector< std::byte >& _output,
+         size_t _maxSize ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
 
-#if defined( HAS_ZSTD )
+    do {
+        const std::optional< size_t > l_size = lzSize( _data );
+
+        if ( !l_size || ( *l_size > _maxSize ) ) [[unlikely]] {
+            break;
+        }
+
+        // A forged prefix must not allocate more than the block can produce
+        if ( ( *l_size / g_lzMaxRatio ) > _data.size() ) [[unlikely]] {
+            break;
+        }
+
+        const size_t l_offset = _output.size();
 
-auto data( std::span< const std::byte > _data, size_t _originalSize )
+        _output.resize( l_offset + *l_size );
+
+        l_returnValue = lz( _data, std::span( _output ).subspan( l_offset ) );
+
+        _output.resize( l_offset + l_returnValue.value_or( 0 ) );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto lz( std::span< const std::byte > _data, size_t _maxSize )
     -> std::optional< std::vector< std::byte > > {
     std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
 
+    std::vector< std::byte > l_decompressed;
+
+    if ( lz( _data, l_decompressed, _maxSize ) ) [[likely]] {
+        l_returnValue = std::move( l_decompressed );
+    }
+
+    return ( l_returnValue );
+}
+
+asset::~asset() {
+#if defined( HAS_MMAN )
+
+    if ( _isMapped ) {
+        ::munmap( const_cast< std::byte* >( _data.data() ), _data.size() );
+    }
+
+#endif
+}
+
+auto asset::data() -> std::span< const std::byte > {
+    std::call_once( _once, [ this ]() -> void { _load(); } );
+
+    return ( _data );
+}
+
+auto asset::_load() -> void {
+    do {
+        const std::optional< size_t > l_size = lzSize( _compressed );
+
+        if ( !l_size || !*l_size ) {
+            break;
+        }
+
+        if ( ( *l_size / g_lzMaxRatio ) > _compressed.size() ) [[unlikely]] {
+            break;
+        }
+
+#if defined( HAS_MMAN )
+
+        void* const l_pages =
+            ::mmap( nullptr, *l_size, ( PROT_READ | PROT_WRITE ),
+                    ( MAP_PRIVATE | MAP_ANONYMOUS ), -1, 0 );
+
+        if ( l_pages != MAP_FAILED ) [[likely]] {
+            const std::span< std::byte > l_buffer(
+                static_cast< std::byte* >( l_pages ), *l_size );
+
+            // Stray writes into the asset fault from here on
+            if ( lz( _compressed, l_buffer ) &&
+                 !::mprotect( l_pages, *l_size, PROT_READ ) ) [[likely]] {
+                _data = l_buffer;
+                _isMapped = true;
+
+            } else {
+                ::munmap( l_pages, *l_size );
+            }
+
+            break;
+        }
+
+#endif
+
+        if ( lz( _compressed, _buffer, *l_size ) ) [[likely]] {
+            _data = _buffer;
+        }
+    } while ( false );
+}
+
+#if defined( HAS_SNAPPY )
+
+auto textSize( std::string_view _data ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
     do {
         if ( _data.empty() ) [[unlikely]] {
             break;
         }
 
-        if ( !_originalSize ) [[unlikely]] {
+        size_t l_size = 0;
+
+        if ( !snappy::GetUncompressedLength( _data.data(), _data.size(),
+                                             &l_size ) ) [[unlikely]] {
             break;
         }
 
-        std::vector< std::byte > l_decompressed( _originalSize );
+        l_returnValue = l_size;
+    } while ( false );
 
-        const size_t l_decompressedSize =
-            ZSTD_decompress( l_decompressed.data(), l_decompressed.size(),
-                             _data.data(), _data.size() );
+    return ( l_returnValue );
+}
 
-        if ( ZSTD_isError( l_decompressedSize ) ) [[unlikely]] {
+auto text( std::string_view _data, std::span< char > _buffer )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        const std::optional< size_t > l_size = textSize( _data );
+
+        if ( !l_size ) [[unlikely]] {
+            break;
+        }
+
+        if ( *l_size > _buffer.size() ) [[unlikely]] {
             break;
         }
 
-        l_decompressed.resize( l_decompressedSize );
+        if ( !snappy::RawUncompress( _data.data(), _data.size(),
+                                     _buffer.data() ) ) [[unlikely]] {
+            break;
+        }
 
-        l_returnValue = l_decompressed;
+        l_returnValue = l_size;
     } while ( false );
 
     return ( l_returnValue );
 }
 
-#endif
+auto text( std::string_view _data, std::string& _output )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        const std::optional< size_t > l_size = textSize( _data );
+
+        if ( !l_size ) [[unlikely]] {
+            break;
+        }
+
+        const size_t l_offset = _output.size();
+
+        _output.resize_and_overwrite(
+            ( l_offset + *l_size ),
+            [ & ]( char* _buffer, size_t _size ) -> size_t {
+                l_returnValue = text(
+                    _data, std::span( ( _buffer + l_offset ),
+                                      ( _size - l_offset ) ) );
+
+                return ( l_offset + l_returnValue.value_or( 0 ) );
+            } );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto text( std::string_view _data ) -> std::optional< std::string > {
+    std::optional< std::string > l_returnValue = std::nullopt;
+
+    std::string l_decompressed;
+
+    if ( text( _data, l_decompressed ) ) [[likely]] {
+        l_returnValue = std::move( l_decompressed );
+    }
+
+    return ( l_returnValue );
+}
+
+namespace {
+
+// Snappy framing format
+constexpr size_t g_framingBlockSize = ( 64 * 1024 );
+constexpr size_t g_framingHeaderSize = 4;
+constexpr size_t g_framingChecksumSize = 4;
+constexpr std::byte g_framingCompressedChunk{ 0x00 };
+constexpr std::byte g_framingUncompressedChunk{ 0x01 };
+constexpr std::byte g_framingStreamIdentifierChunk{ 0xFF };
+// Chunk types 0x02 - 0x7F are reserved and must not be skipped
+constexpr std::byte g_framingFirstSkippableChunk{ 0x80 };
+constexpr std::array< std::byte, 6 > g_framingStreamIdentifier{
+    std::byte{ 's' }, std::byte{ 'N' }, std::byte{ 'a' },
+    std::byte{ 'P' }, std::byte{ 'p' }, std::byte{ 'Y' } };
+
+auto maskedCrc32c( std::span< const std::byte > _data ) -> uint32_t {
+    const uint32_t l_crc = hash::crc32c( _data );
+
+    return ( ( ( l_crc >> 15 ) | ( l_crc << 17 ) ) + 0xA282EAD8 );
+}
+
+} // namespace
+
+textStream::textStream() : _buffer( g_framingBlockSize ) {}
+
+auto textStream::_decodeChunk() -> bool {
+    bool l_returnValue = false;
+
+    do {
+        const std::byte l_type = _chunk.front();
+        const std::span< const std::byte > l_body =
+            std::span( _chunk ).subspan( g_framingHeaderSize );
+
+        if ( l_type == g_framingStreamIdentifierChunk ) {
+            _hasStreamIdentifier =
+                std::ranges::equal( l_body, g_framingStreamIdentifier );
+
+            l_returnValue = _hasStreamIdentifier;
+
+            break;
+        }
+
+        if ( !_hasStreamIdentifier ) [[unlikely]] {
+            break;
+        }
+
+        if ( l_body.size() < g_framingChecksumSize ) [[unlikely]] {
+            break;
+        }
+
+        const uint32_t l_checksum =
+            loadLittleEndian( l_body.data(), g_framingChecksumSize );
+        const std::string_view l_data(
+            reinterpret_cast< const char* >( l_body.data() +
+                                             g_framingChecksumSize ),
+            ( l_body.size() - g_framingChecksumSize ) );
+
+        if ( l_type == g_framingCompressedChunk ) {
+            const std::optional< size_t > l_size = textSize( l_data );
+
+            if ( !l_size || ( *l_size > g_framingBlockSize ) ) [[unlikely]] {
+                break;
+            }
+
+            _pending.resize( *l_size );
+
+            if ( !snappy::RawUncompress(
+                     l_data.data(), l_data.size(),
+                     reinterpret_cast< char* >( _pending.data() ) ) )
+                [[unlikely]] {
+                break;
+            }
+
+        } else if ( l_type == g_framingUncompressedChunk ) {
+            if ( l_data.size() > g_framingBlockSize ) [[unlikely]] {
+                break;
+            }
+
+            const auto l_bytes = std::as_bytes( std::span( l_data ) );
+
+            _pending.assign( l_bytes.begin(), l_bytes.end() );
+
+        } else [[unlikely]] {
+            break;
+        }
+
+        _pendingOffset = 0;
+
+        l_returnValue = ( maskedCrc32c( _pending ) == l_checksum );
+    } while ( false );
+
+    _chunk.clear();
+
+    return ( l_returnValue );
+}
+
+auto textStream::update( std::span< const std::byte >& _input,
+                         std::span< std::byte >& _output ) -> bool {
+    const size_t l_maxChunkSize =
+        ( g_framingHeaderSize + g_framingChecksumSize +
+          snappy::MaxCompressedLength( g_framingBlockSize ) );
+
+    auto l_take = [ & ]( size_t _size ) -> void {
+        const size_t l_size = std::min( _size, _input.size() );
+
+        _chunk.insert(
+            _chunk.end(), _input.begin(),
+            ( _input.begin() + static_cast< ptrdiff_t >( l_size ) ) );
+
+        _input = _input.subspan( l_size );
+    };
+
+    bool l_returnValue = true;
+
+    while ( l_returnValue ) {
+        const size_t l_size =
+            std::min( ( _pending.size() - _pendingOffset ), _output.size() );
+
+        std::copy_n( ( _pending.begin() +
+                       static_cast< ptrdiff_t >( _pendingOffset ) ),
+                     l_size, _output.begin() );
+
+        _pendingOffset += l_size;
+        _output = _output.subspan( l_size );
+
+        if ( ( _pendingOffset != _pending.size() ) || _input.empty() ) {
+            break;
+        }
+
+        if ( _skipSize ) {
+            const size_t l_skippedSize = std::min( _skipSize, _input.size() );
+
+            _skipSize -= l_skippedSize;
+            _input = _input.subspan( l_skippedSize );
+
+            continue;
+        }
+
+        if ( _chunk.size() < g_framingHeaderSize ) {
+            l_take( g_framingHeaderSize - _chunk.size() );
+
+            continue;
+        }
+
+        const size_t l_chunkSize =
+            ( g_framingHeaderSize +
+              loadLittleEndian( ( _chunk.data() + 1 ), 3 ) );
+
+        if ( _chunk.front() >= g_framingFirstSkippableChunk &&
+             ( _chunk.front() != g_framingStreamIdentifierChunk ) ) {
+            _skipSize = ( l_chunkSize - g_framingHeaderSize );
+
+            _chunk.clear();
+
+            continue;
+        }
+
+        if ( l_chunkSize > l_maxChunkSize ) [[unlikely]] {
+            l_returnValue = false;
+
+            break;
+        }
+
+        l_take( l_chunkSize - _chunk.size() );
+
+        if ( _chunk.size() == l_chunkSize ) {
+            l_returnValue = _decodeChunk();
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+auto framedText( std::string_view _data, size_t _workers )
+    -> std::optional< std::string > {
+    struct chunk {
+        std::string_view data;
+        uint32_t checksum;
+        // In the decompressed text
+        size_t offset;
+        size_t size;
+        bool isCompressed;
+    };
+
+    std::optional< std::string > l_returnValue = std::nullopt;
+
+    do {
+        std::vector< chunk > l_chunks;
+
+        bool l_isValid = true;
+        bool l_hasStreamIdentifier = false;
+        size_t l_size = 0;
+
+        std::string_view l_input = _data;
+
+        // Sequential pass over the chunk headers, sizes only
+        while ( l_isValid && !l_input.empty() ) {
+            const auto l_header = std::as_bytes( std::span( l_input ) );
+
+            if ( l_header.size() < g_framingHeaderSize ) [[unlikely]] {
+                l_isValid = false;
+
+                break;
+            }
+
+            const std::byte l_type = l_header.front();
+            const size_t l_length =
+                loadLittleEndian( ( l_header.data() + 1 ), 3 );
+
+            if ( l_input.size() < ( g_framingHeaderSize + l_length ) )
+                [[unlikely]] {
+                l_isValid = false;
+
+                break;
+            }
+
+            const std::string_view l_body =
+                l_input.substr( g_framingHeaderSize, l_length );
+
+            l_input.remove_prefix( g_framingHeaderSize + l_length );
+
+            if ( l_type == g_framingStreamIdentifierChunk ) {
+                l_isValid = std::ranges::equal(
+                    std::as_bytes( std::span( l_body ) ),
+                    g_framingStreamIdentifier );
+                l_hasStreamIdentifier = true;
+
+                continue;
+            }
+
+            if ( l_type >= g_framingFirstSkippableChunk ) {
+                continue;
+            }
+
+            l_isValid = ( l_hasStreamIdentifier &&
+                          ( l_body.size() >= g_framingChecksumSize ) &&
+                          ( ( l_type == g_framingCompressedChunk ) ||
+                            ( l_type == g_framingUncompressedChunk ) ) );
+
+            if ( !l_isValid ) [[unlikely]] {
+                break;
+            }
+
+            chunk l_chunk{
+                .data = l_body.substr( g_framingChecksumSize ),
+                .checksum = loadLittleEndian(
+                    reinterpret_cast< const std::byte* >( l_body.data() ),
+                    g_framingChecksumSize ),
+                .offset = l_size,
+                .size = 0,
+                .isCompressed = ( l_type == g_framingCompressedChunk ) };
+
+            const std::optional< size_t > l_chunkSize =
+                ( l_chunk.isCompressed ? textSize( l_chunk.data )
+                                       : l_chunk.data.size() );
+
+            l_isValid =
+                ( l_chunkSize && ( *l_chunkSize <= g_framingBlockSize ) );
+
+            l_chunk.size = l_chunkSize.value_or( 0 );
+            l_size += l_chunk.size;
+
+            l_chunks.emplace_back( l_chunk );
+        }
+
+        if ( !l_isValid || !l_hasStreamIdentifier ) [[unlikely]] {
+            break;
+        }
+
+        std::string l_decompressed;
+        std::atomic< bool > l_isCorrupted = false;
+
+        l_decompressed.resize_and_overwrite(
+            l_size, [ & ]( char* _buffer, size_t _size ) -> size_t {
+                thread::parallelFor(
+                    l_chunks.size(),
+                    [ & ]( size_t _index ) -> void {
+                        const chunk& l_chunk = l_chunks[ _index ];
+                        char* l_output = ( _buffer + l_chunk.offset );
+
+                        if ( l_chunk.isCompressed ) {
+                            if ( !snappy::RawUncompress( l_chunk.data.data(),
+                                                         l_chunk.data.size(),
+                                                         l_output ) )
+                                [[unlikely]] {
+                                l_isCorrupted = true;
+
+                                return;
+                            }
+
+                        } else {
+                            std::ranges::copy( l_chunk.data, l_output );
+                        }
+
+                        if ( maskedCrc32c( std::as_bytes( std::span(
+                                 l_output, l_chunk.size ) ) ) !=
+                             l_chunk.checksum ) [[unlikely]] {
+                            l_isCorrupted = true;
+                        }
+                    },
+                    _workers );
+
+                return ( _size );
+            } );
+
+        if ( l_isCorrupted ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = std::move( l_decompressed );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto pipe( textStream& _stream, std::istream& _input, std::ostream& _output )
+    -> bool {
+    return ( pipeStreams( _stream, _input, _output ) );
+}
+
+#if defined( HAS_UNISTD )
+
+auto pipe( textStream& _stream, int _input, int _output ) -> bool {
+    return ( pipeDescriptors( _stream, _input, _output ) );
+}
+
+#endif
+
+#endif
+
+#if defined( HAS_ZSTD )
+
+namespace {
+
+struct contextDeleter {
+    void operator()( ZSTD_DCtx* _context ) const { ZSTD_freeDCtx( _context ); }
+};
+
+auto threadContext() -> ZSTD_DCtx* {
+    thread_local const std::unique_ptr< ZSTD_DCtx, contextDeleter > l_context{
+        ZSTD_createDCtx() };
+
+    return ( l_context.get() );
+}
+
+auto decompressInto( ZSTD_DCtx* _context,
+                     std::span< const std::byte > _data,
+                     std::span< std::byte > _buffer )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_context ) [[unlikely]] {
+            break;
+        }
+
+        if ( _data.empty() ) [[unlikely]] {
+            break;
+        }
+
+        const size_t l_decompressedSize =
+            ZSTD_decompressDCtx( _context, _buffer.data(), _buffer.size(),
+                                 _data.data(), _data.size() );
+
+        if ( ZSTD_isError( l_decompressedSize ) ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = l_decompressedSize;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+// Sum over all frames, ZSTD_CONTENTSIZE_UNKNOWN when a frame does not store
+// its size and ZSTD_CONTENTSIZE_ERROR on malformed input
+auto contentSize( std::span< const std::byte > _data ) -> unsigned long long {
+    unsigned long long l_returnValue = 0;
+
+    while ( !_data.empty() ) {
+        const unsigned long long l_frameSize =
+            ZSTD_getFrameContentSize( _data.data(), _data.size() );
+        const size_t l_compressedSize =
+            ZSTD_findFrameCompressedSize( _data.data(), _data.size() );
+
+        if ( ( l_frameSize == ZSTD_CONTENTSIZE_ERROR ) ||
+             ZSTD_isError( l_compressedSize ) ) [[unlikely]] {
+            l_returnValue = ZSTD_CONTENTSIZE_ERROR;
+
+            break;
+        }
+
+        if ( l_frameSize == ZSTD_CONTENTSIZE_UNKNOWN ) {
+            l_returnValue = ZSTD_CONTENTSIZE_UNKNOWN;
+
+            break;
+        }
+
+        l_returnValue += l_frameSize;
+
+        // Beyond any allocation, also keeps the sum from wrapping
+        if ( l_returnValue > std::numeric_limits< size_t >::max() )
+            [[unlikely]] {
+            l_returnValue = ZSTD_CONTENTSIZE_ERROR;
+
+            break;
+        }
+
+        _data = _data.subspan( l_compressedSize );
+    }
+
+    return ( l_returnValue );
+}
+
+// Frames without a stored size, the output grows geometrically up to
+// _maxSize
+auto appendStreamed( ZSTD_DCtx* _context,
+                     std::span< const std::byte > _data,
+                     std::vector< std::byte >& _output,
+                     size_t _maxSize ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    const size_t l_offset = _output.size();
+
+    do {
+        if ( ZSTD_isError(
+                 ZSTD_DCtx_reset( _context, ZSTD_reset_session_only ) ) )
+            [[unlikely]] {
+            break;
+        }
+
+        ZSTD_inBuffer l_input{ _data.data(), _data.size(), 0 };
+        ZSTD_outBuffer l_output{ nullptr, 0, 0 };
+
+        size_t l_result = 0;
+        bool l_isFailed = false;
+
+        do {
+            if ( l_output.pos == l_output.size ) {
+                if ( l_output.size == _maxSize ) [[unlikely]] {
+                    l_isFailed = true;
+
+                    break;
+                }
+
+                l_output.size = std::min(
+                    ( l_output.size
+                          ? ( l_output.size * 2 )
+                          : std::max( ( _data.size() * 4 ),
+                                      ZSTD_DStreamOutSize() ) ),
+                    _maxSize );
+
+                _output.resize( l_offset + l_output.size );
+
+                l_output.dst = ( _output.data() + l_offset );
+            }
+
+            l_result = ZSTD_decompressStream( _context, &l_output, &l_input );
+
+            // Input ran out in the middle of a frame
+            l_isFailed = ( ZSTD_isError( l_result ) ||
+                           ( l_result && ( l_input.pos == l_input.size ) &&
+                             ( l_output.pos < l_output.size ) ) );
+        } while ( !l_isFailed &&
+                  ( l_result || ( l_input.pos < l_input.size ) ) );
+
+        if ( l_isFailed ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = l_output.pos;
+    } while ( false );
+
+    _output.resize( l_offset + l_returnValue.value_or( 0 ) );
+
+    return ( l_returnValue );
+}
+
+// Grows _output by the original size, detected from the frame headers when
+// _originalSize is 0, then trims it to what was decompressed
+auto appendInto( ZSTD_DCtx* _context,
+                 std::span< const std::byte > _data,
+                 std::vector< std::byte >& _output,
+                 size_t _originalSize,
+                 size_t _maxSize ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    const size_t l_offset = _output.size();
+
+    do {
+        if ( !_context ) [[unlikely]] {
+            break;
+        }
+
+        if ( _data.empty() ) [[unlikely]] {
+            break;
+        }
+
+        size_t l_size = _originalSize;
+
+        if ( !l_size ) {
+            const unsigned long long l_contentSize = contentSize( _data );
+
+            if ( l_contentSize == ZSTD_CONTENTSIZE_ERROR ) [[unlikely]] {
+                break;
+            }
+
+            if ( l_contentSize == ZSTD_CONTENTSIZE_UNKNOWN ) {
+                l_returnValue =
+                    appendStreamed( _context, _data, _output, _maxSize );
+
+                break;
+            }
+
+            if ( l_contentSize > _maxSize ) [[unlikely]] {
+                break;
+            }
+
+            l_size = static_cast< size_t >( l_contentSize );
+        }
+
+        _output.resize( l_offset + l_size );
+
+        l_returnValue = decompressInto(
+            _context, _data, std::span( _output ).subspan( l_offset ) );
+
+        _output.resize( l_offset + l_returnValue.value_or( 0 ) );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto decompressData( ZSTD_DCtx* _context,
+                     std::span< const std::byte > _data,
+                     size_t _originalSize,
+                     size_t _maxSize )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    std::vector< std::byte > l_decompressed;
+
+    if ( appendInto( _context, _data, l_decompressed, _originalSize,
+                     _maxSize ) )
+        [[likely]] {
+        l_returnValue = std::move( l_decompressed );
+    }
+
+    return ( l_returnValue );
+}
+
+// Frames that record a dictionary ID have to record _id
+auto dictionaryMatches( std::span< const std::byte > _data, uint32_t _id )
+    -> bool {
+    bool l_returnValue = true;
+
+    while ( l_returnValue && !_data.empty() ) {
+        const uint32_t l_frameId =
+            ZSTD_getDictID_fromFrame( _data.data(), _data.size() );
+        const size_t l_compressedSize =
+            ZSTD_findFrameCompressedSize( _data.data(), _data.size() );
+
+        l_returnValue = ( !ZSTD_isError( l_compressedSize ) &&
+                          ( !l_frameId || ( l_frameId == _id ) ) );
+
+        if ( l_returnValue ) [[likely]] {
+            _data = _data.subspan( l_compressedSize );
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+// Runs _decompress() with _dictionary referenced by _context
+template < typename Decompress >
+auto withDictionary( ZSTD_DCtx* _context,
+                     const ZSTD_DDict* _dictionary,
+                     std::span< const std::byte > _data,
+                     Decompress&& _decompress ) -> decltype( _decompress() ) {
+    decltype( _decompress() ) l_returnValue = std::nullopt;
+
+    do {
+        if ( !_context || !_dictionary ) [[unlikely]] {
+            break;
+        }
+
+        if ( !dictionaryMatches( _data,
+                                 ZSTD_getDictID_fromDDict( _dictionary ) ) )
+            [[unlikely]] {
+            break;
+        }
+
+        // Referencing fails while a streamed frame is unfinished
+        if ( ZSTD_isError(
+                 ZSTD_DCtx_reset( _context, ZSTD_reset_session_only ) ) ||
+             ZSTD_isError( ZSTD_DCtx_refDDict( _context, _dictionary ) ) )
+            [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = _decompress();
+
+        // The context is reused by calls without a dictionary
+        ZSTD_DCtx_refDDict( _context, nullptr );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+// _decompress( frame, slot ) decompresses one non-empty frame into its slot
+template < typename Decompress >
+auto decompressBatch( std::span< const std::byte > _data,
+                      std::span< const size_t > _offsets,
+                      size_t _workers,
+                      size_t _maxSize,
+                      Decompress&& _decompress ) -> std::optional< arena > {
+    std::optional< arena > l_returnValue = std::nullopt;
+
+    do {
+        if ( _offsets.empty() || ( _offsets.back() > _data.size() ) ||
+             !std::ranges::is_sorted( _offsets ) ) [[unlikely]] {
+            break;
+        }
+
+        const size_t l_count = ( _offsets.size() - 1 );
+
+        auto l_frame = [ & ]( size_t _index ) -> std::span< const std::byte > {
+            return ( _data.subspan( _offsets[ _index ],
+                                    ( _offsets[ _index + 1 ] -
+                                      _offsets[ _index ] ) ) );
+        };
+
+        arena l_arena;
+
+        l_arena.offsets.resize( l_count + 1 );
+
+        bool l_isFailed = false;
+
+        // Header scan, cheap next to decompression
+        for ( size_t l_index = 0; l_index < l_count; l_index++ ) {
+            const std::span< const std::byte > l_bytes = l_frame( l_index );
+            const std::optional< size_t > l_size =
+                ( l_bytes.empty() ? 0 : dataSize( l_bytes ) );
+
+            // Offsets never exceed _maxSize, the subtraction cannot wrap
+            l_isFailed =
+                ( !l_size ||
+                  ( *l_size > ( _maxSize - l_arena.offsets[ l_index ] ) ) );
+
+            if ( l_isFailed ) [[unlikely]] {
+                break;
+            }
+
+            l_arena.offsets[ l_index + 1 ] =
+                ( l_arena.offsets[ l_index ] + *l_size );
+        }
+
+        if ( l_isFailed ) [[unlikely]] {
+            break;
+        }
+
+        l_arena.data.resize( l_arena.offsets.back() );
+
+        std::atomic< bool > l_isDecompressionFailed = false;
+
+        thread::parallelFor(
+            l_count,
+            [ & ]( size_t _index ) -> void {
+                const std::span< const std::byte > l_bytes = l_frame( _index );
+
+                if ( l_bytes.empty() ) {
+                    return;
+                }
+
+                const std::span< std::byte > l_slot =
+                    std::span( l_arena.data )
+                        .subspan( l_arena.offsets[ _index ],
+                                  ( l_arena.offsets[ _index + 1 ] -
+                                    l_arena.offsets[ _index ] ) );
+
+                if ( _decompress( l_bytes, l_slot ) != l_slot.size() )
+                    [[unlikely]] {
+                    l_isDecompressionFailed.store( true,
+                                                   std::memory_order_relaxed );
+                }
+            },
+            _workers );
+
+        if ( l_isDecompressionFailed.load( std::memory_order_relaxed ) )
+            [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = std::move( l_arena );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+auto data( std::span< const std::byte > _data, std::span< std::byte > _buffer )
+    -> std::optional< size_t > {
+    return ( decompressInto( threadContext(), _data, _buffer ) );
+}
+
+auto data( std::span< const std::byte > _data,
+           std::vector< std::byte >& _output,
+           size_t _originalSize,
+           size_t _maxSize ) -> std::optional< size_t > {
+    return ( appendInto( threadContext(), _data, _output, _originalSize,
+                         _maxSize ) );
+}
+
+auto data( std::span< const std::byte > _data,
+           size_t _originalSize,
+           size_t _maxSize ) -> std::optional< std::vector< std::byte > > {
+    return (
+        decompressData( threadContext(), _data, _originalSize, _maxSize ) );
+}
+
+auto async( std::span< const std::byte > _data,
+            size_t _originalSize,
+            size_t _maxSize,
+            async::pool& _pool )
+    -> async::task< std::optional< std::vector< std::byte > > > {
+    co_await _pool.schedule();
+
+    co_return ( data( _data, _originalSize, _maxSize ) );
+}
+
+auto dataSize( std::span< const std::byte > _data )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    const unsigned long long l_contentSize = contentSize( _data );
+
+    if ( !_data.empty() && ( l_contentSize != ZSTD_CONTENTSIZE_ERROR ) &&
+         ( l_contentSize != ZSTD_CONTENTSIZE_UNKNOWN ) ) [[likely]] {
+        l_returnValue = static_cast< size_t >( l_contentSize );
+    }
+
+    return ( l_returnValue );
+}
+
+context::context() : _context( ZSTD_createDCtx() ) {}
+
+context::context( context&& _other ) noexcept
+    : _context( std::exchange( _other._context, nullptr ) ) {}
+
+context::~context() {
+    ZSTD_freeDCtx( _context );
+}
+
+auto context::operator=( context&& _other ) noexcept -> context& {
+    if ( this != &_other ) {
+        ZSTD_freeDCtx( _context );
+
+        _context = std::exchange( _other._context, nullptr );
+    }
+
+    return ( *this );
+}
+
+auto context::data( std::span< const std::byte > _data,
+                    std::span< std::byte > _buffer )
+    -> std::optional< size_t > {
+    return ( decompressInto( _context, _data, _buffer ) );
+}
+
+auto context::data( std::span< const std::byte > _data,
+                    std::vector< std::byte >& _output,
+                    size_t _originalSize,
+                    size_t _maxSize ) -> std::optional< size_t > {
+    return (
+        appendInto( _context, _data, _output, _originalSize, _maxSize ) );
+}
+
+auto context::data( std::span< const std::byte > _data,
+                    size_t _originalSize,
+                    size_t _maxSize )
+    -> std::optional< std::vector< std::byte > > {
+    return ( decompressData( _context, _data, _originalSize, _maxSize ) );
+}
+
+auto context::data( std::span< const std::byte > _data,
+                    const dictionary& _dictionary,
+                    size_t _originalSize,
+                    size_t _maxSize )
+    -> std::optional< std::vector< std::byte > > {
+    return ( withDictionary( _context, _dictionary._dictionary, _data, [ & ] {
+        return ( decompressData( _context, _data, _originalSize, _maxSize ) );
+    } ) );
+}
+
+auto context::data( std::span< const std::byte > _data,
+                    std::span< std::byte > _buffer,
+                    const dictionary& _dictionary )
+    -> std::optional< size_t > {
+    return ( withDictionary( _context, _dictionary._dictionary, _data, [ & ] {
+        return ( decompressInto( _context, _data, _buffer ) );
+    } ) );
+}
+
+auto context::data( std::span< const std::byte > _data,
+                    std::vector< std::byte >& _output,
+                    const dictionary& _dictionary,
+                    size_t _originalSize,
+                    size_t _maxSize ) -> std::optional< size_t > {
+    return ( withDictionary( _context, _dictionary._dictionary, _data, [ & ] {
+        return ( appendInto( _context, _data, _output, _originalSize,
+                             _maxSize ) );
+    } ) );
+}
+
+dictionary::dictionary( std::span< const std::byte > _content )
+    : _dictionary( ZSTD_createDDict( _content.data(), _content.size() ) ) {}
+
+dictionary::dictionary( dictionary&& _other ) noexcept
+    : _dictionary( std::exchange( _other._dictionary, nullptr ) ) {}
+
+dictionary::~dictionary() {
+    ZSTD_freeDDict( _dictionary );
+}
+
+auto dictionary::operator=( dictionary&& _other ) noexcept -> dictionary& {
+    if ( this != &_other ) {
+        ZSTD_freeDDict( _dictionary );
+
+        _dictionary = std::exchange( _other._dictionary, nullptr );
+    }
+
+    return ( *this );
+}
+
+auto dictionary::id() const -> uint32_t {
+    return ( _dictionary ? ZSTD_getDictID_fromDDict( _dictionary ) : 0 );
+}
+
+auto data( std::span< const std::byte > _data,
+           const dictionary& _dictionary,
+           size_t _originalSize,
+           size_t _maxSize ) -> std::optional< std::vector< std::byte > > {
+    ZSTD_DCtx* l_context = threadContext();
+
+    return ( withDictionary( l_context, _dictionary._dictionary, _data, [ & ] {
+        return ( decompressData( l_context, _data, _originalSize, _maxSize ) );
+    } ) );
+}
+
+auto data( std::span< const std::byte > _data,
+           std::span< std::byte > _buffer,
+           const dictionary& _dictionary ) -> std::optional< size_t > {
+    ZSTD_DCtx* l_context = threadContext();
+
+    return ( withDictionary( l_context, _dictionary._dictionary, _data, [ & ] {
+        return ( decompressInto( l_context, _data, _buffer ) );
+    } ) );
+}
+
+auto data( std::span< const std::byte > _data,
+           std::vector< std::byte >& _output,
+           const dictionary& _dictionary,
+           size_t _originalSize,
+           size_t _maxSize ) -> std::optional< size_t > {
+    ZSTD_DCtx* l_context = threadContext();
+
+    return ( withDictionary( l_context, _dictionary._dictionary, _data, [ & ] {
+        return ( appendInto( l_context, _data, _output, _originalSize,
+                             _maxSize ) );
+    } ) );
+}
+
+auto batch( std::span< const std::byte > _data,
+            std::span< const size_t > _offsets,
+            size_t _workers,
+            size_t _maxSize ) -> std::optional< arena > {
+    return ( decompressBatch(
+        _data, _offsets, _workers, _maxSize,
+        []( std::span< const std::byte > _frame,
+            std::span< std::byte > _slot ) -> std::optional< size_t > {
+            return ( data( _frame, _slot ) );
+        } ) );
+}
+
+auto batch( std::span< const std::byte > _data,
+            std::span< const size_t > _offsets,
+            const dictionary& _dictionary,
+            size_t _workers,
+            size_t _maxSize ) -> std::optional< arena > {
+    return ( decompressBatch(
+        _data, _offsets, _workers, _maxSize,
+        [ & ]( std::span< const std::byte > _frame,
+               std::span< std::byte > _slot ) -> std::optional< size_t > {
+            return ( data( _frame, _slot, _dictionary ) );
+        } ) );
+}
+
+dataStream::dataStream()
+    : _context( ZSTD_createDCtx() ), _buffer( ZSTD_DStreamOutSize() ) {}
+
+dataStream::dataStream( dataStream&& _other ) noexcept
+    : _context( std::exchange( _other._context, nullptr ) ),
+      _buffer( std::move( _other._buffer ) ),
+      _isFinished( _other._isFinished ) {}
+
+dataStream::~dataStream() {
+    ZSTD_freeDCtx( _context );
+}
+
+auto dataStream::operator=( dataStream&& _other ) noexcept -> dataStream& {
+    if ( this != &_other ) {
+        ZSTD_freeDCtx( _context );
+
+        _context = std::exchange( _other._context, nullptr );
+        _buffer = std::move( _other._buffer );
+        _isFinished = _other._isFinished;
+    }
+
+    return ( *this );
+}
+
+auto dataStream::update( std::span< const std::byte >& _input,
+                         std::span< std::byte >& _output ) -> bool {
+    bool l_returnValue = false;
+
+    do {
+        if ( !_context ) [[unlikely]] {
+            break;
+        }
+
+        // Nothing buffered, a call would only report the next frame header
+        if ( _input.empty() && _isFinished ) {
+            l_returnValue = true;
+
+            break;
+        }
+
+        ZSTD_inBuffer l_input{ _input.data(), _input.size(), 0 };
+        ZSTD_outBuffer l_output{ _output.data(), _output.size(), 0 };
+
+        size_t l_result = 0;
+
+        // Runs once more on empty input to flush what an earlier call left
+        do {
+            l_result = ZSTD_decompressStream( _context, &l_output, &l_input );
+
+            if ( ZSTD_isError( l_result ) ) [[unlikely]] {
+                break;
+            }
+
+            // 0 once a frame is decoded and flushed
+            _isFinished = !l_result;
+        } while ( ( l_input.pos < l_input.size ) &&
+                  ( l_output.pos < l_output.size ) );
+
+        _input = _input.subspan( l_input.pos );
+        _output = _output.subspan( l_output.pos );
+
+        if ( ZSTD_isError( l_result ) ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = true;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto pipe( dataStream& _stream, std::istream& _input, std::ostream& _output )
+    -> bool {
+    return ( pipeStreams( _stream, _input, _output ) );
+}
+
+#if defined( HAS_UNISTD )
+
+auto pipe( dataStream& _stream, int _input, int _output ) -> bool {
+    return ( pipeDescriptors( _stream, _input, _output ) );
+}
+
+#endif
+
+namespace {
+
+// zstd seekable format
+constexpr uint32_t g_seekTableMagic = 0x184D2A5E;
+constexpr uint32_t g_seekableMagic = 0x8F92EAB1;
+constexpr uint8_t g_seekTableChecksumFlag = 0x80;
+constexpr uint8_t g_seekTableReservedBits = 0x7C;
+constexpr size_t g_seekTableHeaderSize = ( 2 * sizeof( uint32_t ) );
+constexpr size_t g_seekTableFooterSize = ( ( 2 * sizeof( uint32_t ) ) + 1 );
+
+} // namespace
+
+seekable::seekable( std::span< const std::byte > _data,
+                    size_t _workers,
+                    size_t _cacheSize,
+                    size_t _maxSize )
+    : _data( _data ), _workers( _workers ), _cacheSize( _cacheSize ) {
+    _isValid = _open( _data.size(), _maxSize );
+}
+
+#if defined( HAS_UNISTD )
+
+seekable::seekable( int _descriptor,
+                    size_t _workers,
+                    size_t _cacheSize,
+                    size_t _maxSize )
+    : _descriptor( _descriptor ),
+      _workers( _workers ),
+      _cacheSize( _cacheSize ) {
+    struct stat l_status{};
+
+    if ( ( _descriptor >= 0 ) && !::fstat( _descriptor, &l_status ) )
+        [[likely]] {
+        _isValid =
+            _open( static_cast< uint64_t >( l_status.st_size ), _maxSize );
+    }
+}
+
+#endif
+
+auto seekable::_open( uint64_t _compressedSize, size_t _maxSize ) -> bool {
+    bool l_returnValue = false;
+
+    do {
+        std::array< std::byte, g_seekTableFooterSize > l_footer{};
+
+        if ( _compressedSize < ( g_seekTableHeaderSize + l_footer.size() ) )
+            [[unlikely]] {
+            break;
+        }
+
+        if ( !_readCompressed( ( _compressedSize - l_footer.size() ),
+                               l_footer ) ) [[unlikely]] {
+            break;
+        }
+
+        const uint32_t l_chunkCount =
+            loadLittleEndian( l_footer.data(), sizeof( uint32_t ) );
+        const auto l_descriptor = static_cast< uint8_t >( l_footer[ 4 ] );
+
+        if ( ( loadLittleEndian( ( l_footer.data() + 5 ),
+                                 sizeof( uint32_t ) ) != g_seekableMagic ) ||
+             ( l_descriptor & g_seekTableReservedBits ) ) [[unlikely]] {
+            break;
+        }
+
+        _hasChecksums = ( l_descriptor & g_seekTableChecksumFlag );
+
+        // Compressed size, decompressed size and optionally the checksum
+        const size_t l_entrySize =
+            ( ( _hasChecksums ? 3 : 2 ) * sizeof( uint32_t ) );
+        const uint64_t l_tableSize =
+            ( g_seekTableHeaderSize +
+              ( static_cast< uint64_t >( l_chunkCount ) * l_entrySize ) +
+              g_seekTableFooterSize );
+
+        if ( l_tableSize > _compressedSize ) [[unlikely]] {
+            break;
+        }
+
+        std::vector< std::byte > l_table( l_tableSize -
+                                          g_seekTableFooterSize );
+
+        if ( !_readCompressed( ( _compressedSize - l_tableSize ), l_table ) )
+            [[unlikely]] {
+            break;
+        }
+
+        if ( ( loadLittleEndian( l_table.data(), sizeof( uint32_t ) ) !=
+               g_seekTableMagic ) ||
+             ( loadLittleEndian( ( l_table.data() + sizeof( uint32_t ) ),
+                                 sizeof( uint32_t ) ) !=
+               ( l_tableSize - g_seekTableHeaderSize ) ) ) [[unlikely]] {
+            break;
+        }
+
+        uint64_t l_compressedOffset = 0;
+        uint64_t l_offset = 0;
+        bool l_isOversized = false;
+
+        _chunks.reserve( l_chunkCount );
+
+        for ( size_t l_index = 0; l_index < l_chunkCount; l_index++ ) {
+            const std::byte* l_entry =
+                ( l_table.data() + g_seekTableHeaderSize +
+                  ( l_index * l_entrySize ) );
+
+            const chunk l_chunk{
+                .compressedOffset = l_compressedOffset,
+                .offset = l_offset,
+                .compressedSize = loadLittleEndian( l_entry, 4 ),
+                .size = loadLittleEndian( ( l_entry + 4 ), 4 ),
+                .checksum = ( _hasChecksums
+                                  ? loadLittleEndian( ( l_entry + 8 ), 4 )
+                                  : 0 ) };
+
+            // Decoded chunks are allocated up front, l_offset stays within
+            // _maxSize
+            if ( l_chunk.size > ( _maxSize - l_offset ) ) [[unlikely]] {
+                l_isOversized = true;
+
+                break;
+            }
+
+            l_compressedOffset += l_chunk.compressedSize;
+            l_offset += l_chunk.size;
+
+            _chunks.emplace_back( l_chunk );
+        }
+
+        // The frames fill everything in front of the seek table
+        if ( l_isOversized ||
+             ( l_compressedOffset != ( _compressedSize - l_tableSize ) ) )
+            [[unlikely]] {
+            _chunks.clear();
+
+            break;
+        }
+
+        l_returnValue = true;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto seekable::_readCompressed( uint64_t _offset,
+                                std::span< std::byte > _buffer ) const
+    -> bool {
+    bool l_returnValue = false;
+
+    do {
+        if ( _descriptor < 0 ) {
+            if ( ( _offset > _data.size() ) ||
+                 ( _buffer.size() > ( _data.size() - _offset ) ) )
+                [[unlikely]] {
+                break;
+            }
+
+            std::ranges::copy( _data.subspan( _offset, _buffer.size() ),
+                               _buffer.begin() );
+
+            l_returnValue = true;
+
+            break;
+        }
+
+#if defined( HAS_UNISTD )
+
+        while ( !_buffer.empty() ) {
+            const ssize_t l_readSize =
+                ::pread( _descriptor, _buffer.data(), _buffer.size(),
+                         static_cast< off_t >( _offset ) );
+
+            if ( ( l_readSize < 0 ) && ( errno == EINTR ) ) {
+                continue;
+            }
+
+            // Failed or ended early
+            if ( l_readSize <= 0 ) [[unlikely]] {
+                break;
+            }
+
+            _buffer = _buffer.subspan( static_cast< size_t >( l_readSize ) );
+            _offset += static_cast< uint64_t >( l_readSize );
+        }
+
+        l_returnValue = _buffer.empty();
+
+#endif
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto seekable::_decode( size_t _index, std::vector< std::byte >& _output ) const
+    -> bool {
+    bool l_returnValue = false;
+
+    const chunk& l_chunk = _chunks[ _index ];
+
+    do {
+        std::vector< std::byte > l_storage;
+        std::span< const std::byte > l_compressed;
+
+        // Memory is decompressed in place, _open() checked the bounds
+        if ( _descriptor < 0 ) {
+            l_compressed = _data.subspan( l_chunk.compressedOffset,
+                                          l_chunk.compressedSize );
+
+        } else {
+            l_storage.resize( l_chunk.compressedSize );
+
+            if ( !_readCompressed( l_chunk.compressedOffset, l_storage ) )
+                [[unlikely]] {
+                break;
+            }
+
+            l_compressed = l_storage;
+        }
+
+        _output.resize( l_chunk.size );
+
+        if ( data( l_compressed, std::span( _output ) ) != l_chunk.size )
+            [[unlikely]] {
+            break;
+        }
+
+        if ( _hasChecksums && ( static_cast< uint32_t >( hash::xxh64(
+                                    _output ) ) != l_chunk.checksum ) )
+            [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = true;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto seekable::_cached( size_t _index ) -> const std::vector< std::byte >* {
+    const auto l_iterator = std::ranges::find(
+        _cache, _index,
+        &std::pair< size_t, std::vector< std::byte > >::first );
+
+    if ( l_iterator == _cache.end() ) {
+        return ( nullptr );
+    }
+
+    _cache.splice( _cache.begin(), _cache, l_iterator );
+
+    return ( &_cache.front().second );
+}
+
+auto seekable::size() const -> uint64_t {
+    return ( _chunks.empty()
+                 ? 0
+                 : ( _chunks.back().offset + _chunks.back().size ) );
+}
+
+auto seekable::read( uint64_t _offset, std::span< std::byte > _buffer )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_isValid ) [[unlikely]] {
+            break;
+        }
+
+        if ( _offset > size() ) [[unlikely]] {
+            break;
+        }
+
+        const auto l_readSize = static_cast< size_t >(
+            std::min< uint64_t >( _buffer.size(), ( size() - _offset ) ) );
+        const uint64_t l_end = ( _offset + l_readSize );
+
+        if ( !l_readSize ) {
+            l_returnValue = 0;
+
+            break;
+        }
+
+        // Chunks overlapping [ _offset, l_end )
+        const auto l_first = static_cast< size_t >(
+            std::ranges::upper_bound( _chunks, _offset, {}, &chunk::offset ) -
+            _chunks.begin() - 1 );
+        const auto l_last = static_cast< size_t >(
+            std::ranges::lower_bound( _chunks, l_end, {}, &chunk::offset ) -
+            _chunks.begin() );
+
+        std::vector< size_t > l_missing;
+
+        for ( size_t l_index = l_first; l_index < l_last; l_index++ ) {
+            if ( _chunks[ l_index ].size && !_cached( l_index ) ) {
+                l_missing.emplace_back( l_index );
+            }
+        }
+
+        std::vector< std::vector< std::byte > > l_decoded( l_missing.size() );
+        std::atomic< bool > l_isFailed = false;
+
+        thread::parallelFor(
+            l_missing.size(),
+            [ & ]( size_t _index ) -> void {
+                if ( !_decode( l_missing[ _index ], l_decoded[ _index ] ) )
+                    [[unlikely]] {
+                    l_isFailed.store( true, std::memory_order_relaxed );
+                }
+            },
+            _workers );
+
+        if ( l_isFailed.load( std::memory_order_relaxed ) ) [[unlikely]] {
+            break;
+        }
+
+        size_t l_written = 0;
+        size_t l_decodedIndex = 0;
+
+        for ( size_t l_index = l_first; l_index < l_last; l_index++ ) {
+            const chunk& l_chunk = _chunks[ l_index ];
+
+            if ( !l_chunk.size ) {
+                continue;
+            }
+
+            const std::vector< std::byte >* l_bytes =
+                ( ( ( l_decodedIndex < l_missing.size() ) &&
+                    ( l_missing[ l_decodedIndex ] == l_index ) )
+                      ? &l_decoded[ l_decodedIndex++ ]
+                      : _cached( l_index ) );
+
+            const uint64_t l_from =
+                ( std::max( _offset, l_chunk.offset ) - l_chunk.offset );
+            const auto l_size = static_cast< size_t >(
+                std::min( ( l_chunk.offset + l_chunk.size ), l_end ) -
+                l_chunk.offset - l_from );
+
+            std::copy_n(
+                ( l_bytes->begin() + static_cast< ptrdiff_t >( l_from ) ),
+                l_size,
+                ( _buffer.begin() + static_cast< ptrdiff_t >( l_written ) ) );
+
+            l_written += l_size;
+        }
+
+        // Copied first, inserting may evict chunks read above
+        for ( size_t l_index = 0; ( l_index < l_missing.size() ) && _cacheSize;
+              l_index++ ) {
+            _cache.emplace_front( l_missing[ l_index ],
+                                  std::move( l_decoded[ l_index ] ) );
+
+            if ( _cache.size() > _cacheSize ) {
+                _cache.pop_back();
+            }
+        }
+
+        l_returnValue = l_written;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto seekable::read( uint64_t _offset, size_t _size )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    const uint64_t l_available =
+        ( ( _offset < size() ) ? ( size() - _offset ) : 0 );
+
+    std::vector< std::byte > l_bytes(
+        static_cast< size_t >( std::min< uint64_t >( _size, l_available ) ) );
+
+    if ( read( _offset, l_bytes ) ) [[likely]] {
+        l_returnValue = std::move( l_bytes );
+    }
+
+    return ( l_returnValue );
+}
+
+#endif
+
+namespace {
+
+constexpr uint8_t g_adaptiveMagic = 0xA0;
+constexpr uint8_t g_adaptiveMagicMask = 0xF0;
+
+// Values of compress::codec
+constexpr uint8_t g_storedCodec = 0;
+constexpr uint8_t g_snappyCodec = 1;
+constexpr uint8_t g_zstdCodec = 2;
+constexpr uint8_t g_lzCodec = 3;
+
+// "SFC1", followed by the 64 bit decompressed size
+constexpr uint32_t g_checkedMagic = 0x31434653;
+constexpr size_t g_checkedHeaderSize = ( sizeof( uint32_t ) * 3 );
+// Codec, stored size, decompressed size and CRC-32C of the plaintext
+constexpr size_t g_checkedBlockHeaderSize = ( 1 + ( 3 * sizeof( uint32_t ) ) );
+
+struct checkedBlock {
+    std::span< const std::byte > payload;
+    size_t offset;
+    size_t size;
+    uint32_t checksum;
+    uint8_t codec;
+};
+
+auto isAvailable( uint8_t _codec ) -> bool {
+    switch ( _codec ) {
+        case g_storedCodec:
+        case g_lzCodec: {
+            return ( true );
+        }
+
+#if defined( HAS_SNAPPY )
+
+        case g_snappyCodec: {
+            return ( true );
+        }
+
+#endif
+
+#if defined( HAS_ZSTD )
+
+        case g_zstdCodec: {
+            return ( true );
+        }
+
+#endif
+
+        default: {
+            return ( false );
+        }
+    }
+}
+
+// True when _payload decodes to exactly all of _output
+auto decodeBlock( uint8_t _codec,
+                  std::span< const std::byte > _payload,
+                  std::span< std::byte > _output ) -> bool {
+    std::optional< size_t > l_size = std::nullopt;
+
+    switch ( _codec ) {
+        case g_storedCodec: {
+            if ( _payload.size() == _output.size() ) [[likely]] {
+                std::ranges::copy( _payload, _output.begin() );
+
+                l_size = _payload.size();
+            }
+
+            break;
+        }
+
+        case g_lzCodec: {
+            l_size = lz( _payload, _output );
+
+            break;
+        }
+
+#if defined( HAS_SNAPPY )
+
+        case g_snappyCodec: {
+            l_size = text( std::string_view( reinterpret_cast< const char* >(
+                                                 _payload.data() ),
+                                             _payload.size() ),
+                           std::span( reinterpret_cast< char* >(
+                                          _output.data() ),
+                                      _output.size() ) );
+
+            break;
+        }
+
+#endif
+
+#if defined( HAS_ZSTD )
+
+        case g_zstdCodec: {
+            l_size = data( _payload, _output );
+
+            break;
+        }
+
+#endif
+
+        default: {
+            break;
+        }
+    }
+
+    return ( l_size == _output.size() );
+}
+
+// Splits a checked frame into its blocks without decoding them
+auto scanChecked( std::span< const std::byte > _data,
+                  size_t _maxSize,
+                  std::vector< checkedBlock >& _blocks,
+                  size_t& _size ) -> std::optional< error > {
+    std::optional< error > l_returnValue = std::nullopt;
+
+    do {
+        if ( ( _data.size() < g_checkedHeaderSize ) ||
+             ( loadLittleEndian( _data.data(), sizeof( uint32_t ) ) !=
+               g_checkedMagic ) ) [[unlikely]] {
+            l_returnValue = error::malformed;
+
+            break;
+        }
+
+        const uint64_t l_size =
+            ( static_cast< uint64_t >( loadLittleEndian(
+                  ( _data.data() + 4 ), sizeof( uint32_t ) ) ) |
+              ( static_cast< uint64_t >( loadLittleEndian(
+                    ( _data.data() + 8 ), sizeof( uint32_t ) ) )
+                << 32 ) );
+
+        if ( l_size > _maxSize ) [[unlikely]] {
+            l_returnValue = error::tooLarge;
+
+            break;
+        }
+
+        _size = static_cast< size_t >( l_size );
+
+        std::span< const std::byte > l_rest =
+            _data.subspan( g_checkedHeaderSize );
+        size_t l_offset = 0;
+
+        while ( !l_rest.empty() ) {
+            if ( l_rest.size() < g_checkedBlockHeaderSize ) [[unlikely]] {
+                l_returnValue = error::malformed;
+
+                break;
+            }
+
+            const auto l_codec = static_cast< uint8_t >( l_rest.front() );
+            const uint32_t l_payloadSize =
+                loadLittleEndian( ( l_rest.data() + 1 ), sizeof( uint32_t ) );
+            const uint32_t l_blockSize =
+                loadLittleEndian( ( l_rest.data() + 5 ), sizeof( uint32_t ) );
+            const uint32_t l_checksum =
+                loadLittleEndian( ( l_rest.data() + 9 ), sizeof( uint32_t ) );
+
+            l_rest = l_rest.subspan( g_checkedBlockHeaderSize );
+
+            if ( ( l_payloadSize > l_rest.size() ) || !l_blockSize ||
+                 ( l_blockSize > ( _size - l_offset ) ) ) [[unlikely]] {
+                l_returnValue = error::malformed;
+
+                break;
+            }
+
+            if ( !isAvailable( l_codec ) ) [[unlikely]] {
+                l_returnValue = error::unsupported;
+
+                break;
+            }
+
+            _blocks.emplace_back( checkedBlock{
+                .payload = l_rest.first( l_payloadSize ),
+                .offset = l_offset,
+                .size = l_blockSize,
+                .checksum = l_checksum,
+                .codec = l_codec,
+            } );
+
+            l_rest = l_rest.subspan( l_payloadSize );
+            l_offset += l_blockSize;
+        }
+
+        if ( !l_returnValue && ( l_offset != _size ) ) [[unlikely]] {
+            l_returnValue = error::malformed;
+        }
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+auto adaptive( std::span< const std::byte > _data, size_t _maxSize )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        if ( _data.empty() ) [[unlikely]] {
+            break;
+        }
+
+        const auto l_header = static_cast< uint8_t >( _data.front() );
+
+        if ( ( l_header & g_adaptiveMagicMask ) != g_adaptiveMagic )
+            [[unlikely]] {
+            break;
+        }
+
+        const std::span< const std::byte > l_payload = _data.subspan( 1 );
+
+        switch ( l_header & ~g_adaptiveMagicMask ) {
+            case g_storedCodec: {
+                if ( l_payload.size() <= _maxSize ) [[likely]] {
+                    l_returnValue.emplace( l_payload.begin(),
+                                           l_payload.end() );
+                }
+
+                break;
+            }
+
+            case g_lzCodec: {
+                l_returnValue = lz( l_payload, _maxSize );
+
+                break;
+            }
+
+#if defined( HAS_SNAPPY )
+
+            case g_snappyCodec: {
+                const std::string_view l_text(
+                    reinterpret_cast< const char* >( l_payload.data() ),
+                    l_payload.size() );
+
+                const std::optional< size_t > l_size = textSize( l_text );
+
+                if ( !l_size || ( *l_size > _maxSize ) ) [[unlikely]] {
+                    break;
+                }
+
+                std::vector< std::byte > l_output( *l_size );
+
+                if ( text( l_text,
+                           std::span( reinterpret_cast< char* >(
+                                          l_output.data() ),
+                                      l_output.size() ) ) ) [[likely]] {
+                    l_returnValue = std::move( l_output );
+                }
+
+                break;
+            }
+
+#endif
+
+#if defined( HAS_ZSTD )
+
+            case g_zstdCodec: {
+                l_returnValue = data( l_payload, 0, _maxSize );
+
+                break;
+            }
+
+#endif
+
+            default: {
+                break;
+            }
+        }
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto checked( std::span< const std::byte > _data,
+              size_t _workers,
+              size_t _maxSize )
+    -> std::expected< std::vector< std::byte >, error > {
+    std::vector< checkedBlock > l_blocks;
+    size_t l_size = 0;
+
+    if ( const std::optional< error > l_error =
+             scanChecked( _data, _maxSize, l_blocks, l_size ) ) [[unlikely]] {
+        return ( std::unexpected( *l_error ) );
+    }
+
+    std::vector< std::byte > l_output( l_size );
+    std::atomic< bool > l_isCorrupted = false;
+
+    thread::parallelFor(
+        l_blocks.size(),
+        [ & ]( size_t _index ) -> void {
+            const checkedBlock& l_block = l_blocks[ _index ];
+
+            if ( l_isCorrupted.load( std::memory_order_relaxed ) ) {
+                return;
+            }
+
+            const std::span< std::byte > l_plaintext =
+                std::span( l_output ).subspan( l_block.offset, l_block.size );
+
+            // Verified while the block is still hot in cache
+            if ( !decodeBlock( l_block.codec, l_block.payload,
+                               l_plaintext ) ||
+                 ( hash::crc32c( std::span< const std::byte >(
+                       l_plaintext ) ) != l_block.checksum ) ) [[unlikely]] {
+                l_isCorrupted.store( true, std::memory_order_relaxed );
+            }
+        },
+        _workers );
+
+    if ( l_isCorrupted ) [[unlikely]] {
+        return ( std::unexpected( error::corrupted ) );
+    }
+
+    return ( l_output );
+}
+
+namespace {
+
+constexpr uint8_t g_arrayMagic = 0xB0;
+constexpr uint8_t g_arrayMagicMask = 0xF0;
+// Magic and filter, element size, codec, element count and filtered size
+constexpr size_t g_arrayHeaderSize = ( 3 + ( 4 * sizeof( uint32_t ) ) );
+constexpr size_t g_shuffleBlock = 16;
+constexpr size_t g_gorillaFieldBits = 6;
+
+// Values of compress::filter
+constexpr uint8_t g_noFilter = 0;
+constexpr uint8_t g_shuffleFilter = 1;
+constexpr uint8_t g_bitShuffleFilter = 2;
+constexpr uint8_t g_deltaFilter = 3;
+constexpr uint8_t g_xorDeltaFilter = 4;
+constexpr uint8_t g_gorillaFilter = 5;
+
+struct arrayHeader {
+    uint8_t transform;
+    size_t elementSize;
+    uint8_t codec;
+    uint64_t count;
+    uint64_t filteredSize;
+    std::span< const std::byte > payload;
+};
+
+// Calls _function.template operator()< Word >() with the unsigned integer of
+// _elementSize bytes, false when there is none
+template < typename Function >
+auto withWord( size_t _elementSize, Function&& _function ) -> bool {
+    switch ( _elementSize ) {
+        case 1: {
+            _function.template operator()< uint8_t >();
+
+            return ( true );
+        }
+
+        case 2: {
+            _function.template operator()< uint16_t >();
+
+            return ( true );
+        }
+
+        case 4: {
+            _function.template operator()< uint32_t >();
+
+            return ( true );
+        }
+
+        case 8: {
+            _function.template operator()< uint64_t >();
+
+            return ( true );
+        }
+
+#if defined( __x86_64__ )
+
+        case 16: {
+            _function.template operator()< uint128_t >();
+
+            return ( true );
+        }
+
+#endif
+
+        default: {
+            return ( false );
+        }
+    }
+}
+
+auto readArrayHeader( std::span< const std::byte > _data )
+    -> std::optional< arrayHeader > {
+    std::optional< arrayHeader > l_returnValue = std::nullopt;
+
+    do {
+        if ( _data.size() < g_arrayHeaderSize ) [[unlikely]] {
+            break;
+        }
+
+        const auto l_magic = static_cast< uint8_t >( _data[ 0 ] );
+        const arrayHeader l_header{
+            .transform =
+                static_cast< uint8_t >( l_magic & ~g_arrayMagicMask ),
+            .elementSize = static_cast< uint8_t >( _data[ 1 ] ),
+            .codec = static_cast< uint8_t >( _data[ 2 ] ),
+            .count = ( loadLittleEndian( ( _data.data() + 3 ), 4 ) |
+                       ( static_cast< uint64_t >(
+                             loadLittleEndian( ( _data.data() + 7 ), 4 ) )
+                         << 32 ) ),
+            .filteredSize =
+                ( loadLittleEndian( ( _data.data() + 11 ), 4 ) |
+                  ( static_cast< uint64_t >(
+                        loadLittleEndian( ( _data.data() + 15 ), 4 ) )
+                    << 32 ) ),
+            .payload = _data.subspan( g_arrayHeaderSize ),
+        };
+
+        if ( ( ( l_magic & g_arrayMagicMask ) != g_arrayMagic ) ||
+             ( l_header.transform > g_gorillaFilter ) ||
+             !withWord( l_header.elementSize, []< typename >() -> void {} ) )
+            [[unlikely]] {
+            break;
+        }
+
+        if ( ( l_header.transform == g_gorillaFilter ) &&
+             ( l_header.elementSize != sizeof( uint32_t ) ) &&
+             ( l_header.elementSize != sizeof( uint64_t ) ) ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = l_header;
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+#if defined( __SSE2__ )
+
+// Interleaves 16 elements back from Size byte plane vectors, the inverse of
+// the even and odd byte splits of compress::array
+template < size_t Size >
+auto unshuffleVectors( const std::byte* _input, std::byte* _output,
+                       size_t _count ) -> size_t {
+    const size_t l_blockCount = ( _count / g_shuffleBlock );
+
+    for ( size_t l_block = 0; l_block < l_blockCount; l_block++ ) {
+        __m128i l_vectors[ Size ];
+
+        for ( size_t l_plane = 0; l_plane < Size; l_plane++ ) {
+            l_vectors[ l_plane ] =
+                _mm_loadu_si128( reinterpret_cast< const __m128i* >(
+                    _input + ( l_plane * _count ) +
+                    ( l_block * g_shuffleBlock ) ) );
+        }
+
+        for ( size_t l_width = 1; l_width < Size; l_width *= 2 ) {
+            __m128i l_merged[ Size ];
+
+            for ( size_t l_pair = 0; l_pair < ( Size / 2 ); l_pair++ ) {
+                const __m128i l_even = l_vectors[ l_pair ];
+                const __m128i l_odd = l_vectors[ l_pair + ( Size / 2 ) ];
+
+                l_merged[ l_pair * 2 ] = _mm_unpacklo_epi8( l_even, l_odd );
+                l_merged[ ( l_pair * 2 ) + 1 ] =
+                    _mm_unpackhi_epi8( l_even, l_odd );
+            }
+
+            std::ranges::copy( l_merged, l_vectors );
+        }
+
+        for ( size_t l_index = 0; l_index < Size; l_index++ ) {
+            _mm_storeu_si128(
+                reinterpret_cast< __m128i* >(
+                    _output +
+                    ( ( ( l_block * Size ) + l_index ) * g_shuffleBlock ) ),
+                l_vectors[ l_index ] );
+        }
+    }
+
+    return ( l_blockCount * g_shuffleBlock );
+}
+
+#endif
+
+// Gathers byte b of element i from _input[ b * count + i ]
+void unshuffle( std::span< const std::byte > _planes,
+                size_t _elementSize,
+                std::byte* _output ) {
+    const size_t l_count = ( _planes.size() / _elementSize );
+    size_t l_element = 0;
+
+#if defined( __SSE2__ )
+
+    switch ( _elementSize ) {
+        case 2: {
+            l_element =
+                unshuffleVectors< 2 >( _planes.data(), _output, l_count );
+
+            break;
+        }
+
+        case 4: {
+            l_element =
+                unshuffleVectors< 4 >( _planes.data(), _output, l_count );
+
+            break;
+        }
+
+        case 8: {
+            l_element =
+                unshuffleVectors< 8 >( _planes.data(), _output, l_count );
+
+            break;
+        }
+
+        case 16: {
+            l_element =
+                unshuffleVectors< 16 >( _planes.data(), _output, l_count );
+
+            break;
+        }
+
+        default: {
+            break;
+        }
+    }
+
+#endif
+
+    for ( ; l_element < l_count; l_element++ ) {
+        for ( size_t l_byte = 0; l_byte < _elementSize; l_byte++ ) {
+            _output[ ( l_element * _elementSize ) + l_byte ] =
+                _planes[ ( l_byte * l_count ) + l_element ];
+        }
+    }
+}
+
+// Joins the 8 bit planes of the first multiple of 8 bytes back into _plane
+void bitUnshuffle( std::span< const std::byte > _bits, std::byte* _plane ) {
+    const size_t l_groupCount = ( _bits.size() / 8 );
+    size_t l_group = 0;
+
+#if defined( __SSE2__ )
+
+    // Bit i of every byte
+    const __m128i l_select = _mm_setr_epi8( 1, 2, 4, 8, 16, 32, 64, -128, 1,
+                                            2, 4, 8, 16, 32, 64, -128 );
+
+    for ( ; ( l_group + 2 ) <= l_groupCount; l_group += 2 ) {
+        __m128i l_bytes = _mm_setzero_si128();
+
+        for ( size_t l_bit = 0; l_bit < 8; l_bit++ ) {
+            const std::byte* l_mask =
+                ( _bits.data() + ( l_bit * l_groupCount ) + l_group );
+
+            // Byte i holds the mask byte covering it
+            const __m128i l_spread = _mm_unpacklo_epi64(
+                _mm_set1_epi8( static_cast< char >( l_mask[ 0 ] ) ),
+                _mm_set1_epi8( static_cast< char >( l_mask[ 1 ] ) ) );
+            const __m128i l_isSet = _mm_cmpeq_epi8(
+                _mm_and_si128( l_spread, l_select ), l_select );
+
+            l_bytes = _mm_or_si128(
+                l_bytes,
+                _mm_and_si128( l_isSet, _mm_set1_epi8( static_cast< char >(
+                                            1 << l_bit ) ) ) );
+        }
+
+        _mm_storeu_si128(
+            reinterpret_cast< __m128i* >( _plane + ( l_group * 8 ) ),
+            l_bytes );
+    }
+
+#endif
+
+    for ( ; l_group < l_groupCount; l_group++ ) {
+        for ( size_t l_index = 0; l_index < 8; l_index++ ) {
+            uint8_t l_byte = 0;
+
+            for ( size_t l_bit = 0; l_bit < 8; l_bit++ ) {
+                l_byte |= static_cast< uint8_t >(
+                    ( ( static_cast< uint8_t >(
+                            _bits[ ( l_bit * l_groupCount ) + l_group ] ) >>
+                        l_index ) &
+                      1 )
+                    << l_bit );
+            }
+
+            _plane[ ( l_group * 8 ) + l_index ] = std::byte{ l_byte };
+        }
+    }
+
+    std::copy(
+        ( _bits.begin() + static_cast< ptrdiff_t >( l_groupCount * 8 ) ),
+        _bits.end(), ( _plane + ( l_groupCount * 8 ) ) );
+}
+
+// Running sum, or with _isXor running XOR, of the elements in place
+void deltaDecode( std::span< std::byte > _data,
+                  size_t _elementSize,
+                  bool _isXor ) {
+    withWord( _elementSize, [ & ]< typename Word >() -> void {
+        Word l_previous = 0;
+
+        for ( size_t l_offset = 0; l_offset < _data.size();
+              l_offset += sizeof( Word ) ) {
+            Word l_value;
+
+            std::memcpy( &l_value, ( _data.data() + l_offset ),
+                         sizeof( l_value ) );
+
+            l_value = static_cast< Word >( _isXor ? ( l_value ^ l_previous )
+                                                  : ( l_value + l_previous ) );
+
+            std::memcpy( ( _data.data() + l_offset ), &l_value,
+                         sizeof( l_value ) );
+
+            l_previous = l_value;
+        }
+    } );
+}
+
+// Little endian bit stream, least significant bit first
+struct bitReader {
+    std::span< const std::byte > input;
+    uint64_t bits = 0;
+    size_t count = 0;
+
+    auto read( size_t _count ) -> std::optional< uint64_t > {
+        if ( _count > 32 ) {
+            const std::optional< uint64_t > l_low = read( 32 );
+            const std::optional< uint64_t > l_high =
+                ( l_low ? read( _count - 32 ) : std::nullopt );
+
+            return ( l_high ? std::optional( *l_low | ( *l_high << 32 ) )
+                            : std::nullopt );
+        }
+
+        for ( ; ( count < _count ) && !input.empty(); count += 8 ) {
+            bits |= ( static_cast< uint64_t >( input.front() ) << count );
+            input = input.subspan( 1 );
+        }
+
+        if ( count < _count ) [[unlikely]] {
+            return ( std::nullopt );
+        }
+
+        const uint64_t l_returnValue =
+            ( bits & ( ( uint64_t{ 1 } << _count ) - 1 ) );
+
+        bits >>= _count;
+        count -= _count;
+
+        return ( l_returnValue );
+    }
+};
+
+// Inverse of the Gorilla encoding of compress::array, true when _bits fills
+// exactly all of _output
+auto gorillaDecode( std::span< const std::byte > _bits,
+                    size_t _elementSize,
+                    std::span< std::byte > _output ) -> bool {
+    const size_t l_bits = ( _elementSize * 8 );
+
+    bitReader l_reader{ _bits };
+    uint64_t l_previous = 0;
+    size_t l_leading = 0;
+    size_t l_trailing = 0;
+    bool l_hasWindow = false;
+
+    for ( size_t l_offset = 0; l_offset < _output.size();
+          l_offset += _elementSize ) {
+        std::optional< uint64_t > l_value = std::nullopt;
+
+        if ( !l_offset ) {
+            l_value = l_reader.read( l_bits );
+        } else if ( const std::optional< uint64_t > l_isChanged =
+                        l_reader.read( 1 );
+                    !l_isChanged || !*l_isChanged ) {
+            l_value = ( l_isChanged ? std::optional( l_previous )
+                                    : std::nullopt );
+        } else {
+            const std::optional< uint64_t > l_isNewWindow = l_reader.read( 1 );
+
+            if ( !l_isNewWindow ) [[unlikely]] {
+                return ( false );
+            }
+
+            if ( *l_isNewWindow ) {
+                const std::optional< uint64_t > l_newLeading =
+                    l_reader.read( g_gorillaFieldBits );
+                const std::optional< uint64_t > l_meaningful =
+                    l_reader.read( g_gorillaFieldBits );
+
+                if ( !l_newLeading || !l_meaningful ||
+                     ( ( *l_newLeading + *l_meaningful + 1 ) > l_bits ) )
+                    [[unlikely]] {
+                    return ( false );
+                }
+
+                l_leading = *l_newLeading;
+                l_trailing = ( l_bits - l_leading - *l_meaningful - 1 );
+                l_hasWindow = true;
+            }
+
+            if ( !l_hasWindow ) [[unlikely]] {
+                return ( false );
+            }
+
+            const std::optional< uint64_t > l_xor =
+                l_reader.read( l_bits - l_leading - l_trailing );
+
+            if ( l_xor ) [[likely]] {
+                l_value = ( l_previous ^ ( *l_xor << l_trailing ) );
+            }
+        }
+
+        if ( !l_value ) [[unlikely]] {
+            return ( false );
+        }
+
+        if ( _elementSize == sizeof( uint64_t ) ) {
+            std::memcpy( ( _output.data() + l_offset ), &*l_value,
+                         sizeof( uint64_t ) );
+        } else {
+            const auto l_word = static_cast< uint32_t >( *l_value );
+
+            std::memcpy( ( _output.data() + l_offset ), &l_word,
+                         sizeof( l_word ) );
+        }
+
+        l_previous = *l_value;
+    }
+
+    return ( l_reader.input.empty() );
+}
+
+} // namespace
+
+auto arraySize( std::span< const std::byte > _data )
+    -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    if ( const std::optional< arrayHeader > l_header =
+             readArrayHeader( _data ) ) [[likely]] {
+        if ( l_header->count <= std::numeric_limits< size_t >::max() ) {
+            l_returnValue = static_cast< size_t >( l_header->count );
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+auto array( std::span< const std::byte > _data,
+            std::span< std::byte > _buffer,
+            size_t _elementSize ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        const std::optional< arrayHeader > l_header = readArrayHeader( _data );
+
+        if ( !l_header || ( l_header->elementSize != _elementSize ) ||
+             !isAvailable( l_header->codec ) ) [[unlikely]] {
+            break;
+        }
+
+        if ( l_header->count > ( _buffer.size() / _elementSize ) )
+            [[unlikely]] {
+            break;
+        }
+
+        const auto l_count = static_cast< size_t >( l_header->count );
+        const size_t l_size = ( l_count * _elementSize );
+        const std::span< std::byte > l_output = _buffer.first( l_size );
+
+        // Gorilla spends at most both control bits and both fields per value
+        const size_t l_filteredLimit =
+            ( ( l_header->transform == g_gorillaFilter )
+                  ? ( ( ( l_count * ( ( _elementSize * 8 ) + 2 +
+                                      ( 2 * g_gorillaFieldBits ) ) ) +
+                        7 ) /
+                      8 )
+                  : l_size );
+
+        if ( ( l_header->transform == g_gorillaFilter )
+                 ? ( l_header->filteredSize > l_filteredLimit )
+                 : ( l_header->filteredSize != l_size ) ) [[unlikely]] {
+            break;
+        }
+
+        if ( l_header->transform == g_noFilter ) {
+            if ( decodeBlock( l_header->codec, l_header->payload,
+                              l_output ) ) [[likely]] {
+                l_returnValue = l_size;
+            }
+
+            break;
+        }
+
+        // Stored filtered bytes are read in place
+        std::vector< std::byte > l_decoded;
+        std::span< const std::byte > l_filtered = l_header->payload;
+
+        if ( l_header->codec != g_storedCodec ) {
+            l_decoded.resize(
+                static_cast< size_t >( l_header->filteredSize ) );
+
+            if ( !decodeBlock( l_header->codec, l_header->payload,
+                               l_decoded ) ) [[unlikely]] {
+                break;
+            }
+
+            l_filtered = l_decoded;
+        }
+
+        if ( l_filtered.size() != l_header->filteredSize ) [[unlikely]] {
+            break;
+        }
+
+        switch ( l_header->transform ) {
+            case g_shuffleFilter: {
+                unshuffle( l_filtered, _elementSize, l_output.data() );
+
+                l_returnValue = l_size;
+
+                break;
+            }
+
+            case g_bitShuffleFilter: {
+                std::vector< std::byte > l_planes( l_size );
+
+                for ( size_t l_offset = 0; l_offset < l_size;
+                      l_offset += l_count ) {
+                    bitUnshuffle( l_filtered.subspan( l_offset, l_count ),
+                                  ( l_planes.data() + l_offset ) );
+                }
+
+                unshuffle( l_planes, _elementSize, l_output.data() );
+
+                l_returnValue = l_size;
+
+                break;
+            }
+
+            case g_deltaFilter:
+            case g_xorDeltaFilter: {
+                unshuffle( l_filtered, _elementSize, l_output.data() );
+                deltaDecode( l_output, _elementSize,
+                             ( l_header->transform == g_xorDeltaFilter ) );
+
+                l_returnValue = l_size;
+
+                break;
+            }
+
+            case g_gorillaFilter: {
+                if ( gorillaDecode( l_filtered, _elementSize, l_output ) )
+                    [[likely]] {
+                    l_returnValue = l_size;
+                }
+
+                break;
+            }
+
+            default: {
+                break;
+            }
+        }
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+namespace {
+
+constexpr size_t g_packedBlockSize = 128;
+constexpr size_t g_packedHeaderSize = ( 1 + sizeof( uint32_t ) );
+// 32 bit lanes per 128 bit vector, and the integers each lane packs
+constexpr size_t g_packedLanes = 4;
+constexpr size_t g_packedLaneSize = ( g_packedBlockSize / g_packedLanes );
+
+using unpackBlockFunction = void ( * )( const std::byte*,
+                                        uint32_t,
+                                        uint32_t* );
+
+// Inverse of the interleaved lane packing of full compress::packed blocks
+template < size_t Bits >
+void unpackBlock( const std::byte* _input, uint32_t _base, uint32_t* _values ) {
+#if defined( __SSE2__ )
+
+    const __m128i l_base = _mm_set1_epi32( static_cast< int >( _base ) );
+
+    if constexpr ( !Bits ) {
+        for ( size_t l_index = 0; l_index < g_packedBlockSize;
+              l_index += g_packedLanes ) {
+            _mm_storeu_si128(
+                reinterpret_cast< __m128i* >( _values + l_index ), l_base );
+        }
+    } else {
+        const __m128i l_mask = _mm_set1_epi32(
+            static_cast< int >( ( uint64_t{ 1 } << Bits ) - 1 ) );
+        __m128i l_word =
+            _mm_loadu_si128( reinterpret_cast< const __m128i* >( _input ) );
+
+        auto l_step = [ & ]( auto _index ) -> void {
+            constexpr size_t l_index = decltype( _index )::value;
+            constexpr size_t l_offset = ( l_index * Bits );
+            constexpr size_t l_shift = ( l_offset % 32 );
+            const std::byte* l_next =
+                ( _input + ( ( ( l_offset / 32 ) + 1 ) * 16 ) );
+
+            __m128i l_value = _mm_srli_epi32( l_word, l_shift );
+
+            if constexpr ( ( l_shift + Bits ) > 32 ) {
+                l_word = _mm_loadu_si128(
+                    reinterpret_cast< const __m128i* >( l_next ) );
+                l_value = _mm_or_si128(
+                    l_value, _mm_slli_epi32( l_word, ( 32 - l_shift ) ) );
+            } else if constexpr ( ( ( l_shift + Bits ) == 32 ) &&
+                                  ( ( l_index + 1 ) < g_packedLaneSize ) ) {
+                l_word = _mm_loadu_si128(
+                    reinterpret_cast< const __m128i* >( l_next ) );
+            }
+
+            if constexpr ( Bits < 32 ) {
+                l_value = _mm_and_si128( l_value, l_mask );
+            }
+
+            _mm_storeu_si128( reinterpret_cast< __m128i* >(
+                                  _values + ( l_index * g_packedLanes ) ),
+                              _mm_add_epi32( l_value, l_base ) );
+        };
+
+        [ & ]< size_t... Index >( std::index_sequence< Index... > ) -> void {
+            ( l_step( std::integral_constant< size_t, Index >{} ), ... );
+        }( std::make_index_sequence< g_packedLaneSize >{} );
+    }
+
+#else
+
+    for ( size_t l_lane = 0; l_lane < g_packedLanes; l_lane++ ) {
+        uint64_t l_bits = 0;
+        size_t l_count = 0;
+        size_t l_word = 0;
+
+        for ( size_t l_index = 0; l_index < g_packedLaneSize; l_index++ ) {
+            if ( l_count < Bits ) {
+                l_bits |= ( static_cast< uint64_t >( loadLittleEndian(
+                                _input + ( ( ( l_word++ * g_packedLanes ) +
+                                             l_lane ) *
+                                           sizeof( uint32_t ) ),
+                                sizeof( uint32_t ) ) )
+                            << l_count );
+                l_count += 32;
+            }
+
+            _values[ ( l_index * g_packedLanes ) + l_lane ] =
+                ( _base + static_cast< uint32_t >(
+                              l_bits & ( ( uint64_t{ 1 } << Bits ) - 1 ) ) );
+
+            l_bits >>= Bits;
+            l_count -= Bits;
+        }
+    }
+
+#endif
+}
+
+constexpr auto g_unpackBlocks =
+    []< size_t... Bits >( std::index_sequence< Bits... > )
+    -> std::array< unpackBlockFunction, sizeof...( Bits ) > {
+    return ( std::array< unpackBlockFunction, sizeof...( Bits ) >{
+        &unpackBlock< Bits >... } );
+}( std::make_index_sequence< 33 >{} );
+
+// Byte lengths of the four integers of a Stream VByte control byte
+constexpr auto g_streamVByteLengths = []() -> std::array< uint8_t, 256 > {
+    std::array< uint8_t, 256 > l_returnValue{};
+
+    for ( size_t l_control = 0; l_control < l_returnValue.size();
+          l_control++ ) {
+        for ( size_t l_index = 0; l_index < 4; l_index++ ) {
+            l_returnValue[ l_control ] += static_cast< uint8_t >(
+                ( ( l_control >> ( l_index * 2 ) ) & 3 ) + 1 );
+        }
+    }
+
+    return ( l_returnValue );
+}();
+
+#if defined( __SSSE3__ )
+
+// Spreads the data bytes of a control byte over four 32 bit lanes, 0x80
+// clears the bytes past each length
+constexpr auto g_streamVByteShuffles =
+    []() -> std::array< std::array< uint8_t, 16 >, 256 > {
+    std::array< std::array< uint8_t, 16 >, 256 > l_returnValue{};
+
+    for ( size_t l_control = 0; l_control < l_returnValue.size();
+          l_control++ ) {
+        uint8_t l_source = 0;
+
+        for ( size_t l_index = 0; l_index < 4; l_index++ ) {
+            const size_t l_length =
+                ( ( ( l_control >> ( l_index * 2 ) ) & 3 ) + 1 );
+
+            for ( size_t l_byte = 0; l_byte < 4; l_byte++ ) {
+                l_returnValue[ l_control ][ ( l_index * 4 ) + l_byte ] =
+                    ( ( l_byte < l_length ) ? l_source++ : 0x80 );
+            }
+        }
+    }
+
+    return ( l_returnValue );
+}();
+
+#endif
+
+} // namespace
+
+void delta( std::span< uint32_t > _values, uint32_t _previous ) {
+    size_t l_index = 0;
+
+#if defined( __SSE2__ )
+
+    __m128i l_previous = _mm_set1_epi32( static_cast< int >( _previous ) );
+
+    for ( ; ( l_index + 4 ) <= _values.size(); l_index += 4 ) {
+        auto* l_address = reinterpret_cast< __m128i* >( &_values[ l_index ] );
+        __m128i l_sums = _mm_loadu_si128( l_address );
+
+        // Prefix sum within the vector in two shifted adds
+        l_sums = _mm_add_epi32( l_sums, _mm_slli_si128( l_sums, 4 ) );
+        l_sums = _mm_add_epi32( l_sums, _mm_slli_si128( l_sums, 8 ) );
+        l_sums = _mm_add_epi32( l_sums, l_previous );
+
+        _mm_storeu_si128( l_address, l_sums );
+
+        l_previous = _mm_shuffle_epi32( l_sums, 0xFF );
+    }
+
+    _previous = static_cast< uint32_t >( _mm_cvtsi128_si32( l_previous ) );
+
+#endif
+
+    for ( ; l_index < _values.size(); l_index++ ) {
+        _previous += _values[ l_index ];
+        _values[ l_index ] = _previous;
+    }
+}
+
+auto packed( std::span< const std::byte > _data,
+             std::span< uint32_t > _values ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        std::span< const std::byte > l_input = _data;
+        size_t l_bits = 0;
+        uint32_t l_base = 0;
+
+        // Consumes a block header and checks its payload is there
+        const auto l_readHeader = [ & ]( size_t _count ) -> bool {
+            if ( l_input.size() < g_packedHeaderSize ) [[unlikely]] {
+                return ( false );
+            }
+
+            l_bits = static_cast< uint8_t >( l_input.front() );
+            l_base = loadLittleEndian( ( l_input.data() + 1 ),
+                                       sizeof( uint32_t ) );
+            l_input = l_input.subspan( g_packedHeaderSize );
+
+            return ( ( l_bits <= 32 ) &&
+                     ( bitsToBytes( _count * l_bits ) <= l_input.size() ) );
+        };
+
+        size_t l_offset = 0;
+        bool l_isValid = true;
+
+        for ( ; ( l_offset + g_packedBlockSize ) <= _values.size();
+              l_offset += g_packedBlockSize ) {
+            if ( !l_readHeader( g_packedBlockSize ) ) [[unlikely]] {
+                l_isValid = false;
+
+                break;
+            }
+
+            g_unpackBlocks[ l_bits ]( l_input.data(), l_base,
+                                      ( _values.data() + l_offset ) );
+
+            l_input =
+                l_input.subspan( bitsToBytes( g_packedBlockSize * l_bits ) );
+        }
+
+        if ( !l_isValid ) [[unlikely]] {
+            break;
+        }
+
+        if ( l_offset < _values.size() ) {
+            const size_t l_count = ( _values.size() - l_offset );
+
+            if ( !l_readHeader( l_count ) ) [[unlikely]] {
+                break;
+            }
+
+            const uint64_t l_mask = ( ( uint64_t{ 1 } << l_bits ) - 1 );
+            uint64_t l_pending = 0;
+            size_t l_pendingBits = 0;
+
+            for ( uint32_t& _value : _values.subspan( l_offset ) ) {
+                for ( ; l_pendingBits < l_bits; l_pendingBits += 8 ) {
+                    l_pending |=
+                        ( static_cast< uint64_t >( l_input.front() )
+                          << l_pendingBits );
+                    l_input = l_input.subspan( 1 );
+                }
+
+                _value = ( l_base + static_cast< uint32_t >( l_pending &
+                                                             l_mask ) );
+
+                l_pending >>= l_bits;
+                l_pendingBits -= l_bits;
+            }
+        }
+
+        l_returnValue = ( _data.size() - l_input.size() );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto streamVByte( std::span< const std::byte > _data,
+                  std::span< uint32_t > _values ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    do {
+        const size_t l_controlSize = bitsToBytes( _values.size() * 2 );
+
+        if ( _data.size() < l_controlSize ) [[unlikely]] {
+            break;
+        }
+
+        const std::byte* l_control = _data.data();
+        const std::byte* l_input = ( l_control + l_controlSize );
+        const std::byte* l_end = ( _data.data() + _data.size() );
+        size_t l_index = 0;
+
+#if defined( __SSSE3__ )
+
+        // Whole vector loads stay inside _data
+        for ( ; ( ( l_index + 4 ) <= _values.size() ) &&
+                ( ( l_end - l_input ) >= 16 );
+              l_index += 4 ) {
+            const auto l_byte =
+                static_cast< uint8_t >( l_control[ l_index / 4 ] );
+
+            _mm_storeu_si128(
+                reinterpret_cast< __m128i* >( &_values[ l_index ] ),
+                _mm_shuffle_epi8(
+                    _mm_loadu_si128(
+                        reinterpret_cast< const __m128i* >( l_input ) ),
+                    _mm_loadu_si128( reinterpret_cast< const __m128i* >(
+                        g_streamVByteShuffles[ l_byte ].data() ) ) ) );
+
+            l_input += g_streamVByteLengths[ l_byte ];
+        }
+
+#endif
+
+        bool l_isValid = true;
+
+        for ( ; l_index < _values.size(); l_index++ ) {
+            const size_t l_length =
+                ( ( ( static_cast< uint8_t >( l_control[ l_index / 4 ] ) >>
+                      ( ( l_index % 4 ) * 2 ) ) &
+                    3 ) +
+                  1 );
+
+            if ( static_cast< size_t >( l_end - l_input ) < l_length )
+                [[unlikely]] {
+                l_isValid = false;
+
+                break;
+            }
+
+            _values[ l_index ] = loadLittleEndian( l_input, l_length );
+            l_input += l_length;
+        }
+
+        if ( !l_isValid ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = static_cast< size_t >( l_input - _data.data() );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+namespace {
+
+constexpr size_t g_huffmanStreams = 4;
+// Symbols per refill of a stream's bits, 4 codes of at most 11 bits fit the
+// 56 bits a refill guarantees
+constexpr size_t g_huffmanSymbolsPerRefill = 4;
+
+// 8 bytes of _data from _offset on as a little endian word, zeros past its
+// end
+auto loadBits( std::span< const std::byte > _data, size_t _offset )
+    -> uint64_t {
+    uint64_t l_returnValue = 0;
+
+    if ( ( _offset + sizeof( l_returnValue ) ) <= _data.size() ) [[likely]] {
+        std::memcpy( &l_returnValue, ( _data.data() + _offset ),
+                     sizeof( l_returnValue ) );
+
+        if constexpr ( std::endian::native == std::endian::big ) {
+            l_returnValue = std::byteswap( l_returnValue );
+        }
+
+    } else {
+        for ( size_t l_byte = 0; ( _offset + l_byte ) < _data.size();
+              l_byte++ ) {
+            l_returnValue |=
+                ( static_cast< uint64_t >( _data[ _offset + l_byte ] )
+                  << ( l_byte * 8 ) );
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+// Reads a tANS stream from its end towards its start. Bits are read from a
+// word loaded by refill(), which has to come at least every 56 bits
+struct backwardBitReader {
+    std::span< const std::byte > data;
+    // Bits left, counted from the start of data
+    size_t position;
+    // First bit of data in container
+    size_t base = 0;
+    uint64_t container = 0;
+    bool isValid = true;
+
+    void refill() {
+        base = ( ( position > 56 ) ? ( ( position - 56 ) & ~size_t{ 7 } ) : 0 );
+        container = loadBits( data, ( base / 8 ) );
+    }
+
+    auto read( size_t _count ) -> uint32_t {
+        uint32_t l_returnValue = 0;
+
+        if ( _count <= position ) [[likely]] {
+            position -= _count;
+
+            l_returnValue = static_cast< uint32_t >(
+                ( container >> ( position - base ) ) &
+                ( ( uint64_t{ 1 } << _count ) - 1 ) );
+
+        } else {
+            isValid = false;
+        }
+
+        return ( l_returnValue );
+    }
+};
+
+// Inverse of the compress side: the distribution in front of the coded
+// output, empty input for empty output
+template < typename Decode >
+auto selfDescribed( std::span< const std::byte > _data,
+                    size_t _maxSize,
+                    Decode&& _decode )
+    -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        if ( _data.empty() ) {
+            l_returnValue.emplace();
+
+            break;
+        }
+
+        const std::optional< entropy::distribution > l_distribution =
+            entropy::deserialize( _data );
+
+        if ( !l_distribution ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue =
+            _decode( _data, entropyTable( *l_distribution ), _maxSize );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+entropyTable::entropyTable( const entropy::distribution& _distribution ) {
+    if ( !entropy::isValid( _distribution ) ) [[unlikely]] {
+        return;
+    }
+
+    const size_t l_tableLog = _distribution.tableLog;
+    const size_t l_states = ( size_t{ 1 } << l_tableLog );
+
+    _tableLog = l_tableLog;
+
+    // The k-th spread state of a symbol with frequency f decodes from
+    // f + k, normalized back into [ states, 2 * states ) by the bits read
+    const std::vector< uint8_t > l_spread = entropy::spread( _distribution );
+    std::array< size_t, 256 > l_next{};
+
+    std::ranges::copy( _distribution.frequencies, l_next.begin() );
+
+    _ans.resize( l_states );
+
+    for ( size_t l_state = 0; l_state < l_states; l_state++ ) {
+        const uint8_t l_symbol = l_spread[ l_state ];
+        const size_t l_value = l_next[ l_symbol ]++;
+        const size_t l_bits =
+            ( l_tableLog - ( std::bit_width( l_value ) - 1 ) );
+
+        _ans[ l_state ] = {
+            .newState =
+                static_cast< uint16_t >( ( l_value << l_bits ) - l_states ),
+            .symbol = l_symbol,
+            .bits = static_cast< uint8_t >( l_bits ) };
+    }
+
+    const std::array< uint8_t, 256 > l_lengths =
+        entropy::codeLengths( _distribution );
+    const std::array< uint16_t, 256 > l_codes =
+        entropy::canonicalCodes( l_lengths );
+
+    _huffmanLog = *std::ranges::max_element( l_lengths );
+    _huffman.resize( size_t{ 1 } << _huffmanLog );
+
+    // Every index whose low bits are a code decodes to its symbol. Huffman
+    // codes are complete, except the 1 bit code of a lone symbol which then
+    // takes either bit, so no entry is left unused
+    const bool l_isLone =
+        ( static_cast< size_t >( std::ranges::count( l_lengths, 0 ) ) ==
+          ( l_lengths.size() - 1 ) );
+
+    for ( size_t l_symbol = 0; l_symbol < l_lengths.size(); l_symbol++ ) {
+        const size_t l_length = l_lengths[ l_symbol ];
+
+        if ( !l_length ) {
+            continue;
+        }
+
+        const size_t l_step = ( l_isLone ? 1 : ( size_t{ 1 } << l_length ) );
+
+        for ( size_t l_index = l_codes[ l_symbol ]; l_index < _huffman.size();
+              l_index += l_step ) {
+            _huffman[ l_index ] = {
+                .symbol = static_cast< uint8_t >( l_symbol ),
+                .length = static_cast< uint8_t >( l_length ) };
+        }
+    }
+}
+
+auto entropyTable::tableLog() const -> size_t {
+    return ( _tableLog );
+}
+
+auto ans( std::span< const std::byte > _data,
+          const entropyTable& _table,
+          size_t _maxSize ) -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_table._tableLog ) [[unlikely]] {
+            break;
+        }
+
+        const std::optional< size_t > l_size = readSizePrefix( _data );
+
+        if ( !l_size || ( *l_size > _maxSize ) ) [[unlikely]] {
+            break;
+        }
+
+        if ( !*l_size ) {
+            if ( _data.empty() ) [[likely]] {
+                l_returnValue.emplace();
+            }
+
+            break;
+        }
+
+        // The highest set bit of the last byte marks the end of the stream
+        if ( _data.empty() || ( _data.back() == std::byte{ 0 } ) )
+            [[unlikely]] {
+            break;
+        }
+
+        backwardBitReader l_reader{
+            .data = _data,
+            .position =
+                ( ( ( _data.size() - 1 ) * 8 ) +
+                  ( std::bit_width( static_cast< uint8_t >( _data.back() ) ) -
+                    1 ) ) };
+
+        const size_t l_tableLog = _table._tableLog;
+        const entropyTable::ansEntry* const l_table = _table._ans.data();
+
+        std::array< size_t, 2 > l_state{};
+
+        l_reader.refill();
+
+        l_state[ 0 ] = l_reader.read( l_tableLog );
+        l_state[ 1 ] = l_reader.read( l_tableLog );
+
+        std::vector< std::byte > l_output( *l_size );
+
+        const auto l_step = [ & ]( size_t _stream ) -> std::byte {
+            const entropyTable::ansEntry l_entry =
+                l_table[ l_state[ _stream ] ];
+
+            l_state[ _stream ] =
+                ( l_entry.newState + l_reader.read( l_entry.bits ) );
+
+            return ( std::byte{ l_entry.symbol } );
+        };
+
+        std::byte* const l_destination = l_output.data();
+        size_t l_index = 0;
+
+        // 4 symbols of at most 12 bits per refill
+        for ( ; ( l_index + 4 ) <= l_output.size(); l_index += 4 ) {
+            l_reader.refill();
+
+            l_destination[ l_index ] = l_step( 0 );
+            l_destination[ l_index + 1 ] = l_step( 1 );
+            l_destination[ l_index + 2 ] = l_step( 0 );
+            l_destination[ l_index + 3 ] = l_step( 1 );
+        }
+
+        l_reader.refill();
+
+        for ( ; l_index < l_output.size(); l_index++ ) {
+            l_destination[ l_index ] = l_step( l_index & 1 );
+        }
+
+        // Both states back where the encoder started, every bit used
+        if ( !l_reader.isValid || l_reader.position || l_state[ 0 ] ||
+             l_state[ 1 ] ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = std::move( l_output );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto ans( std::span< const std::byte > _data, size_t _maxSize )
+    -> std::optional< std::vector< std::byte > > {
+    return ( selfDescribed(
+        _data, _maxSize,
+        []( std::span< const std::byte > _input, const entropyTable& _table,
+            size_t _limit ) -> std::optional< std::vector< std::byte > > {
+            return ( ans( _input, _table, _limit ) );
+        } ) );
+}
+
+auto huffman( std::span< const std::byte > _data,
+              const entropyTable& _table,
+              size_t _maxSize ) -> std::optional< std::vector< std::byte > > {
+    std::optional< std::vector< std::byte > > l_returnValue = std::nullopt;
+
+    do {
+        if ( !_table._tableLog ) [[unlikely]] {
+            break;
+        }
+
+        const std::optional< size_t > l_size = readSizePrefix( _data );
+
+        if ( !l_size || ( *l_size > _maxSize ) ) [[unlikely]] {
+            break;
+        }
+
+        if ( !*l_size ) {
+            if ( _data.empty() ) [[likely]] {
+                l_returnValue.emplace();
+            }
+
+            break;
+        }
+
+        constexpr size_t l_sizesSize =
+            ( ( g_huffmanStreams - 1 ) * sizeof( uint32_t ) );
+
+        if ( _data.size() < l_sizesSize ) [[unlikely]] {
+            break;
+        }
+
+        std::array< std::span< const std::byte >, g_huffmanStreams >
+            l_streams{};
+        std::span< const std::byte > l_rest = _data.subspan( l_sizesSize );
+        bool l_isValid = true;
+
+        for ( size_t l_stream = 0; l_stream < ( g_huffmanStreams - 1 );
+              l_stream++ ) {
+            const size_t l_streamSize = loadLittleEndian(
+                ( _data.data() + ( l_stream * sizeof( uint32_t ) ) ),
+                sizeof( uint32_t ) );
+
+            if ( l_streamSize > l_rest.size() ) [[unlikely]] {
+                l_isValid = false;
+
+                break;
+            }
+
+            l_streams[ l_stream ] = l_rest.first( l_streamSize );
+            l_rest = l_rest.subspan( l_streamSize );
+        }
+
+        if ( !l_isValid ) [[unlikely]] {
+            break;
+        }
+
+        l_streams.back() = l_rest;
+
+        std::vector< std::byte > l_output( *l_size );
+
+        const size_t l_quarter =
+            ( ( l_output.size() + 3 ) / g_huffmanStreams );
+        std::array< size_t, g_huffmanStreams > l_begins{};
+        std::array< size_t, g_huffmanStreams > l_lengths{};
+
+        for ( size_t l_stream = 0; l_stream < g_huffmanStreams; l_stream++ ) {
+            l_begins[ l_stream ] =
+                std::min( ( l_stream * l_quarter ), l_output.size() );
+            l_lengths[ l_stream ] = ( std::min( ( l_begins[ l_stream ] +
+                                                  l_quarter ),
+                                                l_output.size() ) -
+                                      l_begins[ l_stream ] );
+        }
+
+        const uint64_t l_mask = ( ( uint64_t{ 1 } << _table._huffmanLog ) - 1 );
+        const entropyTable::huffmanEntry* const l_table =
+            _table._huffman.data();
+        std::byte* const l_destination = l_output.data();
+        // Bits read from every stream, only ever indexed by constants so they
+        // stay in registers
+        std::array< size_t, g_huffmanStreams > l_positions{};
+
+        // Decodes Count symbols of _stream from one refill of its bits. They
+        // go through a local array, stores through std::byte would make the
+        // compiler reload everything else after each one
+        const auto l_decode = [ & ]< size_t Count >( size_t _stream,
+                                                     size_t _index ) -> void {
+            size_t& l_position = l_positions[ _stream ];
+            uint64_t l_bits =
+                ( loadBits( l_streams[ _stream ], ( l_position / 8 ) ) >>
+                  ( l_position % 8 ) );
+            std::array< std::byte, Count > l_symbols{};
+
+            const auto l_step = [ & ]( std::byte& _symbol ) -> void {
+                const entropyTable::huffmanEntry l_entry =
+                    l_table[ l_bits & l_mask ];
+
+                _symbol = std::byte{ l_entry.symbol };
+                l_bits >>= l_entry.length;
+                l_position += l_entry.length;
+            };
+
+            [ & ]< size_t... Symbol >( std::index_sequence< Symbol... > )
+                -> void {
+                ( l_step( l_symbols[ Symbol ] ), ... );
+            }( std::make_index_sequence< Count >{} );
+
+            std::memcpy( ( l_destination + l_begins[ _stream ] + _index ),
+                         l_symbols.data(), Count );
+        };
+
+        // The last stream is the shortest, all four run interleaved up to
+        // its length
+        size_t l_index = 0;
+
+        for ( ; ( l_index + g_huffmanSymbolsPerRefill ) <= l_lengths.back();
+              l_index += g_huffmanSymbolsPerRefill ) {
+            [ & ]< size_t... Stream >( std::index_sequence< Stream... > )
+                -> void {
+                ( l_decode.template operator()< g_huffmanSymbolsPerRefill >(
+                      Stream, l_index ),
+                  ... );
+            }( std::make_index_sequence< g_huffmanStreams >{} );
+        }
+
+        [ & ]< size_t... Stream >( std::index_sequence< Stream... > ) -> void {
+            ( [ & ]() -> void {
+                  for ( size_t l_tail = l_index; l_tail < l_lengths[ Stream ];
+                        l_tail++ ) {
+                      l_decode.template operator()< 1 >( Stream, l_tail );
+                  }
+              }(),
+              ... );
+        }( std::make_index_sequence< g_huffmanStreams >{} );
+
+        // Every stream ends in the last byte it was given
+        l_isValid =
+            [ & ]< size_t... Stream >( std::index_sequence< Stream... > )
+                -> bool {
+            return ( ( ( bitsToBytes( l_positions[ Stream ] ) ==
+                         l_streams[ Stream ].size() ) &&
+                       ... ) );
+        }( std::make_index_sequence< g_huffmanStreams >{} );
+
+        if ( !l_isValid ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = std::move( l_output );
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+auto huffman( std::span< const std::byte > _data, size_t _maxSize )
+    -> std::optional< std::vector< std::byte > > {
+    return ( selfDescribed(
+        _data, _maxSize,
+        []( std::span< const std::byte > _input, const entropyTable& _table,
+            size_t _limit ) -> std::optional< std::vector< std::byte > > {
+            return ( huffman( _input, _table, _limit ) );
+        } ) );
+}
 
 } // namespace stdfunc::decompress
@@ -1,34 +1,1905 @@
-#if defined( HAS_LINUX_LIMITS )
-
 #include "stdfilesystem.hpp"
 
+#if defined( HAS_LINUX_LIMITS )
+
 #include <linux/limits.h>
 #include <unistd.h>
 
+#endif
+
+#if defined( __linux__ ) && __has_include( <sys/syscall.h> ) && \
+    __has_include( <dirent.h> ) && __has_include( <fcntl.h> )
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define HAS_GETDENTS
+
+#endif
+
+#if defined( __SSE2__ )
+
+#include <emmintrin.h>
+
+#endif
+
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <bitset>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <filesystem>
+#include <limits>
+#include <map>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "stdthread.hpp"
 
 namespace stdfunc::filesystem {
 
+#if defined( HAS_LINUX_LIMITS )
+
 [[nodiscard]] auto getApplicationDirectoryAbsolutePath()
     -> std::optional< std::filesystem::path > {
     std::array< char, PATH_MAX > l_executablePath{};
 
     // Get executable path
-    {
-        const ssize_t l_executablePathLength = readlink(
-            "/proc/self/exe", l_executablePath.data(), ( PATH_MAX - 1 ) );
+    const ssize_t l_executablePathLength = readlink(
+        "/proc/self/exe", l_executablePath.data(), ( PATH_MAX - 1 ) );
 
-        if ( l_executablePathLength == -1 ) [[unlikely]] {
-            return ( std::nullopt );
-        }
+    if ( l_executablePathLength == -1 ) [[unlikely]] {
+        return ( std::nullopt );
     }
 
-    return ( std::filesystem::path( std::string_view( l_executablePath ) )
+    return ( std::filesystem::path(
+                 std::string_view(
+                     l_executablePath.data(),
+                     static_cast< size_t >( l_executablePathLength ) ) )
                  .remove_filename() );
 }
 
-} // namespace stdfunc::filesystem
+#endif
+
+namespace {
+
+// Receives the worker index as well, so collecting needs no lock
+using workerVisitor_t =
+    std::function< void( size_t, std::string_view, std::string_view ) >;
+
+struct directory {
+    std::string path;
+    size_t depth;
+};
+
+auto joined( std::string_view _directory, std::string_view _name )
+    -> std::string {
+    std::string l_returnValue;
+
+    l_returnValue.reserve( _directory.size() + 1 + _name.size() );
+    l_returnValue.append( _directory );
+
+    if ( !l_returnValue.ends_with( '/' ) ) {
+        l_returnValue.push_back( '/' );
+    }
+
+    l_returnValue.append( _name );
+
+    return ( l_returnValue );
+}
+
+#if defined( HAS_GETDENTS )
+
+// Large directories are read in a few calls
+constexpr size_t g_direntBufferSize = ( 64 * 1024 );
+
+// Layout of struct linux_dirent64, after the inode and the next offset
+constexpr size_t g_direntLengthOffset = 16;
+constexpr size_t g_direntTypeOffset = 18;
+constexpr size_t g_direntNameOffset = 19;
+
+struct worker {
+    std::mutex lock;
+    std::deque< directory > directories;
+};
+
+// Closes the directory on every way out of walker::read, filters, visitors
+// and push() may throw
+struct directoryDescriptor {
+    int descriptor;
+
+    explicit directoryDescriptor( const std::string& _path )
+        : descriptor( ::open( _path.c_str(),
+                              ( O_RDONLY | O_DIRECTORY | O_CLOEXEC ) ) ) {}
+
+    directoryDescriptor( const directoryDescriptor& ) = delete;
+
+    auto operator=( const directoryDescriptor& )
+        -> directoryDescriptor& = delete;
+
+    ~directoryDescriptor() {
+        if ( descriptor != -1 ) {
+            ::close( descriptor );
+        }
+    }
+};
+
+struct walker {
+    const filter_t& filter;
+    const workerVisitor_t& visit;
+    size_t depth;
+    std::vector< worker > workers;
+    // Directories queued or being read, the walk ends at 0
+    std::atomic< size_t > pending = 0;
+    // Bumped on every push and at the end, idle workers wait on it
+    std::atomic< uint32_t > signal = 0;
+
+    walker( const filter_t& _filter,
+            const workerVisitor_t& _visit,
+            size_t _depth,
+            size_t _workers )
+        : filter( _filter ),
+          visit( _visit ),
+          depth( _depth ),
+          workers( _workers ) {}
+
+    void push( size_t _worker, directory&& _directory ) {
+        pending.fetch_add( 1, std::memory_order_relaxed );
+
+        {
+            std::lock_guard l_lock( workers[ _worker ].lock );
+
+            workers[ _worker ].directories.emplace_back(
+                std::move( _directory ) );
+        }
+
+        signal.fetch_add( 1, std::memory_order_release );
+        signal.notify_one();
+    }
+
+    // Own newest directory first, the oldest of another worker otherwise
+    auto take( size_t _worker ) -> std::optional< directory > {
+        std::optional< directory > l_returnValue = std::nullopt;
+
+        for ( size_t l_offset = 0; l_offset < workers.size(); l_offset++ ) {
+            worker& l_worker =
+                workers[ ( _worker + l_offset ) % workers.size() ];
+
+            std::lock_guard l_lock( l_worker.lock );
+
+            if ( l_worker.directories.empty() ) {
+                continue;
+            }
+
+            if ( !l_offset ) {
+                l_returnValue = std::move( l_worker.directories.back() );
+
+                l_worker.directories.pop_back();
+
+            } else {
+                l_returnValue = std::move( l_worker.directories.front() );
+
+                l_worker.directories.pop_front();
+            }
+
+            break;
+        }
+
+        return ( l_returnValue );
+    }
+
+    // False when the directory cannot be opened or fails to read to the end
+    auto read( size_t _worker,
+               const directory& _directory,
+               std::span< std::byte > _buffer ) -> bool {
+        const directoryDescriptor l_directory( _directory.path );
+        const int l_descriptor = l_directory.descriptor;
+
+        if ( l_descriptor == -1 ) [[unlikely]] {
+            return ( false );
+        }
+
+        const bool l_isDescending = ( _directory.depth < depth );
+
+        for ( ;; ) {
+            const long l_size = ::syscall( SYS_getdents64, l_descriptor,
+                                           _buffer.data(), _buffer.size() );
+
+            // EIO, ENOENT once removed, ..., what was visited stays visited
+            if ( l_size < 0 ) [[unlikely]] {
+                return ( false );
+            }
+
+            if ( !l_size ) {
+                break;
+            }
+
+            for ( size_t l_offset = 0;
+                  l_offset < static_cast< size_t >( l_size ); ) {
+                const std::byte* const l_record = ( _buffer.data() + l_offset );
+
+                uint16_t l_length = 0;
+
+                std::memcpy( &l_length, ( l_record + g_direntLengthOffset ),
+                             sizeof( l_length ) );
+
+                l_offset += l_length;
+
+                auto l_type = static_cast< unsigned char >(
+                    l_record[ g_direntTypeOffset ] );
+                const std::string_view l_name(
+                    reinterpret_cast< const char* >( l_record +
+                                                     g_direntNameOffset ) );
+
+                if ( ( l_name == "." ) || ( l_name == ".." ) ) {
+                    continue;
+                }
+
+                // File systems without d_type
+                if ( l_type == DT_UNKNOWN ) {
+                    struct stat l_status{};
+
+                    if ( ::fstatat( l_descriptor, l_name.data(), &l_status,
+                                    AT_SYMLINK_NOFOLLOW ) ) {
+                        continue;
+                    }
+
+                    l_type = ( S_ISREG( l_status.st_mode )   ? DT_REG
+                               : S_ISDIR( l_status.st_mode ) ? DT_DIR
+                               : S_ISLNK( l_status.st_mode ) ? DT_LNK
+                                                             : DT_UNKNOWN );
+                }
+
+                // Links only count as files, the filter runs before the stat
+                if ( l_type == DT_LNK ) {
+                    struct stat l_status{};
+
+                    if ( ( !filter || filter( l_name ) ) &&
+                         !::fstatat( l_descriptor, l_name.data(), &l_status,
+                                     0 ) &&
+                         S_ISREG( l_status.st_mode ) ) {
+                        visit( _worker, _directory.path, l_name );
+                    }
+
+                    continue;
+                }
+
+                if ( l_type == DT_REG ) {
+                    if ( !filter || filter( l_name ) ) {
+                        visit( _worker, _directory.path, l_name );
+                    }
+
+                } else if ( ( l_type == DT_DIR ) && l_isDescending ) {
+                    push( _worker,
+                          directory{ joined( _directory.path, l_name ),
+                                     ( _directory.depth + 1 ) } );
+                }
+            }
+        }
+
+        return ( true );
+    }
+
+    void run( size_t _worker ) {
+        std::vector< std::byte > l_buffer( g_direntBufferSize );
+
+        for ( ;; ) {
+            // Read before looking for work, a push in between ends the wait
+            const uint32_t l_signal = signal.load( std::memory_order_acquire );
+
+            if ( std::optional< directory > l_directory = take( _worker ) ) {
+                read( _worker, *l_directory, l_buffer );
+
+                if ( pending.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+                    signal.fetch_add( 1, std::memory_order_release );
+                    signal.notify_all();
+                }
+
+                continue;
+            }
+
+            if ( !pending.load( std::memory_order_acquire ) ) {
+                break;
+            }
+
+            signal.wait( l_signal, std::memory_order_acquire );
+        }
+    }
+};
+
+#endif
+
+auto walkWith( std::string_view _directory,
+               const filter_t& _filter,
+               const workerVisitor_t& _visit,
+               const walkParameters& _parameters,
+               [[maybe_unused]] size_t _workers ) -> bool {
+    std::string l_root( _directory.empty() ? "." : _directory );
+
+    if ( ( l_root.size() > 1 ) && l_root.ends_with( '/' ) ) {
+        l_root.pop_back();
+    }
+
+#if defined( HAS_GETDENTS )
+
+    walker l_walker( _filter, _visit, _parameters.depth, _workers );
+
+    // The root is read here, threads only start for subdirectories
+    {
+        std::vector< std::byte > l_buffer( g_direntBufferSize );
+
+        if ( !l_walker.read( 0, directory{ std::move( l_root ), 0 },
+                             l_buffer ) ) [[unlikely]] {
+            return ( false );
+        }
+    }
+
+    if ( l_walker.pending.load( std::memory_order_relaxed ) ) {
+        std::vector< std::jthread > l_threads;
+
+        l_threads.reserve( _workers - 1 );
+
+        for ( size_t l_worker = 1; l_worker < _workers; l_worker++ ) {
+            l_threads.emplace_back( [ &l_walker, l_worker ]() -> void {
+                l_walker.run( l_worker );
+            } );
+        }
+
+        l_walker.run( 0 );
+    }
+
+    return ( true );
+
+#else
+
+    std::error_code l_error;
+
+    std::filesystem::recursive_directory_iterator l_iterator(
+        l_root, std::filesystem::directory_options::skip_permission_denied,
+        l_error );
+
+    if ( l_error ) [[unlikely]] {
+        return ( false );
+    }
+
+    for ( const std::filesystem::recursive_directory_iterator l_end;
+          l_iterator != l_end; l_iterator.increment( l_error ) ) {
+        if ( l_error ) [[unlikely]] {
+            break;
+        }
+
+        const std::filesystem::directory_entry& l_entry = *l_iterator;
+
+        if ( l_entry.is_directory( l_error ) &&
+             ( static_cast< size_t >( l_iterator.depth() ) >=
+               _parameters.depth ) ) {
+            l_iterator.disable_recursion_pending();
+        }
+
+        if ( !l_entry.is_regular_file( l_error ) ) {
+            continue;
+        }
+
+        const std::string l_name = l_entry.path().filename().string();
+
+        if ( !_filter || _filter( l_name ) ) {
+            _visit( 0, l_entry.path().parent_path().string(), l_name );
+        }
+    }
+
+    return ( true );
 
 #endif
+}
+
+auto workerCount( const walkParameters& _parameters ) -> size_t {
+    return ( ( _parameters.depth && ( _parameters.workers != 1 ) )
+                 ? ( _parameters.workers ? _parameters.workers
+                                         : thread::hardwareConcurrency() )
+                 : 1 );
+}
+
+} // namespace
+
+auto walk( std::string_view _directory,
+           const filter_t& _filter,
+           const visitor_t& _visit,
+           const walkParameters& _parameters ) -> bool {
+    return ( walkWith(
+        _directory, _filter,
+        [ & ]( size_t, std::string_view _path, std::string_view _name )
+            -> void { _visit( _path, _name ); },
+        _parameters, workerCount( _parameters ) ) );
+}
+
+auto getPaths( std::string_view _directory,
+               const filter_t& _filter,
+               const walkParameters& _parameters )
+    -> std::optional< std::vector< std::filesystem::path > > {
+    std::optional< std::vector< std::filesystem::path > > l_returnValue =
+        std::nullopt;
+
+    const size_t l_workers = workerCount( _parameters );
+
+    std::vector< std::vector< std::filesystem::path > > l_found( l_workers );
+
+    do {
+        if ( !walkWith(
+                 _directory, _filter,
+                 [ & ]( size_t _worker, std::string_view _path,
+                        std::string_view _name ) -> void {
+                     l_found[ _worker ].emplace_back( joined( _path, _name ) );
+                 },
+                 _parameters, l_workers ) ) [[unlikely]] {
+            break;
+        }
+
+        l_returnValue = std::move( l_found.front() );
+
+        for ( size_t l_worker = 1; l_worker < l_workers; l_worker++ ) {
+            l_returnValue->insert(
+                l_returnValue->end(),
+                std::make_move_iterator( l_found[ l_worker ].begin() ),
+                std::make_move_iterator( l_found[ l_worker ].end() ) );
+        }
+    } while ( false );
+
+    return ( l_returnValue );
+}
+
+namespace {
+
+constexpr size_t g_unbounded = std::numeric_limits< size_t >::max();
+// Larger regexps fall back to std::regex, larger globs fail
+constexpr size_t g_maximumNfaStates = ( 16 * 1024 );
+constexpr size_t g_maximumDfaStates = 4096;
+// Most strings the fast paths expand a pattern part into
+constexpr size_t g_maximumLiterals = 64;
+// Patterns cachedMatcher keeps, all are dropped past it
+constexpr size_t g_matcherCacheSize = 1024;
+
+using bytes_t = std::bitset< 256 >;
+
+struct node {
+    enum class type : uint8_t { set, concat, alternate, repeat };
+
+    type kind = type::concat;
+    bytes_t bytes{};
+    std::vector< node > children{};
+    size_t minimum = 0;
+    size_t maximum = 0;
+};
+
+auto byteOf( char _byte ) -> bytes_t {
+    bytes_t l_returnValue;
+
+    l_returnValue.set( static_cast< unsigned char >( _byte ) );
+
+    return ( l_returnValue );
+}
+
+auto rangeOf( size_t _first, size_t _last ) -> bytes_t {
+    bytes_t l_returnValue;
+
+    for ( size_t l_byte = _first; l_byte <= _last; l_byte++ ) {
+        l_returnValue.set( l_byte );
+    }
+
+    return ( l_returnValue );
+}
+
+auto firstOf( const bytes_t& _bytes ) -> size_t {
+    size_t l_returnValue = 0;
+
+    while ( ( l_returnValue < _bytes.size() ) &&
+            !_bytes.test( l_returnValue ) ) {
+        l_returnValue++;
+    }
+
+    return ( l_returnValue );
+}
+
+auto setOf( const bytes_t& _bytes ) -> node {
+    return ( node{ .kind = node::type::set, .bytes = _bytes } );
+}
+
+auto repeatOf( node&& _child, size_t _minimum, size_t _maximum ) -> node {
+    node l_returnValue{
+        .kind = node::type::repeat, .minimum = _minimum, .maximum = _maximum };
+
+    l_returnValue.children.emplace_back( std::move( _child ) );
+
+    return ( l_returnValue );
+}
+
+// \d, \w, \s and their negations
+auto classOf( char _escape ) -> std::optional< bytes_t > {
+    std::optional< bytes_t > l_returnValue = std::nullopt;
+
+    switch ( _escape | 0x20 ) {
+        case 'd': {
+            l_returnValue = rangeOf( '0', '9' );
+
+            break;
+        }
+
+        case 'w': {
+            l_returnValue = ( rangeOf( '0', '9' ) | rangeOf( 'A', 'Z' ) |
+                              rangeOf( 'a', 'z' ) | byteOf( '_' ) );
+
+            break;
+        }
+
+        case 's': {
+            l_returnValue = ( rangeOf( '\t', '\r' ) | byteOf( ' ' ) );
+
+            break;
+        }
+
+        default: {
+        }
+    }
+
+    if ( l_returnValue && ( _escape >= 'A' ) && ( _escape <= 'Z' ) ) {
+        l_returnValue->flip();
+    }
+
+    return ( l_returnValue );
+}
+
+auto hexOf( char _digit ) -> std::optional< size_t > {
+    std::optional< size_t > l_returnValue = std::nullopt;
+
+    if ( ( _digit >= '0' ) && ( _digit <= '9' ) ) {
+        l_returnValue = static_cast< size_t >( _digit - '0' );
+
+    } else if ( ( ( _digit | 0x20 ) >= 'a' ) && ( ( _digit | 0x20 ) <= 'f' ) ) {
+        l_returnValue = static_cast< size_t >( ( _digit | 0x20 ) - 'a' + 10 );
+    }
+
+    return ( l_returnValue );
+}
+
+// ECMAScript subset, syntax outside of it is left to std::regex
+struct regexpParser {
+    std::string_view pattern;
+    size_t position = 0;
+    bool isSupported = true;
+
+    [[nodiscard]] auto isAt( char _character ) const -> bool {
+        return ( ( position < pattern.size() ) &&
+                 ( pattern[ position ] == _character ) );
+    }
+
+    auto parse() -> node {
+        // Anchors at the ends change nothing for whole names
+        if ( isAt( '^' ) ) {
+            position++;
+        }
+
+        if ( pattern.ends_with( '$' ) ) {
+            size_t l_backslashes = 0;
+
+            while ( ( l_backslashes + 1 ) < pattern.size() &&
+                    ( pattern[ pattern.size() - 2 - l_backslashes ] ==
+                      '\\' ) ) {
+                l_backslashes++;
+            }
+
+            if ( !( l_backslashes % 2 ) ) {
+                pattern.remove_suffix( 1 );
+            }
+        }
+
+        node l_returnValue = alternation();
+
+        if ( position < pattern.size() ) {
+            isSupported = false;
+        }
+
+        return ( l_returnValue );
+    }
+
+    auto alternation() -> node {
+        node l_returnValue = concatenation();
+
+        if ( isAt( '|' ) ) {
+            node l_alternatives{ .kind = node::type::alternate };
+
+            l_alternatives.children.emplace_back( std::move( l_returnValue ) );
+
+            while ( isSupported && isAt( '|' ) ) {
+                position++;
+
+                l_alternatives.children.emplace_back( concatenation() );
+            }
+
+            l_returnValue = std::move( l_alternatives );
+        }
+
+        return ( l_returnValue );
+    }
+
+    auto concatenation() -> node {
+        node l_returnValue;
+
+        while ( isSupported && ( position < pattern.size() ) && !isAt( '|' ) &&
+                !isAt( ')' ) ) {
+            l_returnValue.children.emplace_back( repetition() );
+        }
+
+        if ( l_returnValue.children.size() == 1 ) {
+            node l_child = std::move( l_returnValue.children.front() );
+
+            return ( l_child );
+        }
+
+        return ( l_returnValue );
+    }
+
+    auto repetition() -> node {
+        node l_returnValue = atom();
+
+        size_t l_minimum = 0;
+        size_t l_maximum = g_unbounded;
+
+        if ( !isSupported || ( position >= pattern.size() ) ) {
+            return ( l_returnValue );
+        }
+
+        switch ( pattern[ position ] ) {
+            case '*': {
+                position++;
+
+                break;
+            }
+
+            case '+': {
+                l_minimum = 1;
+                position++;
+
+                break;
+            }
+
+            case '?': {
+                l_maximum = 1;
+                position++;
+
+                break;
+            }
+
+            case '{': {
+                isSupported = counts( l_minimum, l_maximum );
+
+                break;
+            }
+
+            default: {
+                return ( l_returnValue );
+            }
+        }
+
+        // Lazy quantifiers match the same whole names
+        if ( isAt( '?' ) ) {
+            position++;
+        }
+
+        if ( isAt( '*' ) || isAt( '+' ) || isAt( '?' ) || isAt( '{' ) ) {
+            isSupported = false;
+        }
+
+        return ( repeatOf( std::move( l_returnValue ), l_minimum, l_maximum ) );
+    }
+
+    // {m}, {m,} or {m,n}
+    auto counts( size_t& _minimum, size_t& _maximum ) -> bool {
+        auto l_number = [ this ]() -> std::optional< size_t > {
+            const size_t l_start = position;
+            size_t l_value = 0;
+
+            while ( ( position < pattern.size() ) &&
+                    ( pattern[ position ] >= '0' ) &&
+                    ( pattern[ position ] <= '9' ) &&
+                    ( l_value <= g_maximumNfaStates ) ) {
+                l_value =
+                    ( ( l_value * 10 ) +
+                      static_cast< size_t >( pattern[ position ] - '0' ) );
+                position++;
+            }
+
+            if ( ( position == l_start ) || ( l_value > g_maximumNfaStates ) ) {
+                return ( std::nullopt );
+            }
+
+            return ( l_value );
+        };
+
+        position++;
+
+        const std::optional< size_t > l_minimum = l_number();
+
+        if ( !l_minimum ) {
+            return ( false );
+        }
+
+        _minimum = _maximum = *l_minimum;
+
+        if ( isAt( ',' ) ) {
+            position++;
+
+            if ( isAt( '}' ) ) {
+                _maximum = g_unbounded;
+
+            } else {
+                const std::optional< size_t > l_maximum = l_number();
+
+                if ( !l_maximum ) {
+                    return ( false );
+                }
+
+                _maximum = *l_maximum;
+            }
+        }
+
+        if ( !isAt( '}' ) ) {
+            return ( false );
+        }
+
+        position++;
+
+        return ( _minimum <= _maximum );
+    }
+
+    auto atom() -> node {
+        const char l_character = pattern[ position++ ];
+
+        switch ( l_character ) {
+            case '(': {
+                if ( pattern.substr( position ).starts_with( "?:" ) ) {
+                    position += 2;
+
+                } else if ( isAt( '?' ) ) {
+                    isSupported = false;
+
+                    return ( node{} );
+                }
+
+                node l_returnValue = alternation();
+
+                if ( isAt( ')' ) ) {
+                    position++;
+
+                } else {
+                    isSupported = false;
+                }
+
+                return ( l_returnValue );
+            }
+
+            case '[': {
+                return ( setOf( characterClass() ) );
+            }
+
+            case '.': {
+                return ( setOf( ~( byteOf( '\n' ) | byteOf( '\r' ) ) ) );
+            }
+
+            case '\\': {
+                return ( setOf( escape().value_or( bytes_t{} ) ) );
+            }
+
+            case '*':
+            case '+':
+            case '?':
+            case '{':
+            case '}':
+            case ']':
+            case '^':
+            case '$': {
+                isSupported = false;
+
+                return ( node{} );
+            }
+
+            default: {
+                return ( setOf( byteOf( l_character ) ) );
+            }
+        }
+    }
+
+    // After a backslash
+    auto escape() -> std::optional< bytes_t > {
+        if ( position >= pattern.size() ) {
+            isSupported = false;
+
+            return ( std::nullopt );
+        }
+
+        const char l_character = pattern[ position++ ];
+
+        if ( const auto l_class = classOf( l_character ) ) {
+            return ( l_class );
+        }
+
+        switch ( l_character ) {
+            case 't': {
+                return ( byteOf( '\t' ) );
+            }
+
+            case 'n': {
+                return ( byteOf( '\n' ) );
+            }
+
+            case 'r': {
+                return ( byteOf( '\r' ) );
+            }
+
+            case 'f': {
+                return ( byteOf( '\f' ) );
+            }
+
+            case 'v': {
+                return ( byteOf( '\v' ) );
+            }
+
+            case '0': {
+                if ( ( position < pattern.size() ) &&
+                     ( pattern[ position ] >= '0' ) &&
+                     ( pattern[ position ] <= '9' ) ) {
+                    break;
+                }
+
+                return ( byteOf( '\0' ) );
+            }
+
+            case 'x': {
+                if ( ( position + 1 ) < pattern.size() ) {
+                    const auto l_high = hexOf( pattern[ position ] );
+                    const auto l_low = hexOf( pattern[ position + 1 ] );
+
+                    if ( l_high && l_low ) {
+                        position += 2;
+
+                        return ( bytes_t{}.set( ( *l_high * 16 ) + *l_low ) );
+                    }
+                }
+
+                break;
+            }
+
+            default: {
+                // Back references, word boundaries, unicode escapes, ...
+                if ( !std::isalnum( static_cast< unsigned char >(
+                         l_character ) ) ) {
+                    return ( byteOf( l_character ) );
+                }
+            }
+        }
+
+        isSupported = false;
+
+        return ( std::nullopt );
+    }
+
+    auto characterClass() -> bytes_t {
+        bytes_t l_returnValue;
+
+        const bool l_isNegated = isAt( '^' );
+
+        if ( l_isNegated ) {
+            position++;
+        }
+
+        // Empty classes
+        if ( isAt( ']' ) ) {
+            isSupported = false;
+        }
+
+        auto l_item = [ this ]() -> std::optional< bytes_t > {
+            if ( pattern[ position++ ] == '\\' ) {
+                return ( escape() );
+            }
+
+            return ( byteOf( pattern[ position - 1 ] ) );
+        };
+
+        while ( isSupported ) {
+            if ( position >= pattern.size() ) {
+                isSupported = false;
+
+                break;
+            }
+
+            if ( isAt( ']' ) ) {
+                position++;
+
+                break;
+            }
+
+            // POSIX classes, equivalence classes and collating elements
+            if ( isAt( '[' ) && ( ( position + 1 ) < pattern.size() ) &&
+                 std::string_view( ":=." ).contains(
+                     pattern[ position + 1 ] ) ) {
+                isSupported = false;
+
+                break;
+            }
+
+            const std::optional< bytes_t > l_first = l_item();
+
+            if ( !l_first ) {
+                break;
+            }
+
+            // A - before the ] is a literal
+            if ( ( l_first->count() == 1 ) && isAt( '-' ) &&
+                 ( ( position + 1 ) < pattern.size() ) &&
+                 ( pattern[ position + 1 ] != ']' ) ) {
+                position++;
+
+                const std::optional< bytes_t > l_last = l_item();
+
+                if ( !l_last || ( l_last->count() != 1 ) ||
+                     ( firstOf( *l_first ) > firstOf( *l_last ) ) ) {
+                    isSupported = false;
+
+                    break;
+                }
+
+                l_returnValue |=
+                    rangeOf( firstOf( *l_first ), firstOf( *l_last ) );
+
+            } else {
+                l_returnValue |= *l_first;
+            }
+        }
+
+        if ( l_isNegated ) {
+            l_returnValue.flip();
+        }
+
+        return ( l_returnValue );
+    }
+};
+
+struct globParser {
+    std::string_view pattern;
+    size_t position = 0;
+    bool isValid = true;
+
+    // Any byte of a name
+    static auto anyName() -> bytes_t {
+        return ( ~byteOf( '/' ) );
+    }
+
+    // Up to the end, or the , or } of the braces it is in
+    auto sequence( bool _isInBraces ) -> node {
+        node l_returnValue;
+
+        while ( isValid && ( position < pattern.size() ) ) {
+            const char l_character = pattern[ position ];
+
+            if ( _isInBraces &&
+                 ( ( l_character == ',' ) || ( l_character == '}' ) ) ) {
+                break;
+            }
+
+            position++;
+
+            switch ( l_character ) {
+                case '*': {
+                    l_returnValue.children.emplace_back(
+                        repeatOf( setOf( anyName() ), 0, g_unbounded ) );
+
+                    break;
+                }
+
+                case '?': {
+                    l_returnValue.children.emplace_back( setOf( anyName() ) );
+
+                    break;
+                }
+
+                case '[': {
+                    l_returnValue.children.emplace_back(
+                        setOf( characterClass() ) );
+
+                    break;
+                }
+
+                case '{': {
+                    l_returnValue.children.emplace_back( braces() );
+
+                    break;
+                }
+
+                case '\\': {
+                    l_returnValue.children.emplace_back(
+                        setOf( byteOf( ( position < pattern.size() )
+                                           ? pattern[ position++ ]
+                                           : '\\' ) ) );
+
+                    break;
+                }
+
+                default: {
+                    l_returnValue.children.emplace_back(
+                        setOf( byteOf( l_character ) ) );
+                }
+            }
+        }
+
+        return ( l_returnValue );
+    }
+
+    auto braces() -> node {
+        node l_returnValue{ .kind = node::type::alternate };
+
+        for ( ;; ) {
+            l_returnValue.children.emplace_back( sequence( true ) );
+
+            if ( position >= pattern.size() ) {
+                isValid = false;
+
+                break;
+            }
+
+            if ( pattern[ position++ ] == '}' ) {
+                break;
+            }
+        }
+
+        return ( l_returnValue );
+    }
+
+    auto characterClass() -> bytes_t {
+        bytes_t l_returnValue;
+
+        const bool l_isNegated = ( ( position < pattern.size() ) &&
+                                   ( ( pattern[ position ] == '!' ) ||
+                                     ( pattern[ position ] == '^' ) ) );
+
+        if ( l_isNegated ) {
+            position++;
+        }
+
+        auto l_item = [ this ]() -> char {
+            if ( ( pattern[ position ] == '\\' ) &&
+                 ( ( position + 1 ) < pattern.size() ) ) {
+                position++;
+            }
+
+            return ( pattern[ position++ ] );
+        };
+
+        // A ] first is a literal
+        for ( bool l_isFirst = true;; l_isFirst = false ) {
+            if ( position >= pattern.size() ) {
+                isValid = false;
+
+                break;
+            }
+
+            if ( !l_isFirst && ( pattern[ position ] == ']' ) ) {
+                position++;
+
+                break;
+            }
+
+            const auto l_first = static_cast< unsigned char >( l_item() );
+
+            if ( ( ( position + 1 ) < pattern.size() ) &&
+                 ( pattern[ position ] == '-' ) &&
+                 ( pattern[ position + 1 ] != ']' ) ) {
+                position++;
+
+                const auto l_last = static_cast< unsigned char >( l_item() );
+
+                if ( l_first <= l_last ) {
+                    l_returnValue |= rangeOf( l_first, l_last );
+                }
+
+            } else {
+                l_returnValue.set( l_first );
+            }
+        }
+
+        if ( l_isNegated ) {
+            l_returnValue.flip();
+        }
+
+        l_returnValue.reset( '/' );
+
+        return ( l_returnValue );
+    }
+};
+
+// Items of _node concatenated, groups flattened
+void flatten( const node& _node, std::vector< const node* >& _items ) {
+    if ( _node.kind == node::type::concat ) {
+        for ( const node& _child : _node.children ) {
+            flatten( _child, _items );
+        }
+
+    } else {
+        _items.emplace_back( &_node );
+    }
+}
+
+auto product( const std::vector< std::string >& _heads,
+              const std::vector< std::string >& _tails )
+    -> std::optional< std::vector< std::string > > {
+    std::optional< std::vector< std::string > > l_returnValue = std::nullopt;
+
+    if ( ( _heads.size() * _tails.size() ) <= g_maximumLiterals ) {
+        l_returnValue.emplace();
+
+        for ( const std::string& _head : _heads ) {
+            for ( const std::string& _tail : _tails ) {
+                l_returnValue->emplace_back( _head + _tail );
+            }
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+auto literalsOf( std::span< const node* const > _items )
+    -> std::optional< std::vector< std::string > >;
+
+// Every string _node matches, when there are few
+auto literalsOf( const node& _node )
+    -> std::optional< std::vector< std::string > > {
+    std::optional< std::vector< std::string > > l_returnValue = std::nullopt;
+
+    switch ( _node.kind ) {
+        case node::type::set: {
+            if ( _node.bytes.count() <= g_maximumLiterals ) {
+                l_returnValue.emplace();
+
+                for ( size_t l_byte = 0; l_byte < _node.bytes.size();
+                      l_byte++ ) {
+                    if ( _node.bytes.test( l_byte ) ) {
+                        l_returnValue->emplace_back(
+                            1, static_cast< char >( l_byte ) );
+                    }
+                }
+            }
+
+            break;
+        }
+
+        case node::type::concat: {
+            std::vector< const node* > l_items;
+
+            flatten( _node, l_items );
+
+            l_returnValue = literalsOf( l_items );
+
+            break;
+        }
+
+        case node::type::alternate: {
+            l_returnValue.emplace();
+
+            for ( const node& _child : _node.children ) {
+                const auto l_literals = literalsOf( _child );
+
+                if ( !l_literals || ( ( l_returnValue->size() +
+                                        l_literals->size() ) >
+                                      g_maximumLiterals ) ) {
+                    l_returnValue.reset();
+
+                    break;
+                }
+
+                l_returnValue->insert( l_returnValue->end(),
+                                       l_literals->begin(),
+                                       l_literals->end() );
+            }
+
+            break;
+        }
+
+        case node::type::repeat: {
+            const auto l_literals = literalsOf( _node.children.front() );
+
+            if ( !l_literals || ( _node.maximum > g_maximumLiterals ) ) {
+                break;
+            }
+
+            std::vector< std::string > l_repeated{ "" };
+
+            l_returnValue.emplace();
+
+            for ( size_t l_count = 0;; l_count++ ) {
+                if ( l_count >= _node.minimum ) {
+                    l_returnValue->insert( l_returnValue->end(),
+                                           l_repeated.begin(),
+                                           l_repeated.end() );
+                }
+
+                if ( l_count == _node.maximum ) {
+                    break;
+                }
+
+                auto l_next = product( l_repeated, *l_literals );
+
+                if ( !l_next || ( ( l_returnValue->size() + l_next->size() ) >
+                                  g_maximumLiterals ) ) {
+                    l_returnValue.reset();
+
+                    break;
+                }
+
+                l_repeated = std::move( *l_next );
+            }
+
+            break;
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+auto literalsOf( std::span< const node* const > _items )
+    -> std::optional< std::vector< std::string > > {
+    std::optional< std::vector< std::string > > l_returnValue =
+        std::vector< std::string >{ "" };
+
+    for ( const node* const _item : _items ) {
+        const auto l_literals = literalsOf( *_item );
+
+        if ( !l_literals ) {
+            l_returnValue.reset();
+
+            break;
+        }
+
+        l_returnValue = product( *l_returnValue, *l_literals );
+
+        if ( !l_returnValue ) {
+            break;
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+// Bytes a wildcard excludes, when _node repeats a set missing at most 2
+auto exclusionsOf( const node& _node ) -> std::optional< std::string > {
+    std::optional< std::string > l_returnValue = std::nullopt;
+
+    if ( ( _node.kind == node::type::repeat ) && !_node.minimum &&
+         ( _node.maximum == g_unbounded ) &&
+         ( _node.children.front().kind == node::type::set ) ) {
+        const bytes_t l_excluded = ~_node.children.front().bytes;
+
+        if ( l_excluded.count() <= 2 ) {
+            l_returnValue.emplace();
+
+            for ( size_t l_byte = 0; l_byte < l_excluded.size(); l_byte++ ) {
+                if ( l_excluded.test( l_byte ) ) {
+                    l_returnValue->push_back( static_cast< char >( l_byte ) );
+                }
+            }
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+struct nfa {
+    struct state {
+        // Transition to next, none for states with epsilon moves only
+        bytes_t bytes;
+        bool hasBytes = false;
+        uint32_t next = 0;
+        std::vector< uint32_t > epsilon;
+    };
+
+    std::vector< state > states;
+    bool isOverflowing = false;
+
+    auto add() -> uint32_t {
+        isOverflowing = ( states.size() >= g_maximumNfaStates );
+
+        states.emplace_back();
+
+        return ( static_cast< uint32_t >( states.size() - 1 ) );
+    }
+
+    // Entry and exit of _node, Thompson construction
+    auto build( const node& _node ) -> std::pair< uint32_t, uint32_t > {
+        if ( isOverflowing ) {
+            return ( std::pair< uint32_t, uint32_t >{} );
+        }
+
+        const uint32_t l_entry = add();
+        uint32_t l_exit = l_entry;
+
+        switch ( _node.kind ) {
+            case node::type::set: {
+                l_exit = add();
+
+                states[ l_entry ].bytes = _node.bytes;
+                states[ l_entry ].hasBytes = true;
+                states[ l_entry ].next = l_exit;
+
+                break;
+            }
+
+            case node::type::concat: {
+                for ( const node& _child : _node.children ) {
+                    const auto [ l_first, l_last ] = build( _child );
+
+                    states[ l_exit ].epsilon.emplace_back( l_first );
+
+                    l_exit = l_last;
+                }
+
+                break;
+            }
+
+            case node::type::alternate: {
+                l_exit = add();
+
+                for ( const node& _child : _node.children ) {
+                    const auto [ l_first, l_last ] = build( _child );
+
+                    states[ l_entry ].epsilon.emplace_back( l_first );
+                    states[ l_last ].epsilon.emplace_back( l_exit );
+                }
+
+                break;
+            }
+
+            case node::type::repeat: {
+                const node& l_child = _node.children.front();
+
+                for ( size_t l_count = 0;
+                      ( l_count < _node.minimum ) && !isOverflowing;
+                      l_count++ ) {
+                    const auto [ l_first, l_last ] = build( l_child );
+
+                    states[ l_exit ].epsilon.emplace_back( l_first );
+
+                    l_exit = l_last;
+                }
+
+                if ( _node.maximum == g_unbounded ) {
+                    const uint32_t l_loop = add();
+                    const auto [ l_first, l_last ] = build( l_child );
+
+                    states[ l_exit ].epsilon.emplace_back( l_loop );
+                    states[ l_loop ].epsilon.emplace_back( l_first );
+                    states[ l_last ].epsilon.emplace_back( l_loop );
+
+                    l_exit = l_loop;
+
+                    break;
+                }
+
+                for ( size_t l_count = _node.minimum;
+                      ( l_count < _node.maximum ) && !isOverflowing;
+                      l_count++ ) {
+                    const uint32_t l_next = add();
+                    const auto [ l_first, l_last ] = build( l_child );
+
+                    states[ l_exit ].epsilon.emplace_back( l_first );
+                    states[ l_exit ].epsilon.emplace_back( l_next );
+                    states[ l_last ].epsilon.emplace_back( l_next );
+
+                    l_exit = l_next;
+                }
+
+                break;
+            }
+        }
+
+        return ( std::pair{ l_entry, l_exit } );
+    }
+};
+
+struct automaton {
+    std::array< uint8_t, 256 > classes{};
+    size_t classCount = 0;
+    std::vector< uint32_t > transitions;
+    std::vector< uint8_t > isAccepting;
+};
+
+// Subset construction, state 0 rejects and state 1 starts
+auto determinize( const nfa& _nfa, uint32_t _entry, uint32_t _accept )
+    -> std::optional< automaton > {
+    automaton l_returnValue;
+
+    // Bytes no transition tells apart share a class
+    l_returnValue.classCount = 1;
+
+    for ( const nfa::state& _state : _nfa.states ) {
+        if ( !_state.hasBytes ) {
+            continue;
+        }
+
+        std::array< int, 512 > l_split;
+        size_t l_count = 0;
+
+        l_split.fill( -1 );
+
+        for ( size_t l_byte = 0; l_byte < 256; l_byte++ ) {
+            const size_t l_key = ( ( l_returnValue.classes[ l_byte ] * 2 ) +
+                                   _state.bytes.test( l_byte ) );
+
+            if ( l_split[ l_key ] < 0 ) {
+                l_split[ l_key ] = static_cast< int >( l_count++ );
+            }
+
+            l_returnValue.classes[ l_byte ] =
+                static_cast< uint8_t >( l_split[ l_key ] );
+        }
+
+        l_returnValue.classCount = l_count;
+    }
+
+    std::array< size_t, 256 > l_representatives{};
+
+    for ( size_t l_byte = 256; l_byte-- > 0; ) {
+        l_representatives[ l_returnValue.classes[ l_byte ] ] = l_byte;
+    }
+
+    std::vector< uint32_t > l_marks( _nfa.states.size(), 0 );
+    uint32_t l_mark = 0;
+    std::vector< uint32_t > l_stack;
+
+    auto l_close = [ & ]( std::vector< uint32_t >& _set ) -> void {
+        l_mark++;
+
+        l_stack = _set;
+
+        _set.clear();
+
+        while ( !l_stack.empty() ) {
+            const uint32_t l_state = l_stack.back();
+
+            l_stack.pop_back();
+
+            if ( l_marks[ l_state ] == l_mark ) {
+                continue;
+            }
+
+            l_marks[ l_state ] = l_mark;
+
+            _set.emplace_back( l_state );
+
+            for ( const uint32_t _next : _nfa.states[ l_state ].epsilon ) {
+                l_stack.emplace_back( _next );
+            }
+        }
+
+        std::ranges::sort( _set );
+    };
+
+    std::map< std::vector< uint32_t >, uint32_t > l_ids;
+    std::vector< std::vector< uint32_t > > l_sets{ {}, { _entry } };
+
+    l_close( l_sets.back() );
+
+    l_ids.emplace( l_sets[ 0 ], 0 );
+    l_ids.emplace( l_sets[ 1 ], 1 );
+
+    l_returnValue.transitions.resize( 2 * l_returnValue.classCount );
+
+    for ( size_t l_state = 1; l_state < l_sets.size(); l_state++ ) {
+        for ( size_t l_class = 0; l_class < l_returnValue.classCount;
+              l_class++ ) {
+            const size_t l_byte = l_representatives[ l_class ];
+
+            std::vector< uint32_t > l_next;
+
+            for ( const uint32_t _member : l_sets[ l_state ] ) {
+                const nfa::state& l_member = _nfa.states[ _member ];
+
+                if ( l_member.hasBytes && l_member.bytes.test( l_byte ) ) {
+                    l_next.emplace_back( l_member.next );
+                }
+            }
+
+            l_close( l_next );
+
+            auto [ l_found, l_isNew ] = l_ids.try_emplace(
+                l_next, static_cast< uint32_t >( l_sets.size() ) );
+
+            if ( l_isNew ) {
+                if ( l_sets.size() >= g_maximumDfaStates ) {
+                    return ( std::nullopt );
+                }
+
+                l_sets.emplace_back( std::move( l_next ) );
+                l_returnValue.transitions.resize( l_sets.size() *
+                                                  l_returnValue.classCount );
+            }
+
+            l_returnValue.transitions[ ( l_state * l_returnValue.classCount ) +
+                                       l_class ] = l_found->second;
+        }
+    }
+
+    for ( const std::vector< uint32_t >& _set : l_sets ) {
+        l_returnValue.isAccepting.emplace_back(
+            std::ranges::binary_search( _set, _accept ) );
+    }
+
+    return ( l_returnValue );
+}
+
+// Whether _data holds one of _bytes, at most 2 of them
+auto containsAny( std::string_view _data, std::string_view _bytes ) -> bool {
+    if ( _bytes.empty() ) {
+        return ( false );
+    }
+
+    size_t l_offset = 0;
+
+#if defined( __SSE2__ )
+
+    const __m128i l_first = _mm_set1_epi8( _bytes.front() );
+    const __m128i l_last = _mm_set1_epi8( _bytes.back() );
+
+    for ( ; ( l_offset + 16 ) <= _data.size(); l_offset += 16 ) {
+        const __m128i l_block = _mm_loadu_si128(
+            reinterpret_cast< const __m128i* >( _data.data() + l_offset ) );
+
+        if ( _mm_movemask_epi8(
+                 _mm_or_si128( _mm_cmpeq_epi8( l_block, l_first ),
+                               _mm_cmpeq_epi8( l_block, l_last ) ) ) ) {
+            return ( true );
+        }
+    }
+
+#endif
+
+    return ( _data.find_first_of( _bytes, l_offset ) !=
+             std::string_view::npos );
+}
+
+// Substring search comparing the first and last needle bytes 16 positions at
+// a time
+auto contains( std::string_view _data, std::string_view _needle ) -> bool {
+    size_t l_offset = 0;
+
+#if defined( __SSE2__ )
+
+    if ( _needle.size() >= 2 ) {
+        const __m128i l_first = _mm_set1_epi8( _needle.front() );
+        const __m128i l_last = _mm_set1_epi8( _needle.back() );
+        const std::string_view l_inner =
+            _needle.substr( 1, ( _needle.size() - 2 ) );
+
+        for ( ; ( l_offset + _needle.size() - 1 + 16 ) <= _data.size();
+              l_offset += 16 ) {
+            const __m128i l_starts = _mm_loadu_si128(
+                reinterpret_cast< const __m128i* >( _data.data() + l_offset ) );
+            const __m128i l_ends =
+                _mm_loadu_si128( reinterpret_cast< const __m128i* >(
+                    _data.data() + l_offset + _needle.size() - 1 ) );
+
+            auto l_candidates = static_cast< uint32_t >( _mm_movemask_epi8(
+                _mm_and_si128( _mm_cmpeq_epi8( l_starts, l_first ),
+                               _mm_cmpeq_epi8( l_ends, l_last ) ) ) );
+
+            for ( ; l_candidates; l_candidates &= ( l_candidates - 1 ) ) {
+                const size_t l_position =
+                    ( l_offset + std::countr_zero( l_candidates ) );
+
+                if ( _data.substr( ( l_position + 1 ), l_inner.size() ) ==
+                     l_inner ) {
+                    return ( true );
+                }
+            }
+        }
+    }
+
+#endif
+
+    return ( _data.find( _needle, l_offset ) != std::string_view::npos );
+}
+
+struct patternHash {
+    using is_transparent = void;
+
+    auto operator()( std::string_view _pattern ) const -> size_t {
+        return ( std::hash< std::string_view >{}( _pattern ) );
+    }
+};
+
+using matcherCache_t = std::unordered_map< std::string,
+                                           std::shared_ptr< const matcher >,
+                                           patternHash,
+                                           std::equal_to<> >;
+
+} // namespace
+
+matcher::matcher( std::string_view _pattern, syntax _syntax ) {
+    node l_root;
+    bool l_isSupported = true;
+
+    if ( _syntax == syntax::glob ) {
+        globParser l_parser{ .pattern = _pattern };
+
+        l_root = l_parser.sequence( false );
+
+        if ( !l_parser.isValid ) {
+            return;
+        }
+
+    } else {
+        regexpParser l_parser{ .pattern = _pattern };
+
+        l_root = l_parser.parse();
+        l_isSupported = l_parser.isSupported;
+    }
+
+    do {
+        if ( !l_isSupported ) {
+            break;
+        }
+
+        std::vector< const node* > l_items;
+        std::vector< size_t > l_wildcards;
+
+        flatten( l_root, l_items );
+
+        for ( size_t l_index = 0; l_index < l_items.size(); l_index++ ) {
+            if ( exclusionsOf( *l_items[ l_index ] ) ) {
+                l_wildcards.emplace_back( l_index );
+            }
+        }
+
+        const std::span< const node* const > l_all = l_items;
+
+        auto l_exclude = [ this ]( const std::string& _bytes ) -> void {
+            // exclusionsOf() keeps at most 2 bytes
+            _excludedCount = std::min( _bytes.size(), _excluded.size() );
+
+            std::ranges::copy_n( _bytes.begin(), _excludedCount,
+                                 _excluded.begin() );
+        };
+
+        // Literals, a prefix and suffixes around one wildcard or a substring
+        // between two
+        if ( l_wildcards.empty() ) {
+            if ( auto l_literals = literalsOf( l_all ) ) {
+                std::ranges::sort( *l_literals );
+
+                _suffixes = std::move( *l_literals );
+                _kind = kind::literals;
+
+                break;
+            }
+
+        } else if ( l_wildcards.size() == 1 ) {
+            const size_t l_wildcard = l_wildcards.front();
+            const auto l_prefix = literalsOf( l_all.first( l_wildcard ) );
+            auto l_suffixes = literalsOf( l_all.subspan( l_wildcard + 1 ) );
+
+            if ( l_prefix && ( l_prefix->size() == 1 ) && l_suffixes ) {
+                _prefix = l_prefix->front();
+                _suffixes = std::move( *l_suffixes );
+                _kind = kind::affixes;
+
+                l_exclude( *exclusionsOf( *l_items[ l_wildcard ] ) );
+
+                break;
+            }
+
+        } else if ( ( l_wildcards.size() == 2 ) && !l_wildcards.front() &&
+                    ( l_wildcards.back() == ( l_items.size() - 1 ) ) ) {
+            const auto l_excluded = exclusionsOf( *l_items.front() );
+            const auto l_middle =
+                literalsOf( l_all.subspan( 1, ( l_items.size() - 2 ) ) );
+
+            if ( ( l_excluded == exclusionsOf( *l_items.back() ) ) &&
+                 l_middle && ( l_middle->size() == 1 ) &&
+                 !l_middle->front().empty() &&
+                 !containsAny( l_middle->front(), *l_excluded ) ) {
+                _prefix = l_middle->front();
+                _kind = kind::substring;
+
+                l_exclude( *l_excluded );
+
+                break;
+            }
+        }
+
+        nfa l_nfa;
+
+        const auto [ l_entry, l_accept ] = l_nfa.build( l_root );
+
+        if ( l_nfa.isOverflowing ) {
+            break;
+        }
+
+        std::optional< automaton > l_automaton =
+            determinize( l_nfa, l_entry, l_accept );
+
+        if ( !l_automaton ) {
+            break;
+        }
+
+        // Literal ends checked before the automaton runs
+        auto l_single = []( const node* _item ) -> bool {
+            const auto l_literals = literalsOf( *_item );
+
+            return ( l_literals && ( l_literals->size() == 1 ) );
+        };
+
+        size_t l_leading = 0;
+        size_t l_trailing = 0;
+
+        while ( ( l_leading < l_items.size() ) &&
+                l_single( l_items[ l_leading ] ) ) {
+            l_leading++;
+        }
+
+        while ( ( ( l_leading + l_trailing ) < l_items.size() ) &&
+                l_single( l_items[ l_items.size() - 1 - l_trailing ] ) ) {
+            l_trailing++;
+        }
+
+        _prefix = literalsOf( l_all.first( l_leading ) )->front();
+        _suffixes = { literalsOf( l_all.last( l_trailing ) )->front() };
+        _classes = l_automaton->classes;
+        _classCount = l_automaton->classCount;
+        _transitions = std::move( l_automaton->transitions );
+        _isAccepting = std::move( l_automaton->isAccepting );
+        _start = 1;
+
+        for ( const char _byte : _prefix ) {
+            _start =
+                _transitions[ ( _start * _classCount ) +
+                              _classes[ static_cast< uint8_t >( _byte ) ] ];
+        }
+
+        _kind = kind::automaton;
+    } while ( false );
+
+    if ( ( _kind == kind::invalid ) && ( _syntax == syntax::regexp ) ) {
+        try {
+            _fallback.emplace( _pattern.begin(), _pattern.end() );
+
+            _kind = kind::fallback;
+
+        } catch ( const std::regex_error& ) {
+        }
+    }
+}
+
+auto matcher::operator()( std::string_view _name ) const -> bool {
+    bool l_returnValue = false;
+
+    switch ( _kind ) {
+        case kind::invalid: {
+            break;
+        }
+
+        case kind::literals: {
+            l_returnValue = std::ranges::binary_search( _suffixes, _name );
+
+            break;
+        }
+
+        case kind::affixes: {
+            if ( !_name.starts_with( _prefix ) ) {
+                break;
+            }
+
+            const std::string_view l_rest = _name.substr( _prefix.size() );
+
+            l_returnValue = std::ranges::any_of(
+                _suffixes, [ & ]( const std::string& _suffix ) -> bool {
+                    return ( l_rest.ends_with( _suffix ) &&
+                             !_isExcluded( l_rest.substr(
+                                 0, ( l_rest.size() - _suffix.size() ) ) ) );
+                } );
+
+            break;
+        }
+
+        case kind::substring: {
+            l_returnValue = ( !_isExcluded( _name ) &&
+                              contains( _name, _prefix ) );
+
+            break;
+        }
+
+        case kind::automaton: {
+            const std::string& l_suffix = _suffixes.front();
+
+            if ( ( _name.size() < ( _prefix.size() + l_suffix.size() ) ) ||
+                 !_name.starts_with( _prefix ) ||
+                 !_name.ends_with( l_suffix ) ) {
+                break;
+            }
+
+            uint32_t l_state = _start;
+
+            for ( const char _byte : _name.substr( _prefix.size() ) ) {
+                if ( !l_state ) {
+                    break;
+                }
+
+                l_state = _transitions[ ( l_state * _classCount ) +
+                                        _classes[ static_cast< uint8_t >(
+                                            _byte ) ] ];
+            }
+
+            l_returnValue = _isAccepting[ l_state ];
+
+            break;
+        }
+
+        case kind::fallback: {
+            l_returnValue =
+                std::regex_match( _name.begin(), _name.end(), *_fallback );
+
+            break;
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+auto matcher::_isExcluded( std::string_view _part ) const -> bool {
+    return ( containsAny( _part,
+                          std::string_view( _excluded.data(),
+                                            _excludedCount ) ) );
+}
+
+auto cachedMatcher( std::string_view _pattern, syntax _syntax )
+    -> std::shared_ptr< const matcher > {
+    static std::shared_mutex l_lock;
+    static std::array< matcherCache_t, 2 > l_caches;
+
+    matcherCache_t& l_cache = l_caches[ std::to_underlying( _syntax ) ];
+
+    {
+        std::shared_lock l_reading( l_lock );
+
+        if ( const auto l_found = l_cache.find( _pattern );
+             l_found != l_cache.end() ) {
+            return ( l_found->second );
+        }
+    }
+
+    // Compiled unlocked, a racing caller keeps the first one inserted
+    auto l_matcher = std::make_shared< const matcher >( _pattern, _syntax );
+
+    if ( !l_matcher->isValid() ) [[unlikely]] {
+        return ( l_matcher );
+    }
+
+    std::lock_guard l_writing( l_lock );
+
+    if ( l_cache.size() >= g_matcherCacheSize ) {
+        l_cache.clear();
+    }
+
+    return ( l_cache.try_emplace( std::string( _pattern ),
+                                  std::move( l_matcher ) )
+                 .first->second );
+}
+
+} // namespace stdfunc::filesystem
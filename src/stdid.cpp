@@ -0,0 +1,400 @@
+#include "stdid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#if defined( __SSSE3__ ) || defined( __BMI2__ )
+
+#include <immintrin.h>
+
+#endif
+
+#include "stdrandom.hpp"
+
+namespace stdfunc::id {
+
+namespace {
+
+constexpr std::string_view g_hexAlphabet = "0123456789abcdef";
+constexpr std::string_view g_base32Alphabet =
+    "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+constexpr std::string_view g_base62Alphabet =
+    "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+constexpr uint16_t g_uuid7CounterMask = 0x0FFF;
+// Top bit stays clear on reseed to leave room for increments
+constexpr uint16_t g_uuid7CounterSeedMask = 0x07FF;
+constexpr uint64_t g_timestampMask = ( ( uint64_t{ 1 } << 48 ) - 1 );
+
+struct uuid7State {
+    uint64_t timestamp = 0;
+    uint16_t counter = 0;
+};
+
+struct ulidState {
+    uint64_t timestamp = 0;
+    // 80bits: high 16bits and low 64bits
+    uint16_t randomHigh = 0;
+    uint64_t randomLow = 0;
+};
+
+thread_local uuid7State g_uuid7State;
+thread_local ulidState g_ulidState;
+
+[[nodiscard]] auto now() -> uint64_t {
+    return ( static_cast< uint64_t >(
+                 std::chrono::duration_cast< std::chrono::milliseconds >(
+                     std::chrono::system_clock::now().time_since_epoch() )
+                     .count() ) &
+             g_timestampMask );
+}
+
+void storeBigEndian( std::byte* _destination, uint64_t _value, size_t _size ) {
+    for ( size_t l_index = 0; l_index < _size; l_index++ ) {
+        _destination[ _size - 1 - l_index ] =
+            static_cast< std::byte >( _value >> ( l_index * 8 ) );
+    }
+}
+
+[[nodiscard]] auto loadBigEndian( const std::byte* _source, size_t _size )
+    -> uint64_t {
+    uint64_t l_returnValue = 0;
+
+    for ( size_t l_index = 0; l_index < _size; l_index++ ) {
+        l_returnValue = ( ( l_returnValue << 8 ) |
+                          static_cast< uint8_t >( _source[ l_index ] ) );
+    }
+
+    return ( l_returnValue );
+}
+
+void fillRandom( std::span< std::byte, 16 > _bytes ) {
+    const std::array l_words = { random::number::bits(),
+                                 random::number::bits() };
+
+    std::memcpy( _bytes.data(), l_words.data(), _bytes.size() );
+}
+
+// RFC 9562 variant bits 10
+void setVariant( uuid& _uuid ) {
+    _uuid.bytes[ 8 ] =
+        ( ( _uuid.bytes[ 8 ] & std::byte{ 0x3F } ) | std::byte{ 0x80 } );
+}
+
+// Advances the per-thread counter, borrowing from the next millisecond when
+// it overflows or the clock went backwards
+void advance( uuid7State& _state, uint64_t _timestamp ) {
+    if ( _timestamp > _state.timestamp ) [[likely]] {
+        _state.timestamp = _timestamp;
+        _state.counter = static_cast< uint16_t >( random::number::bits() &
+                                                  g_uuid7CounterSeedMask );
+
+        return;
+    }
+
+    _state.counter++;
+
+    if ( _state.counter > g_uuid7CounterMask ) [[unlikely]] {
+        _state.timestamp++;
+        _state.counter = static_cast< uint16_t >( random::number::bits() &
+                                                  g_uuid7CounterSeedMask );
+    }
+}
+
+void advance( ulidState& _state, uint64_t _timestamp ) {
+    if ( _timestamp > _state.timestamp ) [[likely]] {
+        _state.timestamp = _timestamp;
+        _state.randomHigh = static_cast< uint16_t >( random::number::bits() );
+        _state.randomLow = random::number::bits();
+
+        return;
+    }
+
+    _state.randomLow++;
+
+    if ( !_state.randomLow ) [[unlikely]] {
+        _state.randomHigh++;
+
+        if ( !_state.randomHigh ) [[unlikely]] {
+            _state.timestamp++;
+        }
+    }
+}
+
+[[nodiscard]] auto makeUuid7( const uuid7State& _state ) -> uuid {
+    uuid l_returnValue{};
+
+    fillRandom( l_returnValue.bytes );
+
+    storeBigEndian( l_returnValue.bytes.data(), _state.timestamp, 6 );
+
+    l_returnValue.bytes[ 6 ] =
+        static_cast< std::byte >( 0x70 | ( _state.counter >> 8 ) );
+    l_returnValue.bytes[ 7 ] = static_cast< std::byte >( _state.counter );
+    setVariant( l_returnValue );
+
+    return ( l_returnValue );
+}
+
+[[nodiscard]] auto makeUlid( const ulidState& _state ) -> ulid {
+    ulid l_returnValue{};
+
+    storeBigEndian( l_returnValue.bytes.data(), _state.timestamp, 6 );
+    storeBigEndian( ( l_returnValue.bytes.data() + 6 ), _state.randomHigh, 2 );
+    storeBigEndian( ( l_returnValue.bytes.data() + 8 ), _state.randomLow, 8 );
+
+    return ( l_returnValue );
+}
+
+// 16 bytes into 32 hex digits
+void hex( const std::byte* _source, char* _destination ) {
+#if defined( __SSSE3__ )
+
+    const __m128i l_alphabet = _mm_loadu_si128(
+        reinterpret_cast< const __m128i* >( g_hexAlphabet.data() ) );
+    const __m128i l_nibbleMask = _mm_set1_epi8( 0x0F );
+    const __m128i l_bytes =
+        _mm_loadu_si128( reinterpret_cast< const __m128i* >( _source ) );
+
+    const __m128i l_high = _mm_shuffle_epi8(
+        l_alphabet,
+        _mm_and_si128( _mm_srli_epi16( l_bytes, 4 ), l_nibbleMask ) );
+    const __m128i l_low =
+        _mm_shuffle_epi8( l_alphabet, _mm_and_si128( l_bytes, l_nibbleMask ) );
+
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( _destination ),
+                      _mm_unpacklo_epi8( l_high, l_low ) );
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( _destination + 16 ),
+                      _mm_unpackhi_epi8( l_high, l_low ) );
+
+#else
+
+    for ( size_t l_index = 0; l_index < 16; l_index++ ) {
+        const auto l_byte = static_cast< uint8_t >( _source[ l_index ] );
+
+        _destination[ ( l_index * 2 ) ] = g_hexAlphabet[ l_byte >> 4 ];
+        _destination[ ( l_index * 2 ) + 1 ] = g_hexAlphabet[ l_byte & 0x0F ];
+    }
+
+#endif
+}
+
+// 128bits as 26 five-bit digits, the first one holding only 3bits
+void base32( const std::byte* _source, char* _destination ) {
+    std::array< uint8_t, 32 > l_digits{};
+
+    l_digits[ 0 ] = ( static_cast< uint8_t >( _source[ 0 ] ) >> 5 );
+    l_digits[ 1 ] = ( static_cast< uint8_t >( _source[ 0 ] ) & 0x1F );
+
+    // Three groups of 40bits -> 8 digits each
+    for ( size_t l_group = 0; l_group < 3; l_group++ ) {
+        const uint64_t l_bits =
+            loadBigEndian( ( _source + 1 + ( l_group * 5 ) ), 5 );
+
+#if defined( __BMI2__ )
+
+        const uint64_t l_spread = __builtin_bswap64(
+            _pdep_u64( l_bits, 0x1F1F1F1F1F1F1F1FULL ) );
+
+        std::memcpy( &l_digits[ 2 + ( l_group * 8 ) ], &l_spread,
+                     sizeof( l_spread ) );
+
+#else
+
+        for ( size_t l_index = 0; l_index < 8; l_index++ ) {
+            l_digits[ 2 + ( l_group * 8 ) + l_index ] =
+                ( ( l_bits >> ( 35 - ( l_index * 5 ) ) ) & 0x1F );
+        }
+
+#endif
+    }
+
+#if defined( __SSSE3__ )
+
+    const __m128i l_alphabetLow = _mm_loadu_si128(
+        reinterpret_cast< const __m128i* >( g_base32Alphabet.data() ) );
+    const __m128i l_alphabetHigh = _mm_loadu_si128(
+        reinterpret_cast< const __m128i* >( g_base32Alphabet.data() + 16 ) );
+    const __m128i l_fifteen = _mm_set1_epi8( 15 );
+
+    std::array< char, 32 > l_text{};
+
+    for ( size_t l_offset = 0; l_offset < l_digits.size(); l_offset += 16 ) {
+        const __m128i l_indices = _mm_loadu_si128(
+            reinterpret_cast< const __m128i* >( &l_digits[ l_offset ] ) );
+        const __m128i l_isHigh = _mm_cmpgt_epi8( l_indices, l_fifteen );
+
+        const __m128i l_result = _mm_or_si128(
+            _mm_andnot_si128( l_isHigh,
+                              _mm_shuffle_epi8( l_alphabetLow, l_indices ) ),
+            _mm_and_si128( l_isHigh,
+                           _mm_shuffle_epi8( l_alphabetHigh, l_indices ) ) );
+
+        _mm_storeu_si128( reinterpret_cast< __m128i* >( &l_text[ l_offset ] ),
+                          l_result );
+    }
+
+    std::memcpy( _destination, l_text.data(), g_ulidTextLength );
+
+#else
+
+    for ( size_t l_index = 0; l_index < g_ulidTextLength; l_index++ ) {
+        _destination[ l_index ] = g_base32Alphabet[ l_digits[ l_index ] ];
+    }
+
+#endif
+}
+
+} // namespace
+
+auto makeUuid4() -> uuid {
+    uuid l_returnValue{};
+
+    fillRandom( l_returnValue.bytes );
+
+    l_returnValue.bytes[ 6 ] =
+        ( ( l_returnValue.bytes[ 6 ] & std::byte{ 0x0F } ) |
+          std::byte{ 0x40 } );
+
+    setVariant( l_returnValue );
+
+    return ( l_returnValue );
+}
+
+void makeUuid4( std::span< uuid > _result ) {
+    std::ranges::generate( _result, []() -> uuid { return ( makeUuid4() ); } );
+}
+
+auto makeUuid7() -> uuid {
+    advance( g_uuid7State, now() );
+
+    return ( makeUuid7( g_uuid7State ) );
+}
+
+void makeUuid7( std::span< uuid > _result ) {
+    const uint64_t l_timestamp = now();
+
+    for ( uuid& _uuid : _result ) {
+        advance( g_uuid7State, l_timestamp );
+
+        _uuid = makeUuid7( g_uuid7State );
+    }
+}
+
+auto makeUlid() -> ulid {
+    advance( g_ulidState, now() );
+
+    return ( makeUlid( g_ulidState ) );
+}
+
+void makeUlid( std::span< ulid > _result ) {
+    const uint64_t l_timestamp = now();
+
+    for ( ulid& _ulid : _result ) {
+        advance( g_ulidState, l_timestamp );
+
+        _ulid = makeUlid( g_ulidState );
+    }
+}
+
+void encode( const uuid& _uuid, std::span< char, g_uuidTextLength > _result ) {
+    std::array< char, 32 > l_digits{};
+
+    hex( _uuid.bytes.data(), l_digits.data() );
+
+    char* l_destination = _result.data();
+
+    // 8-4-4-4-12
+    for ( const auto& [ l_offset, l_length ] :
+          { std::pair{ 0, 8 }, std::pair{ 8, 4 }, std::pair{ 12, 4 },
+            std::pair{ 16, 4 }, std::pair{ 20, 12 } } ) {
+        if ( l_offset ) {
+            *l_destination++ = '-';
+        }
+
+        std::memcpy( l_destination, &l_digits[ l_offset ], l_length );
+
+        l_destination += l_length;
+    }
+}
+
+void encode( const ulid& _ulid, std::span< char, g_ulidTextLength > _result ) {
+    base32( _ulid.bytes.data(), _result.data() );
+}
+
+void encode( std::span< const uuid > _uuids, std::span< char > _result ) {
+    assert( _result.size() >= ( _uuids.size() * g_uuidTextLength ) );
+
+    for ( size_t l_index = 0; l_index < _uuids.size(); l_index++ ) {
+        encode( _uuids[ l_index ],
+                _result.subspan( ( l_index * g_uuidTextLength ) )
+                    .first< g_uuidTextLength >() );
+    }
+}
+
+void encode( std::span< const ulid > _ulids, std::span< char > _result ) {
+    assert( _result.size() >= ( _ulids.size() * g_ulidTextLength ) );
+
+    for ( size_t l_index = 0; l_index < _ulids.size(); l_index++ ) {
+        encode( _ulids[ l_index ],
+                _result.subspan( ( l_index * g_ulidTextLength ) )
+                    .first< g_ulidTextLength >() );
+    }
+}
+
+auto text( const uuid& _uuid ) -> std::array< char, g_uuidTextLength > {
+    std::array< char, g_uuidTextLength > l_returnValue{};
+
+    encode( _uuid, l_returnValue );
+
+    return ( l_returnValue );
+}
+
+auto text( const ulid& _ulid ) -> std::array< char, g_ulidTextLength > {
+    std::array< char, g_ulidTextLength > l_returnValue{};
+
+    encode( _ulid, l_returnValue );
+
+    return ( l_returnValue );
+}
+
+// 6bits per byte of randomness, the 2 values out of 64 that do not map to the
+// alphabet are rejected to keep the distribution uniform
+void base62( std::span< char > _result ) {
+    size_t l_index = 0;
+
+    while ( l_index < _result.size() ) {
+        uint64_t l_word = random::number::bits();
+
+        for ( size_t l_byte = 0; ( l_byte < 8 ) && ( l_index < _result.size() );
+              l_byte++, l_word >>= 8 ) {
+            const auto l_digit = static_cast< uint8_t >( l_word & 0x3F );
+
+            if ( l_digit < g_base62Alphabet.size() ) [[likely]] {
+                _result[ l_index++ ] = g_base62Alphabet[ l_digit ];
+            }
+        }
+    }
+}
+
+void base32( std::span< char > _result ) {
+    size_t l_index = 0;
+
+    while ( l_index < _result.size() ) {
+        uint64_t l_word = random::number::bits();
+
+        for ( size_t l_digit = 0;
+              ( l_digit < 12 ) && ( l_index < _result.size() );
+              l_digit++, l_word >>= 5 ) {
+            _result[ l_index++ ] = g_base32Alphabet[ l_word & 0x1F ];
+        }
+    }
+}
+
+} // namespace stdfunc::id
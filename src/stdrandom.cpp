@@ -1,7 +1,15 @@
 #include "stdrandom.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
 #include <cstddef>
+#include <initializer_list>
+#include <limits>
 #include <random>
+#include <ranges>
+#include <vector>
 
 namespace stdfunc::random {
 
@@ -31,4 +39,449 @@ thread_local engine_t g_engine{
 
 } // namespace number
 
+namespace distribution {
+
+namespace {
+
+template < typename Density, typename InverseDensity >
+auto makeZigguratTable( double _tailStart,
+                        double _layerArea,
+                        Density _density,
+                        InverseDensity _inverseDensity ) -> zigguratTable {
+    zigguratTable l_returnValue{};
+
+    auto& l_x = l_returnValue.x;
+
+    l_x[ 0 ] = ( _layerArea / _density( _tailStart ) );
+    l_x[ 1 ] = _tailStart;
+
+    for ( size_t l_index = 2; l_index < ( l_x.size() - 1 ); l_index++ ) {
+        const double l_previous = l_x[ l_index - 1 ];
+
+        l_x[ l_index ] = _inverseDensity( ( _layerArea / l_previous ) +
+                                          _density( l_previous ) );
+    }
+
+    l_x.back() = 0;
+
+    for ( size_t l_index = 0; l_index < l_x.size(); l_index++ ) {
+        l_returnValue.f[ l_index ] = _density( l_x[ l_index ] );
+    }
+
+    l_returnValue.tailStart = _tailStart;
+
+    return ( l_returnValue );
+}
+
+} // namespace
+
+const zigguratTable g_zigguratNormal = makeZigguratTable(
+    3.6541528853610088, 0.00492867323399,
+    []( double _x ) -> double { return ( std::exp( -0.5 * _x * _x ) ); },
+    []( double _y ) -> double {
+        return ( std::sqrt( -2 * std::log( _y ) ) );
+    } );
+
+const zigguratTable g_zigguratExponential = makeZigguratTable(
+    7.69711747013104972, 0.0039496598225815571993,
+    []( double _x ) -> double { return ( std::exp( -_x ) ); },
+    []( double _y ) -> double { return ( -std::log( _y ) ); } );
+
+} // namespace distribution
+
+namespace sequence {
+
+namespace {
+
+// Joe-Kuo new-joe-kuo-6.21201 initial direction numbers m for dimensions 2 to
+// g_sobolMaxDimensions, m[ k ] is odd and below 2^( k + 1 ). Their polynomials
+// are the first primitive ones, which primitivePolynomials() enumerates in the
+// same order
+const std::array< std::initializer_list< uint32_t >,
+                  ( g_sobolMaxDimensions - 1 ) >
+    g_sobolInitialDirections{ {
+        { 1 },
+        { 1, 3 },
+        { 1, 3, 1 },
+        { 1, 1, 1 },
+        { 1, 1, 3, 3 },
+        { 1, 3, 5, 13 },
+        { 1, 1, 5, 5, 17 },
+        { 1, 1, 5, 5, 5 },
+        { 1, 1, 7, 11, 19 },
+        { 1, 1, 5, 1, 1 },
+        { 1, 1, 1, 3, 11 },
+        { 1, 3, 5, 5, 31 },
+        { 1, 3, 3, 9, 7, 49 },
+        { 1, 1, 1, 15, 21, 21 },
+        { 1, 3, 1, 13, 27, 49 },
+        { 1, 1, 1, 15, 7, 5 },
+        { 1, 3, 1, 15, 13, 25 },
+        { 1, 1, 5, 5, 19, 61 },
+        { 1, 3, 7, 11, 23, 15, 103 },
+        { 1, 3, 7, 13, 13, 15, 69 },
+    } };
+
+template < typename... Arguments >
+[[nodiscard]] auto hashOf( Arguments... _arguments ) -> uint64_t {
+    const std::array< uint64_t, sizeof...( Arguments ) > l_words{
+        static_cast< uint64_t >( _arguments )... };
+
+    return ( hash::weak< uint64_t >( std::as_bytes( std::span( l_words ) ) ) );
+}
+
+// Over GF( 2 ), both operands already reduced modulo _modulus of degree _degree
+[[nodiscard]] auto multiplyModulo( uint64_t _left,
+                                   uint64_t _right,
+                                   uint64_t _modulus,
+                                   uint32_t _degree ) -> uint64_t {
+    uint64_t l_returnValue = 0;
+
+    for ( ; _right; _right >>= 1 ) {
+        if ( _right & 1 ) {
+            l_returnValue ^= _left;
+        }
+
+        _left <<= 1;
+
+        if ( _left >> _degree ) {
+            _left ^= _modulus;
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+// x^_exponent modulo _modulus
+[[nodiscard]] auto powerOfX( uint64_t _exponent,
+                             uint64_t _modulus,
+                             uint32_t _degree ) -> uint64_t {
+    uint64_t l_returnValue = 1;
+    uint64_t l_base = ( ( _degree == 1 ) ? ( _modulus ^ 2 ) : 2 );
+
+    for ( ; _exponent; _exponent >>= 1 ) {
+        if ( _exponent & 1 ) {
+            l_returnValue =
+                multiplyModulo( l_returnValue, l_base, _modulus, _degree );
+        }
+
+        l_base = multiplyModulo( l_base, l_base, _modulus, _degree );
+    }
+
+    return ( l_returnValue );
+}
+
+// Primitive when the order of x is exactly 2^degree - 1
+[[nodiscard]] auto isPrimitive( uint64_t _polynomial,
+                                uint32_t _degree,
+                                std::span< const uint64_t > _primeFactors )
+    -> bool {
+    const uint64_t l_order = ( ( uint64_t{ 1 } << _degree ) - 1 );
+
+    if ( powerOfX( l_order, _polynomial, _degree ) != 1 ) {
+        return ( false );
+    }
+
+    return ( std::ranges::none_of(
+        _primeFactors, [ & ]( uint64_t _factor ) -> bool {
+            return ( powerOfX( ( l_order / _factor ), _polynomial,
+                               _degree ) == 1 );
+        } ) );
+}
+
+[[nodiscard]] auto primeFactors( uint64_t _value ) -> std::vector< uint64_t > {
+    std::vector< uint64_t > l_returnValue;
+
+    for ( uint64_t l_factor = 2; ( l_factor * l_factor ) <= _value;
+          l_factor++ ) {
+        if ( !( _value % l_factor ) ) {
+            l_returnValue.emplace_back( l_factor );
+
+            while ( !( _value % l_factor ) ) {
+                _value /= l_factor;
+            }
+        }
+    }
+
+    if ( _value > 1 ) {
+        l_returnValue.emplace_back( _value );
+    }
+
+    return ( l_returnValue );
+}
+
+// In Joe-Kuo order: by degree, then by coefficients
+[[nodiscard]] auto primitivePolynomials( size_t _count )
+    -> std::vector< std::pair< uint32_t, uint32_t > > {
+    std::vector< std::pair< uint32_t, uint32_t > > l_returnValue;
+
+    l_returnValue.reserve( _count );
+
+    for ( uint32_t l_degree = 1; l_returnValue.size() < _count; l_degree++ ) {
+        const std::vector< uint64_t > l_factors =
+            primeFactors( ( uint64_t{ 1 } << l_degree ) - 1 );
+
+        for ( uint32_t l_coefficients = 0;
+              ( l_coefficients < ( uint32_t{ 1 } << ( l_degree - 1 ) ) ) &&
+              ( l_returnValue.size() < _count );
+              l_coefficients++ ) {
+            const uint64_t l_polynomial = ( ( uint64_t{ 1 } << l_degree ) |
+                                            ( l_coefficients << 1 ) | 1 );
+
+            if ( isPrimitive( l_polynomial, l_degree, l_factors ) ) {
+                l_returnValue.emplace_back( l_degree, l_coefficients );
+            }
+        }
+    }
+
+    return ( l_returnValue );
+}
+
+// Burley 2020 Laine-Karras style hash, applied to the reversed bits it is a
+// nested uniform scramble
+[[nodiscard]] auto nestedUniformScramble( uint32_t _value, uint32_t _seed )
+    -> uint32_t {
+    auto l_reverse = []( uint32_t _bits ) -> uint32_t {
+        _bits = ( ( ( _bits >> 1 ) & 0x55555555 ) |
+                  ( ( _bits & 0x55555555 ) << 1 ) );
+        _bits = ( ( ( _bits >> 2 ) & 0x33333333 ) |
+                  ( ( _bits & 0x33333333 ) << 2 ) );
+        _bits = ( ( ( _bits >> 4 ) & 0x0F0F0F0F ) |
+                  ( ( _bits & 0x0F0F0F0F ) << 4 ) );
+
+        return ( std::byteswap( _bits ) );
+    };
+
+    uint32_t l_value = l_reverse( _value );
+
+    l_value += _seed;
+    l_value ^= ( l_value * 0x6C50B47C );
+    l_value ^= ( l_value * 0xB82F1E52 );
+    l_value ^= ( l_value * 0xC7AFE638 );
+    l_value ^= ( l_value * 0x8D22F6E6 );
+
+    return ( l_reverse( l_value ) );
+}
+
+constexpr size_t g_sobolBits = 32;
+
+} // namespace
+
+sobol::sobol( size_t _dimensions )
+    : _dimensions( _dimensions ),
+      _directions( g_sobolBits * _dimensions ),
+      _state( _dimensions ) {
+    assert( _dimensions && ( _dimensions <= g_sobolMaxDimensions ) );
+
+    // First dimension is van der Corput
+    for ( size_t l_bit = 0; l_bit < g_sobolBits; l_bit++ ) {
+        _directions[ l_bit * _dimensions ] =
+            ( uint32_t{ 1 } << ( 31 - l_bit ) );
+    }
+
+    const auto l_polynomials = primitivePolynomials( _dimensions - 1 );
+
+    std::array< uint32_t, g_sobolBits > l_directions{};
+
+    for ( size_t l_dimension = 1; l_dimension < _dimensions; l_dimension++ ) {
+        const auto [ l_degree, l_coefficients ] =
+            l_polynomials[ l_dimension - 1 ];
+
+        const std::initializer_list< uint32_t >& l_initial =
+            g_sobolInitialDirections[ l_dimension - 1 ];
+
+        assert( l_initial.size() == l_degree );
+
+        for ( size_t l_bit = 0; l_bit < l_degree; l_bit++ ) {
+            l_directions[ l_bit ] =
+                ( l_initial.begin()[ l_bit ] << ( 31 - l_bit ) );
+        }
+
+        for ( size_t l_bit = l_degree; l_bit < g_sobolBits; l_bit++ ) {
+            const uint32_t l_previous = l_directions[ l_bit - l_degree ];
+
+            l_directions[ l_bit ] = ( l_previous ^ ( l_previous >> l_degree ) );
+
+            for ( uint32_t l_term = 1; l_term < l_degree; l_term++ ) {
+                if ( ( l_coefficients >> ( l_degree - 1 - l_term ) ) & 1 ) {
+                    l_directions[ l_bit ] ^= l_directions[ l_bit - l_term ];
+                }
+            }
+        }
+
+        for ( size_t l_bit = 0; l_bit < g_sobolBits; l_bit++ ) {
+            _directions[ ( l_bit * _dimensions ) + l_dimension ] =
+                l_directions[ l_bit ];
+        }
+    }
+}
+
+sobol::sobol( size_t _dimensions, uint64_t _seed ) : sobol( _dimensions ) {
+    _seeds.resize( _dimensions );
+
+    for ( size_t l_dimension = 0; l_dimension < _dimensions; l_dimension++ ) {
+        _seeds[ l_dimension ] =
+            static_cast< uint32_t >( hashOf( _seed, l_dimension ) >> 32 );
+    }
+}
+
+void sobol::seek( uint64_t _index ) {
+    assert( _index <= ( uint64_t{ 1 } << g_sobolBits ) );
+
+    this->_index = _index;
+
+    std::ranges::fill( _state, 0 );
+
+    const uint64_t l_grayCode = ( _index ^ ( _index >> 1 ) );
+
+    for ( size_t l_bit = 0; l_bit < g_sobolBits; l_bit++ ) {
+        if ( ( l_grayCode >> l_bit ) & 1 ) {
+            const uint32_t* l_directions =
+                ( _directions.data() + ( l_bit * _dimensions ) );
+
+            for ( size_t l_dimension = 0; l_dimension < _dimensions;
+                  l_dimension++ ) {
+                _state[ l_dimension ] ^= l_directions[ l_dimension ];
+            }
+        }
+    }
+}
+
+void sobol::next( std::span< uint32_t > _points ) {
+    assert( !( _points.size() % _dimensions ) );
+
+    for ( size_t l_offset = 0; l_offset < _points.size();
+          l_offset += _dimensions ) {
+        uint32_t* l_point = ( _points.data() + l_offset );
+
+        if ( _seeds.empty() ) {
+            std::ranges::copy( _state, l_point );
+
+        } else {
+            for ( size_t l_dimension = 0; l_dimension < _dimensions;
+                  l_dimension++ ) {
+                l_point[ l_dimension ] = nestedUniformScramble(
+                    _state[ l_dimension ], _seeds[ l_dimension ] );
+            }
+        }
+
+        _index++;
+
+        const auto l_bit = static_cast< size_t >( std::countr_zero( _index ) );
+
+        // Sequence is exhausted after 2^32 points
+        if ( l_bit >= g_sobolBits ) [[unlikely]] {
+            assert( false );
+
+            break;
+        }
+
+        const uint32_t* l_directions =
+            ( _directions.data() + ( l_bit * _dimensions ) );
+
+        for ( size_t l_dimension = 0; l_dimension < _dimensions;
+              l_dimension++ ) {
+            _state[ l_dimension ] ^= l_directions[ l_dimension ];
+        }
+    }
+}
+
+halton::halton( size_t _dimensions ) {
+    assert( _dimensions );
+
+    _bases.reserve( _dimensions );
+
+    for ( uint32_t l_candidate = 2; _bases.size() < _dimensions;
+          l_candidate++ ) {
+        const bool l_isPrime = std::ranges::none_of(
+            _bases | std::views::take_while( [ & ]( uint32_t _prime ) -> bool {
+                return ( ( _prime * _prime ) <= l_candidate );
+            } ),
+            [ & ]( uint32_t _prime ) -> bool {
+                return ( !( l_candidate % _prime ) );
+            } );
+
+        if ( l_isPrime ) {
+            _bases.emplace_back( l_candidate );
+        }
+    }
+}
+
+halton::halton( size_t _dimensions, uint64_t _seed ) : halton( _dimensions ) {
+    this->_seed = _seed;
+    _isScrambled = true;
+}
+
+auto halton::_radicalInverse( uint64_t _index, size_t _dimension ) const
+    -> uint64_t {
+    const uint64_t l_base = _bases[ _dimension ];
+    const uint64_t l_limit =
+        ( std::numeric_limits< uint64_t >::max() / l_base );
+    // Scrambled zero digits still carry value down to double precision
+    constexpr uint64_t l_precision = ( uint64_t{ 1 } << 53 );
+
+    uint64_t l_reversed = 0;
+    uint64_t l_scale = 1;
+    uint64_t l_prefix = 0;
+
+    for ( uint64_t l_position = 0;
+          ( _index || ( _isScrambled && ( l_scale < l_precision ) ) ) &&
+          ( l_scale <= l_limit );
+          l_position++ ) {
+        const uint64_t l_digit = ( _index % l_base );
+        uint64_t l_scrambled = l_digit;
+
+        _index /= l_base;
+
+        if ( _isScrambled ) {
+            l_scrambled =
+                ( ( l_digit + ( ( hashOf( _seed, _dimension, l_position,
+                                          l_prefix ) >>
+                                  32 ) %
+                                l_base ) ) %
+                  l_base );
+        }
+
+        l_prefix += ( l_digit * l_scale );
+        l_reversed = ( ( l_reversed * l_base ) + l_scrambled );
+        l_scale *= l_base;
+    }
+
+    const double l_value =
+        std::min( ( static_cast< double >( l_reversed ) /
+                    static_cast< double >( l_scale ) ),
+                  0x1.fffffffffffffp-1 );
+
+    return ( static_cast< uint64_t >( std::ldexp( l_value, 64 ) ) );
+}
+
+r2::r2( size_t _dimensions )
+    : _alphas( _dimensions ), _offsets( _dimensions, uint64_t{ 1 } << 63 ) {
+    assert( _dimensions );
+
+    // Generalized golden ratio: positive root of x^( d + 1 ) = x + 1
+    double l_phi = 2;
+
+    for ( size_t l_iteration = 0; l_iteration < 64; l_iteration++ ) {
+        l_phi = std::pow( ( 1 + l_phi ),
+                          ( 1 / static_cast< double >( _dimensions + 1 ) ) );
+    }
+
+    double l_alpha = 1;
+
+    for ( uint64_t& _alpha : _alphas ) {
+        l_alpha /= l_phi;
+
+        _alpha = static_cast< uint64_t >( std::ldexp( l_alpha, 64 ) );
+    }
+}
+
+r2::r2( size_t _dimensions, uint64_t _seed ) : r2( _dimensions ) {
+    for ( size_t l_dimension = 0; l_dimension < _dimensions; l_dimension++ ) {
+        _offsets[ l_dimension ] = hashOf( _seed, l_dimension );
+    }
+}
+
+} // namespace sequence
+
 } // namespace stdfunc::random
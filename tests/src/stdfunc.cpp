@@ -4,8 +4,13 @@
 #include <sys/types.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <numeric>
+#include <sstream>
+#include <thread>
 #include <unordered_set>
 
 #if defined( __x86_64__ )
@@ -14,10 +19,14 @@
 
 #endif
 
+#include "stdarchive.hpp"
+#include "stdasync.hpp"
 #include "stdcompress.hpp"
 #include "stddecompress.hpp"
+#include "stdentropy.hpp"
 #include "stdfilesystem.hpp"
 #include "stdhash.hpp"
+#include "stdid.hpp"
 #include "stdliterals.hpp"
 #include "stdmeta.hpp"
 #include "stdrandom.hpp"
@@ -461,6 +470,589 @@ TEST( stdfunc, random$fill ) {
         << "fill with same seed must produce identical sequence";
 }
 
+TEST( stdfunc, random$distribution ) {
+    stdfunc::random::number::g_engine.seed( 12345u );
+
+    const auto l_moments = []( const auto& _values ) -> auto {
+        double l_mean = 0;
+        double l_variance = 0;
+
+        for ( const auto _value : _values ) {
+            l_mean += static_cast< double >( _value );
+        }
+
+        l_mean /= _values.size();
+
+        for ( const auto _value : _values ) {
+            const double l_delta = ( static_cast< double >( _value ) - l_mean );
+
+            l_variance += ( l_delta * l_delta );
+        }
+
+        return ( std::pair{ l_mean, ( l_variance / _values.size() ) } );
+    };
+
+    // ---- normal ----
+    {
+        std::vector< double > l_values( 1'000'000 );
+        random::distribution::fillNormal( l_values, 1.0, 2.0 );
+
+        const auto [ l_mean, l_variance ] = l_moments( l_values );
+        EXPECT_NEAR( l_mean, 1.0, 0.02 );
+        EXPECT_NEAR( l_variance, 4.0, 0.05 );
+
+        // Tail is reached
+        EXPECT_TRUE( std::ranges::any_of( l_values, []( double _v ) -> bool {
+            return ( std::abs( _v - 1.0 ) > ( 2.0 * 3.6541528853610088 ) );
+        } ) );
+
+        std::vector< float > l_scalar( 100'000 );
+        std::ranges::generate( l_scalar, [] -> float {
+            return ( random::distribution::normal< float >() );
+        } );
+
+        const auto [ l_scalarMean, l_scalarVariance ] = l_moments( l_scalar );
+        EXPECT_NEAR( l_scalarMean, 0.0, 0.02 );
+        EXPECT_NEAR( l_scalarVariance, 1.0, 0.02 );
+
+        std::vector< float16_t > l_half( 10'000 );
+        random::distribution::fillNormal( l_half );
+
+        const auto [ l_halfMean, l_halfVariance ] = l_moments( l_half );
+        EXPECT_NEAR( l_halfMean, 0.0, 0.05 );
+        EXPECT_NEAR( l_halfVariance, 1.0, 0.05 );
+    }
+
+    // ---- exponential ----
+    {
+        std::vector< float > l_values( 1'000'000 );
+        random::distribution::fillExponential( l_values, 2.0f );
+
+        const auto [ l_mean, l_variance ] = l_moments( l_values );
+        EXPECT_NEAR( l_mean, 0.5, 0.01 );
+        EXPECT_NEAR( l_variance, 0.25, 0.01 );
+        EXPECT_TRUE( std::ranges::all_of(
+            l_values, []( float _v ) -> bool { return ( _v >= 0 ); } ) );
+    }
+
+    // ---- gamma ----
+    for ( const double _shape : { 0.5, 1.0, 3.0, 20.0 } ) {
+        std::vector< double > l_values( 200'000 );
+        random::distribution::fillGamma( l_values, _shape, 2.0 );
+
+        const auto [ l_mean, l_variance ] = l_moments( l_values );
+        EXPECT_NEAR( l_mean, ( 2.0 * _shape ), ( 0.02 * 2.0 * _shape ) );
+        EXPECT_NEAR( l_variance, ( 4.0 * _shape ), ( 0.05 * 4.0 * _shape ) );
+    }
+
+    // ---- poisson ----
+    for ( const double _mean : { 0.5, 4.0, 15.0, 1000.0 } ) {
+        std::vector< int > l_values( 200'000 );
+        random::distribution::fillPoisson( l_values, _mean );
+
+        const auto [ l_mean, l_variance ] = l_moments( l_values );
+        EXPECT_NEAR( l_mean, _mean, ( 0.02 * _mean ) );
+        EXPECT_NEAR( l_variance, _mean, ( 0.05 * _mean ) );
+    }
+
+    // ---- binomial ----
+    for ( const auto [ _trials, _probability ] :
+          { std::pair{ 10, 0.3 }, std::pair{ 1000, 0.2 },
+            std::pair{ 1000, 0.9 }, std::pair{ 50, 0.01 } } ) {
+        std::vector< int > l_values( 200'000 );
+        random::distribution::fillBinomial( l_values, _trials, _probability );
+
+        const double l_expected = ( _trials * _probability );
+
+        const auto [ l_mean, l_variance ] = l_moments( l_values );
+        EXPECT_NEAR( l_mean, l_expected, ( 0.02 * l_expected ) );
+        EXPECT_NEAR( l_variance, ( l_expected * ( 1 - _probability ) ),
+                     ( 0.05 * l_expected ) );
+        EXPECT_TRUE( std::ranges::all_of( l_values, [ & ]( int _v ) -> bool {
+            return ( ( _v >= 0 ) && ( _v <= _trials ) );
+        } ) );
+    }
+
+    // Degenerate
+    EXPECT_EQ( random::distribution::binomial( 100, 0.0 ), 0 );
+    EXPECT_EQ( random::distribution::binomial( 100, 1.0 ), 100 );
+    EXPECT_EQ( random::distribution::poisson< int >( 0.0 ), 0 );
+}
+
+TEST( stdfunc, random$permutation ) {
+    // Bijection
+    for ( const uint64_t _size : { 1uz, 2uz, 3uz, 1000uz, 65'539uz } ) {
+        const random::permutation l_permutation( _size, 12345 );
+
+        std::vector< uint64_t > l_mapped =
+            l_permutation.view() | std::ranges::to< std::vector >();
+
+        ASSERT_EQ( l_mapped.size(), _size );
+
+        for ( uint64_t l_index = 0; l_index < _size; l_index++ ) {
+            EXPECT_EQ( l_permutation.unmap( l_mapped[ l_index ] ), l_index );
+        }
+
+        std::ranges::sort( l_mapped );
+
+        EXPECT_TRUE( std::ranges::equal(
+            l_mapped, std::views::iota( uint64_t{}, _size ) ) );
+    }
+
+    // Batched map matches scalar map
+    {
+        const random::permutation l_permutation( 1'000'003 );
+
+        std::vector< uint64_t > l_indices( 10'000 );
+        std::iota( l_indices.begin(), l_indices.end(), 500'000 );
+
+        std::vector< uint64_t > l_result( l_indices.size() );
+        l_permutation.map( l_indices, l_result );
+
+        for ( size_t l_index = 0; l_index < l_indices.size(); l_index++ ) {
+            EXPECT_EQ( l_result[ l_index ],
+                       l_permutation.map( l_indices[ l_index ] ) );
+        }
+    }
+
+    // Huge range, O(1) memory
+    {
+        constexpr uint64_t l_size = ( uint64_t{ 1 } << 40 );
+
+        const random::permutation l_permutation( l_size, 7 );
+
+        std::unordered_set< uint64_t > l_seen;
+
+        for ( const uint64_t _value :
+              l_permutation.view() | std::views::take( 10'000 ) ) {
+            EXPECT_LT( _value, l_size );
+            EXPECT_TRUE( l_seen.insert( _value ).second );
+        }
+    }
+
+    // Deterministic for a seed, different across seeds
+    {
+        const random::permutation l_first( 1000, 1 );
+        const random::permutation l_second( 1000, 1 );
+        const random::permutation l_third( 1000, 2 );
+
+        EXPECT_TRUE(
+            std::ranges::equal( l_first.view(), l_second.view() ) );
+        EXPECT_FALSE(
+            std::ranges::equal( l_first.view(), l_third.view() ) );
+
+        constexpr uint64_t l_constexprCheck =
+            random::permutation( 1000, 1 ).map( 0 );
+
+        EXPECT_EQ( l_constexprCheck, l_first.map( 0 ) );
+    }
+
+    // Container view visits every element once
+    {
+        std::vector< int > l_vec( 100 );
+        std::iota( l_vec.begin(), l_vec.end(), 0 );
+
+        int l_sum = 0;
+
+        for ( int& _item : random::view( l_vec, random::permutation( 100 ) ) ) {
+            l_sum += _item;
+        }
+
+        EXPECT_EQ( l_sum, 4950 );
+    }
+}
+
+TEST( stdfunc, random$float16 ) {
+    stdfunc::random::number::g_engine.seed( 12345u );
+
+    // Scalar
+    for ( int l_i = 0; l_i < 1000; ++l_i ) {
+        const float16_t l_value = random::number::balanced< float16_t >(
+            float16_t{ -2.0f }, float16_t{ 3.0f } );
+        EXPECT_GE( static_cast< float >( l_value ), -2.0f );
+        EXPECT_LE( static_cast< float >( l_value ), 3.0f );
+    }
+
+    // Vector lanes are independent
+    {
+        const float16x8_t l_vector = random::number::balanced< float16x8_t >(
+            float16_t{ 0.0f }, float16_t{ 1.0f } );
+
+        bool l_sawDifferent = false;
+
+        for ( size_t l_index = 1; l_index < 8; l_index++ ) {
+            EXPECT_GE( static_cast< float >( l_vector[ l_index ] ), 0.0f );
+            EXPECT_LE( static_cast< float >( l_vector[ l_index ] ), 1.0f );
+
+            l_sawDifferent |= ( l_vector[ l_index ] != l_vector[ 0 ] );
+        }
+
+        EXPECT_TRUE( l_sawDifferent );
+    }
+
+    // Bulk uniform, including a tail shorter than one vector
+    {
+        std::vector< float16_t > l_values( 100'003 );
+        random::fill( l_values, float16_t{ 10.0f }, float16_t{ 20.0f } );
+
+        double l_mean = 0;
+
+        for ( const float16_t _value : l_values ) {
+            EXPECT_GE( static_cast< float >( _value ), 10.0f );
+            EXPECT_LE( static_cast< float >( _value ), 20.0f );
+
+            l_mean += static_cast< double >( _value );
+        }
+
+        EXPECT_NEAR( ( l_mean / l_values.size() ), 15.0, 0.05 );
+
+        std::vector< float16_t > l_full( 1000 );
+        random::fill( l_full );
+        EXPECT_TRUE( std::ranges::none_of( l_full, []( float16_t _v ) -> bool {
+            return ( std::isinf( static_cast< float >( _v ) ) ||
+                     std::isnan( static_cast< float >( _v ) ) );
+        } ) );
+    }
+
+    // Vector containers, uniform and normal
+    {
+        std::vector< float16x16_t > l_vectors( 1000 );
+        random::fill( l_vectors, float16_t{ -1.0f }, float16_t{ 1.0f } );
+
+        for ( const float16x16_t& _vector : l_vectors ) {
+            for ( size_t l_index = 0; l_index < 16; l_index++ ) {
+                EXPECT_GE( static_cast< float >( _vector[ l_index ] ), -1.0f );
+                EXPECT_LE( static_cast< float >( _vector[ l_index ] ), 1.0f );
+            }
+        }
+
+        random::distribution::fillNormal( l_vectors, float16_t{ 5.0f } );
+
+        double l_mean = 0;
+
+        for ( const float16x16_t& _vector : l_vectors ) {
+            for ( size_t l_index = 0; l_index < 16; l_index++ ) {
+                l_mean += static_cast< double >( _vector[ l_index ] );
+            }
+        }
+
+        EXPECT_NEAR( ( l_mean / ( l_vectors.size() * 16 ) ), 5.0, 0.05 );
+    }
+}
+
+TEST( stdfunc, id ) {
+    // UUIDv4
+    {
+        const id::uuid l_uuid = id::makeUuid4();
+
+        EXPECT_EQ( ( l_uuid.bytes[ 6 ] >> 4 ), std::byte{ 0x4 } );
+        EXPECT_EQ( ( l_uuid.bytes[ 8 ] >> 6 ), std::byte{ 0x2 } );
+        EXPECT_NE( l_uuid, id::makeUuid4() );
+
+        const auto l_text = id::text( l_uuid );
+        EXPECT_EQ( l_text[ 8 ], '-' );
+        EXPECT_EQ( l_text[ 13 ], '-' );
+        EXPECT_EQ( l_text[ 14 ], '4' );
+        EXPECT_EQ( l_text[ 18 ], '-' );
+        EXPECT_EQ( l_text[ 23 ], '-' );
+    }
+
+    // Hex encoding
+    {
+        id::uuid l_uuid{};
+
+        for ( size_t l_index = 0; l_index < l_uuid.bytes.size(); l_index++ ) {
+            l_uuid.bytes[ l_index ] = std::byte( ( l_index * 0x11 ) );
+        }
+
+        const auto l_text = id::text( l_uuid );
+        EXPECT_EQ( std::string_view( l_text ),
+                   "00112233-4455-6677-8899-aabbccddeeff" );
+    }
+
+    // UUIDv7 is strictly increasing, also across counter overflow
+    {
+        std::vector< id::uuid > l_uuids( 10'000 );
+        id::makeUuid7( l_uuids );
+
+        EXPECT_TRUE( std::ranges::adjacent_find(
+                         l_uuids, std::greater_equal{} ) == l_uuids.end() );
+
+        for ( const id::uuid& _uuid : l_uuids ) {
+            EXPECT_EQ( ( _uuid.bytes[ 6 ] >> 4 ), std::byte{ 0x7 } );
+            EXPECT_EQ( ( _uuid.bytes[ 8 ] >> 6 ), std::byte{ 0x2 } );
+        }
+
+        EXPECT_LT( l_uuids.back(), id::makeUuid7() );
+    }
+
+    // ULID is strictly increasing and encodes to sortable base32
+    {
+        std::vector< id::ulid > l_ulids( 10'000 );
+        id::makeUlid( l_ulids );
+
+        EXPECT_TRUE( std::ranges::adjacent_find(
+                         l_ulids, std::greater_equal{} ) == l_ulids.end() );
+
+        std::string l_texts( ( l_ulids.size() * id::g_ulidTextLength ), '\0' );
+        id::encode( l_ulids, l_texts );
+
+        for ( size_t l_index = 1; l_index < l_ulids.size(); l_index++ ) {
+            EXPECT_LT( l_texts.substr( ( ( l_index - 1 ) * 26 ), 26 ),
+                       l_texts.substr( ( l_index * 26 ), 26 ) );
+        }
+
+        id::ulid l_max{};
+        std::ranges::fill( l_max.bytes, std::byte{ 0xFF } );
+        EXPECT_EQ( std::string_view( id::text( l_max ) ),
+                   "7ZZZZZZZZZZZZZZZZZZZZZZZZZ" );
+
+        id::ulid l_known{};
+        l_known.bytes[ 15 ] = std::byte{ 0x21 };
+        EXPECT_EQ( std::string_view( id::text( l_known ) ),
+                   "00000000000000000000000011" );
+    }
+
+    // Tokens
+    {
+        const auto l_token = id::base62< 4096 >();
+        EXPECT_TRUE( std::ranges::all_of( l_token, []( char _c ) -> bool {
+            return ( std::isalnum( static_cast< unsigned char >( _c ) ) );
+        } ) );
+
+        std::unordered_set< char > l_seen( l_token.begin(), l_token.end() );
+        EXPECT_EQ( l_seen.size(), 62u );
+
+        const auto l_token32 = id::base32< 64 >();
+        EXPECT_TRUE( std::ranges::none_of( l_token32, []( char _c ) -> bool {
+            return ( ( _c == 'I' ) || ( _c == 'L' ) || ( _c == 'O' ) ||
+                     ( _c == 'U' ) );
+        } ) );
+    }
+}
+
+TEST( stdfunc, random$sequence ) {
+    using namespace random::sequence;
+
+    // Joe-Kuo reference points
+    {
+        sobol l_sobol( 3 );
+
+        std::array< double, 12 > l_points{};
+        l_sobol.fill( l_points );
+
+        EXPECT_EQ( l_points, ( std::array< double, 12 >{
+                                 0, 0, 0, 0.5, 0.5, 0.5, 0.75, 0.25, 0.25,
+                                 0.25, 0.75, 0.75 } ) );
+    }
+
+    // First 2^k points hit every 1 / 2^k interval once, per dimension and
+    // with Owen scrambling too
+    for ( const auto& _sobol : { sobol( g_sobolMaxDimensions ),
+                                 sobol( g_sobolMaxDimensions, 0xC0FFEE ),
+                                 sobol( 7, 1 ) } ) {
+        constexpr size_t l_count = 1024;
+
+        sobol l_sobol = _sobol;
+
+        std::vector< uint32_t > l_points( l_count * l_sobol.dimensions() );
+        l_sobol.next( std::span( l_points ) );
+
+        for ( size_t l_dimension = 0; l_dimension < l_sobol.dimensions();
+              l_dimension++ ) {
+            std::vector< bool > l_hit( l_count );
+
+            for ( size_t l_index = 0; l_index < l_count; l_index++ ) {
+                const uint32_t l_value =
+                    l_points[ ( l_index * l_sobol.dimensions() ) +
+                              l_dimension ];
+
+                l_hit[ l_value >> 22 ] = true;
+            }
+
+            EXPECT_TRUE( std::ranges::all_of(
+                l_hit, []( bool _hit ) -> bool { return ( _hit ); } ) );
+        }
+
+        // ( 0, m, 2 )-net in the first two dimensions: 16 x 16 grid
+        std::array< int, 256 > l_cells{};
+
+        for ( size_t l_index = 0; l_index < 256; l_index++ ) {
+            const uint32_t l_x = l_points[ l_index * l_sobol.dimensions() ];
+            const uint32_t l_y =
+                l_points[ ( l_index * l_sobol.dimensions() ) + 1 ];
+
+            l_cells[ ( ( l_x >> 28 ) * 16 ) + ( l_y >> 28 ) ]++;
+        }
+
+        EXPECT_TRUE( std::ranges::all_of(
+            l_cells, []( int _count ) -> bool { return ( _count == 1 ); } ) );
+    }
+
+    // Conversion in batches that do not end on a point
+    {
+        sobol l_raw( g_sobolMaxDimensions, 5 );
+        sobol l_real( g_sobolMaxDimensions, 5 );
+
+        std::vector< uint32_t > l_fractions( g_sobolMaxDimensions * 100 );
+        std::vector< double > l_points( g_sobolMaxDimensions * 100 );
+        l_raw.next( std::span( l_fractions ) );
+        l_real.fill( l_points );
+
+        EXPECT_EQ( l_real.index(), 100 );
+        EXPECT_TRUE( std::ranges::equal(
+            l_points, l_fractions, {}, {}, []( uint32_t _fraction ) -> double {
+                return ( static_cast< double >( _fraction ) / 0x1p32 );
+            } ) );
+    }
+
+    // seek() and skip() match sequential generation
+    {
+        sobol l_sequential( 8, 3 );
+        sobol l_seeked( 8, 3 );
+
+        std::vector< float > l_first( 8 * 777 );
+        std::vector< float > l_second( 8 * 23 );
+        l_sequential.fill( l_first );
+        l_sequential.fill( l_second );
+
+        std::vector< float > l_jumped( 8 * 23 );
+        l_seeked.seek( 700 );
+        l_seeked.skip( 77 );
+        l_seeked.fill( l_jumped );
+
+        EXPECT_EQ( l_second, l_jumped );
+        EXPECT_EQ( l_seeked.index(), 800 );
+
+        halton l_halton( 5, 9 );
+        halton l_haltonSeeked( 5, 9 );
+
+        std::vector< double > l_haltonFirst( 5 * 100 );
+        l_halton.fill( l_haltonFirst );
+
+        l_haltonSeeked.seek( 60 );
+
+        std::vector< double > l_haltonTail( 5 * 40 );
+        l_haltonSeeked.fill( l_haltonTail );
+
+        EXPECT_TRUE( std::ranges::equal(
+            l_haltonTail, l_haltonFirst | std::views::drop( 5 * 60 ) ) );
+
+        // Workers splitting one sequence by seek() reproduce it
+        std::vector< double > l_r2Sequential( 3 * 100 );
+        r2( 3, 7 ).fill( l_r2Sequential );
+
+        std::vector< double > l_r2Split( 3 * 100 );
+
+        for ( size_t l_part = 0; l_part < 4; l_part++ ) {
+            r2 l_worker( 3, 7 );
+            l_worker.seek( l_part * 25 );
+
+            std::span< double > l_range =
+                std::span( l_r2Split ).subspan( ( l_part * 3 * 25 ), 3 * 25 );
+            l_worker.next( l_range );
+
+            EXPECT_EQ( l_worker.index(), ( ( l_part + 1 ) * 25 ) );
+        }
+
+        EXPECT_EQ( l_r2Split, l_r2Sequential );
+    }
+
+    // Radical inverse
+    {
+        halton l_halton( 2 );
+
+        std::array< double, 6 > l_points{};
+        l_halton.fill( l_points );
+
+        EXPECT_EQ( l_points[ 2 ], 0.5 );
+        EXPECT_DOUBLE_EQ( l_points[ 3 ], 1.0 / 3 );
+        EXPECT_EQ( l_points[ 4 ], 0.25 );
+        EXPECT_DOUBLE_EQ( l_points[ 5 ], 2.0 / 3 );
+    }
+
+    // [ 0, 1 ) with the mean close to 1/2 in every dimension
+    {
+        constexpr size_t l_dimensions = 16;
+        constexpr size_t l_count = 4096;
+
+        std::vector< double > l_sobol( l_dimensions * l_count );
+        std::vector< double > l_halton( l_dimensions * l_count );
+        std::vector< double > l_r2( l_dimensions * l_count );
+        std::vector< float > l_r2Float( l_dimensions * l_count );
+
+        sobol( l_dimensions, 5 ).fill( l_sobol );
+        halton( l_dimensions, 5 ).fill( l_halton );
+        r2( l_dimensions ).fill( l_r2 );
+        r2( l_dimensions, 5 ).fill( l_r2Float );
+
+        for ( const auto& _points : { l_sobol, l_halton, l_r2 } ) {
+            EXPECT_TRUE(
+                std::ranges::all_of( _points, []( double _value ) -> bool {
+                    return ( ( _value >= 0 ) && ( _value < 1 ) );
+                } ) );
+
+            for ( size_t l_dimension = 0; l_dimension < l_dimensions;
+                  l_dimension++ ) {
+                double l_sum = 0;
+
+                for ( size_t l_index = 0; l_index < l_count; l_index++ ) {
+                    l_sum +=
+                        _points[ ( l_index * l_dimensions ) + l_dimension ];
+                }
+
+                EXPECT_NEAR( ( l_sum / l_count ), 0.5, 0.01 );
+            }
+        }
+
+        EXPECT_TRUE(
+            std::ranges::all_of( l_r2Float, []( float _value ) -> bool {
+                return ( ( _value >= 0 ) && ( _value < 1 ) );
+            } ) );
+    }
+
+    // Integrating prod( 2 * x ) over [ 0, 1 )^4 converges faster than with
+    // pseudo-random points
+    {
+        constexpr size_t l_dimensions = 4;
+        constexpr size_t l_count = 16'384;
+
+        auto l_error = [ & ]( std::span< const double > _points ) -> double {
+            double l_sum = 0;
+
+            for ( size_t l_offset = 0; l_offset < _points.size();
+                  l_offset += l_dimensions ) {
+                double l_product = 1;
+
+                for ( size_t l_dimension = 0; l_dimension < l_dimensions;
+                      l_dimension++ ) {
+                    l_product *= ( 2 * _points[ l_offset + l_dimension ] );
+                }
+
+                l_sum += l_product;
+            }
+
+            return ( std::abs( ( l_sum / l_count ) - 1 ) );
+        };
+
+        std::vector< double > l_points( l_dimensions * l_count );
+
+        random::fill( l_points, 0.0, 1.0 );
+        const double l_pseudoRandomError = l_error( l_points );
+
+        auto l_check = [ & ]( auto _sequence ) -> void {
+            _sequence.fill( l_points );
+
+            EXPECT_LT( l_error( l_points ), 0.01 );
+            EXPECT_LT( l_error( l_points ), ( l_pseudoRandomError + 1e-3 ) );
+        };
+
+        l_check( sobol( l_dimensions, 11 ) );
+        l_check( halton( l_dimensions, 11 ) );
+        l_check( r2( l_dimensions ) );
+    }
+}
+
 TEST( stdfunc, generateHash$weak ) {
     // Invalid inputs
     {
@@ -785,6 +1377,85 @@ TEST( stdfunc, generateHash$balanced ) {
     }
 }
 
+TEST( stdfunc, generateHash$crc32c ) {
+    static_assert( hash::crc32c( "123456789"_bytes ) == 0xE3069283 );
+
+    EXPECT_EQ( hash::crc32c( "123456789"_bytes ), 0xE3069283 );
+    EXPECT_EQ( hash::crc32c( std::span< const std::byte >{} ), 0 );
+
+    // Continues over split data, both paths agree
+    {
+        std::vector< std::byte > l_data( 1000 );
+
+        for ( size_t l_index = 0; l_index < l_data.size(); l_index++ ) {
+            l_data[ l_index ] =
+                std::byte( static_cast< unsigned char >( l_index * 37 ) );
+        }
+
+        const uint32_t l_crc = hash::crc32c( l_data );
+
+        for ( const size_t _split : { 1uz, 7uz, 8uz, 500uz, 999uz } ) {
+            const std::span< const std::byte > l_span = l_data;
+
+            EXPECT_EQ( hash::crc32c( l_span.subspan( _split ),
+                                     hash::crc32c( l_span.first( _split ) ) ),
+                       l_crc );
+        }
+
+        constexpr auto l_constant = []() -> uint32_t {
+            std::array< std::byte, 1000 > l_data{};
+
+            for ( size_t l_index = 0; l_index < l_data.size(); l_index++ ) {
+                l_data[ l_index ] =
+                    std::byte( static_cast< unsigned char >( l_index * 37 ) );
+            }
+
+            return ( hash::crc32c( l_data ) );
+        }();
+
+        EXPECT_EQ( l_constant, l_crc );
+    }
+}
+
+TEST( stdfunc, generateHash$xxh64 ) {
+    static_assert( hash::xxh64( "abc"_bytes ) == 0x44BC2CF5AD770999 );
+
+    EXPECT_EQ( hash::xxh64( std::span< const std::byte >{} ),
+               0xEF46DB3751D8E999 );
+    EXPECT_EQ( hash::xxh64( "a"_bytes ), 0xD24EC4F1A98C6E5B );
+    EXPECT_EQ( hash::xxh64( "abc"_bytes ), 0x44BC2CF5AD770999 );
+
+    // Compile time and run time agree on every tail length
+    constexpr auto l_constant = []() -> std::array< uint64_t, 40 > {
+        std::array< std::byte, 40 > l_data{};
+        std::array< uint64_t, 40 > l_returnValue{};
+
+        for ( size_t l_index = 0; l_index < l_data.size(); l_index++ ) {
+            l_data[ l_index ] =
+                std::byte( static_cast< unsigned char >( l_index * 37 ) );
+        }
+
+        for ( size_t l_size = 0; l_size < l_returnValue.size(); l_size++ ) {
+            l_returnValue[ l_size ] =
+                hash::xxh64( std::span( l_data ).first( l_size ), 7 );
+        }
+
+        return ( l_returnValue );
+    }();
+
+    std::array< std::byte, 40 > l_data{};
+
+    for ( size_t l_index = 0; l_index < l_data.size(); l_index++ ) {
+        l_data[ l_index ] =
+            std::byte( static_cast< unsigned char >( l_index * 37 ) );
+    }
+
+    for ( size_t l_size = 0; l_size < l_constant.size(); l_size++ ) {
+        EXPECT_EQ( hash::xxh64( std::span( l_data ).first( l_size ), 7 ),
+                   l_constant[ l_size ] );
+    }
+}
+
 TEST( stdfunc, makeVariantContainer ) {
     {
         // Use std::vector (has defaulted allocator, so it works as a
@@ -864,26 +1535,457 @@ TEST( stdfunc, filesystem$getApplicationDirectoryAbsolutePath ) {
     EXPECT_NE( l_path, std::nullopt );
 }
 
-TEST( stdfunc, compress$decompress ) {
-    {
-        const std::string l_original = "hello, compress world!";
-        auto l_compressedOpt = compress::text( l_original, /*level=*/1 );
-        ASSERT_TRUE( l_compressedOpt.has_value() )
-            << "compress::text failed for simple input";
+TEST( stdfunc, filesystem$walk ) {
+    const std::filesystem::path l_root =
+        ( std::filesystem::temp_directory_path() / "stdfunc-walk" );
 
-        auto l_decompressedOpt = decompress::text( *l_compressedOpt );
-        ASSERT_TRUE( l_decompressedOpt.has_value() )
-            << "decompress::text failed for simple input";
-        EXPECT_EQ( *l_decompressedOpt, l_original );
-    }
+    std::filesystem::remove_all( l_root );
 
-    {
-        const std::string l_original = "";
-        auto l_compressedOpt = compress::text( l_original );
-        ASSERT_FALSE( l_compressedOpt.has_value() );
-#if 0
-        auto l_decompressedOpt = decompress::text( *l_compressedOpt );
-        ASSERT_FALSE( l_decompressedOpt.has_value() );
+    std::vector< std::string > l_expected;
+
+    // 3 levels of 4 directories with 5 files each, plus files in the root
+    for ( size_t l_index = 0; l_index < 84; l_index++ ) {
+        std::filesystem::path l_directory = l_root;
+
+        if ( l_index >= 4 ) {
+            const size_t l_node = ( ( l_index - 4 ) / 5 );
+
+            l_directory /= std::to_string( l_node % 4 );
+
+            if ( l_node >= 4 ) {
+                l_directory /= std::to_string( ( l_node / 4 ) % 4 );
+            }
+        }
+
+        std::filesystem::create_directories( l_directory );
+
+        const std::filesystem::path l_file =
+            ( l_directory /
+              ( "file" + std::to_string( l_index ) +
+                ( ( l_index % 3 ) ? ".txt" : ".bin" ) ) );
+
+        std::ofstream( l_file ) << l_index;
+
+        l_expected.emplace_back( l_file.string() );
+    }
+
+    // Links to files are visited, links to directories are not followed
+    std::filesystem::create_symlink( ( l_root / "file0.bin" ),
+                                     ( l_root / "link.bin" ) );
+    std::filesystem::create_directory_symlink( ( l_root / "0" ),
+                                               ( l_root / "loop" ) );
+
+    l_expected.emplace_back( ( l_root / "link.bin" ).string() );
+
+    auto l_sorted = []( std::vector< std::filesystem::path > _paths )
+        -> std::vector< std::string > {
+        std::vector< std::string > l_returnValue;
+
+        for ( const auto& _path : _paths ) {
+            l_returnValue.emplace_back( _path.string() );
+        }
+
+        std::ranges::sort( l_returnValue );
+
+        return ( l_returnValue );
+    };
+
+    std::ranges::sort( l_expected );
+
+    for ( const size_t _workers : { 1, 2, 4 } ) {
+        EXPECT_EQ( l_sorted( filesystem::getPaths( l_root.string(), {},
+                                                   { .workers = _workers } )
+                                 .value() ),
+                   l_expected );
+    }
+
+    // Filter on names, from the streaming interface
+    {
+        std::atomic< size_t > l_count = 0;
+
+        EXPECT_TRUE( filesystem::walk(
+            ( l_root.string() + "/" ),
+            []( std::string_view _name ) -> bool {
+                return ( _name.ends_with( ".bin" ) );
+            },
+            [ & ]( std::string_view _directory,
+                   std::string_view _name ) -> void {
+                EXPECT_TRUE( _name.ends_with( ".bin" ) );
+                EXPECT_TRUE( std::filesystem::is_regular_file(
+                    std::filesystem::path( _directory ) / _name ) );
+
+                l_count++;
+            },
+            { .workers = 3 } ) );
+
+        EXPECT_EQ( l_count, ( std::ranges::count_if(
+                                  l_expected,
+                                  []( std::string_view _path ) -> bool {
+                                      return ( _path.ends_with( ".bin" ) );
+                                  } ) ) );
+    }
+
+    // Depth limits and the one level regexp
+    {
+        EXPECT_EQ( filesystem::getPaths( l_root.string(), {},
+                                         { .depth = 0 } )
+                       ->size(),
+                   5 );
+        EXPECT_EQ( filesystem::getPaths( l_root.string(), {},
+                                         { .depth = 1 } )
+                       ->size(),
+                   25 );
+
+        std::string l_regexp = "file[0-9]+\\.txt";
+
+        EXPECT_EQ( l_sorted( filesystem::getPathsByRegexp( l_regexp,
+                                                           l_root.string() ) ),
+                   ( std::vector< std::string >{
+                       ( l_root / "file1.txt" ).string(),
+                       ( l_root / "file2.txt" ).string() } ) );
+        EXPECT_EQ( l_sorted( filesystem::getPathsByGlob( "file?.{txt,bin}",
+                                                         l_root.string() ) ),
+                   ( std::vector< std::string >{
+                       ( l_root / "file0.bin" ).string(),
+                       ( l_root / "file1.txt" ).string(),
+                       ( l_root / "file2.txt" ).string(),
+                       ( l_root / "file3.bin" ).string() } ) );
+
+        // Malformed runtime regexps throw as std::regex does
+        std::string l_malformed = "(";
+
+        EXPECT_THROW( ( void )filesystem::getPathsByRegexp( l_malformed,
+                                                            l_root.string() ),
+                      std::regex_error );
+    }
+
+    // A throwing filter leaves no directory open
+    if ( std::filesystem::is_directory( "/proc/self/fd" ) ) {
+        auto l_openCount = []() -> size_t {
+            return ( static_cast< size_t >( std::ranges::distance(
+                std::filesystem::directory_iterator( "/proc/self/fd" ),
+                std::filesystem::directory_iterator{} ) ) );
+        };
+
+        const size_t l_before = l_openCount();
+
+        EXPECT_THROW( ( void )filesystem::getPaths(
+                          l_root.string(),
+                          []( std::string_view ) -> bool {
+                              throw std::runtime_error( "filter" );
+                          },
+                          { .workers = 1 } ),
+                      std::runtime_error );
+        EXPECT_EQ( l_openCount(), l_before );
+    }
+
+    EXPECT_FALSE( filesystem::walk(
+        ( l_root / "missing" ).string(), {},
+        []( std::string_view, std::string_view ) -> void {} ) );
+    EXPECT_FALSE( filesystem::getPaths( ( l_root / "missing" ).string() )
+                      .has_value() );
+
+    // Unlike a missing match, a missing directory throws as it always did
+    EXPECT_THROW( ( void )filesystem::getPathsByGlob(
+                      "*", ( l_root / "missing" ).string() ),
+                  std::filesystem::filesystem_error );
+
+    std::filesystem::remove_all( l_root );
+}
+
+TEST( stdfunc, filesystem$matcher ) {
+    // Against std::regex on every name of up to 4 bytes and a few longer ones
+    {
+        std::vector< std::string > l_names{
+            "file1.txt", "file12.txt", "foo.png",   "bar.jpg",
+            "x.tga",     "a\nb",       "needle",    "a needle in a haystack",
+            "AAA",       "aaa",        "abcbc",     "yyyz",
+            "__init__",  "data.tar.gz" };
+
+        for ( size_t l_length = 0; l_length <= 4; l_length++ ) {
+            size_t l_count = 1;
+
+            for ( size_t l_index = 0; l_index < l_length; l_index++ ) {
+                l_count *= 5;
+            }
+
+            for ( size_t l_index = 0; l_index < l_count; l_index++ ) {
+                std::string l_name;
+
+                for ( size_t l_digit = 0, l_rest = l_index;
+                      l_digit < l_length; l_digit++, l_rest /= 5 ) {
+                    l_name += "ab.1\n"[ l_rest % 5 ];
+                }
+
+                l_names.emplace_back( std::move( l_name ) );
+            }
+        }
+
+        for ( const std::string_view _pattern : {
+                  // Literals
+                  "", "abc", "needle", "(foo|bar)\\.(png|jpg)", "a{3}",
+                  "[aA]b?",
+                  // Prefix and suffixes
+                  ".*\\.txt", ".*\\.(png|jpg|tga)", "file.*", "a.*b",
+                  "[\\s\\S]*1", "__.*__",
+                  // Substring
+                  ".*needle.*", ".*\\..*", "[^]*a1[^]*",
+                  // Automaton
+                  "file[0-9]+\\.txt", "[^.]*", "\\w+\\.\\d{1,3}",
+                  "x?y*z+", "(ab|a)(bc|c)*", "^a.c$", "[a-c-]+",
+                  "\\x41.*", "(?:ab)+c?", "(a|b)*?1", ".{2,}", "a|b|",
+                  "(a|)+b", "[\\d.]+", "\\n", "[^\\n]+", "\\.\\.?",
+                  // Fallbacks
+                  "(a)\\1", "a(?=b).*", "[[:alpha:]]+", "\\bab",
+                  // Malformed
+                  "(", "a)", "[b", "a{2,1}", "*a" } ) {
+            std::optional< std::regex > l_regexp;
+
+            try {
+                l_regexp.emplace( _pattern.begin(), _pattern.end() );
+            } catch ( const std::regex_error& ) {
+            }
+
+            const filesystem::matcher l_matcher( _pattern );
+
+            EXPECT_EQ( l_matcher.isValid(), l_regexp.has_value() )
+                << _pattern;
+
+            for ( const std::string& _name : l_names ) {
+                EXPECT_EQ(
+                    l_matcher( _name ),
+                    ( l_regexp && std::regex_match( _name, *l_regexp ) ) )
+                    << _pattern << " on " << _name;
+            }
+        }
+    }
+
+    // Globs
+    {
+        const filesystem::matcher l_extension( "*.txt",
+                                               filesystem::syntax::glob );
+
+        EXPECT_TRUE( l_extension( "a.txt" ) );
+        EXPECT_TRUE( l_extension( ".txt" ) );
+        EXPECT_FALSE( l_extension( "a.txt.bin" ) );
+        EXPECT_FALSE( l_extension( "a/b.txt" ) );
+
+        const filesystem::matcher l_complex(
+            "[!.]?le[0-9]*.{png,jp{e,}g}", filesystem::syntax::glob );
+
+        EXPECT_TRUE( l_complex( "file1.png" ) );
+        EXPECT_TRUE( l_complex( "tile42x.jpeg" ) );
+        EXPECT_TRUE( l_complex( "Mxle7.jpg" ) );
+        EXPECT_FALSE( l_complex( ".ile1.png" ) );
+        EXPECT_FALSE( l_complex( "file.jpeg" ) );
+        EXPECT_FALSE( l_complex( "file1.gif" ) );
+
+        const filesystem::matcher l_escaped( "\\*{,.bak}",
+                                             filesystem::syntax::glob );
+
+        EXPECT_TRUE( l_escaped( "*" ) );
+        EXPECT_TRUE( l_escaped( "*.bak" ) );
+        EXPECT_FALSE( l_escaped( "a" ) );
+
+        EXPECT_TRUE(
+            filesystem::matcher( "*", filesystem::syntax::glob )( "" ) );
+        EXPECT_FALSE(
+            filesystem::matcher( "[a", filesystem::syntax::glob ).isValid() );
+        EXPECT_FALSE(
+            filesystem::matcher( "{a,b", filesystem::syntax::glob ).isValid() );
+    }
+
+    // Cache
+    {
+        const auto l_first = filesystem::cachedMatcher( ".*\\.txt" );
+
+        EXPECT_EQ( filesystem::cachedMatcher( ".*\\.txt" ), l_first );
+        EXPECT_NE( filesystem::cachedMatcher( ".*\\.txt",
+                                              filesystem::syntax::glob ),
+                   l_first );
+        EXPECT_TRUE( ( *l_first )( "a.txt" ) );
+
+        // Invalid patterns are not kept
+        EXPECT_NE( filesystem::cachedMatcher( "(" ),
+                   filesystem::cachedMatcher( "(" ) );
+        EXPECT_FALSE( filesystem::cachedMatcher( "(" )->isValid() );
+    }
+}
+
+TEST( stdfunc, async$pipeline ) {
+    // Bounded queue
+    {
+        async::queue< int > l_queue( 2 );
+
+        EXPECT_TRUE( l_queue.push( 1 ) );
+        EXPECT_TRUE( l_queue.push( 2 ) );
+
+        std::atomic< bool > l_isPushed = false;
+
+        std::jthread l_producer( [ & ]() -> void {
+            EXPECT_TRUE( l_queue.push( 3 ) );
+
+            l_isPushed = true;
+        } );
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+        EXPECT_FALSE( l_isPushed );
+
+        EXPECT_EQ( l_queue.pop(), 1 );
+
+        l_producer.join();
+
+        EXPECT_TRUE( l_isPushed );
+
+        l_queue.close();
+
+        EXPECT_FALSE( l_queue.push( 4 ) );
+        EXPECT_EQ( l_queue.pop(), 2 );
+        EXPECT_EQ( l_queue.pop(), 3 );
+        EXPECT_EQ( l_queue.pop(), std::nullopt );
+    }
+
+    async::pool l_pool( 4, 2 );
+
+    EXPECT_EQ( l_pool.workers(), 4 );
+
+    // Tasks hop onto the pool, nest and pass exceptions on
+    {
+        auto l_square = [ & ]( int _value ) -> async::task< int > {
+            co_await l_pool.schedule();
+
+            co_return ( _value * _value );
+        };
+
+        auto l_sum = [ & ]( int _count ) -> async::task< int > {
+            int l_returnValue = 0;
+
+            for ( int l_index = 0; l_index < _count; l_index++ ) {
+                l_returnValue += co_await l_square( l_index );
+            }
+
+            co_return ( l_returnValue );
+        };
+
+        EXPECT_EQ( async::wait( l_sum( 10 ) ), 285 );
+
+        const std::thread::id l_caller = std::this_thread::get_id();
+
+        auto l_where = [ & ]() -> async::task< std::thread::id > {
+            co_await l_pool.schedule();
+
+            co_return ( std::this_thread::get_id() );
+        };
+
+        EXPECT_NE( async::wait( l_where() ), l_caller );
+
+        auto l_throw = [ & ]() -> async::task<> {
+            co_await l_pool.schedule();
+
+            throw std::runtime_error( "task" );
+        };
+
+        EXPECT_THROW( async::wait( l_throw() ), std::runtime_error );
+    }
+
+    // Ordered and unordered completion, with items finishing out of order
+    for ( const bool l_isOrdered : { true, false } ) {
+        int l_next = 0;
+        std::vector< int > l_written;
+
+        EXPECT_TRUE( async::pipeline(
+            [ & ]() -> std::optional< int > {
+                if ( l_next == 200 ) {
+                    return ( std::nullopt );
+                }
+
+                return ( l_next++ );
+            },
+            [ & ]( int _value ) -> std::optional< int > {
+                if ( ( _value % 7 ) == 0 ) {
+                    std::this_thread::sleep_for(
+                        std::chrono::microseconds( 500 ) );
+                }
+
+                return ( _value * 2 );
+            },
+            [ & ]( int _value ) -> bool {
+                l_written.emplace_back( _value );
+
+                return ( true );
+            },
+            { .depth = 8, .ordered = l_isOrdered }, l_pool ) );
+
+        ASSERT_EQ( l_written.size(), 200 );
+
+        if ( l_isOrdered ) {
+            for ( int l_index = 0; l_index < 200; l_index++ ) {
+                EXPECT_EQ( l_written[ l_index ], ( l_index * 2 ) );
+            }
+        }
+
+        std::ranges::sort( l_written );
+
+        EXPECT_EQ( l_written.back(), 398 );
+        EXPECT_EQ( std::ranges::adjacent_find( l_written ), l_written.end() );
+    }
+
+    // Failures stop reading and drain what is in flight
+    {
+        int l_next = 0;
+
+        EXPECT_FALSE( async::pipeline(
+            [ & ]() -> std::optional< int > { return ( l_next++ ); },
+            [ & ]( int _value ) -> std::optional< int > {
+                if ( _value == 50 ) {
+                    return ( std::nullopt );
+                }
+
+                return ( _value );
+            },
+            []( int ) -> bool { return ( true ); }, {}, l_pool ) );
+
+        EXPECT_LT( l_next, 100 );
+
+        l_next = 0;
+        size_t l_writes = 0;
+
+        EXPECT_FALSE( async::pipeline(
+            [ & ]() -> std::optional< int > { return ( l_next++ ); },
+            []( int _value ) -> std::optional< int > { return ( _value ); },
+            [ & ]( int ) -> bool { return ( ++l_writes < 10 ); }, {},
+            l_pool ) );
+
+        EXPECT_EQ( l_writes, 10 );
+    }
+
+    // Nothing to read
+    EXPECT_TRUE( async::pipeline(
+        []() -> std::optional< int > { return ( std::nullopt ); },
+        []( int _value ) -> std::optional< int > { return ( _value ); },
+        []( int ) -> bool { return ( false ); }, {}, l_pool ) );
+}
+
+TEST( stdfunc, compress$decompress ) {
+    {
+        const std::string l_original = "hello, compress world!";
+        auto l_compressedOpt = compress::text( l_original, /*level=*/1 );
+        ASSERT_TRUE( l_compressedOpt.has_value() )
+            << "compress::text failed for simple input";
+
+        auto l_decompressedOpt = decompress::text( *l_compressedOpt );
+        ASSERT_TRUE( l_decompressedOpt.has_value() )
+            << "decompress::text failed for simple input";
+        EXPECT_EQ( *l_decompressedOpt, l_original );
+    }
+
+    {
+        const std::string l_original = "";
+        auto l_compressedOpt = compress::text( l_original );
+        ASSERT_FALSE( l_compressedOpt.has_value() );
+#if 0
+        auto l_decompressedOpt = decompress::text( *l_compressedOpt );
+        ASSERT_FALSE( l_decompressedOpt.has_value() );
 #endif
     }
 
@@ -1032,6 +2134,2242 @@ TEST( stdfunc, compress$decompress ) {
     }
 }
 
+TEST( stdfunc, compress$context ) {
+    std::vector< std::byte > l_message( 200 );
+
+    for ( size_t l_index = 0; l_index < l_message.size(); l_index++ ) {
+        l_message[ l_index ] =
+            std::byte( static_cast< unsigned char >( ( l_index * 7 ) % 13 ) );
+    }
+
+    // Context output matches the free function at the same level
+    {
+        compress::context l_compressContext( 19 );
+        decompress::context l_decompressContext;
+
+        EXPECT_EQ( l_compressContext.level(), 19 );
+
+        for ( size_t l_iteration = 0; l_iteration < 1000; l_iteration++ ) {
+            l_message[ l_iteration % l_message.size() ] ^= std::byte{ 1 };
+
+            auto l_compressed = l_compressContext.data( l_message );
+            ASSERT_TRUE( l_compressed.has_value() );
+
+            EXPECT_EQ( l_compressed, compress::data( l_message, 19 ) );
+
+            auto l_decompressed =
+                l_decompressContext.data( *l_compressed, l_message.size() );
+            ASSERT_TRUE( l_decompressed.has_value() );
+            EXPECT_EQ( *l_decompressed, l_message );
+        }
+
+        EXPECT_FALSE( l_compressContext.data( {} ).has_value() );
+    }
+
+    // Moved-from contexts fail instead of crashing
+    {
+        compress::context l_first( 3 );
+        compress::context l_second = std::move( l_first );
+
+        EXPECT_FALSE( l_first.data( l_message ).has_value() );
+        EXPECT_TRUE( l_second.data( l_message ).has_value() );
+
+        decompress::context l_decompressFirst;
+        decompress::context l_decompressSecond;
+        l_decompressSecond = std::move( l_decompressFirst );
+
+        auto l_compressed = l_second.data( l_message );
+        ASSERT_TRUE( l_compressed.has_value() );
+
+        EXPECT_FALSE(
+            l_decompressFirst.data( *l_compressed, l_message.size() )
+                .has_value() );
+        EXPECT_EQ(
+            l_decompressSecond.data( *l_compressed, l_message.size() ),
+            l_message );
+    }
+
+    // Per-thread cached contexts with mixed levels
+    {
+        std::vector< std::thread > l_threads;
+        std::atomic< size_t > l_failures = 0;
+
+        for ( size_t l_thread = 0; l_thread < 4; l_thread++ ) {
+            l_threads.emplace_back( [ & ] -> void {
+                for ( size_t l_iteration = 0; l_iteration < 200;
+                      l_iteration++ ) {
+                    const auto l_compressed = compress::data(
+                        l_message, ( ( l_iteration % 9 ) + 1 ) );
+
+                    if ( !l_compressed || ( decompress::data(
+                                                *l_compressed,
+                                                l_message.size() ) !=
+                                            l_message ) ) {
+                        l_failures++;
+                    }
+                }
+            } );
+        }
+
+        for ( std::thread& _thread : l_threads ) {
+            _thread.join();
+        }
+
+        EXPECT_EQ( l_failures, 0 );
+    }
+}
+
+TEST( stdfunc, compress$buffers ) {
+    std::vector< std::byte > l_original( 4096 );
+
+    for ( size_t l_index = 0; l_index < l_original.size(); l_index++ ) {
+        l_original[ l_index ] =
+            std::byte( static_cast< unsigned char >( l_index % 61 ) );
+    }
+
+    // Caller-provided buffers
+    {
+        std::vector< std::byte > l_buffer(
+            compress::dataBound( l_original.size() ) );
+
+        const auto l_compressedSize =
+            compress::data( l_original, std::span( l_buffer ) );
+        ASSERT_TRUE( l_compressedSize.has_value() );
+        EXPECT_LE( *l_compressedSize, l_buffer.size() );
+
+        const std::span< const std::byte > l_frame =
+            std::span( l_buffer ).first( *l_compressedSize );
+
+        EXPECT_EQ( compress::data( l_original ),
+                   std::vector( l_frame.begin(), l_frame.end() ) );
+
+        std::vector< std::byte > l_decompressed( l_original.size() );
+
+        EXPECT_EQ( decompress::data( l_frame, std::span( l_decompressed ) ),
+                   l_original.size() );
+        EXPECT_EQ( l_decompressed, l_original );
+
+        // Too small
+        std::array< std::byte, 4 > l_small{};
+
+        EXPECT_FALSE(
+            compress::data( l_original, std::span( l_small ) ).has_value() );
+        EXPECT_FALSE(
+            decompress::data( l_frame, std::span( l_small ) ).has_value() );
+    }
+
+    // Appending keeps existing contents
+    {
+        std::vector< std::byte > l_compressed{ std::byte{ 0xAA } };
+
+        const auto l_compressedSize =
+            compress::data( l_original, l_compressed, 5 );
+        ASSERT_TRUE( l_compressedSize.has_value() );
+        EXPECT_EQ( l_compressed.size(), ( *l_compressedSize + 1 ) );
+        EXPECT_EQ( l_compressed.front(), std::byte{ 0xAA } );
+
+        std::vector< std::byte > l_decompressed{ std::byte{ 0xBB } };
+
+        EXPECT_EQ( decompress::data( std::span( l_compressed ).subspan( 1 ),
+                                     l_decompressed, l_original.size() ),
+                   l_original.size() );
+        EXPECT_EQ( l_decompressed.front(), std::byte{ 0xBB } );
+        EXPECT_TRUE( std::ranges::equal(
+            std::span( l_decompressed ).subspan( 1 ), l_original ) );
+
+        // Failure leaves the output untouched
+        EXPECT_FALSE( decompress::data( std::span( l_compressed ).first( 1 ),
+                                        l_decompressed, l_original.size() )
+                          .has_value() );
+        EXPECT_EQ( l_decompressed.size(), ( l_original.size() + 1 ) );
+    }
+
+    // Text
+    {
+        const std::string l_original( 1000, 'x' );
+
+        std::string l_buffer( compress::textBound( l_original.size() ), '\0' );
+
+        const auto l_compressedSize =
+            compress::text( l_original, std::span( l_buffer ) );
+        ASSERT_TRUE( l_compressedSize.has_value() );
+
+        l_buffer.resize( *l_compressedSize );
+
+        EXPECT_EQ( decompress::textSize( l_buffer ), l_original.size() );
+
+        std::string l_decompressed = "prefix";
+
+        EXPECT_EQ( decompress::text( l_buffer, l_decompressed ),
+                   l_original.size() );
+        EXPECT_EQ( l_decompressed, ( "prefix" + l_original ) );
+
+        std::string l_compressed = "prefix";
+
+        EXPECT_EQ( compress::text( l_original, l_compressed ),
+                   l_buffer.size() );
+        EXPECT_EQ( l_compressed, ( "prefix" + l_buffer ) );
+
+        std::array< char, 8 > l_small{};
+
+        EXPECT_FALSE(
+            compress::text( l_original, std::span( l_small ) ).has_value() );
+        EXPECT_FALSE(
+            decompress::text( l_buffer, std::span( l_small ) ).has_value() );
+    }
+}
+
+TEST( stdfunc, compress$dataFragments ) {
+    std::vector< std::byte > l_original( 700 * 1024 );
+
+    uint64_t l_state = 0x9E3779B97F4A7C15;
+
+    for ( auto& _byte : l_original ) {
+        l_state ^= ( l_state << 13 );
+        l_state ^= ( l_state >> 7 );
+        l_state ^= ( l_state << 17 );
+
+        _byte = std::byte( "header: value\r\n"[ l_state % 15 ] );
+    }
+
+    // Same frame as the concatenation, streamed below 512 KiB and gathered
+    // above, with empty fragments anywhere
+    for ( const size_t l_size : { size_t{ 1 }, size_t{ 100 }, size_t{ 4096 },
+                                  size_t{ 200000 }, size_t{ 512 * 1024 },
+                                  l_original.size() } ) {
+        const std::span< const std::byte > l_data =
+            std::span( l_original ).first( l_size );
+
+        for ( const size_t l_level : { 1, 3, 19 } ) {
+            const auto l_expected = compress::data( l_data, l_level );
+            ASSERT_TRUE( l_expected.has_value() );
+
+            const std::array< std::span< const std::byte >, 6 > l_fragments{
+                std::span< const std::byte >{},
+                l_data.first( l_size / 7 ),
+                l_data.subspan( l_size / 7, ( l_size / 3 ) - ( l_size / 7 ) ),
+                std::span< const std::byte >{},
+                l_data.subspan( l_size / 3 ),
+                std::span< const std::byte >{} };
+
+            EXPECT_EQ( compress::data( l_fragments, l_level ), l_expected );
+        }
+    }
+
+    const std::span< const std::byte > l_data =
+        std::span( l_original ).first( 10000 );
+    const std::vector< std::span< const std::byte > > l_fragments{
+        l_data.first( 10 ), l_data.subspan( 10, 990 ), l_data.subspan( 1000 ) };
+
+    // Single fragment
+    EXPECT_EQ( compress::data( std::span( l_fragments ).first( 1 ) ),
+               compress::data( l_data.first( 10 ) ) );
+
+    // Caller buffer, appending and decompression
+    {
+        std::vector< std::byte > l_buffer(
+            compress::dataBound( l_data.size() ) );
+
+        const auto l_compressedSize =
+            compress::data( l_fragments, std::span( l_buffer ) );
+        ASSERT_TRUE( l_compressedSize.has_value() );
+
+        l_buffer.resize( *l_compressedSize );
+
+        EXPECT_EQ( decompress::dataSize( l_buffer ), l_data.size() );
+        EXPECT_TRUE( std::ranges::equal( *decompress::data( l_buffer ),
+                                         l_data ) );
+
+        std::vector< std::byte > l_appended{ std::byte{ 0xAA } };
+
+        EXPECT_EQ( compress::data( l_fragments, l_appended ),
+                   l_buffer.size() );
+        EXPECT_TRUE( std::ranges::equal( std::span( l_appended ).subspan( 1 ),
+                                         l_buffer ) );
+
+        // Too small, then the thread context still works
+        std::array< std::byte, 16 > l_small{};
+
+        EXPECT_FALSE(
+            compress::data( l_fragments, std::span( l_small ) ).has_value() );
+        EXPECT_EQ( compress::data( l_fragments ),
+                   compress::data( l_data ) );
+    }
+
+    // Nothing to compress
+    EXPECT_FALSE(
+        compress::data( std::span< const std::span< const std::byte > >{} )
+            .has_value() );
+    EXPECT_FALSE(
+        compress::data( std::array< std::span< const std::byte >, 2 >{} )
+            .has_value() );
+    EXPECT_FALSE( compress::data( l_fragments, 0 ).has_value() );
+}
+
+TEST( stdfunc, compress$stream ) {
+    std::vector< std::byte > l_original( ( 3 * 1024 * 1024 ) + 17 );
+
+    for ( size_t l_index = 0; l_index < l_original.size(); l_index++ ) {
+        l_original[ l_index ] = std::byte( static_cast< unsigned char >(
+            ( ( l_index / 100 ) * 7 ) ^ ( l_index % 5 ) ) );
+    }
+
+    auto l_appendTo = []( std::vector< std::byte >& _output ) {
+        return ( [ &_output ]( std::span< const std::byte > _chunk ) -> bool {
+            _output.insert( _output.end(), _chunk.begin(), _chunk.end() );
+
+            return ( true );
+        } );
+    };
+
+    // Pushes in uneven pieces
+    auto l_compress = [ & ]( auto& _stream ) -> std::vector< std::byte > {
+        std::vector< std::byte > l_compressed;
+
+        std::span< const std::byte > l_input = l_original;
+
+        while ( !l_input.empty() ) {
+            const size_t l_size = std::min( l_input.size(), 12'345uz );
+
+            EXPECT_TRUE(
+                _stream.write( l_input.first( l_size ),
+                               l_appendTo( l_compressed ) ) );
+
+            l_input = l_input.subspan( l_size );
+        }
+
+        EXPECT_TRUE( _stream.finish( l_appendTo( l_compressed ) ) );
+
+        return ( l_compressed );
+    };
+
+    // Pulls through a small output window
+    auto l_decompress =
+        [ & ]( auto& _stream, std::span< const std::byte > _compressed )
+        -> std::optional< std::vector< std::byte > > {
+        std::vector< std::byte > l_decompressed;
+        std::array< std::byte, 1000 > l_window{};
+
+        while ( !_compressed.empty() || !_stream.finished() ) {
+            std::span< std::byte > l_output = l_window;
+
+            if ( !_stream.update( _compressed, l_output ) ) {
+                return ( std::nullopt );
+            }
+
+            const size_t l_size = ( l_window.size() - l_output.size() );
+
+            if ( !l_size && _compressed.empty() ) {
+                break;
+            }
+
+            l_decompressed.insert( l_decompressed.end(), l_window.begin(),
+                                   ( l_window.begin() + l_size ) );
+        }
+
+        if ( !_stream.finished() ) {
+            return ( std::nullopt );
+        }
+
+        return ( l_decompressed );
+    };
+
+    // zstd
+    {
+        compress::dataStream l_compressStream( 3 );
+
+        const std::vector< std::byte > l_compressed =
+            l_compress( l_compressStream );
+
+        EXPECT_LT( l_compressed.size(), l_original.size() );
+
+        // Regular frame
+        EXPECT_EQ( decompress::data( l_compressed, l_original.size() ),
+                   l_original );
+
+        decompress::dataStream l_decompressStream;
+
+        EXPECT_EQ( l_decompress( l_decompressStream, l_compressed ),
+                   l_original );
+
+        // Truncated
+        decompress::dataStream l_truncatedStream;
+
+        EXPECT_FALSE(
+            l_decompress( l_truncatedStream,
+                          std::span( l_compressed ).first(
+                              l_compressed.size() - 1 ) )
+                .has_value() );
+
+        // Concatenated frames from one stream, pushed into one sink
+        std::vector< std::byte > l_twice = l_compress( l_compressStream );
+        l_twice.insert( l_twice.end(), l_compressed.begin(),
+                        l_compressed.end() );
+
+        std::vector< std::byte > l_decompressed;
+
+        decompress::dataStream l_pushStream;
+
+        EXPECT_TRUE(
+            l_pushStream.write( l_twice, l_appendTo( l_decompressed ) ) );
+        EXPECT_TRUE( l_pushStream.finished() );
+        EXPECT_EQ( l_decompressed.size(), ( 2 * l_original.size() ) );
+        EXPECT_TRUE( std::ranges::equal(
+            std::span( l_decompressed ).first( l_original.size() ),
+            l_original ) );
+    }
+
+    // Snappy framing format
+    {
+        compress::textStream l_compressStream;
+
+        std::vector< std::byte > l_compressed = l_compress( l_compressStream );
+
+        EXPECT_EQ( l_compressed.front(), std::byte{ 0xFF } );
+
+        decompress::textStream l_decompressStream;
+
+        EXPECT_EQ( l_decompress( l_decompressStream, l_compressed ),
+                   l_original );
+
+        // Skippable chunks are ignored
+        std::vector< std::byte > l_padded( l_compressed.begin(),
+                                           ( l_compressed.begin() + 10 ) );
+        const std::array l_padding{ std::byte{ 0xFE }, std::byte{ 2 },
+                                    std::byte{},       std::byte{},
+                                    std::byte{},       std::byte{} };
+        l_padded.insert( l_padded.end(), l_padding.begin(),
+                         l_padding.end() );
+        l_padded.insert( l_padded.end(), ( l_compressed.begin() + 10 ),
+                         l_compressed.end() );
+
+        decompress::textStream l_paddedStream;
+
+        EXPECT_EQ( l_decompress( l_paddedStream, l_padded ), l_original );
+
+        // Checksum mismatch
+        l_compressed[ l_compressed.size() / 2 ] ^= std::byte{ 0x10 };
+
+        decompress::textStream l_corruptedStream;
+
+        EXPECT_FALSE( l_decompress( l_corruptedStream, l_compressed )
+                          .has_value() );
+
+        // Missing stream identifier
+        decompress::textStream l_headlessStream;
+
+        EXPECT_FALSE(
+            l_decompress( l_headlessStream,
+                          std::span( l_compressed ).subspan( 10 ) )
+                .has_value() );
+    }
+
+    // std::istream/ std::ostream and file descriptor adapters
+    {
+        const std::string l_text(
+            reinterpret_cast< const char* >( l_original.data() ),
+            l_original.size() );
+
+        std::istringstream l_input( l_text );
+        std::stringstream l_compressed;
+        std::ostringstream l_output;
+
+        compress::dataStream l_compressStream;
+        decompress::dataStream l_decompressStream;
+
+        EXPECT_TRUE(
+            compress::pipe( l_compressStream, l_input, l_compressed ) );
+        EXPECT_TRUE(
+            decompress::pipe( l_decompressStream, l_compressed, l_output ) );
+        EXPECT_EQ( l_output.str(), l_text );
+
+        FILE* l_source = std::tmpfile();
+        FILE* l_intermediate = std::tmpfile();
+        FILE* l_destination = std::tmpfile();
+
+        ASSERT_TRUE( l_source && l_intermediate && l_destination );
+
+        std::fwrite( l_text.data(), 1, l_text.size(), l_source );
+        std::fflush( l_source );
+        std::rewind( l_source );
+
+        compress::textStream l_compressTextStream;
+        decompress::textStream l_decompressTextStream;
+
+        EXPECT_TRUE( compress::pipe( l_compressTextStream, fileno( l_source ),
+                                     fileno( l_intermediate ) ) );
+
+        std::rewind( l_intermediate );
+
+        EXPECT_TRUE( decompress::pipe( l_decompressTextStream,
+                                       fileno( l_intermediate ),
+                                       fileno( l_destination ) ) );
+
+        std::rewind( l_destination );
+
+        std::string l_result( l_text.size() + 1, '\0' );
+        l_result.resize( std::fread( l_result.data(), 1, l_result.size(),
+                                     l_destination ) );
+
+        EXPECT_EQ( l_result, l_text );
+
+        std::fclose( l_source );
+        std::fclose( l_intermediate );
+        std::fclose( l_destination );
+    }
+}
+
+TEST( stdfunc, compress$parallel ) {
+    std::vector< std::byte > l_original( 8 * 1024 * 1024 );
+
+    for ( size_t l_index = 0; l_index < l_original.size(); l_index++ ) {
+        l_original[ l_index ] = std::byte( static_cast< unsigned char >(
+            ( ( l_index / 64 ) * 13 ) ^ ( l_index % 7 ) ) );
+    }
+
+    // zstd workers, job size and long distance matching keep a standard frame
+    {
+        for ( const compress::parameters& _parameters :
+              { compress::parameters{ .level = 3, .workers = 4 },
+                compress::parameters{ .level = 5,
+                                      .workers = 2,
+                                      .jobSize = ( 1024 * 1024 ),
+                                      .longDistanceMatching = true,
+                                      .windowLog = 24 } } ) {
+            const auto l_compressed = compress::data( l_original, _parameters );
+            ASSERT_TRUE( l_compressed.has_value() );
+            EXPECT_LT( l_compressed->size(), l_original.size() );
+
+            EXPECT_EQ( decompress::data( *l_compressed, l_original.size() ),
+                       l_original );
+        }
+
+        EXPECT_FALSE(
+            compress::data( l_original, compress::parameters{ .level = 0 } )
+                .has_value() );
+    }
+
+    // Block-parallel Snappy framing
+    {
+        const std::string_view l_text(
+            reinterpret_cast< const char* >( l_original.data() ),
+            l_original.size() );
+
+        const auto l_single = compress::framedText( l_text, 1 );
+        const auto l_parallel = compress::framedText( l_text, 4 );
+        ASSERT_TRUE( l_single.has_value() );
+
+        // Deterministic regardless of threads
+        EXPECT_EQ( l_single, l_parallel );
+
+        EXPECT_EQ( decompress::framedText( *l_parallel ), l_text );
+        EXPECT_EQ( decompress::framedText( *l_parallel, 1 ), l_text );
+
+        // Same format as the streaming compressor
+        compress::textStream l_compressStream;
+        std::string l_streamed;
+
+        EXPECT_TRUE( l_compressStream.write(
+            l_original, [ & ]( std::span< const std::byte > _chunk ) -> bool {
+                l_streamed.append(
+                    reinterpret_cast< const char* >( _chunk.data() ),
+                    _chunk.size() );
+
+                return ( true );
+            } ) );
+        EXPECT_TRUE( l_compressStream.finish(
+            [ & ]( std::span< const std::byte > _chunk ) -> bool {
+                l_streamed.append(
+                    reinterpret_cast< const char* >( _chunk.data() ),
+                    _chunk.size() );
+
+                return ( true );
+            } ) );
+
+        EXPECT_EQ( l_streamed, *l_parallel );
+
+        std::string l_corrupted = *l_parallel;
+        l_corrupted[ l_corrupted.size() / 3 ] ^= 0x01;
+
+        EXPECT_FALSE( decompress::framedText( l_corrupted ).has_value() );
+        EXPECT_FALSE( decompress::framedText(
+                          std::string_view( *l_parallel ).substr( 10 ) )
+                          .has_value() );
+        EXPECT_FALSE( decompress::framedText(
+                          std::string_view( *l_parallel )
+                              .substr( 0, ( l_parallel->size() - 1 ) ) )
+                          .has_value() );
+    }
+}
+
+TEST( stdfunc, decompress$size ) {
+    std::vector< std::byte > l_original( ( 3 * 1024 * 1024 ) + 5 );
+
+    for ( size_t l_index = 0; l_index < l_original.size(); l_index++ ) {
+        l_original[ l_index ] = std::byte( static_cast< unsigned char >(
+            ( ( l_index / 100 ) * 7 ) ^ ( l_index % 3 ) ) );
+    }
+
+    const std::optional< std::vector< std::byte > > l_sized =
+        compress::data( l_original );
+
+    ASSERT_TRUE( l_sized.has_value() );
+
+    // Size stored in the frame header
+    {
+        EXPECT_EQ( decompress::dataSize( *l_sized ), l_original.size() );
+        EXPECT_EQ( decompress::data( *l_sized ), l_original );
+
+        decompress::context l_context;
+
+        EXPECT_EQ( l_context.data( *l_sized ), l_original );
+
+        // Declared size over the limit fails before allocating
+        EXPECT_FALSE( decompress::data( *l_sized, 0, ( l_original.size() - 1 ) )
+                          .has_value() );
+        EXPECT_EQ( decompress::data( *l_sized, 0, l_original.size() ),
+                   l_original );
+
+        EXPECT_FALSE( decompress::dataSize( {} ).has_value() );
+        EXPECT_FALSE( decompress::data( {} ).has_value() );
+        EXPECT_FALSE( decompress::dataSize( std::span( *l_sized ).first( 3 ) )
+                          .has_value() );
+    }
+
+    // Concatenated frames add up
+    {
+        std::vector< std::byte > l_twice = *l_sized;
+
+        l_twice.insert( l_twice.end(), l_sized->begin(), l_sized->end() );
+
+        EXPECT_EQ( decompress::dataSize( l_twice ),
+                   ( 2 * l_original.size() ) );
+
+        std::vector< std::byte > l_decompressed{ std::byte{ 0xBB } };
+
+        EXPECT_EQ( decompress::data( l_twice, l_decompressed ),
+                   ( 2 * l_original.size() ) );
+        EXPECT_EQ( l_decompressed.size(), ( ( 2 * l_original.size() ) + 1 ) );
+        EXPECT_TRUE( std::ranges::equal(
+            std::span( l_decompressed ).last( l_original.size() ),
+            l_original ) );
+    }
+
+    // A stream does not know its size up front, output grows instead
+    {
+        std::vector< std::byte > l_unsized;
+
+        compress::dataStream l_stream;
+
+        auto l_appendTo = [ &l_unsized ]( std::span< const std::byte > _chunk )
+            -> bool {
+            l_unsized.insert( l_unsized.end(), _chunk.begin(), _chunk.end() );
+
+            return ( true );
+        };
+
+        ASSERT_TRUE( l_stream.write( l_original, l_appendTo ) );
+        ASSERT_TRUE( l_stream.finish( l_appendTo ) );
+
+        EXPECT_FALSE( decompress::dataSize( l_unsized ).has_value() );
+        EXPECT_EQ( decompress::data( l_unsized ), l_original );
+
+        // Exactly at the limit still fits
+        EXPECT_EQ( decompress::data( l_unsized, 0, l_original.size() ),
+                   l_original );
+        EXPECT_FALSE(
+            decompress::data( l_unsized, 0, ( l_original.size() - 1 ) )
+                .has_value() );
+
+        // Truncated
+        std::vector< std::byte > l_decompressed{ std::byte{ 0xBB } };
+
+        EXPECT_FALSE(
+            decompress::data( std::span( l_unsized ).first(
+                                  l_unsized.size() - 1 ),
+                              l_decompressed )
+                .has_value() );
+        EXPECT_EQ( l_decompressed.size(), 1 );
+    }
+}
+
+TEST( stdfunc, compress$dictionary ) {
+    // Small JSON messages sharing keys and structure
+    auto l_message = []( size_t _index, std::string_view _kind ) {
+        const std::string l_message =
+            ( R"({"id":)" + std::to_string( _index ) + R"(,"kind":")" +
+              std::string( _kind ) + R"(","user":"user)" +
+              std::to_string( _index % 97 ) +
+              R"(","tags":["alpha","beta","gamma"],"score":)" +
+              std::to_string( _index * 37 % 1000 ) + R"(,"active":)" +
+              ( ( _index % 2 ) ? "true" : "false" ) +
+              R"(,"comment":"message number )" + std::to_string( _index ) +
+              R"("})" );
+
+        return ( std::vector< std::byte >(
+            reinterpret_cast< const std::byte* >( l_message.data() ),
+            reinterpret_cast< const std::byte* >( l_message.data() +
+                                                  l_message.size() ) ) );
+    };
+
+    auto l_train = [ & ]( std::string_view _kind ) {
+        std::vector< std::vector< std::byte > > l_samples;
+        std::vector< std::span< const std::byte > > l_spans;
+
+        for ( size_t l_index = 0; l_index < 2000; l_index++ ) {
+            l_samples.emplace_back( l_message( l_index, _kind ) );
+        }
+
+        for ( const std::vector< std::byte >& _sample : l_samples ) {
+            l_spans.emplace_back( _sample );
+        }
+
+        return ( compress::trainDictionary( l_spans, ( 4 * 1024 ) ) );
+    };
+
+    const std::optional< std::vector< std::byte > > l_content =
+        l_train( "order" );
+
+    ASSERT_TRUE( l_content.has_value() );
+    EXPECT_LE( l_content->size(), ( 4 * 1024 ) );
+
+    EXPECT_FALSE( compress::trainDictionary( {} ).has_value() );
+
+    const compress::dictionary l_compressDictionary( *l_content, 3 );
+    const decompress::dictionary l_decompressDictionary( *l_content );
+
+    EXPECT_NE( l_compressDictionary.id(), 0 );
+    EXPECT_EQ( l_compressDictionary.id(), l_decompressDictionary.id() );
+
+    // Messages not seen during training
+    size_t l_plainSize = 0;
+    size_t l_dictionarySize = 0;
+
+    for ( size_t l_index = 5000; l_index < 5100; l_index++ ) {
+        const std::vector< std::byte > l_original =
+            l_message( l_index, "order" );
+
+        const std::optional< std::vector< std::byte > > l_plain =
+            compress::data( l_original );
+        const std::optional< std::vector< std::byte > > l_compressed =
+            compress::data( l_original, l_compressDictionary );
+
+        ASSERT_TRUE( l_plain.has_value() );
+        ASSERT_TRUE( l_compressed.has_value() );
+
+        l_plainSize += l_plain->size();
+        l_dictionarySize += l_compressed->size();
+
+        EXPECT_EQ( decompress::data( *l_compressed, l_decompressDictionary ),
+                   l_original );
+
+        // The cached context forgets the dictionary afterwards
+        EXPECT_EQ( decompress::data( *l_plain ), l_original );
+    }
+
+    EXPECT_LT( ( l_dictionarySize * 2 ), l_plainSize );
+
+    const std::vector< std::byte > l_original = l_message( 7, "order" );
+
+    // Contexts, buffers and appending
+    {
+        compress::context l_compressContext( 19 );
+        decompress::context l_decompressContext;
+
+        std::vector< std::byte > l_compressed{ std::byte{ 0xAA } };
+
+        const std::optional< size_t > l_compressedSize =
+            l_compressContext.data( l_original, l_compressed,
+                                    l_compressDictionary );
+
+        ASSERT_TRUE( l_compressedSize.has_value() );
+        EXPECT_EQ( l_compressed.size(), ( *l_compressedSize + 1 ) );
+
+        const std::span< const std::byte > l_frame =
+            std::span( l_compressed ).subspan( 1 );
+
+        EXPECT_EQ( l_compressContext.data( l_original, l_compressDictionary ),
+                   compress::data( l_original, l_compressDictionary ) );
+
+        std::vector< std::byte > l_buffer( l_original.size() );
+
+        EXPECT_EQ( l_decompressContext.data( l_frame, std::span( l_buffer ),
+                                             l_decompressDictionary ),
+                   l_original.size() );
+        EXPECT_EQ( l_buffer, l_original );
+
+        std::vector< std::byte > l_decompressed;
+
+        EXPECT_EQ( decompress::data( l_frame, l_decompressed,
+                                     l_decompressDictionary ),
+                   l_original.size() );
+        EXPECT_EQ( l_decompressed, l_original );
+        EXPECT_EQ( l_decompressContext.data( l_frame, l_decompressDictionary ),
+                   l_original );
+
+        // Level 19 context compresses without a dictionary as before
+        const std::optional< std::vector< std::byte > > l_plain =
+            l_compressContext.data( l_original );
+
+        ASSERT_TRUE( l_plain.has_value() );
+        EXPECT_EQ( l_decompressContext.data( *l_plain ), l_original );
+    }
+
+    // Dictionary IDs are verified
+    {
+        const std::optional< std::vector< std::byte > > l_otherContent =
+            l_train( "refund" );
+
+        ASSERT_TRUE( l_otherContent.has_value() );
+
+        const decompress::dictionary l_other( *l_otherContent );
+
+        EXPECT_NE( l_other.id(), l_decompressDictionary.id() );
+
+        const std::optional< std::vector< std::byte > > l_compressed =
+            compress::data( l_original, l_compressDictionary );
+
+        ASSERT_TRUE( l_compressed.has_value() );
+        EXPECT_FALSE(
+            decompress::data( *l_compressed, l_other ).has_value() );
+        EXPECT_FALSE( decompress::data( *l_compressed ).has_value() );
+        EXPECT_EQ( decompress::data( *l_compressed, l_decompressDictionary ),
+                   l_original );
+    }
+}
+
+TEST( stdfunc, compress$seekable ) {
+    std::vector< std::byte > l_original( ( 2 * 1024 * 1024 ) + 777 );
+
+    for ( size_t l_index = 0; l_index < l_original.size(); l_index++ ) {
+        l_original[ l_index ] = std::byte( static_cast< unsigned char >(
+            ( ( l_index / 100 ) * 7 ) ^ ( l_index % 11 ) ) );
+    }
+
+    constexpr size_t l_chunkSize = ( 64 * 1024 );
+
+    const std::optional< std::vector< std::byte > > l_compressed =
+        compress::seekable( l_original, l_chunkSize, 3, 4 );
+
+    ASSERT_TRUE( l_compressed.has_value() );
+    EXPECT_LT( l_compressed->size(), l_original.size() );
+
+    // Seek table footer
+    EXPECT_EQ( l_compressed->back(), std::byte{ 0x8F } );
+
+    // The seek table is a skippable frame
+    EXPECT_EQ( decompress::data( *l_compressed ), l_original );
+
+    EXPECT_FALSE( compress::seekable( l_original, 0 ).has_value() );
+
+    // The stream writes the same bytes
+    {
+        std::vector< std::byte > l_streamed;
+
+        auto l_appendTo = [ &l_streamed ]( std::span< const std::byte > _chunk )
+            -> bool {
+            l_streamed.insert( l_streamed.end(), _chunk.begin(),
+                               _chunk.end() );
+
+            return ( true );
+        };
+
+        compress::seekableStream l_stream( l_chunkSize, 3 );
+
+        for ( size_t l_offset = 0; l_offset < l_original.size();
+              l_offset += 10007 ) {
+            ASSERT_TRUE( l_stream.write(
+                std::span( l_original )
+                    .subspan( l_offset, std::min< size_t >(
+                                            10007, ( l_original.size() -
+                                                     l_offset ) ) ),
+                l_appendTo ) );
+        }
+
+        ASSERT_TRUE( l_stream.finish( l_appendTo ) );
+        EXPECT_EQ( l_streamed, *l_compressed );
+    }
+
+    // Random access
+    {
+        decompress::seekable l_reader( *l_compressed, 2, 4 );
+
+        ASSERT_TRUE( l_reader.isValid() );
+        EXPECT_EQ( l_reader.size(), l_original.size() );
+        EXPECT_EQ( l_reader.chunkCount(),
+                   ( ( l_original.size() + l_chunkSize - 1 ) / l_chunkSize ) );
+
+        for ( const auto [ _offset, _size ] :
+              std::initializer_list< std::pair< size_t, size_t > >{
+                  { 0, 10 },
+                  { ( l_chunkSize - 5 ), 10 },
+                  { 1'000'000, 4096 },
+                  { 1'000'000, 4096 },
+                  { 100, ( 5 * l_chunkSize ) },
+                  { ( l_original.size() - 3 ), 100 },
+                  { 0, l_original.size() } } ) {
+            const size_t l_size =
+                std::min( _size, ( l_original.size() - _offset ) );
+
+            const std::optional< std::vector< std::byte > > l_bytes =
+                l_reader.read( _offset, _size );
+
+            ASSERT_TRUE( l_bytes.has_value() );
+            EXPECT_TRUE( std::ranges::equal(
+                *l_bytes,
+                std::span( l_original ).subspan( _offset, l_size ) ) );
+        }
+
+        EXPECT_EQ( l_reader.read( l_original.size(), 10 ),
+                   std::vector< std::byte >{} );
+        EXPECT_FALSE( l_reader.read( ( l_original.size() + 1 ), 10 ) );
+    }
+
+    // Corrupted chunks fail only the reads covering them
+    {
+        std::vector< std::byte > l_corrupted = *l_compressed;
+
+        l_corrupted[ 100 ] ^= std::byte{ 0x55 };
+
+        decompress::seekable l_reader( l_corrupted );
+
+        ASSERT_TRUE( l_reader.isValid() );
+        EXPECT_FALSE( l_reader.read( 0, 10 ).has_value() );
+        EXPECT_EQ( l_reader.read( l_chunkSize, 10 ),
+                   std::vector< std::byte >(
+                       ( l_original.begin() + l_chunkSize ),
+                       ( l_original.begin() + l_chunkSize + 10 ) ) );
+
+        EXPECT_FALSE( decompress::seekable(
+                          std::span( *l_compressed ).first(
+                              l_compressed->size() - 1 ) )
+                          .isValid() );
+        EXPECT_FALSE( decompress::seekable( l_original ).isValid() );
+    }
+
+    // Tables that would decompress beyond _maxSize, checked before anything
+    // is allocated
+    {
+        EXPECT_TRUE( decompress::seekable( *l_compressed, 0, 8,
+                                           l_original.size() )
+                         .isValid() );
+        EXPECT_FALSE( decompress::seekable( *l_compressed, 0, 8,
+                                            ( l_original.size() - 1 ) )
+                          .isValid() );
+
+        std::vector< std::byte > l_crafted = *l_compressed;
+
+        auto l_little = [ & ]( size_t _offset ) -> uint32_t {
+            uint32_t l_value = 0;
+
+            for ( size_t l_byte = 0; l_byte < 4; l_byte++ ) {
+                l_value |= ( std::to_integer< uint32_t >(
+                                 l_crafted[ _offset + l_byte ] )
+                             << ( l_byte * 8 ) );
+            }
+
+            return ( l_value );
+        };
+
+        // Footer: chunk count, descriptor with the checksum flag, magic
+        const size_t l_chunkCount = l_little( l_crafted.size() - 9 );
+        const auto l_descriptor =
+            std::to_integer< uint8_t >( l_crafted[ l_crafted.size() - 5 ] );
+        const size_t l_entrySize = ( ( l_descriptor & 0x80 ) ? 12 : 8 );
+        const size_t l_firstEntry =
+            ( l_crafted.size() - 9 - ( l_chunkCount * l_entrySize ) );
+
+        // Decompressed size of the first chunk
+        std::fill_n( ( l_crafted.begin() + l_firstEntry + 4 ), 4,
+                     std::byte{ 0xFF } );
+
+        EXPECT_FALSE( decompress::seekable( l_crafted ).isValid() );
+    }
+
+    // From a file
+    {
+        FILE* l_file = std::tmpfile();
+
+        ASSERT_TRUE( l_file );
+
+        std::fwrite( l_compressed->data(), 1, l_compressed->size(), l_file );
+        std::fflush( l_file );
+
+        decompress::seekable l_reader( fileno( l_file ) );
+
+        ASSERT_TRUE( l_reader.isValid() );
+        EXPECT_EQ( l_reader.read( 1'500'000, 100 ),
+                   std::vector< std::byte >(
+                       ( l_original.begin() + 1'500'000 ),
+                       ( l_original.begin() + 1'500'100 ) ) );
+
+        std::fclose( l_file );
+    }
+}
+
+TEST( stdfunc, compress$batch ) {
+    // Records of varying size, some empty
+    std::vector< std::vector< std::byte > > l_records( 1000 );
+
+    for ( size_t l_record = 0; l_record < l_records.size(); l_record++ ) {
+        l_records[ l_record ].resize( ( l_record % 7 ) ? ( l_record % 600 )
+                                                         : 0 );
+
+        for ( size_t l_index = 0; l_index < l_records[ l_record ].size();
+              l_index++ ) {
+            l_records[ l_record ][ l_index ] =
+                std::byte( static_cast< unsigned char >(
+                    ( ( l_index / 10 ) * 7 ) ^ l_record ) );
+        }
+    }
+
+    std::vector< std::span< const std::byte > > l_buffers(
+        l_records.begin(), l_records.end() );
+
+    for ( const size_t _workers : { 1uz, 4uz } ) {
+        const std::optional< compress::arena > l_compressed =
+            compress::batch( l_buffers, 3, _workers );
+
+        ASSERT_TRUE( l_compressed.has_value() );
+        ASSERT_EQ( l_compressed->size(), l_records.size() );
+        EXPECT_EQ( l_compressed->offsets.back(), l_compressed->data.size() );
+
+        // Same frames as one at a time
+        for ( size_t l_record = 0; l_record < l_records.size(); l_record++ ) {
+            if ( l_records[ l_record ].empty() ) {
+                EXPECT_TRUE( ( *l_compressed )[ l_record ].empty() );
+
+                continue;
+            }
+
+            EXPECT_TRUE( std::ranges::equal(
+                ( *l_compressed )[ l_record ],
+                *compress::data( l_records[ l_record ] ) ) );
+        }
+
+        const std::optional< decompress::arena > l_decompressed =
+            decompress::batch( l_compressed->data, l_compressed->offsets,
+                               _workers );
+
+        ASSERT_TRUE( l_decompressed.has_value() );
+        ASSERT_EQ( l_decompressed->size(), l_records.size() );
+
+        for ( size_t l_record = 0; l_record < l_records.size(); l_record++ ) {
+            EXPECT_TRUE( std::ranges::equal( ( *l_decompressed )[ l_record ],
+                                             l_records[ l_record ] ) );
+        }
+
+        // The limit covers the whole batch
+        EXPECT_FALSE( decompress::batch( l_compressed->data,
+                                         l_compressed->offsets, _workers,
+                                         ( l_decompressed->data.size() - 1 ) )
+                          .has_value() );
+
+        // A corrupted frame fails the batch
+        std::vector< std::byte > l_corrupted = l_compressed->data;
+
+        l_corrupted[ l_compressed->offsets[ 1 ] + 10 ] ^= std::byte{ 0x55 };
+
+        EXPECT_FALSE(
+            decompress::batch( l_corrupted, l_compressed->offsets, _workers )
+                .has_value() );
+    }
+
+    // Empty batch
+    {
+        const std::optional< compress::arena > l_compressed =
+            compress::batch( {} );
+
+        ASSERT_TRUE( l_compressed.has_value() );
+        EXPECT_EQ( l_compressed->size(), 0 );
+        EXPECT_EQ( decompress::batch( {}, l_compressed->offsets )->size(), 0 );
+        EXPECT_FALSE( decompress::batch( {}, {} ).has_value() );
+    }
+
+    // With a dictionary
+    {
+        const compress::dictionary l_compressDictionary( l_records[ 599 ] );
+        const decompress::dictionary l_decompressDictionary(
+            l_records[ 599 ] );
+
+        const std::optional< compress::arena > l_compressed =
+            compress::batch( l_buffers, l_compressDictionary );
+
+        ASSERT_TRUE( l_compressed.has_value() );
+
+        const std::optional< decompress::arena > l_decompressed =
+            decompress::batch( l_compressed->data, l_compressed->offsets,
+                               l_decompressDictionary );
+
+        ASSERT_TRUE( l_decompressed.has_value() );
+        for ( size_t l_record = 0; l_record < l_records.size(); l_record++ ) {
+            EXPECT_TRUE( std::ranges::equal( ( *l_decompressed )[ l_record ],
+                                             l_records[ l_record ] ) );
+        }
+    }
+}
+
+TEST( stdfunc, compress$adaptive ) {
+    std::vector< std::byte > l_random( 200000 );
+    uint64_t l_state = 1;
+
+    for ( auto& _byte : l_random ) {
+        l_state = random::number::weak< uint64_t >( l_state );
+
+        _byte = std::byte( static_cast< unsigned char >( l_state >> 56 ) );
+    }
+
+    // Uniform histogram, yet trivially compressible
+    std::vector< std::byte > l_counter( 256 * 800 );
+
+    for ( size_t l_index = 0; l_index < l_counter.size(); l_index++ ) {
+        l_counter[ l_index ] =
+            std::byte( static_cast< unsigned char >( l_index ) );
+    }
+
+    const std::string l_sentence = "The quick brown fox jumps over the dog. ";
+    std::vector< std::byte > l_text;
+
+    for ( size_t l_index = 0; l_index < 5000; l_index++ ) {
+        const std::string l_line =
+            ( l_sentence + std::to_string( l_index * 7919 ) + '\n' );
+        const auto l_bytes = std::as_bytes( std::span( l_line ) );
+
+        l_text.insert( l_text.end(), l_bytes.begin(), l_bytes.end() );
+    }
+
+    // Entropy
+    {
+        EXPECT_EQ( compress::entropy( {} ), 0 );
+        EXPECT_EQ( compress::entropy( std::vector< std::byte >( 100 ) ), 0 );
+        EXPECT_DOUBLE_EQ( compress::entropy( l_counter ), 8 );
+        EXPECT_GT( compress::entropy( l_random ), 7.9 );
+        EXPECT_LT( compress::entropy( l_text ), 5 );
+    }
+
+    // Selection
+    {
+        EXPECT_EQ( compress::probe( l_random ).method,
+                   compress::codec::stored );
+        EXPECT_EQ( compress::probe( l_counter ).method, compress::codec::zstd );
+        EXPECT_NE( compress::probe( l_text ).method, compress::codec::stored );
+
+        // Too small to gain anything
+        EXPECT_EQ( compress::probe( std::span( l_text ).first( 10 ) ).method,
+                   compress::codec::stored );
+
+        // Savings it can never reach
+        EXPECT_EQ( compress::probe( l_text, { .minimumSavings = 1 } ).method,
+                   compress::codec::stored );
+
+        const compress::selection l_ratio = compress::probe(
+            l_text, { .target = compress::preference::ratio } );
+
+        EXPECT_EQ( l_ratio.method, compress::codec::zstd );
+        EXPECT_EQ( l_ratio.level, 9 );
+
+        const compress::selection l_speed = compress::probe(
+            l_text, { .target = compress::preference::speed } );
+
+        EXPECT_NE( l_speed.method, compress::codec::stored );
+        EXPECT_EQ( l_speed.level, 1 );
+    }
+
+    // Round trips
+    for ( const auto _target :
+          { compress::preference::speed, compress::preference::balanced,
+            compress::preference::ratio } ) {
+        for ( const std::span< const std::byte > _data :
+              { std::span< const std::byte >( l_random ),
+                std::span< const std::byte >( l_counter ),
+                std::span< const std::byte >( l_text ),
+                std::span< const std::byte >() } ) {
+            const std::optional< std::vector< std::byte > > l_compressed =
+                compress::adaptive( _data, { .target = _target } );
+
+            ASSERT_TRUE( l_compressed.has_value() );
+
+            // Never grows past the header
+            EXPECT_LE( l_compressed->size(), ( _data.size() + 1 ) );
+
+            const std::optional< std::vector< std::byte > > l_decompressed =
+                decompress::adaptive( *l_compressed );
+
+            ASSERT_TRUE( l_decompressed.has_value() );
+            EXPECT_TRUE( std::ranges::equal( *l_decompressed, _data ) );
+        }
+    }
+
+    // Stored data is copied behind the header
+    {
+        const std::optional< std::vector< std::byte > > l_compressed =
+            compress::adaptive( l_random );
+
+        ASSERT_TRUE( l_compressed.has_value() );
+        EXPECT_EQ( l_compressed->size(), ( l_random.size() + 1 ) );
+    }
+
+    // Corruption and limits
+    {
+        std::vector< std::byte > l_compressed = *compress::adaptive( l_text );
+
+        EXPECT_LT( l_compressed.size(), ( l_text.size() / 2 ) );
+        EXPECT_FALSE(
+            decompress::adaptive( l_compressed, ( l_text.size() - 1 ) )
+                .has_value() );
+
+        EXPECT_FALSE( decompress::adaptive( {} ).has_value() );
+
+        l_compressed.front() = std::byte{ 0x12 };
+
+        EXPECT_FALSE( decompress::adaptive( l_compressed ).has_value() );
+
+        l_compressed.front() = std::byte{ 0xAF };
+
+        EXPECT_FALSE( decompress::adaptive( l_compressed ).has_value() );
+
+        const std::optional< std::vector< std::byte > > l_stored =
+            compress::adaptive( l_random );
+
+        EXPECT_FALSE( decompress::adaptive( *l_stored, ( l_random.size() - 1 ) )
+                          .has_value() );
+    }
+}
+
+TEST( stdfunc, compress$lz ) {
+    std::vector< std::byte > l_text;
+
+    for ( size_t l_index = 0; l_index < 20000; l_index++ ) {
+        const std::string l_line = ( "level=info request=" +
+                                     std::to_string( l_index * 7919 ) +
+                                     " path=/api/v1/items status=200\n" );
+        const auto l_bytes = std::as_bytes( std::span( l_line ) );
+
+        l_text.insert( l_text.end(), l_bytes.begin(), l_bytes.end() );
+    }
+
+    std::vector< std::byte > l_random( 100000 );
+    uint64_t l_state = 1;
+
+    for ( auto& _byte : l_random ) {
+        l_state = random::number::weak< uint64_t >( l_state );
+
+        _byte = std::byte( static_cast< unsigned char >( l_state >> 56 ) );
+    }
+
+    // One byte repeated and a short period, matches overlapping their source
+    const std::vector< std::byte > l_run( 100000, std::byte{ 'a' } );
+    std::vector< std::byte > l_period( 100000 );
+
+    for ( size_t l_index = 0; l_index < l_period.size(); l_index++ ) {
+        l_period[ l_index ] =
+            std::byte( static_cast< unsigned char >( l_index % 3 ) );
+    }
+
+    // Round trips, including every size around the end of block rules
+    {
+        std::vector< std::span< const std::byte > > l_inputs = {
+            l_text, l_random, l_run, l_period };
+
+        for ( size_t l_size = 0; l_size < 40; l_size++ ) {
+            l_inputs.emplace_back( std::span( l_text ).first( l_size ) );
+        }
+
+        for ( const size_t _level : { 1uz, 2uz, 5uz, 9uz, 100uz } ) {
+            for ( const std::span< const std::byte > _input : l_inputs ) {
+                const std::optional< std::vector< std::byte > > l_compressed =
+                    compress::lz( _input, _level );
+
+                ASSERT_TRUE( l_compressed.has_value() );
+                EXPECT_LE( l_compressed->size(),
+                           compress::lzBound( _input.size() ) );
+                EXPECT_EQ( decompress::lzSize( *l_compressed ),
+                           _input.size() );
+
+                const std::optional< std::vector< std::byte > >
+                    l_decompressed = decompress::lz( *l_compressed );
+
+                ASSERT_TRUE( l_decompressed.has_value() );
+                EXPECT_TRUE( std::ranges::equal( *l_decompressed, _input ) );
+            }
+        }
+    }
+
+    // Ratio
+    {
+        const size_t l_fastSize = compress::lz( l_text )->size();
+        const size_t l_bestSize =
+            compress::lz( l_text, compress::g_lzMaxLevel )->size();
+
+        EXPECT_LT( l_fastSize, ( l_text.size() / 3 ) );
+        EXPECT_LT( l_bestSize, l_fastSize );
+        EXPECT_LT( compress::lz( l_run )->size(), 500 );
+        EXPECT_GT( compress::lz( l_random )->size(), l_random.size() );
+    }
+
+    // Buffers
+    {
+        EXPECT_FALSE( compress::lz( l_text, 0 ).has_value() );
+
+        std::vector< std::byte > l_buffer(
+            compress::lzBound( l_text.size() ) - 1 );
+
+        EXPECT_FALSE(
+            compress::lz( l_text, std::span( l_buffer ) ).has_value() );
+
+        l_buffer.resize( l_buffer.size() + 1 );
+
+        const std::optional< size_t > l_size =
+            compress::lz( l_text, std::span( l_buffer ) );
+
+        ASSERT_TRUE( l_size.has_value() );
+        EXPECT_TRUE( std::ranges::equal( std::span( l_buffer ).first( *l_size ),
+                                         *compress::lz( l_text ) ) );
+
+        // Appends after what is there
+        std::vector< std::byte > l_output( 3, std::byte{ 7 } );
+
+        ASSERT_EQ( compress::lz( l_text, l_output ), *l_size );
+        EXPECT_EQ( l_output.size(), ( 3 + *l_size ) );
+        EXPECT_EQ( l_output.front(), std::byte{ 7 } );
+
+        std::vector< std::byte > l_decompressed( l_text.size() - 1 );
+
+        EXPECT_FALSE( decompress::lz( std::span( l_buffer ).first( *l_size ),
+                                      std::span( l_decompressed ) )
+                          .has_value() );
+
+        l_decompressed.resize( l_text.size() + 10 );
+
+        EXPECT_EQ( decompress::lz( std::span( l_buffer ).first( *l_size ),
+                                   std::span( l_decompressed ) ),
+                   l_text.size() );
+    }
+
+    // Malformed input fails without touching memory out of bounds
+    {
+        const std::vector< std::byte > l_compressed =
+            *compress::lz( std::span( l_text ).first( 2000 ) );
+
+        EXPECT_FALSE(
+            decompress::lz( l_compressed, ( 2000 - 1 ) ).has_value() );
+        EXPECT_FALSE( decompress::lz( {} ).has_value() );
+
+        for ( size_t l_size = 0; l_size < l_compressed.size(); l_size++ ) {
+            EXPECT_FALSE(
+                decompress::lz( std::span( l_compressed ).first( l_size ) )
+                    .has_value() );
+        }
+
+        for ( size_t l_index = 0; l_index < l_compressed.size(); l_index++ ) {
+            std::vector< std::byte > l_corrupted = l_compressed;
+
+            l_corrupted[ l_index ] ^= std::byte{ 0xA5 };
+
+            const std::optional< std::vector< std::byte > > l_decompressed =
+                decompress::lz( l_corrupted );
+
+            if ( l_decompressed ) {
+                EXPECT_EQ( l_decompressed->size(), 2000 );
+            }
+        }
+
+        // A forged size larger than the block could produce
+        std::vector< std::byte > l_forged = { std::byte{ 0x80 },
+                                              std::byte{ 0x80 },
+                                              std::byte{ 0x10 },
+                                              std::byte{ 0x00 } };
+
+        EXPECT_FALSE( decompress::lz( l_forged ).has_value() );
+    }
+}
+
+TEST( stdfunc, compress$embed ) {
+    constexpr auto l_text =
+        "<html><body><p>compile time</p><p>compile time</p><p>compile time"
+        "</p><p>compile time</p><p>compile time</p></body></html>"_bytes;
+
+    constexpr auto l_compressed = compress::embed< l_text >();
+
+    static_assert( l_compressed.size() < l_text.size() );
+
+    // Long enough for length extensions and a full hash table
+    constexpr auto l_pattern = []() -> std::array< std::byte, 20000 > {
+        std::array< std::byte, 20000 > l_returnValue{};
+
+        for ( size_t l_index = 0; l_index < l_returnValue.size();
+              l_index++ ) {
+            l_returnValue[ l_index ] = std::byte( static_cast< unsigned char >(
+                ( ( l_index / 300 ) % 2 ) ? ( l_index % 251 ) : 'x' ) );
+        }
+
+        return ( l_returnValue );
+    }();
+
+    // Static, assets point at it from constant initialization
+    static constexpr auto l_compressedPattern = compress::embed< l_pattern >();
+
+    static_assert( l_compressedPattern.size() < ( l_pattern.size() / 10 ) );
+
+    // Same format as the runtime codec
+    {
+        EXPECT_EQ( decompress::lzSize( l_compressed ), l_text.size() );
+        EXPECT_TRUE( std::ranges::equal( *decompress::lz( l_compressed ),
+                                         l_text ) );
+        EXPECT_TRUE( std::ranges::equal(
+            *decompress::lz( l_compressedPattern ), l_pattern ) );
+
+        constexpr auto l_empty = compress::embed< std::array< char, 0 >{} >();
+        constexpr auto l_short =
+            compress::embed< std::to_array( { 'a', 'b', 'c' } ) >();
+
+        EXPECT_TRUE( decompress::lz( l_empty )->empty() );
+        EXPECT_TRUE( std::ranges::equal(
+            *decompress::lz( l_short ), "abc"_bytes ) );
+    }
+
+    // Decompressed once, on first use
+    {
+        static constinit decompress::asset l_asset( l_compressedPattern );
+
+        const std::span< const std::byte > l_data = l_asset.data();
+
+        EXPECT_TRUE( std::ranges::equal( l_data, l_pattern ) );
+        EXPECT_EQ( l_asset.data().data(), l_data.data() );
+
+        std::vector< std::thread > l_threads;
+        std::atomic< size_t > l_matching = 0;
+
+        for ( size_t l_thread = 0; l_thread < 4; l_thread++ ) {
+            l_threads.emplace_back( [ & ]() -> void {
+                if ( l_asset.data().data() == l_data.data() ) {
+                    l_matching++;
+                }
+            } );
+        }
+
+        for ( auto& _thread : l_threads ) {
+            _thread.join();
+        }
+
+        EXPECT_EQ( l_matching, 4 );
+    }
+
+    // Truncated blocks stay empty
+    {
+        const std::span< const std::byte > l_truncated =
+            std::span( l_compressed ).first( l_compressed.size() - 1 );
+
+        decompress::asset l_asset( l_truncated );
+
+        EXPECT_TRUE( l_asset.data().empty() );
+
+        decompress::asset l_empty( {} );
+
+        EXPECT_TRUE( l_empty.data().empty() );
+    }
+}
+
+TEST( stdfunc, compress$checked ) {
+    // Incompressible first block, then text
+    std::vector< std::byte > l_data( 4096 );
+    uint64_t l_state = 1;
+
+    for ( auto& _byte : l_data ) {
+        l_state = random::number::weak< uint64_t >( l_state );
+
+        _byte = std::byte( static_cast< unsigned char >( l_state >> 56 ) );
+    }
+
+    const std::string l_sentence = "The quick brown fox jumps over the dog. ";
+
+    for ( size_t l_index = 0; l_index < 2000; l_index++ ) {
+        const std::string l_line =
+            ( l_sentence + std::to_string( l_index * 7919 ) + '\n' );
+        const auto l_bytes = std::as_bytes( std::span( l_line ) );
+
+        l_data.insert( l_data.end(), l_bytes.begin(), l_bytes.end() );
+    }
+
+    // Round trips
+    for ( const auto _method : { compress::codec::stored, compress::codec::lz,
+                                 compress::codec::snappy,
+                                 compress::codec::zstd } ) {
+        for ( const size_t _workers : { 1, 4 } ) {
+            const std::optional< std::vector< std::byte > > l_compressed =
+                compress::checked( l_data, { .method = _method,
+                                             .blockSize = 4096,
+                                             .workers = _workers } );
+
+            ASSERT_TRUE( l_compressed.has_value() );
+
+            if ( _method != compress::codec::stored ) {
+                EXPECT_LT( l_compressed->size(), l_data.size() );
+            }
+
+            const std::expected< std::vector< std::byte >, decompress::error >
+                l_decompressed =
+                    decompress::checked( *l_compressed, _workers );
+
+            ASSERT_TRUE( l_decompressed.has_value() );
+            EXPECT_EQ( *l_decompressed, l_data );
+        }
+    }
+
+    const std::vector< std::byte > l_compressed =
+        *compress::checked( l_data, { .blockSize = 4096 } );
+
+    // Empty
+    {
+        const std::optional< std::vector< std::byte > > l_empty =
+            compress::checked( {} );
+
+        ASSERT_TRUE( l_empty.has_value() );
+        EXPECT_TRUE( decompress::checked( *l_empty )->empty() );
+
+        EXPECT_FALSE( compress::checked( l_data, { .blockSize = 0 } ) );
+    }
+
+    // Payload of the stored first block changed
+    {
+        std::vector< std::byte > l_corrupted = l_compressed;
+
+        // Frame and block header
+        l_corrupted[ 12 + 13 + 100 ] ^= std::byte{ 1 };
+
+        EXPECT_EQ( decompress::checked( l_corrupted ).error(),
+                   decompress::error::corrupted );
+    }
+
+    // Framing
+    {
+        std::vector< std::byte > l_magic = l_compressed;
+
+        l_magic.front() ^= std::byte{ 1 };
+
+        EXPECT_EQ( decompress::checked( l_magic ).error(),
+                   decompress::error::malformed );
+        EXPECT_EQ( decompress::checked( std::span( l_compressed )
+                                            .first( l_compressed.size() - 1 ) )
+                       .error(),
+                   decompress::error::malformed );
+        EXPECT_EQ( decompress::checked( l_compressed, 0, 1000 ).error(),
+                   decompress::error::tooLarge );
+    }
+}
+
+TEST( stdfunc, compress$array ) {
+    // Odd counts leave tails after the vector and bit group loops
+    std::vector< int32_t > l_timestamps( 10'007 );
+    std::vector< float > l_temperatures( 10'007 );
+    std::vector< double > l_prices( 10'007 );
+    std::vector< float16_t > l_half( 1'001 );
+    std::vector< uint128_t > l_ids( 1'001 );
+
+    for ( size_t l_index = 0; l_index < l_timestamps.size(); l_index++ ) {
+        l_timestamps[ l_index ] =
+            static_cast< int32_t >( 1'700'000'000 + ( l_index * 60 ) +
+                                    ( l_index % 3 ) );
+        l_temperatures[ l_index ] = static_cast< float >(
+            20 + ( 5 * std::sin( static_cast< double >( l_index ) / 500 ) ) );
+        l_prices[ l_index ] = static_cast< double >(
+            ( 100 * std::exp( std::sin( static_cast< double >( l_index ) /
+                                        900 ) ) ) );
+    }
+
+    for ( size_t l_index = 0; l_index < l_half.size(); l_index++ ) {
+        l_half[ l_index ] = static_cast< float16_t >(
+            static_cast< float >( l_index % 100 ) / 8 );
+        l_ids[ l_index ] = ( ( uint128_t{ 1 } << 100 ) + ( l_index * 7 ) );
+    }
+
+    const auto l_roundTrip = [ & ]< typename T >(
+                                 const std::vector< T >& _values,
+                                 compress::filter _transform,
+                                 compress::codec _method ) -> size_t {
+        const std::optional< std::vector< std::byte > > l_compressed =
+            compress::array< T >(
+                _values, { .transform = _transform, .method = _method } );
+
+        EXPECT_TRUE( l_compressed.has_value() );
+
+        if ( !l_compressed ) {
+            return ( 0 );
+        }
+
+        EXPECT_EQ( decompress::arraySize( *l_compressed ), _values.size() );
+
+        const std::optional< std::vector< T > > l_decompressed =
+            decompress::array< T >( *l_compressed );
+
+        EXPECT_TRUE( l_decompressed.has_value() );
+
+        if ( l_decompressed ) {
+            EXPECT_TRUE( std::ranges::equal(
+                std::as_bytes( std::span( *l_decompressed ) ),
+                std::as_bytes( std::span( _values ) ) ) );
+        }
+
+        return ( l_compressed->size() );
+    };
+
+    // Round trips
+    for ( const auto _method :
+          { compress::codec::stored, compress::codec::lz,
+            compress::codec::snappy, compress::codec::zstd } ) {
+        for ( const auto _transform :
+              { compress::filter::none, compress::filter::shuffle,
+                compress::filter::bitShuffle, compress::filter::delta,
+                compress::filter::xorDelta } ) {
+            l_roundTrip( l_timestamps, _transform, _method );
+            l_roundTrip( l_temperatures, _transform, _method );
+            l_roundTrip( l_half, _transform, _method );
+            l_roundTrip( l_ids, _transform, _method );
+            l_roundTrip( std::vector< uint8_t >( 100, 7 ), _transform,
+                         _method );
+            l_roundTrip( std::vector< uint64_t >(), _transform, _method );
+        }
+
+        l_roundTrip( l_temperatures, compress::filter::gorilla, _method );
+        l_roundTrip( l_prices, compress::filter::gorilla, _method );
+    }
+
+    // Filters help the codec
+    {
+        const auto l_size = [ & ]< typename T >(
+                                const std::vector< T >& _values,
+                                compress::filter _transform ) -> size_t {
+            return ( l_roundTrip( _values, _transform,
+                                  compress::codec::zstd ) );
+        };
+
+        EXPECT_LT( l_size( l_timestamps, compress::filter::delta ),
+                   ( l_size( l_timestamps, compress::filter::none ) / 2 ) );
+        EXPECT_LT( l_size( l_temperatures, compress::filter::shuffle ),
+                   l_size( l_temperatures, compress::filter::none ) );
+        EXPECT_LT( l_size( l_prices, compress::filter::gorilla ),
+                   l_size( l_prices, compress::filter::none ) );
+    }
+
+    // Invalid
+    {
+        const std::array< std::byte, 3 > l_partial{};
+
+        EXPECT_FALSE( compress::array( l_partial, 2 ) );
+        EXPECT_FALSE( compress::array( l_partial, 3 ) );
+        EXPECT_FALSE( compress::array< float16_t >(
+            l_half, { .transform = compress::filter::gorilla } ) );
+
+        const std::vector< std::byte > l_compressed =
+            *compress::array< float >( l_temperatures );
+
+        // Element size differs
+        EXPECT_FALSE( decompress::array< int16_t >( l_compressed ) );
+        EXPECT_FALSE(
+            decompress::array< float >( l_compressed, sizeof( float ) ) );
+        EXPECT_FALSE( decompress::array< float >(
+            std::span( l_compressed ).first( l_compressed.size() - 1 ) ) );
+
+        std::vector< std::byte > l_magic = l_compressed;
+
+        l_magic.front() = std::byte{ 0xA0 };
+
+        EXPECT_FALSE( decompress::array< float >( l_magic ) );
+    }
+}
+
+TEST( stdfunc, compress$integers ) {
+    static_assert( compress::zigzag( 0 ) == 0 );
+    static_assert( compress::zigzag( -1 ) == 1 );
+    static_assert( compress::zigzag( 1 ) == 2 );
+    static_assert( decompress::zigzag( compress::zigzag(
+                       std::numeric_limits< int32_t >::min() ) ) ==
+                   std::numeric_limits< int32_t >::min() );
+
+    uint64_t l_state = 1;
+
+    const auto l_random = [ & ]( size_t _bits ) -> uint32_t {
+        l_state = random::number::weak< uint64_t >( l_state );
+
+        return ( static_cast< uint32_t >(
+            ( l_state >> 32 ) & ( ( uint64_t{ 1 } << _bits ) - 1 ) ) );
+    };
+
+    // Delta
+    for ( const size_t _size : { 0, 1, 3, 4, 9, 1000 } ) {
+        std::vector< uint32_t > l_values( _size );
+
+        for ( auto& _value : l_values ) {
+            _value = l_random( 32 );
+        }
+
+        std::vector< uint32_t > l_deltas = l_values;
+
+        compress::delta( l_deltas, 7 );
+
+        if ( _size ) {
+            EXPECT_EQ( l_deltas.front(), ( l_values.front() - 7 ) );
+        }
+
+        if ( _size > 1 ) {
+            EXPECT_EQ( l_deltas.back(),
+                       ( l_values.back() - l_values[ _size - 2 ] ) );
+        }
+
+        decompress::delta( l_deltas, 7 );
+
+        EXPECT_EQ( l_deltas, l_values );
+    }
+
+    // Round trips over every width and block tail
+    for ( const size_t _size : { 0, 1, 127, 128, 129, 1000 } ) {
+        for ( size_t l_bits = 0; l_bits <= 32; l_bits++ ) {
+            std::vector< uint32_t > l_values( _size );
+
+            for ( auto& _value : l_values ) {
+                _value = ( 1'000 + l_random( l_bits ) );
+            }
+
+            std::vector< std::byte > l_buffer(
+                std::max( compress::packedBound( _size ),
+                          compress::streamVByteBound( _size ) ) );
+            std::vector< uint32_t > l_decoded( _size );
+
+            const std::optional< size_t > l_packedSize =
+                compress::packed( l_values, l_buffer );
+
+            ASSERT_TRUE( l_packedSize.has_value() );
+            EXPECT_EQ( decompress::packed(
+                           std::span( l_buffer ).first( *l_packedSize ),
+                           l_decoded ),
+                       l_packedSize );
+            EXPECT_EQ( l_decoded, l_values );
+
+            const std::optional< size_t > l_vbyteSize =
+                compress::streamVByte( l_values, l_buffer );
+
+            std::ranges::fill( l_decoded, 0 );
+
+            ASSERT_TRUE( l_vbyteSize.has_value() );
+            EXPECT_EQ( decompress::streamVByte(
+                           std::span( l_buffer ).first( *l_vbyteSize ),
+                           l_decoded ),
+                       l_vbyteSize );
+            EXPECT_EQ( l_decoded, l_values );
+        }
+    }
+
+    // Sorted posting list
+    {
+        std::vector< uint32_t > l_postings( 10'000 );
+        uint32_t l_document = 0;
+
+        for ( auto& _posting : l_postings ) {
+            _posting = ( l_document += ( 1 + l_random( 4 ) ) );
+        }
+
+        std::vector< uint32_t > l_gaps = l_postings;
+
+        compress::delta( l_gaps );
+
+        std::vector< std::byte > l_buffer(
+            compress::packedBound( l_gaps.size() ) );
+
+        const std::optional< size_t > l_size =
+            compress::packed( l_gaps, l_buffer );
+
+        ASSERT_TRUE( l_size.has_value() );
+
+        // 4 bits and a header per 128 gaps
+        EXPECT_LT( *l_size, ( l_gaps.size() * 5 / 8 ) );
+
+        std::vector< uint32_t > l_decoded( l_gaps.size() );
+
+        ASSERT_TRUE( decompress::packed( l_buffer, l_decoded ) );
+
+        decompress::delta( l_decoded );
+
+        EXPECT_EQ( l_decoded, l_postings );
+    }
+
+    // Buffers too small and truncated input
+    {
+        const std::vector< uint32_t > l_values( 300, 0xFFFFFFFF );
+        std::vector< std::byte > l_buffer(
+            compress::packedBound( l_values.size() ) - 1 );
+        std::vector< uint32_t > l_decoded( l_values.size() );
+
+        EXPECT_FALSE( compress::packed( l_values, l_buffer ) );
+
+        l_buffer.resize( compress::streamVByteBound( l_values.size() ) - 1 );
+
+        EXPECT_FALSE( compress::streamVByte( l_values, l_buffer ) );
+
+        l_buffer.resize( l_buffer.size() + 1 );
+
+        const size_t l_packedSize = *compress::packed( l_values, l_buffer );
+
+        EXPECT_FALSE( decompress::packed(
+            std::span( l_buffer ).first( l_packedSize - 1 ), l_decoded ) );
+
+        // Width past 32 bits
+        l_buffer.front() = std::byte{ 33 };
+
+        EXPECT_FALSE( decompress::packed( l_buffer, l_decoded ) );
+
+        const size_t l_vbyteSize =
+            *compress::streamVByte( l_values, l_buffer );
+
+        EXPECT_FALSE( decompress::streamVByte(
+            std::span( l_buffer ).first( l_vbyteSize - 1 ), l_decoded ) );
+    }
+}
+
+TEST( stdfunc, compress$entropy ) {
+    uint64_t l_state = 1;
+
+    // Geometric bytes of about 2 bits entropy, 11 distinct values
+    const auto l_skewed = [ & ]( size_t _size ) -> std::vector< std::byte > {
+        std::vector< std::byte > l_returnValue( _size );
+
+        for ( auto& _byte : l_returnValue ) {
+            l_state = random::number::weak< uint64_t >( l_state );
+
+            _byte = static_cast< std::byte >(
+                std::countr_zero( ( l_state >> 32 ) | ( 1ULL << 10 ) ) * 3 );
+        }
+
+        return ( l_returnValue );
+    };
+
+    // Histogram and normalization
+    {
+        const std::vector< std::byte > l_data = l_skewed( 10'000 );
+        const entropy::histogram_t l_counts = entropy::histogram( l_data );
+
+        EXPECT_EQ( std::accumulate( l_counts.begin(), l_counts.end(),
+                                    size_t{ 0 } ),
+                   l_data.size() );
+
+        const std::optional< entropy::distribution > l_distribution =
+            entropy::normalize( l_counts, 10 );
+
+        ASSERT_TRUE( l_distribution.has_value() );
+        EXPECT_TRUE( entropy::isValid( *l_distribution ) );
+
+        for ( size_t l_symbol = 0; l_symbol < l_counts.size(); l_symbol++ ) {
+            EXPECT_EQ( !!l_counts[ l_symbol ],
+                       !!l_distribution->frequencies[ l_symbol ] );
+        }
+
+        const std::vector< std::byte > l_serialized =
+            entropy::serialize( *l_distribution );
+        std::span< const std::byte > l_view = l_serialized;
+
+        const std::optional< entropy::distribution > l_deserialized =
+            entropy::deserialize( l_view );
+
+        ASSERT_TRUE( l_deserialized.has_value() );
+        EXPECT_TRUE( l_view.empty() );
+        EXPECT_EQ( l_deserialized->tableLog, 10 );
+        EXPECT_EQ( l_deserialized->frequencies, l_distribution->frequencies );
+
+        EXPECT_FALSE( entropy::normalize( entropy::histogram_t{} ) );
+        EXPECT_FALSE( entropy::normalize( l_counts, 4 ) );
+
+        l_view = std::span( l_serialized ).first( l_serialized.size() - 1 );
+
+        EXPECT_FALSE( entropy::deserialize( l_view ) );
+    }
+
+    // Round trips, self-described and with a table of the data itself
+    for ( const size_t _size : { 0, 1, 2, 3, 5, 7, 100, 4096, 100'000 } ) {
+        for ( const bool _isUniform : { false, true } ) {
+            std::vector< std::byte > l_data = l_skewed( _size );
+
+            if ( _isUniform ) {
+                for ( size_t l_index = 0; l_index < _size; l_index++ ) {
+                    l_data[ l_index ] = static_cast< std::byte >( l_index );
+                }
+            }
+
+            const auto l_ans = compress::ans( l_data );
+            const auto l_huffman = compress::huffman( l_data );
+
+            ASSERT_TRUE( l_ans.has_value() );
+            ASSERT_TRUE( l_huffman.has_value() );
+            EXPECT_EQ( decompress::ans( *l_ans ), l_data );
+            EXPECT_EQ( decompress::huffman( *l_huffman ), l_data );
+
+            if ( !_size ) {
+                continue;
+            }
+
+            const entropy::distribution l_distribution =
+                *entropy::normalize( entropy::histogram( l_data ) );
+            const compress::entropyTable l_encoder( l_distribution );
+            const decompress::entropyTable l_decoder( l_distribution );
+
+            EXPECT_EQ( l_encoder.tableLog(), entropy::g_defaultTableLog );
+            EXPECT_EQ( decompress::ans( *compress::ans( l_data, l_encoder ),
+                                        l_decoder ),
+                       l_data );
+            EXPECT_EQ(
+                decompress::huffman( *compress::huffman( l_data, l_encoder ),
+                                     l_decoder ),
+                l_data );
+        }
+    }
+
+    // Single symbol
+    {
+        const std::vector< std::byte > l_data( 1000, std::byte{ 'a' } );
+
+        EXPECT_EQ( decompress::ans( *compress::ans( l_data ) ), l_data );
+        EXPECT_EQ( decompress::huffman( *compress::huffman( l_data ) ),
+                   l_data );
+    }
+
+    // One precomputed table reused across inputs from the same source
+    {
+        const entropy::distribution l_distribution =
+            *entropy::normalize( entropy::histogram( l_skewed( 100'000 ) ) );
+        const compress::entropyTable l_encoder( l_distribution );
+        const decompress::entropyTable l_decoder( l_distribution );
+
+        for ( size_t l_message = 0; l_message < 10; l_message++ ) {
+            const std::vector< std::byte > l_data = l_skewed( 5'000 );
+
+            const auto l_ans = compress::ans( l_data, l_encoder );
+            const auto l_huffman = compress::huffman( l_data, l_encoder );
+
+            ASSERT_TRUE( l_ans.has_value() );
+            ASSERT_TRUE( l_huffman.has_value() );
+
+            // Entropy of the source is about 2 bits per byte
+            EXPECT_LT( l_ans->size(), ( l_data.size() / 3 ) );
+            EXPECT_LT( l_huffman->size(), ( l_data.size() / 3 ) );
+
+            EXPECT_EQ( decompress::ans( *l_ans, l_decoder ), l_data );
+            EXPECT_EQ( decompress::huffman( *l_huffman, l_decoder ), l_data );
+            EXPECT_FALSE( decompress::ans( *l_ans, l_decoder, 4'999 ) );
+            EXPECT_FALSE( decompress::huffman( *l_huffman, l_decoder, 4'999 ) );
+        }
+
+        // A byte the table has no frequency for
+        const std::vector< std::byte > l_unknown( 10, std::byte{ 1 } );
+
+        EXPECT_FALSE( compress::ans( l_unknown, l_encoder ) );
+        EXPECT_FALSE( compress::huffman( l_unknown, l_encoder ) );
+
+        // Invalid distribution
+        const compress::entropyTable l_invalid( entropy::distribution{} );
+
+        EXPECT_EQ( l_invalid.tableLog(), 0 );
+        EXPECT_FALSE( compress::ans( l_skewed( 10 ), l_invalid ) );
+    }
+
+    // Truncated and corrupt input
+    {
+        const std::vector< std::byte > l_data = l_skewed( 10'000 );
+
+        std::vector< std::byte > l_ans = *compress::ans( l_data );
+        std::vector< std::byte > l_huffman = *compress::huffman( l_data );
+
+        EXPECT_FALSE( decompress::ans(
+            std::span( l_ans ).first( l_ans.size() - 1 ) ) );
+        EXPECT_FALSE( decompress::huffman(
+            std::span( l_huffman ).first( l_huffman.size() - 1 ) ) );
+
+        l_ans.back() = std::byte{ 0 };
+        l_huffman[ l_huffman.size() / 2 ] ^= std::byte{ 0x10 };
+
+        EXPECT_FALSE( decompress::ans( l_ans ) );
+        EXPECT_NE( decompress::huffman( l_huffman ), l_data );
+    }
+}
+
+TEST( stdfunc, compress$async ) {
+    std::vector< std::byte > l_original( 3 * 1024 * 1024 + 17 );
+
+    for ( size_t l_index = 0; l_index < l_original.size(); l_index++ ) {
+        l_original[ l_index ] =
+            std::byte( static_cast< unsigned char >( ( l_index / 7 ) % 251 ) );
+    }
+
+    async::pool l_pool( 2 );
+
+    // Same frame as compress::data, decompressed on the pool as well
+    {
+        using result_t = std::optional< std::vector< std::byte > >;
+
+        auto l_roundTrip = [ & ]() -> async::task< result_t > {
+            const auto l_compressed =
+                co_await compress::async( l_original, 3, l_pool );
+
+            EXPECT_EQ( l_compressed, compress::data( l_original ) );
+
+            co_return ( co_await decompress::async(
+                *l_compressed, 0, decompress::g_defaultMaxDataSize, l_pool ) );
+        };
+
+        EXPECT_EQ( async::wait( l_roundTrip() ), l_original );
+
+        EXPECT_FALSE( async::wait( compress::async( {}, 3, l_pool ) ) );
+        EXPECT_FALSE(
+            async::wait( decompress::async( l_original, 0, 1024, l_pool ) ) );
+    }
+
+    // Many messages in flight on the default pool
+    {
+        std::vector< async::task< std::optional< std::vector< std::byte > > > >
+            l_tasks;
+
+        for ( size_t l_index = 0; l_index < 16; l_index++ ) {
+            l_tasks.emplace_back( compress::async(
+                std::span( l_original ).subspan( l_index * 1000, 1000 ) ) );
+        }
+
+        for ( size_t l_index = 0; l_index < l_tasks.size(); l_index++ ) {
+            const auto l_compressed =
+                async::wait( std::move( l_tasks[ l_index ] ) );
+            ASSERT_TRUE( l_compressed.has_value() );
+
+            EXPECT_TRUE( std::ranges::equal(
+                *decompress::data( *l_compressed ),
+                std::span( l_original ).subspan( l_index * 1000, 1000 ) ) );
+        }
+    }
+
+    // Pipeline writes frames in order, one stream for decompress::data
+    {
+        std::stringstream l_input;
+
+        l_input.write( reinterpret_cast< const char* >( l_original.data() ),
+                       static_cast< std::streamsize >( l_original.size() ) );
+
+        std::stringstream l_output;
+
+        ASSERT_TRUE(
+            compress::pipeline( l_input, l_output, 3, 256 * 1024, l_pool ) );
+
+        const std::string l_frames = l_output.str();
+        const std::span< const std::byte > l_compressed(
+            reinterpret_cast< const std::byte* >( l_frames.data() ),
+            l_frames.size() );
+
+        EXPECT_EQ( decompress::dataSize( l_compressed ), l_original.size() );
+        EXPECT_EQ( decompress::data( l_compressed ), l_original );
+
+        // Chunk size 0 and empty input
+        std::stringstream l_empty;
+
+        EXPECT_FALSE( compress::pipeline( l_empty, l_output, 3, 0, l_pool ) );
+        EXPECT_TRUE( compress::pipeline( l_empty, l_output, 3,
+                                         compress::g_defaultPipelineChunkSize,
+                                         l_pool ) );
+    }
+}
+
+TEST( stdfunc, archive$pack ) {
+    std::vector< std::string > l_names;
+    std::vector< std::vector< std::byte > > l_contents;
+
+    for ( size_t l_index = 0; l_index < 300; l_index++ ) {
+        l_names.emplace_back( "shaders/" + std::to_string( l_index ) +
+                              ".frag" );
+
+        // Small text-like entries, an empty one and a few large ones
+        std::vector< std::byte > l_content(
+            ( l_index == 7 ) ? 0
+                             : ( ( l_index % 50 ) ? ( 100 + l_index * 3 )
+                                                  : ( 200'000 + l_index ) ) );
+
+        for ( size_t l_byte = 0; l_byte < l_content.size(); l_byte++ ) {
+            l_content[ l_byte ] = std::byte( static_cast< unsigned char >(
+                'a' + ( ( l_byte / 5 + l_index ) % 13 ) ) );
+        }
+
+        l_contents.emplace_back( std::move( l_content ) );
+    }
+
+    std::vector< archive::entry > l_entries;
+
+    for ( size_t l_index = 0; l_index < l_names.size(); l_index++ ) {
+        l_entries.emplace_back( l_names[ l_index ], l_contents[ l_index ] );
+    }
+
+    auto l_check = [ & ]( archive::reader& _reader ) -> void {
+        ASSERT_TRUE( _reader.isValid() );
+        ASSERT_EQ( _reader.size(), l_names.size() );
+
+        for ( size_t l_index = 0; l_index < l_names.size(); l_index++ ) {
+            EXPECT_EQ( _reader.name( l_index ), l_names[ l_index ] );
+            EXPECT_EQ( _reader.entrySize( l_names[ l_index ] ),
+                       l_contents[ l_index ].size() );
+            EXPECT_EQ( _reader.read( l_names[ l_index ] ),
+                       l_contents[ l_index ] );
+
+            if ( const auto l_view = _reader.view( l_names[ l_index ] ) ) {
+                EXPECT_TRUE(
+                    std::ranges::equal( *l_view, l_contents[ l_index ] ) );
+            }
+        }
+
+        EXPECT_FALSE( _reader.contains( "shaders/300.frag" ) );
+        EXPECT_FALSE( _reader.read( "" ).has_value() );
+        EXPECT_EQ( _reader.name( l_names.size() ), "" );
+
+        // Too small a buffer
+        std::vector< std::byte > l_buffer( l_contents[ 0 ].size() - 1 );
+
+        EXPECT_FALSE( _reader.read( l_names[ 0 ], l_buffer ).has_value() );
+    };
+
+    // Stored entries are aligned views into the archive
+    {
+        const auto l_archive = archive::pack(
+            l_entries, { .method = compress::codec::stored } );
+
+        ASSERT_TRUE( l_archive.has_value() );
+
+        archive::reader l_reader( *l_archive );
+
+        l_check( l_reader );
+
+        const auto l_view = l_reader.view( l_names[ 1 ] );
+
+        ASSERT_TRUE( l_view.has_value() );
+        EXPECT_EQ( ( ( l_view->data() - l_archive->data() ) %
+                     archive::g_defaultAlignment ),
+                   0 );
+    }
+
+    // Per entry and solid blocks, with the built-in codec and zstd
+    for ( const compress::codec _method :
+          { compress::codec::lz, compress::codec::zstd } ) {
+        for ( const size_t _solidBlockSize : { size_t{ 0 }, size_t{ 4096 } } ) {
+            const auto l_archive =
+                archive::pack( l_entries, { .method = _method,
+                                            .solidBlockSize = _solidBlockSize,
+                                            .alignment = 64,
+                                            .workers = 2 } );
+
+            ASSERT_TRUE( l_archive.has_value() );
+
+            archive::reader l_reader( *l_archive );
+
+            l_check( l_reader );
+
+            // Compressed entries are only read
+            EXPECT_FALSE( l_reader.view( l_names[ 0 ] ).has_value() );
+
+            // Corruption of the index is caught on open
+            std::vector< std::byte > l_corrupted = *l_archive;
+
+            l_corrupted[ l_corrupted.size() - 1 ] ^= std::byte{ 1 };
+
+            EXPECT_FALSE( archive::reader( l_corrupted ).isValid() );
+            EXPECT_FALSE(
+                archive::reader( std::span( *l_archive ).first( 100 ) )
+                    .isValid() );
+
+            // So is an index with a valid checksum that would decompress
+            // beyond the limit
+            EXPECT_FALSE( archive::reader( *l_archive, 100 ).isValid() );
+
+            std::vector< std::byte > l_crafted = *l_archive;
+
+            auto l_little = [ & ]( size_t _offset, size_t _width ) -> uint64_t {
+                uint64_t l_value = 0;
+
+                for ( size_t l_byte = 0; l_byte < _width; l_byte++ ) {
+                    l_value |= ( std::to_integer< uint64_t >(
+                                     l_crafted[ _offset + l_byte ] )
+                                 << ( l_byte * 8 ) );
+                }
+
+                return ( l_value );
+            };
+
+            auto l_store = [ & ]( size_t _offset, size_t _width,
+                                  uint64_t _value ) -> void {
+                for ( size_t l_byte = 0; l_byte < _width; l_byte++ ) {
+                    l_crafted[ _offset + l_byte ] =
+                        static_cast< std::byte >( _value >> ( l_byte * 8 ) );
+                }
+            };
+
+            const size_t l_indexOffset = l_little( 16, 8 );
+            const size_t l_indexSize = l_little( 24, 8 );
+
+            // Uncompressed size of the first block
+            l_store( ( l_indexOffset + 16 ), 8, ( uint64_t{ 1 } << 62 ) );
+            l_store( 36, 4,
+                     hash::crc32c( std::span( l_crafted )
+                                       .subspan( l_indexOffset,
+                                                 l_indexSize ) ) );
+
+            EXPECT_FALSE( archive::reader( l_crafted ).isValid() );
+        }
+    }
+
+    // Duplicate names and bad alignments
+    {
+        l_entries.emplace_back( l_names[ 3 ], l_contents[ 3 ] );
+
+        EXPECT_FALSE( archive::pack( l_entries ).has_value() );
+
+        l_entries.pop_back();
+
+        EXPECT_FALSE( archive::pack( l_entries, { .alignment = 3 } ) );
+        EXPECT_TRUE( archive::reader( *archive::pack( {} ) ).isValid() );
+    }
+
+    // Files, mapped by the reader
+    {
+        const std::filesystem::path l_directory =
+            ( std::filesystem::temp_directory_path() / "stdfunc-archive" );
+
+        std::filesystem::create_directories( l_directory / "shaders" );
+
+        std::vector< std::filesystem::path > l_paths;
+
+        for ( size_t l_index = 0; l_index < 20; l_index++ ) {
+            l_paths.emplace_back( l_directory / l_names[ l_index ] );
+
+            std::ofstream( l_paths.back(), std::ios::binary )
+                .write( reinterpret_cast< const char* >(
+                            l_contents[ l_index ].data() ),
+                        static_cast< std::streamsize >(
+                            l_contents[ l_index ].size() ) );
+        }
+
+        const std::filesystem::path l_output = ( l_directory / "all.pack" );
+
+        ASSERT_TRUE( archive::pack( l_paths, l_output,
+                                    { .solidBlockSize = 1024 },
+                                    l_directory ) );
+
+        archive::reader l_reader( l_output );
+        archive::reader l_moved = std::move( l_reader );
+
+        EXPECT_FALSE( l_reader.isValid() );
+        ASSERT_TRUE( l_moved.isValid() );
+        EXPECT_EQ( l_moved.size(), l_paths.size() );
+
+        for ( size_t l_index = 0; l_index < l_paths.size(); l_index++ ) {
+            EXPECT_EQ( l_moved.read( l_names[ l_index ] ),
+                       l_contents[ l_index ] );
+        }
+
+        EXPECT_FALSE( archive::reader( l_directory / "missing.pack" )
+                          .isValid() );
+
+        std::filesystem::remove_all( l_directory );
+    }
+}
+
 struct person {
     int id{};
     double salary{};